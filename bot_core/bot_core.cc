@@ -90,6 +90,7 @@ void* LGTBot_Create(const LGTBot_Option* const options, const char** const p)
         return nullptr;
     }
     InfoLog() << "Create the bot successfully, addr:" << std::get<BotCtx*>(bot);
+    std::get<BotCtx*>(bot)->match_manager().RecoverMatches();
     return std::get<BotCtx*>(bot);
 }
 
@@ -125,6 +126,8 @@ ErrCode LGTBot_HandlePrivateRequest(void* const bot_p, const char* const uid, co
     }
     DebugLog() << "Handle private request uid=" << uid << " msg=\"" << msg << "\"";
     BotCtx& bot = *static_cast<BotCtx*>(bot_p);
+    ScopedLatency latency(bot.metrics().Histogram("request.private")); // constructed before the sender to include sending
+    const auto coalescer = bot.MakeMsgCoalescer();
     MsgSender sender = bot.MakeMsgSender(UserID{uid});
     return HandleRequest(bot, std::nullopt, uid, msg, sender);
 }
@@ -154,6 +157,8 @@ ErrCode LGTBot_HandlePublicRequest(void* const bot_p, const char* const gid, con
     }
     DebugLog() << "Handle public request uid=" << uid << " gid=" << gid << " msg=" << msg;
     BotCtx& bot = *static_cast<BotCtx*>(bot_p);
+    ScopedLatency latency(bot.metrics().Histogram("request.public")); // constructed before the sender to include sending
+    const auto coalescer = bot.MakeMsgCoalescer();
     PublicReplyMsgSender sender(bot.MakeMsgSender(GroupID{gid}), UserID{uid});
     return HandleRequest(bot, gid, uid, msg, sender);
 }
@@ -49,6 +49,7 @@ ERRCODE_DEF(EC_REQUEST_UNKNOWN_GAME)
 
 ERRCODE_DEF_V(EC_GAME_ALREADY_RELEASE, 401)
 ERRCODE_DEF(EC_USER_SUICIDE_FAILED)
+ERRCODE_DEF(EC_GAME_LOAD_FAILED)
 
 ERRCODE_DEF_V(EC_HONOR_ADD_FAILED, 501)
 ERRCODE_DEF(EC_HONOR_DELETE_FAILED)
@@ -117,7 +118,7 @@ typedef struct
     LGTBot_MessageType type_;
 } LGTBot_Message;
 
-// All these callbacks should not be NULL when passed to initializing the bot.
+// All these callbacks except `handle_ai_info` should not be NULL when passed to initializing the bot.
 typedef struct
 {
     // Get the name of the user.
@@ -154,6 +155,16 @@ typedef struct
     //   - `messages`: The messages sent by the user.
     //   - `size`: The size of the buffer.
     void (*handle_messages)(void* handler, const char* id, const int is_to_user, const LGTBot_Message* messages, const size_t size);
+
+    // Handle the binary information for AI players. It can be NULL, then the information is sent as json texts by
+    // `handle_messages`. See utility/ai_info.h for the encoding.
+    // Inputs:
+    //   - `handler`: The user defined handler.
+    //   - `user_ids`: The IDs of the AI users which the information is sent to, never be NULL.
+    //   - `user_num`: The number of the AI users.
+    //   - `data`: The encoded information, which is shared by all the AI users.
+    //   - `size`: The size of the encoded information.
+    void (*handle_ai_info)(void* handler, const char* const* user_ids, const size_t user_num, const char* data, const size_t size);
 } LGTBot_Callback;
 
 typedef struct
@@ -170,6 +181,13 @@ typedef struct
     // The path to store the generated images, be NULL if we save image in a default path.
     const char* image_path_;
 
+    // The path to store the journals of the processing matches, be NULL if we do not want to recover matches after the
+    // bot restarts.
+    const char* journal_path_;
+
+    // The file to dump the performance metrics periodically, be NULL if we do not want to dump them.
+    const char* metrics_path_;
+
     // The list for administor user ID, split by ',', be NULL if there are no administors.
     const char* admins_;
 
@@ -185,7 +203,8 @@ typedef struct
 //   The initialized options for the bot.
 LGTBot_Option LGTBot_InitOptions();
 
-// Create a new bot with the options.
+// Create a new bot with the options. If `journal_path_` is set, the matches which were processing when the previous bot
+// exited are recovered from their journals.
 // Inputs:
 //   - `options`: The pointer to options for bot, should not be NULL.
 //   - `p`: The address of the pointer which will point to the error message if the bot is created failed. Callers can pass a
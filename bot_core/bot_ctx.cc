@@ -7,6 +7,7 @@
 #include <cstring>
 #include <ranges>
 #include <span>
+#include <atomic>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -15,6 +16,7 @@
 #include <dlfcn.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <unistd.h>
 #define HINSTANCE void*
 #define GetProcAddress dlsym
 #define FreeLibrary dlclose
@@ -65,64 +67,201 @@ static auto FillAchievements(const std::span<const lgtbot::game::GameAchievement
     return result;
 }
 
-static void LoadGame(HINSTANCE mod, GameHandleMap& game_handles)
+#ifdef __linux__
+static HINSTANCE OpenLibraryCopy(const std::string& lib_path)
+{
+    static std::atomic<uint64_t> copy_count{0};
+    const auto copy_path = std::filesystem::temp_directory_path() /
+        ("lgtbot_" + std::to_string(getpid()) + "_" + std::to_string(++copy_count) + ".so");
+    std::error_code ec;
+    if (!std::filesystem::copy_file(lib_path, copy_path, ec)) {
+        ErrorLog() << "Copy mod failed, reason: '" << ec.message() << "', lib_path: '" << lib_path << "'";
+        return nullptr;
+    }
+    HINSTANCE mod = dlopen(copy_path.c_str(), RTLD_LAZY);
+    std::filesystem::remove(copy_path, ec); // the mapping is kept after the file is removed
+    return mod;
+}
+#endif
+
+// If the library has been loaded, `dlopen` returns the loaded one even if the file has been replaced, so we open a copy
+// of the file to load the new version side by side when reloading.
+// TODO: support reloading on Windows
+static HINSTANCE OpenLibrary(const std::string& lib_path)
 {
+#ifdef _WIN32
+    HINSTANCE mod = LoadLibrary(lib_path.c_str());
+#else
+    HINSTANCE mod = dlopen(lib_path.c_str(), RTLD_LAZY | RTLD_NOLOAD);
+    if (mod) {
+        dlclose(mod);
+        mod = OpenLibraryCopy(lib_path);
+    } else {
+        mod = dlopen(lib_path.c_str(), RTLD_LAZY);
+    }
+#endif
     if (!mod) {
 #ifdef __linux__
         ErrorLog() << "Load mod failed: " << dlerror();
 #else
         ErrorLog() << "Load mod failed";
 #endif
-        return;
     }
-    const auto load_proc = [&mod](const char* const name)
-    {
-        const auto proc = GetProcAddress(mod, name);
-        if (!proc) {
+    return mod;
+}
+
+static auto LoadProc(HINSTANCE mod, const char* const name)
+{
+    const auto proc = GetProcAddress(mod, name);
+    if (!proc) {
 #ifdef __linux__
-            std::cerr << dlerror() << std::endl;
+        std::cerr << dlerror() << std::endl;
 #endif
-            throw std::runtime_error(std::string("load proc ") + name + " from module failed");
-        }
-        return proc;
-    };
-    try {
-        const lgtbot::game::GameInfo game_info = reinterpret_cast<lgtbot::game::GameInfo(*)()>(load_proc("GetGameInfo"))();
-
-        GameHandle::BasicInfo basic_info = *game_info.properties_;
-        basic_info.module_name_ = game_info.module_name_;
-        basic_info.rule_ = game_info.rule_;
-        basic_info.achievements_ = FillAchievements(std::span(game_info.achievements_.data_, game_info.achievements_.size_));
-        basic_info.max_player_num_fn_ = reinterpret_cast<GameHandle::max_player_num_handler>(load_proc("MaxPlayerNum"));
-        basic_info.multiple_fn_ = reinterpret_cast<GameHandle::multiple_handler>(load_proc("Multiple"));
-        basic_info.handle_rule_command_fn_ = reinterpret_cast<GameHandle::rule_command_handler>(load_proc("HandleRuleCommand"));
-        basic_info.handle_init_options_command_fn_ = reinterpret_cast<GameHandle::init_options_command_handler>(load_proc("HandleInitOptionsCommand"));
+        throw std::runtime_error(std::string("load proc ") + name + " from module failed");
+    }
+    return proc;
+}
 
-        game_handles.emplace(std::piecewise_construct, std::forward_as_tuple(game_info.properties_->name_),
-                std::forward_as_tuple(
-                    std::move(basic_info),
-                    GameHandle::InternalHandler{
-                        .game_options_allocator_ = reinterpret_cast<GameHandle::game_options_allocator>(load_proc("NewGameOptions")),
-                        .game_options_deleter_ = reinterpret_cast<GameHandle::game_options_deleter>(load_proc("DeleteGameOptions")),
-                        .main_stage_allocator_ = reinterpret_cast<GameHandle::main_stage_allocator>(load_proc("NewMainStage")),
-                        .main_stage_deleter_ = reinterpret_cast<GameHandle::main_stage_deleter>(load_proc("DeleteMainStage")),
-                        .mod_guard_ = [mod] { FreeLibrary(mod); },
+// The module is unloaded when `mod_guard_` of the returned handler is invoked.
+static std::optional<GameHandle::InternalHandler> LoadGameModule(const std::string& lib_path)
+{
+    HINSTANCE mod = OpenLibrary(lib_path);
+    if (!mod) {
+        return std::nullopt;
+    }
+#if WITH_GLOG
+    // It is optional, so modules built before it was added still log by themselves.
+    if (const auto share_logger = reinterpret_cast<void(*)(AsyncLogger*)>(GetProcAddress(mod, "ShareAsyncLogger"))) {
+        share_logger(&GlobalAsyncLogger());
+    }
+#endif
+    try {
+        return GameHandle::InternalHandler{
+            .max_player_num_fn_ = reinterpret_cast<GameHandle::max_player_num_handler>(LoadProc(mod, "MaxPlayerNum")),
+            .multiple_fn_ = reinterpret_cast<GameHandle::multiple_handler>(LoadProc(mod, "Multiple")),
+            .handle_rule_command_fn_ = reinterpret_cast<GameHandle::rule_command_handler>(LoadProc(mod, "HandleRuleCommand")),
+            .handle_init_options_command_fn_ = reinterpret_cast<GameHandle::init_options_command_handler>(LoadProc(mod, "HandleInitOptionsCommand")),
+            .game_options_allocator_ = reinterpret_cast<GameHandle::game_options_allocator>(LoadProc(mod, "NewGameOptions")),
+            .game_options_deleter_ = reinterpret_cast<GameHandle::game_options_deleter>(LoadProc(mod, "DeleteGameOptions")),
+            .main_stage_allocator_ = reinterpret_cast<GameHandle::main_stage_allocator>(LoadProc(mod, "NewMainStage")),
+            .main_stage_deleter_ = reinterpret_cast<GameHandle::main_stage_deleter>(LoadProc(mod, "DeleteMainStage")),
+            // It is optional, so modules built before it was added can still be loaded.
+            .prefetch_resources_fn_ = reinterpret_cast<GameHandle::resource_prefetcher>(GetProcAddress(mod, "PrefetchResources")),
+            .mod_guard_ = [mod]
+                    {
+#if WITH_GLOG
+                        // The pending records of the module refer to its file names.
+                        GlobalAsyncLogger().Flush();
+#endif
+                        FreeLibrary(mod);
                     },
-                    game_info.default_generic_options_));
+        };
     } catch (const std::exception& e) {
         ErrorLog() << "Load mod failed: " << e.what();
-        return;
+        FreeLibrary(mod);
+        return std::nullopt;
     }
-    InfoLog() << "Loaded successfully!";
 }
 
-// TODO: use std::expect
-static std::variant<GameHandleMap, const char*> LoadGameModules(const char* const games_path)
+// The game info is copied into the manifest entry, so the module is unloaded before returning.
+static std::optional<nlohmann::json> ReadGameInfo(const std::string& lib_path)
 {
-    GameHandleMap game_handles;
-    if (games_path == nullptr) {
-        return game_handles;
+    HINSTANCE mod = OpenLibrary(lib_path);
+    if (!mod) {
+        return std::nullopt;
+    }
+    std::optional<nlohmann::json> entry;
+    try {
+        const lgtbot::game::GameInfo game_info = reinterpret_cast<lgtbot::game::GameInfo(*)()>(LoadProc(mod, "GetGameInfo"))();
+        nlohmann::json achievements = nlohmann::json::array();
+        for (const auto& achievement : FillAchievements(std::span(game_info.achievements_.data_, game_info.achievements_.size_))) {
+            achievements.push_back({{"name", achievement.name_}, {"description", achievement.description_}});
+        }
+        entry = nlohmann::json{
+            {"name", game_info.properties_->name_},
+            {"developer", game_info.properties_->developer_},
+            {"description", game_info.properties_->description_},
+            {"shuffled_player_id", game_info.properties_->shuffled_player_id_},
+            {"module_name", game_info.module_name_},
+            {"rule", game_info.rule_},
+            {"achievements", std::move(achievements)},
+            {"bench_computers_to_player_num", game_info.default_generic_options_.bench_computers_to_player_num_},
+            {"is_formal", game_info.default_generic_options_.is_formal_},
+        };
+    } catch (const std::exception& e) {
+        ErrorLog() << "Read game info failed: " << e.what() << ", lib_path: " << lib_path;
+    }
+    FreeLibrary(mod);
+    return entry;
+}
+
+// The manifest entry is out of date if the library file has been modified.
+static nlohmann::json LibraryStamp(const std::string& lib_path)
+{
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(lib_path, ec);
+    const auto write_time = std::filesystem::last_write_time(lib_path, ec);
+    return {{"size", ec ? 0 : size}, {"write_time", ec ? 0 : write_time.time_since_epoch().count()}};
+}
+
+static GameHandle::BasicInfo ToBasicInfo(const nlohmann::json& entry)
+{
+    GameHandle::BasicInfo basic_info{
+        .name_ = entry["name"].get<std::string>(),
+        .developer_ = entry["developer"].get<std::string>(),
+        .description_ = entry["description"].get<std::string>(),
+        .shuffled_player_id_ = entry["shuffled_player_id"].get<bool>(),
+        .module_name_ = entry["module_name"].get<std::string>(),
+        .rule_ = entry["rule"].get<std::string>(),
+    };
+    for (const auto& achievement : entry["achievements"]) {
+        basic_info.achievements_.emplace_back(achievement["name"].get<std::string>(), achievement["description"].get<std::string>());
     }
+    return basic_info;
+}
+
+static void EmplaceGameHandle(GameHandleMap& game_handles, const std::string& lib_path, const nlohmann::json& entry)
+{
+    auto basic_info = ToBasicInfo(entry);
+    std::optional<GameHandle::DefaultOptionsSummary> summary;
+    if (const auto it = entry.find("default_options_summary"); it != entry.end()) {
+        summary.emplace(GameHandle::DefaultOptionsSummary{
+                .option_commands_ = (*it)["option_commands"].get<std::map<std::string, std::string>>(),
+                .max_player_num_ = (*it)["max_player_num"].get<uint64_t>(),
+                .multiple_ = (*it)["multiple"].get<uint32_t>(),
+            });
+    }
+    const std::string name = basic_info.name_;
+    game_handles.emplace(std::piecewise_construct, std::forward_as_tuple(name),
+            std::forward_as_tuple(
+                std::move(basic_info),
+                [lib_path] { return LoadGameModule(lib_path); },
+                lgtbot::game::MutableGenericOptions{
+                    .bench_computers_to_player_num_ = entry["bench_computers_to_player_num"].get<uint32_t>(),
+                    .is_formal_ = entry["is_formal"].get<uint8_t>(),
+                },
+                std::move(summary)));
+}
+
+static std::filesystem::path GameManifestPath(const std::string_view games_path)
+{
+    return std::filesystem::path(games_path) / "game_manifest.json";
+}
+
+// The key is the name of the library file on Windows or the name of the game directory on Linux.
+static std::string GameLibraryPath(const std::string_view games_path, const std::string_view key)
+{
+#ifdef _WIN32
+    return std::string(games_path) + "\\" + std::string(key);
+#else
+    return std::string(games_path) + "/" + std::string(key) + "/libgame.so";
+#endif
+}
+
+// Returns the library paths of the games by the keys.
+static std::variant<std::map<std::string, std::string>, const char*> FindGameLibraries(const char* const games_path)
+{
+    std::map<std::string, std::string> lib_paths;
 #ifdef _WIN32
     WIN32_FIND_DATA file_data;
     HANDLE file_handle = FindFirstFile((std::string(games_path) + "\\*.dll").c_str(), &file_data);
@@ -130,11 +269,9 @@ static std::variant<GameHandleMap, const char*> LoadGameModules(const char* cons
         return "LoadGameModules: find first file failed";
     }
     do {
-        const auto dll_path = std::string(games_path) + "\\" + file_data.cFileName;
-        LoadGame(LoadLibrary(dll_path.c_str()), game_handles);
+        lib_paths.emplace(file_data.cFileName, GameLibraryPath(games_path, file_data.cFileName));
     } while (FindNextFile(file_handle, &file_data));
     FindClose(file_handle);
-    InfoLog() << "Load module count: " << game_handles.size();
 #elif __linux__
     DIR* d = opendir(games_path);
     if (!d) {
@@ -146,20 +283,67 @@ static std::variant<GameHandleMap, const char*> LoadGameModules(const char* cons
             WarnLog() << "Not the game directory, skip: " << dp->d_name;
             continue;
         }
-        const auto lib_name = std::string(games_path) + "/" + dp->d_name + "/libgame.so";
+        const auto lib_name = GameLibraryPath(games_path, dp->d_name);
         if (access(lib_name.c_str(), F_OK) != 0) {
             WarnLog() << "Cannot find libgame.so, skip: " << dp->d_name;
         } else {
-            LoadGame(dlopen(lib_name.c_str(), RTLD_LAZY), game_handles);
+            lib_paths.emplace(dp->d_name, lib_name);
         }
     }
-    InfoLog() << "Loading finished.";
     closedir(d);
 #endif
+    return lib_paths;
+}
+
+// The game information is read from the manifest in the games path, so modules are not loaded until they are used. Only
+// the modules which are new or modified since the manifest was written are loaded here to refresh their entries.
+// TODO: use std::expect
+static std::variant<std::pair<GameHandleMap, nlohmann::json>, const char*> LoadGameModules(const char* const games_path)
+{
+    GameHandleMap game_handles;
+    if (games_path == nullptr) {
+        return std::pair{std::move(game_handles), nlohmann::json::object()};
+    }
+    const auto begin_time = std::chrono::steady_clock::now();
+    auto lib_paths = FindGameLibraries(games_path);
+    if (const char* const* const errmsg = std::get_if<const char*>(&lib_paths)) {
+        return *errmsg;
+    }
+    nlohmann::json old_manifest = nlohmann::json::object();
+    if (std::ifstream f(GameManifestPath(games_path)); f) {
+        try {
+            f >> old_manifest;
+        } catch (const std::exception& e) {
+            ErrorLog() << "LoadGameModules parse manifest failed, errmsg: " << e.what();
+            old_manifest = nlohmann::json::object();
+        }
+    }
+    nlohmann::json manifest = nlohmann::json::object();
+    uint64_t read_count = 0;
+    for (const auto& [key, lib_path] : std::get<std::map<std::string, std::string>>(lib_paths)) {
+        auto stamp = LibraryStamp(lib_path);
+        std::optional<nlohmann::json> entry;
+        if (const auto it = old_manifest.find(key); it != old_manifest.end() && (*it)["library"] == stamp) {
+            entry = std::move(*it);
+        } else if ((entry = ReadGameInfo(lib_path))) {
+            (*entry)["library"] = std::move(stamp);
+            ++read_count;
+        } else {
+            continue;
+        }
+        try {
+            EmplaceGameHandle(game_handles, lib_path, *entry);
+            manifest[key] = std::move(*entry);
+        } catch (const std::exception& e) {
+            ErrorLog() << "LoadGameModules invalid manifest entry, errmsg: " << e.what() << ", key: " << key;
+        }
+    }
+    InfoLog() << "Loading finished, game_count=" << game_handles.size() << " read_module_count=" << read_count
+              << " cost_ms=" << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin_time).count();
     if (game_handles.empty()) {
         return "LoadGameModules: find no games";
     }
-    return game_handles;
+    return std::pair{std::move(game_handles), std::move(manifest)};
 }
 
 // TODO: use std::expect
@@ -206,14 +390,11 @@ static std::variant<nlohmann::json, const char*> LoadConfig(const char* const co
             ErrorLog() << "LoadConfig game '" << game_name << "' not found";
             continue;
         }
-        auto locked_option = it->second.DefaultGameOptions().Lock();
         for (const auto& [option_name, value] : game_json["options"].items()) {
+            // The option is checked when the module is loaded.
             std::string option_str = option_name + " " + value.get<std::string>();
-            if (locked_option->game_options_->SetOption(option_str.c_str())) {
-                InfoLog() << "LoadConfig set game '" << game_name << "' option successfully: " << option_str;
-            } else {
-                ErrorLog() << "LoadConfig set game '" << game_name << "' option failed: " << option_str;
-            }
+            it->second.PresetDefaultOption(option_name, option_str);
+            InfoLog() << "LoadConfig preset game '" << game_name << "' option: " << option_str;
         }
     }
     return j;
@@ -222,8 +403,11 @@ static std::variant<nlohmann::json, const char*> LoadConfig(const char* const co
 BotCtx::BotCtx(std::string game_path,
                std::string conf_path,
                std::string image_path,
+               std::string journal_path,
+               std::string metrics_path,
                LGTBot_Callback callbacks,
                GameHandleMap game_handles,
+               nlohmann::json game_manifest,
                std::set<UserID> admins,
 #ifdef WITH_SQLITE
                std::unique_ptr<DBManagerBase> db_manager,
@@ -234,14 +418,32 @@ BotCtx::BotCtx(std::string game_path,
     : game_path_(std::move(game_path))
     , conf_path_(std::move(conf_path))
     , image_path_(std::move(image_path))
+    , journal_path_(std::move(journal_path))
     , callbacks_(std::move(callbacks))
     , game_handles_(std::move(game_handles))
+    , game_manifest_(std::move(game_manifest))
     , admins_(std::move(admins))
 #ifdef WITH_SQLITE
-    , db_manager_(std::move(db_manager))
+    , db_manager_(db_manager ? std::make_unique<MetricsDBManager>(std::move(db_manager), metrics_) : nullptr)
 #endif
     , mutable_bot_options_(std::move(mutable_bot_options))
     , config_json_(std::move(config_json))
+    , user_name_cache_(k_user_name_cache_capacity)
+    , user_avatar_cache_(k_user_avatar_cache_capacity)
+    , journal_syncer_(journal_path_.empty() ? nullptr : std::make_unique<JournalSyncer>([this]
+                {
+                    return std::chrono::milliseconds(GET_OPTION_VALUE(*mutable_bot_options_.Lock(), 比赛记录刷盘间隔));
+                }))
+    , metrics_dumper_(metrics_path.empty() ? nullptr : std::make_unique<MetricsDumper>(metrics_, std::move(metrics_path), [this]
+                {
+                    return std::chrono::seconds(GET_OPTION_VALUE(*mutable_bot_options_.Lock(), 性能统计输出间隔));
+                }))
+    , module_unloader_(game_path_.empty() ? nullptr : std::make_unique<PeriodicTask>([this]
+                {
+                    if (const auto idle_minutes = GET_OPTION_VALUE(*mutable_bot_options_.Lock(), 游戏模块闲置卸载时间)) {
+                        UnloadIdleGameModules(std::chrono::minutes(idle_minutes));
+                    }
+                }, [] { return std::chrono::minutes(1); }))
     , match_manager_(*this)
     , handler_(handler)
 {
@@ -249,10 +451,11 @@ BotCtx::BotCtx(std::string game_path,
 
 std::variant<BotCtx*, const char*> BotCtx::Create(const LGTBot_Option& options)
 {
-    auto game_handles = LoadGameModules(options.game_path_);
-    if (const char* const* const errmsg = std::get_if<const char*>(&game_handles)) {
+    auto game_modules = LoadGameModules(options.game_path_);
+    if (const char* const* const errmsg = std::get_if<const char*>(&game_modules)) {
         return *errmsg;
     }
+    auto& [game_handles, game_manifest] = std::get<std::pair<GameHandleMap, nlohmann::json>>(game_modules);
 #ifdef WITH_SQLITE
     std::unique_ptr<DBManagerBase> db_manager;
     if (options.db_path_ && !(db_manager = SQLiteDBManager::UseDB(options.db_path_))) {
@@ -260,24 +463,39 @@ std::variant<BotCtx*, const char*> BotCtx::Create(const LGTBot_Option& options)
     }
 #endif
     MutableBotOption bot_options;
-    auto config_json = LoadConfig(options.conf_path_, std::get<GameHandleMap>(game_handles),
-            bot_options);
+    auto config_json = LoadConfig(options.conf_path_, game_handles, bot_options);
     if (const char* const* const errmsg = std::get_if<const char*>(&config_json)) {
         return *errmsg;
     }
+    for (auto& [_, game_handle] : game_handles) {
+        // Compute the summaries which are out of date so that listing games does not load these modules later.
+        if (!game_handle.CachedDefaultSummary().has_value()) {
+            game_handle.DefaultSummary();
+            game_handle.UnloadModuleIfIdle(std::chrono::steady_clock::duration::zero());
+        }
+    }
     for (const void* const* p = reinterpret_cast<const void* const*>(&options.callbacks_);
-            p < reinterpret_cast<const void* const*>(&options.callbacks_ + 1);
+            p < reinterpret_cast<const void* const*>(&options.callbacks_.handle_ai_info); // the optional callbacks
             ++p) {
         if (!*p) {
             return "some of the callback is NULL";
         }
     }
-    return new BotCtx(
+    if (std::error_code ec; options.journal_path_ && !std::filesystem::exists(options.journal_path_) &&
+            !std::filesystem::create_directories(options.journal_path_, ec)) {
+        ErrorLog() << "Create journal directory failed, reason: '" << ec.message() << "', journal_path: '"
+                   << options.journal_path_ << "'";
+        return "create journal directory failed";
+    }
+    auto* const bot = new BotCtx(
             options.game_path_ ? options.game_path_ : "",
             options.conf_path_ ? options.conf_path_ : "",
             options.image_path_ ? options.image_path_ : (std::filesystem::current_path() / ".lgtbot_image").string(),
+            options.journal_path_ ? options.journal_path_ : "",
+            options.metrics_path_ ? options.metrics_path_ : "",
             options.callbacks_,
-            std::move(std::get<GameHandleMap>(game_handles)),
+            std::move(game_handles),
+            std::move(game_manifest),
             options.admins_ ? SplitIdsByComma(options.admins_) : std::set<UserID>{},
 #ifdef WITH_SQLITE
             std::move(db_manager),
@@ -286,6 +504,102 @@ std::variant<BotCtx*, const char*> BotCtx::Create(const LGTBot_Option& options)
             std::move(std::get<nlohmann::json>(config_json)),
             options.handler_
             );
+    bot->SaveGameManifest_();
+    return bot;
+}
+
+uint64_t BotCtx::UnloadIdleGameModules(const std::chrono::steady_clock::duration idle_duration)
+{
+    uint64_t unloaded_count = 0;
+    for (auto& [_, game_handle] : game_handles_) {
+        unloaded_count += game_handle.UnloadModuleIfIdle(idle_duration);
+    }
+    if (unloaded_count > 0) {
+        SaveGameManifest_();
+    }
+    return unloaded_count;
+}
+
+const char* BotCtx::ReloadGameModule(const std::string& game_name)
+{
+    const auto it = game_handles_.find(game_name);
+    if (it == game_handles_.end()) {
+        return "未知的游戏名";
+    }
+    {
+        auto locked_manifest = game_manifest_.Lock(); // reloading the same game concurrently is not allowed
+        const auto entry_it = std::ranges::find_if(locked_manifest->items(),
+                [&](const auto& item) { return item.value()["name"] == game_name; });
+        if (entry_it == locked_manifest->items().end()) {
+            return "找不到游戏模块的文件";
+        }
+        const auto lib_path = GameLibraryPath(game_path_, entry_it.key());
+        auto stamp = LibraryStamp(lib_path);
+        auto entry = ReadGameInfo(lib_path);
+        if (!entry.has_value()) {
+            return "读取游戏信息失败";
+        }
+        if ((*entry)["name"] != game_name) {
+            return "新版本的游戏名称发生了变化";
+        }
+        GameHandle::BasicInfo basic_info;
+        try {
+            basic_info = ToBasicInfo(*entry);
+        } catch (const std::exception& e) {
+            ErrorLog() << "ReloadGameModule invalid game info, errmsg: " << e.what() << ", lib_path: " << lib_path;
+            return "读取游戏信息失败";
+        }
+        if (!it->second.Reload(std::move(basic_info))) {
+            return "游戏模块载入失败";
+        }
+        (*entry)["library"] = std::move(stamp);
+        entry_it.value() = std::move(*entry);
+    }
+    SaveGameManifest_(); // the summary of default options is updated when reloading
+    return nullptr;
+}
+
+bool BotCtx::SaveGameManifest_()
+{
+    auto locked_manifest = game_manifest_.Lock();
+    if (game_path_.empty() || locked_manifest->empty()) {
+        return true;
+    }
+    const auto old_manifest = *locked_manifest;
+    for (auto& [_, entry] : locked_manifest->items()) {
+        const auto it = game_handles_.find(entry["name"].get<std::string>());
+        if (it == game_handles_.end()) {
+            continue;
+        }
+        if (const auto summary = it->second.CachedDefaultSummary()) {
+            entry["default_options_summary"] = {
+                {"option_commands", summary->option_commands_},
+                {"max_player_num", summary->max_player_num_},
+                {"multiple", summary->multiple_},
+            };
+        }
+    }
+    if (*locked_manifest == old_manifest && is_game_manifest_saved_) {
+        return true;
+    }
+    // Write to a temporary file and then replace the old manifest, so the manifest is never partially written.
+    const auto path = GameManifestPath(game_path_);
+    const auto tmp_path = std::filesystem::path(path) += ".tmp";
+    {
+        std::ofstream f(tmp_path);
+        if (!(f << locked_manifest->dump(4))) {
+            ErrorLog() << "SaveGameManifest write failed, path: '" << tmp_path.string() << "'";
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        ErrorLog() << "SaveGameManifest replace failed, reason: '" << ec.message() << "', path: '" << path.string() << "'";
+        return false;
+    }
+    is_game_manifest_saved_ = true;
+    return true;
 }
 
 static bool SaveConfig_(nlohmann::json& json, std::string_view conf_path)
@@ -356,22 +670,35 @@ bool BotCtx::UpdateGameDefaultFormal(const std::string& game_name, const bool is
 
 std::string BotCtx::GetUserAvatar(const char* const user_id, const int32_t size) const
 {
-    const auto path = (std::filesystem::absolute(image_path_) / "avatar" / user_id) += ".png";
-    std::filesystem::create_directories(path.parent_path());
-    const std::string path_str = path.string();
-    if (!callbacks_.download_user_avatar(handler_, user_id, path_str.c_str())) {
-        CharToImage(user_id[0], path_str);
-    }
+    const std::string path_str = user_avatar_cache_.Get(user_id, UserInfoCacheTtl_(), [&]
+            {
+                const auto path = (std::filesystem::absolute(image_path_) / "avatar" / user_id) += ".png";
+                std::filesystem::create_directories(path.parent_path());
+                // The old image may be being read when refreshing, so we download to a temporary file and then replace
+                // the old image.
+                const auto tmp_path = std::filesystem::path(path) += ".tmp";
+                const std::string tmp_path_str = tmp_path.string();
+                if (!callbacks_.download_user_avatar(handler_, user_id, tmp_path_str.c_str())) {
+                    CharToImage(user_id[0], tmp_path_str);
+                }
+                std::error_code ec;
+                std::filesystem::rename(tmp_path, path, ec);
+                if (ec) {
+                    ErrorLog() << "GetUserAvatar replace avatar failed, reason: '" << ec.message() << "', path: '"
+                               << path.string() << "'";
+                }
+                return path.string();
+            });
     return "<img src=\"file:///" + path_str + "\" style=\"width:" + std::to_string(size) + "px; height:" +
         std::to_string(size) + "px; border-radius:50%; vertical-align: middle;\"/>";
 }
 
 MsgSender BotCtx::MakeMsgSender(const UserID& user_id, Match* const match) const
 {
-    return MsgSender(handler_, image_path_, callbacks_, user_id, match);
+    return MsgSender(*this, handler_, image_path_, callbacks_, user_id, match);
 }
 
 MsgSender BotCtx::MakeMsgSender(const GroupID& group_id, Match* const match) const
 {
-    return MsgSender(handler_, image_path_, callbacks_, group_id, match);
+    return MsgSender(*this, handler_, image_path_, callbacks_, group_id, match);
 }
@@ -12,8 +12,14 @@
 #include "bot_core/match_manager.h"
 #include "bot_core/id.h"
 #include "bot_core/db_manager.h"
+#include "bot_core/msg_sender.h"
 #include "bot_core/options.h"
 #include "utility/lock_wrapper.h"
+#include "utility/ttl_cache.h"
+#include "utility/journal.h"
+#include "utility/metrics.h"
+#include "utility/periodic_task.h"
+#include "utility/thread_pool.h"
 #include "nlohmann/json.hpp"
 
 #include <dirent.h>
@@ -33,12 +39,28 @@ class BotCtx
     auto& game_handles() { return game_handles_; }
     const auto& game_handles() const { return game_handles_; }
 
+    // Unloads the game modules which have not been used for `idle_duration`, and saves the game manifest because the
+    // summaries of default options may have been updated when the modules were loaded. Returns the number of unloaded
+    // modules.
+    uint64_t UnloadIdleGameModules(const std::chrono::steady_clock::duration idle_duration);
+
+    // Loads the new version of the game module from the game path without interrupting the running matches. Returns the
+    // error message, or nullptr if succeeded.
+    const char* ReloadGameModule(const std::string& game_name);
+
     bool HasAdmin(const UserID uid) const { return admins_.find(uid) != admins_.end(); }
 
     const std::string& game_path() const { return game_path_; }
 
     const std::string& image_path() const { return image_path_; }
 
+    // Be empty if the matches should not be journaled.
+    const std::string& journal_path() const { return journal_path_; }
+
+    JournalSyncer* journal_syncer() const { return journal_syncer_.get(); }
+
+    MetricsRegistry& metrics() const { return metrics_; }
+
 #ifdef WITH_SQLITE
     DBManagerBase* db_manager() const { return db_manager_.get(); }
 #endif
@@ -57,30 +79,62 @@ class BotCtx
     // TODO: I don't know why, if I put the definition into bot_ctx.cc, the compiler will report 'undefined reference' in MSYS2.
     std::string GetUserName(const char* const user_id, const char* const group_id) const
     {
-        constexpr static uint64_t k_buffer_size = 128;
-        char buffer[k_buffer_size];
         assert(user_id);
-        if (group_id) {
-            callbacks_.get_user_name_in_group(handler_, buffer, k_buffer_size, group_id, user_id);
-        } else {
-            callbacks_.get_user_name(handler_, buffer, k_buffer_size, user_id);
-        }
-        return buffer;
+        return user_name_cache_.Get(group_id ? std::string(user_id) + '\n' + group_id : std::string(user_id),
+                UserInfoCacheTtl_(), [&]
+                {
+                    constexpr static uint64_t k_buffer_size = 128;
+                    char buffer[k_buffer_size];
+                    if (group_id) {
+                        callbacks_.get_user_name_in_group(handler_, buffer, k_buffer_size, group_id, user_id);
+                    } else {
+                        callbacks_.get_user_name(handler_, buffer, k_buffer_size, user_id);
+                    }
+                    return std::string(buffer);
+                });
     }
 
     std::string GetUserAvatar(const char* const user_id, const int32_t size) const;
 
+    const auto& user_name_cache() const { return user_name_cache_; }
+
+    const auto& user_avatar_cache() const { return user_avatar_cache_; }
+
+    bool IsBinaryAiInfoEnabled() const { return callbacks_.handle_ai_info != nullptr; }
+
+    void SendAiInfo(const char* const* const user_ids, const size_t user_num, const char* const data, const size_t size) const
+    {
+        ai_info_bytes_.Add(size * user_num);
+        callbacks_.handle_ai_info(handler_, user_ids, user_num, data, size);
+    }
+
+    // Messages sent by the current thread are coalesced until the returned object is destructed, if it is enabled.
+    MsgCoalescer MakeMsgCoalescer() const
+    {
+        return MsgCoalescer(GET_OPTION_VALUE(*mutable_bot_options_.Lock(), 合并发送消息),
+                [this](const uint64_t saved_send_count)
+                {
+                    sends_saved_.Add(saved_send_count);
+                    coalesced_requests_.Add();
+                });
+    }
+
     MsgSender MakeMsgSender(const UserID& user_id, Match* const match = nullptr) const;
     MsgSender MakeMsgSender(const GroupID& user_id, Match* const match = nullptr) const;
 
+    ThreadPool& prefetch_thread_pool() { return prefetch_thread_pool_; }
+
 #ifndef TEST_BOT
   private:
 #endif
     BotCtx(std::string game_path,
            std::string conf_path,
            std::string image_path,
+           std::string journal_path,
+           std::string metrics_path,
            LGTBot_Callback callbacks,
            GameHandleMap game_handles,
+           nlohmann::json game_manifest,
            std::set<UserID> admins,
 #ifdef WITH_SQLITE
            std::unique_ptr<DBManagerBase> db_manager_,
@@ -89,19 +143,49 @@ class BotCtx
            nlohmann::json config_json,
            void* const handler);
 
+    bool SaveGameManifest_();
+
+    std::chrono::seconds UserInfoCacheTtl_() const
+    {
+        return std::chrono::seconds(GET_OPTION_VALUE(*mutable_bot_options_.Lock(), 用户信息缓存时间));
+    }
+
+    static constexpr size_t k_user_name_cache_capacity = 4096;
+    static constexpr size_t k_user_avatar_cache_capacity = 1024;
+
     // The passed `BotOption` in constructor can be destructed soon, we must store the string.
     std::string game_path_;
     std::string conf_path_;
     std::string image_path_;
+    std::string journal_path_;
     LGTBot_Callback callbacks_;
     GameHandleMap game_handles_;
+    // The key is the name of the game directory, and the value is the information of the game.
+    LockWrapper<nlohmann::json> game_manifest_;
+    bool is_game_manifest_saved_{false}; // protected by the lock of `game_manifest_`
     std::set<UserID> admins_;
+    // Declared before the members recording metrics so that it is destructed after them.
+    mutable MetricsRegistry metrics_;
 #ifdef WITH_SQLITE
     std::unique_ptr<DBManagerBase> db_manager_;
 #endif
     LockWrapper<MutableBotOption> mutable_bot_options_;
     LockWrapper<nlohmann::json> config_json_;
     void* const handler_;
+    MetricCounter& ai_info_bytes_{metrics_.Counter("ai_info.sent_bytes")};
+    MetricCounter& sends_saved_{metrics_.Counter("msg.sends_saved")};
+    MetricCounter& coalesced_requests_{metrics_.Counter("msg.coalesced_requests")};
+
+    // The key is the user ID, followed by the group ID if the name is in a group.
+    mutable TtlCache<std::string, std::string> user_name_cache_;
+    // The value is the path of the avatar image file.
+    mutable TtlCache<std::string, std::string> user_avatar_cache_;
+
+    std::unique_ptr<JournalSyncer> journal_syncer_;
+    std::unique_ptr<MetricsDumper> metrics_dumper_;
+    std::unique_ptr<PeriodicTask> module_unloader_;
+    // Resources of modules are prefetched one by one, so that creating many matches does not start many threads.
+    ThreadPool prefetch_thread_pool_{1};
 
     MatchManager match_manager_;
     mutable std::mutex mutex_;
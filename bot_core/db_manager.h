@@ -31,6 +31,7 @@ ENUM_END(TimeRange)
 #include <optional>
 
 #include "utility/log.h"
+#include "utility/metrics.h"
 #include "bot_core/id.h"
 
 #define ENUM_FILE "../bot_core/db_manager.h"
@@ -148,6 +149,97 @@ class DBManagerBase
     virtual bool DeleteHonor(const int32_t id) = 0;
 };
 
+// Forwards the calls to another database manager and records the latency of each kind of call.
+class MetricsDBManager : public DBManagerBase
+{
+  public:
+    MetricsDBManager(std::unique_ptr<DBManagerBase> db_manager, MetricsRegistry& metrics)
+        : db_manager_(std::move(db_manager))
+        , record_match_latency_(metrics.Histogram("db.RecordMatch"))
+        , get_user_profile_latency_(metrics.Histogram("db.GetUserProfile"))
+        , suicide_latency_(metrics.Histogram("db.Suicide"))
+        , get_rank_latency_(metrics.Histogram("db.GetRank"))
+        , get_level_score_rank_latency_(metrics.Histogram("db.GetLevelScoreRank"))
+        , get_achievement_statistic_latency_(metrics.Histogram("db.GetAchievementStatistic"))
+        , get_honors_latency_(metrics.Histogram("db.GetHonors"))
+        , add_honor_latency_(metrics.Histogram("db.AddHonor"))
+        , delete_honor_latency_(metrics.Histogram("db.DeleteHonor"))
+    {
+    }
+
+    virtual std::vector<ScoreInfo> RecordMatch(const std::string& game_name, const std::optional<GroupID> gid,
+            const UserID& host_uid, const uint64_t multiple,
+            const std::vector<std::pair<UserID, int64_t>>& game_score_infos,
+            const std::vector<std::pair<UserID, std::string>>& achievements) override
+    {
+        ScopedLatency latency(record_match_latency_);
+        return db_manager_->RecordMatch(game_name, gid, host_uid, multiple, game_score_infos, achievements);
+    }
+
+    virtual UserProfile GetUserProfile(const UserID& uid, const std::string_view& time_range_begin,
+            const std::string_view& time_range_end) override
+    {
+        ScopedLatency latency(get_user_profile_latency_);
+        return db_manager_->GetUserProfile(uid, time_range_begin, time_range_end);
+    }
+
+    virtual bool Suicide(const UserID& uid, const uint32_t required_match_num) override
+    {
+        ScopedLatency latency(suicide_latency_);
+        return db_manager_->Suicide(uid, required_match_num);
+    }
+
+    virtual RankInfo GetRank(const std::string_view& time_range_begin, const std::string_view& time_range_end) override
+    {
+        ScopedLatency latency(get_rank_latency_);
+        return db_manager_->GetRank(time_range_begin, time_range_end);
+    }
+
+    virtual GameRankInfo GetLevelScoreRank(const std::string& game_name, const std::string_view& time_range_begin,
+            const std::string_view& time_range_end) override
+    {
+        ScopedLatency latency(get_level_score_rank_latency_);
+        return db_manager_->GetLevelScoreRank(game_name, time_range_begin, time_range_end);
+    }
+
+    virtual AchievementStatisticInfo GetAchievementStatistic(const UserID& uid, const std::string& game_name,
+            const std::string& achievement_name) override
+    {
+        ScopedLatency latency(get_achievement_statistic_latency_);
+        return db_manager_->GetAchievementStatistic(uid, game_name, achievement_name);
+    }
+
+    virtual std::vector<HonorInfo> GetHonors(const std::string& keyword, const uint32_t limit) override
+    {
+        ScopedLatency latency(get_honors_latency_);
+        return db_manager_->GetHonors(keyword, limit);
+    }
+
+    virtual bool AddHonor(const UserID& uid, const std::string_view& description) override
+    {
+        ScopedLatency latency(add_honor_latency_);
+        return db_manager_->AddHonor(uid, description);
+    }
+
+    virtual bool DeleteHonor(const int32_t id) override
+    {
+        ScopedLatency latency(delete_honor_latency_);
+        return db_manager_->DeleteHonor(id);
+    }
+
+  private:
+    std::unique_ptr<DBManagerBase> db_manager_;
+    LatencyHistogram& record_match_latency_;
+    LatencyHistogram& get_user_profile_latency_;
+    LatencyHistogram& suicide_latency_;
+    LatencyHistogram& get_rank_latency_;
+    LatencyHistogram& get_level_score_rank_latency_;
+    LatencyHistogram& get_achievement_statistic_latency_;
+    LatencyHistogram& get_honors_latency_;
+    LatencyHistogram& add_honor_latency_;
+    LatencyHistogram& delete_honor_latency_;
+};
+
 #ifdef WITH_SQLITE
 
 class SQLiteDBManager : public DBManagerBase
@@ -6,15 +6,21 @@
 
 #include <cassert>
 
+#include <atomic>
+#include <chrono>
 #include <functional>
+#include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <memory>
 #include <filesystem>
+#include <utility>
 
 #include "image.h"
 #include "game_framework/game_main.h"
 #include "utility/lock_wrapper.h"
+#include "utility/log.h"
 
 namespace lgtbot {
 
@@ -37,6 +43,7 @@ class GameHandle
     using multiple_handler = uint32_t(*)(const lgtbot::game::GameOptionsBase*);
     using rule_command_handler = const char*(*)(const char* const s);
     using init_options_command_handler = lgtbot::game::InitOptionsResult(*)(const char*, lgtbot::game::GameOptionsBase*, lgtbot::game::MutableGenericOptions*);
+    using resource_prefetcher = uint32_t(*)(const char* resource_dir);
     using game_options_allocator = lgtbot::game::GameOptionsBase*(*)();
     using game_options_deleter = void(*)(const lgtbot::game::GameOptionsBase*);
     using main_stage_allocator = lgtbot::game::MainStageBase*(*)(MsgSenderBase*, lgtbot::game::GameOptionsBase*, lgtbot::game::GenericOptions*, MatchBase* match);
@@ -48,88 +55,327 @@ class GameHandle
         std::string description_;
     };
 
-    // This information is defined by game.
-    struct BasicInfo : public lgtbot::game::GameProperties
+    // This information is defined by game. It is copied from the module so that it is still available after the module
+    // is unloaded.
+    struct BasicInfo
     {
-        BasicInfo() = default;
-        BasicInfo(const lgtbot::game::GameProperties& properties) : GameProperties(properties) {}
-
-        //GameProperties properties_;
+        std::string name_;
+        std::string developer_;
+        std::string description_;
+        bool shuffled_player_id_{false};
         std::string module_name_;
         std::string rule_;
         std::vector<Achievement> achievements_;
+    };
 
+    // The functions exported by the game module.
+    struct InternalHandler
+    {
         max_player_num_handler max_player_num_fn_{nullptr};
         multiple_handler multiple_fn_{nullptr};
-
         rule_command_handler handle_rule_command_fn_{nullptr};
         init_options_command_handler handle_init_options_command_fn_{nullptr};
-    };
-
-    struct InternalHandler
-    {
         game_options_allocator game_options_allocator_{nullptr};
         game_options_deleter game_options_deleter_{nullptr};
         main_stage_allocator main_stage_allocator_{nullptr};
         main_stage_deleter main_stage_deleter_{nullptr};
+        resource_prefetcher prefetch_resources_fn_{nullptr}; // optional
         std::function<void()> mod_guard_;
     };
 
-    GameHandle(const BasicInfo& info, const InternalHandler& internal_handler,
-            const lgtbot::game::MutableGenericOptions& default_generic_options)
-        : info_(info)
-        , internal_handler_(internal_handler)
-        , default_options_{Options{
-             game_options_ptr{internal_handler_.game_options_allocator_(), internal_handler_.game_options_deleter_},
-             lgtbot::game::GenericOptions{lgtbot::game::ImmutableGenericOptions{}, default_generic_options}
-          }}
+    // Loads the game module, returns std::nullopt if failed.
+    using module_loader = std::function<std::optional<InternalHandler>()>;
+
+    using game_options_ptr = std::unique_ptr<lgtbot::game::GameOptionsBase, game_options_deleter>;
+    using main_stage_ptr = std::unique_ptr<lgtbot::game::MainStageBase, main_stage_deleter>;
+
+    // A loaded game module, which is unloaded when the last reference is released. Objects allocated by the module must
+    // be released before the module is unloaded, so the holders of these objects should also hold the module.
+    class Module
     {
-    }
+      public:
+        Module(std::shared_ptr<const BasicInfo> info, InternalHandler handler)
+            : info_(std::move(info)), handler_(std::move(handler))
+        {
+        }
 
-    GameHandle(const GameHandle&) = delete;
-    GameHandle(GameHandle&&) = delete;
+        Module(const Module&) = delete;
+        Module(Module&&) = delete;
 
-    ~GameHandle() { internal_handler_.mod_guard_(); }
+        ~Module() { handler_.mod_guard_(); }
 
-    using game_options_ptr = std::unique_ptr<lgtbot::game::GameOptionsBase, game_options_deleter>;
+        // The information of this version of the module, which may differ from the one of the game handle after reloading.
+        const BasicInfo& Info() const { return *info_; }
+
+        const InternalHandler& Handler() const { return handler_; }
+
+        // Returns false if the resources of the module are being prefetched, otherwise `FinishPrefetching` should be
+        // invoked after prefetching.
+        bool TryStartPrefetching() const { return !is_prefetching_.exchange(true); }
+        void FinishPrefetching() const { is_prefetching_ = false; }
+
+        main_stage_ptr MakeMainStage(MsgSenderBase& reply, lgtbot::game::GameOptionsBase& game_options,
+                lgtbot::game::GenericOptions& generic_options, MatchBase& match) const
+        {
+            return main_stage_ptr(handler_.main_stage_allocator_(&reply, &game_options, &generic_options, &match),
+                    handler_.main_stage_deleter_);
+        }
+
+      private:
+        const std::shared_ptr<const BasicInfo> info_;
+        const InternalHandler handler_;
+        mutable std::atomic<bool> is_prefetching_{false};
+    };
+
+    using ModulePtr = std::shared_ptr<const Module>;
 
     struct Options
     {
+        ModulePtr module_; // declared first to be released after `game_options_`
         game_options_ptr game_options_;
         lgtbot::game::MutableGenericOptions generic_options_;
     };
 
-    Options CopyDefaultGameOptions() const
+    // The values computed from the default game options, which are shown in the game list. They are cached so that
+    // listing games does not load all the modules.
+    struct DefaultOptionsSummary
     {
-        const auto locked_options = default_options_.Lock();
+        std::map<std::string, std::string> option_commands_; // the default option commands when computing the summary
+        uint64_t max_player_num_{0};
+        uint32_t multiple_{0};
+    };
+
+    GameHandle(BasicInfo info, module_loader loader, const lgtbot::game::MutableGenericOptions& default_generic_options,
+            std::optional<DefaultOptionsSummary> summary = std::nullopt)
+        : loader_(std::move(loader))
+        , info_(std::make_shared<const BasicInfo>(std::move(info)))
+        , default_generic_options_(default_generic_options)
+        , summary_(std::move(summary))
+    {
+    }
+
+    GameHandle(const GameHandle&) = delete;
+    GameHandle(GameHandle&&) = delete;
+
+    // Loads the module if it has not been loaded. Returns nullptr if loading failed.
+    ModulePtr LoadModule()
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        return LoadModule_();
+    }
+
+    // Unloads the module if nobody else holds it and it has not been used for `idle_duration`. Returns true if the
+    // module is unloaded.
+    bool UnloadModuleIfIdle(const std::chrono::steady_clock::duration idle_duration)
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (!module_) {
+            return false;
+        }
+        const auto now = std::chrono::steady_clock::now();
+        // The module can only be shared by others when we hold the lock, so the count is reliable.
+        if (module_.use_count() > 1) {
+            last_used_time_ = now;
+            return false;
+        }
+        if (now - last_used_time_ < idle_duration) {
+            return false;
+        }
+        default_game_options_.reset();
+        module_.reset();
+        InfoLog() << "Unload game module: " << info_->module_name_;
+        return true;
+    }
+
+    // Loads the new version of the module side by side with the old one. New matches use the new version, while the
+    // running matches keep holding the old version, which is unloaded after they are over. The game name in `info`
+    // should not be changed. Returns false if the new version cannot be loaded, and the old version is kept.
+    bool Reload(BasicInfo info)
+    {
+        assert(info.name_ == info_->name_);
+        std::lock_guard<std::mutex> l(mutex_);
+        // The old default options should be released before the old module, so they are declared after it.
+        auto old_module = std::move(module_);
+        auto old_default_game_options = std::move(default_game_options_);
+        auto old_info = std::exchange(info_, std::make_shared<const BasicInfo>(std::move(info)));
+        if (!LoadModule_()) {
+            module_ = std::move(old_module);
+            default_game_options_ = std::move(old_default_game_options);
+            info_ = std::move(old_info);
+            return false;
+        }
+        InfoLog() << "Reload game module: " << info_->module_name_ << ", the old version is held by "
+                  << (old_module ? old_module.use_count() - 1 : 0) << " matches";
+        return true;
+    }
+
+    bool IsModuleLoaded() const
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        return module_ != nullptr;
+    }
+
+    // Returns std::nullopt if the module cannot be loaded.
+    std::optional<Options> CopyDefaultGameOptions()
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        auto module = LoadModule_();
+        if (!module) {
+            return std::nullopt;
+        }
         return Options{
-            .game_options_ = game_options_ptr(locked_options->game_options_->Copy(), internal_handler_.game_options_deleter_),
-            .generic_options_ = locked_options->generic_options_,
+            .module_ = module,
+            .game_options_ = game_options_ptr(default_game_options_->Copy(), module->Handler().game_options_deleter_),
+            .generic_options_ = default_generic_options_,
         };
     }
 
-    LockWrapper<Options>& DefaultGameOptions() { return default_options_; }
-    const LockWrapper<Options>& DefaultGameOptions() const { return default_options_; }
+    // Loads the module and applies the option. The option is recorded to be applied again when the module is reloaded,
+    // and options with the same name overwrite each other. Returns false if the option is invalid or the module cannot
+    // be loaded.
+    bool SetDefaultOption(const std::string& option_name, const std::string& option_command)
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (!LoadModule_() || !default_game_options_->SetOption(option_command.c_str())) {
+            return false;
+        }
+        default_option_commands_[option_name] = option_command;
+        UpdateSummary_();
+        return true;
+    }
 
-    using main_stage_ptr = std::unique_ptr<lgtbot::game::MainStageBase, main_stage_deleter>;
+    // Unlike `SetDefaultOption`, the module is not loaded and the option is checked when the module is loaded later.
+    void PresetDefaultOption(const std::string& option_name, const std::string& option_command)
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (module_ && !default_game_options_->SetOption(option_command.c_str())) {
+            ErrorLog() << "Preset game '" << info_->name_ << "' option failed: " << option_command;
+            return;
+        }
+        default_option_commands_[option_name] = option_command;
+        if (module_) {
+            UpdateSummary_();
+        }
+    }
+
+    // Returns std::nullopt if the module cannot be loaded.
+    std::optional<std::string> DefaultGameOptionsInfo(const bool with_example, const bool with_html_syntax,
+            const char* const prefix)
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (!LoadModule_()) {
+            return std::nullopt;
+        }
+        return default_game_options_->Info(with_example, with_html_syntax, prefix);
+    }
+
+    // Returns std::nullopt if the module cannot be loaded or the command is invalid.
+    std::optional<std::string> HandleRuleCommand(const std::string& command)
+    {
+        const auto module = LoadModule();
+        if (!module) {
+            return std::nullopt;
+        }
+        const char* const result = module->Handler().handle_rule_command_fn_(command.c_str());
+        return result ? std::optional<std::string>(result) : std::nullopt;
+    }
+
+    // Loads the module if the cached summary is out of date. Returns std::nullopt if the module cannot be loaded.
+    std::optional<DefaultOptionsSummary> DefaultSummary()
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (!IsSummaryValid_() && !LoadModule_()) {
+            return std::nullopt;
+        }
+        return summary_;
+    }
+
+    // Returns std::nullopt if the cached summary is out of date. The module is never loaded.
+    std::optional<DefaultOptionsSummary> CachedDefaultSummary() const
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        return IsSummaryValid_() ? summary_ : std::nullopt;
+    }
 
-    main_stage_ptr MakeMainStage(MsgSenderBase& reply, lgtbot::game::GameOptionsBase& game_options, lgtbot::game::GenericOptions& generic_options, MatchBase& match) const
+    lgtbot::game::MutableGenericOptions DefaultGenericOptions() const
     {
-        return main_stage_ptr(internal_handler_.main_stage_allocator_(&reply, &game_options, &generic_options, &match), internal_handler_.main_stage_deleter_);
+        std::lock_guard<std::mutex> l(mutex_);
+        return default_generic_options_;
+    }
+
+    void SetDefaultFormal(const bool is_formal)
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        default_generic_options_.is_formal_ = is_formal;
     }
 
     void IncreaseActivity(const uint64_t count) { activity_ += count; }
     uint64_t Activity() const { return activity_; }
 
-    const BasicInfo& Info() const { return info_; }
+    // The returned information keeps unchanged even if the module is reloaded.
+    std::shared_ptr<const BasicInfo> Info() const
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        return info_;
+    }
+
+    // The game name is never changed, so it can be read without the lock.
+    const std::string& Name() const { return name_; }
 
   private:
-    BasicInfo info_;
-    InternalHandler internal_handler_;
-    LockWrapper<Options> default_options_ = Options{
-        game_options_ptr{internal_handler_.game_options_allocator_(), internal_handler_.game_options_deleter_},
-        lgtbot::game::MutableGenericOptions{}
-    };
+    ModulePtr LoadModule_()
+    {
+        last_used_time_ = std::chrono::steady_clock::now();
+        if (module_) {
+            return module_;
+        }
+        auto handler = loader_();
+        if (!handler.has_value()) {
+            ErrorLog() << "Load game module failed: " << info_->module_name_;
+            return nullptr;
+        }
+        auto module = std::make_shared<const Module>(info_, std::move(*handler));
+        default_game_options_ = game_options_ptr(module->Handler().game_options_allocator_(),
+                module->Handler().game_options_deleter_);
+        std::erase_if(default_option_commands_, [&](const auto& name_and_command)
+                {
+                    if (default_game_options_->SetOption(name_and_command.second.c_str())) {
+                        return false;
+                    }
+                    ErrorLog() << "Set game '" << info_->name_ << "' option failed: " << name_and_command.second;
+                    return true;
+                });
+        module_ = std::move(module);
+        UpdateSummary_();
+        InfoLog() << "Load game module: " << info_->module_name_;
+        return module_;
+    }
+
+    void UpdateSummary_()
+    {
+        summary_ = DefaultOptionsSummary{
+            .option_commands_ = default_option_commands_,
+            .max_player_num_ = module_->Handler().max_player_num_fn_(default_game_options_.get()),
+            .multiple_ = module_->Handler().multiple_fn_(default_game_options_.get()),
+        };
+    }
+
+    bool IsSummaryValid_() const
+    {
+        return summary_.has_value() && summary_->option_commands_ == default_option_commands_;
+    }
+
+    const module_loader loader_;
+
+    mutable std::mutex mutex_;
+    std::shared_ptr<const BasicInfo> info_; // replaced when reloading
+    const std::string name_ = info_->name_;
+    ModulePtr module_;
+    game_options_ptr default_game_options_{nullptr, nullptr}; // allocated by `module_`
+    std::map<std::string, std::string> default_option_commands_; // the key is the option name
+    lgtbot::game::MutableGenericOptions default_generic_options_;
+    std::optional<DefaultOptionsSummary> summary_;
+    std::chrono::steady_clock::time_point last_used_time_;
+
     std::atomic<uint64_t> activity_{0}; // the sum of the number of times all users participated in this game
 };
-
@@ -12,7 +12,10 @@
 #include <utility> // g++12 has a bug which will cause 'exchange' is not a member of 'std'
 #include <ranges>
 #include <random>
+#include <cstring>
+#include <thread>
 
+#include "utility/ai_info.h"
 #include "utility/msg_checker.h"
 #include "utility/log.h"
 #include "utility/empty_func.h"
@@ -25,19 +28,21 @@
 #include "nlohmann/json.hpp"
 
 Match::Match(BotCtx& bot, const MatchID mid, GameHandle& game_handle, GameHandle::Options options,
-        const UserID host_uid, const std::optional<GroupID> gid)
+        const UserID host_uid, const std::optional<GroupID> gid, std::string init_options_args)
         : bot_(bot)
         , mid_(mid)
         , game_handle_(game_handle)
         , host_uid_(host_uid)
         , gid_(gid)
+        , metrics_(bot.metrics(), options.module_->Info().module_name_)
         , options_{
+            .module_ = std::move(options.module_),
             .resource_holder_{
                 .resource_dir_ =
-                    (std::filesystem::absolute(bot_.game_path()) / game_handle_.Info().module_name_ / "resource" / "").string(),
+                    (std::filesystem::absolute(bot_.game_path()) / options_.module_->Info().module_name_ / "resource" / "").string(),
                 .saved_image_dir_ =
                     (std::filesystem::absolute(bot_.image_path()) / "matches" /
-                     (std::to_string(std::chrono::system_clock::now().time_since_epoch().count()) + "_" + game_handle_.Info().module_name_)).string(),
+                     (std::to_string(std::chrono::system_clock::now().time_since_epoch().count()) + "_" + options_.module_->Info().module_name_)).string(),
             },
             .game_options_ = std::move(options.game_options_),
             .generic_options_{
@@ -50,9 +55,38 @@ Match::Match(BotCtx& bot, const MatchID mid, GameHandle& game_handle, GameHandle
             },
           }
         , group_sender_(gid.has_value() ? std::optional<MsgSender>(bot.MakeMsgSender(*gid_, this)) : std::nullopt)
+        , option_commands_{std::move(init_options_args)}
 {
 
     EmplaceUser_(host_uid);
+    PrefetchResources_();
+}
+
+// Resources are decoded while users are joining the match, so that the first image of the game is not delayed. The
+// task holds the module to prevent it from being unloaded. It is skipped if the module is being prefetched for another
+// match.
+void Match::PrefetchResources_()
+{
+    if (!options_.module_->Handler().prefetch_resources_fn_ || !options_.module_->TryStartPrefetching()) {
+        return;
+    }
+    bot_.prefetch_thread_pool().Submit([module = options_.module_, resource_dir = options_.resource_holder_.resource_dir_]
+            {
+                const auto begin = std::chrono::steady_clock::now();
+                const uint32_t count = module->Handler().prefetch_resources_fn_(resource_dir.c_str());
+                module->FinishPrefetching();
+                DebugLog() << "Prefetch resources finished, module=" << module->Info().module_name_ << " count=" << count
+                           << " cost=" << std::chrono::duration_cast<std::chrono::milliseconds>(
+                                   std::chrono::steady_clock::now() - begin).count() << "ms";
+            });
+}
+
+Match::Metrics::Metrics(MetricsRegistry& registry, const std::string& module_name)
+    : request_latency_(registry.Histogram("match.request." + module_name))
+    , stage_request_latency_(registry.Histogram("stage.request." + module_name))
+    , computer_act_latency_(registry.Histogram("stage.computer_act." + module_name))
+    , computer_decision_latency_(registry.Histogram("stage.computer_decision." + module_name))
+{
 }
 
 bool Match::Has_(const UserID uid) const { return users_.find(uid) != users_.end(); }
@@ -145,7 +179,8 @@ static ErrCode ConverErrCode(const StageErrCode& stage_errcode)
 ErrCode Match::Request(const UserID uid, const std::optional<GroupID> gid, const std::string& msg,
                        MsgSender& reply)
 {
-    std::lock_guard<std::mutex> l(mutex_);
+    ScopedLatency latency(metrics_.request_latency_); // waiting for the lock is included
+    std::unique_lock<std::mutex> l(mutex_);
     const auto it = users_.find(uid);
     if (it == users_.end() || it->second.state_ == ParticipantUser::State::LEFT) {
         reply() << "[错误] 您未处于游戏中或已经离开";
@@ -167,12 +202,24 @@ ErrCode Match::Request(const UserID uid, const std::optional<GroupID> gid, const
             reply() << "[错误] 您已经被淘汰，无法执行游戏请求";
             return EC_MATCH_ELIMINATED;
         }
-        const auto stage_rc = main_stage_->HandleRequest(msg.c_str(), pid, gid.has_value(), reply);
+        const auto stage_rc = [&]
+            {
+                ScopedLatency latency(metrics_.stage_request_latency_);
+                return main_stage_->HandleRequest(msg.c_str(), pid, gid.has_value(), reply);
+            }();
         if (stage_rc == StageErrCode::NOT_FOUND) {
             reply() << "[错误] 未预料的游戏指令，您可以通过「帮助」（不带" META_COMMAND_SIGN "号）查看所有支持的游戏指令\n"
                         "若您想执行元指令，请尝试在请求前加「" META_COMMAND_SIGN "」，或通过「" META_COMMAND_SIGN "帮助」查看所有支持的元指令";
+        } else {
+            Journal_(nlohmann::json{
+                    { "type", "request" },
+                    { "user_id", uid.GetStr() },
+                    { "is_public", gid.has_value() },
+                    { "msg", msg },
+                    { "rc", stage_rc.ToString() },
+                });
         }
-        Routine_();
+        Routine_(l);
         return ConverErrCode(stage_rc);
     }
     if (uid != host_uid_) {
@@ -184,6 +231,7 @@ ErrCode Match::Request(const UserID uid, const std::optional<GroupID> gid, const
                     "若您想执行元指令，请尝试在请求前加「" META_COMMAND_SIGN "」，或通过「" META_COMMAND_SIGN "帮助」查看所有支持的元指令";
         return EC_GAME_REQUEST_NOT_FOUND;
     }
+    option_commands_.emplace_back(msg);
     KickForConfigChange_();
     reply() << "设置成功！目前配置：" << OptionInfo_() << "\n\n" << BriefInfo_();
     return EC_GAME_REQUEST_OK;
@@ -191,7 +239,7 @@ ErrCode Match::Request(const UserID uid, const std::optional<GroupID> gid, const
 
 ErrCode Match::GameStart(const UserID uid, MsgSenderBase& reply)
 {
-    std::lock_guard<std::mutex> l(mutex_);
+    std::unique_lock<std::mutex> l(mutex_);
     if (state_ != State::NOT_STARTED) {
         reply() << "[错误] 开始失败：游戏已经开始";
         return EC_MATCH_ALREADY_BEGIN;
@@ -217,9 +265,9 @@ ErrCode Match::GameStart(const UserID uid, MsgSenderBase& reply)
                     { "computer_id", static_cast<uint64_t>(cid) }
                 });
     }
-    if (game_handle_.Info().shuffled_player_id_) {
-        std::random_device rd;
-        std::mt19937 g(rd());
+    seed_ = std::random_device{}();
+    if (options_.module_->Info().shuffled_player_id_) {
+        std::mt19937 g(seed_);
         std::shuffle(players_.begin(), players_.end(), g);
     }
     for (PlayerID pid = 0; pid.Get() < players_.size(); ++pid) {
@@ -235,21 +283,22 @@ ErrCode Match::GameStart(const UserID uid, MsgSenderBase& reply)
 
     // make main stage
     assert(main_stage_ == nullptr);
-    if (!(main_stage_ = game_handle_.MakeMainStage(reply, *options_.game_options_, options_.generic_options_, *this))) {
+    if (!(main_stage_ = options_.module_->MakeMainStage(reply, *options_.game_options_, options_.generic_options_, *this))) {
         reply() << "[错误] 开始失败：不符合游戏参数的预期";
         return EC_MATCH_UNEXPECTED_CONFIG;
     }
 
     // start main stage
     state_ = State::IS_STARTED;
+    StartJournal_();
     BoardcastAtAll() << "游戏开始，您可以使用「帮助」命令（不带" META_COMMAND_SIGN "号），查看可执行命令";
-    BoardcastAiInfo() << nlohmann::json{
+    BoardcastAiState_(nlohmann::json{
             { "match_id", MatchId() },
             { "state", "started" },
             { "players", std::move(players_json_array) },
-        }.dump();
+        });
     main_stage_->HandleStageBegin();
-    Routine_(); // computer act first
+    Routine_(l); // computer act first
 
     return EC_OK;
 }
@@ -281,7 +330,7 @@ ErrCode Match::Join(const UserID uid, MsgSenderBase& reply)
 ErrCode Match::Leave(const UserID uid, MsgSenderBase& reply, const bool force)
 {
     ErrCode rc = EC_OK;
-    std::lock_guard<std::mutex> l(mutex_);
+    std::unique_lock<std::mutex> l(mutex_);
     const auto it = users_.find(uid);
     if (it == users_.end() || it->second.state_ == ParticipantUser::State::LEFT) {
         reply() << "[错误] 退出失败：您未处于游戏中或已经离开";
@@ -314,8 +363,13 @@ ErrCode Match::Leave(const UserID uid, MsgSenderBase& reply, const bool force)
             MatchLog_(InfoLog()) << "All users left the game";
             Terminate_();
         } else {
-            main_stage_->HandleLeave(it->second.pid_);
-            Routine_();
+            const auto stage_rc = main_stage_->HandleLeave(it->second.pid_);
+            Journal_(nlohmann::json{
+                    { "type", "leave" },
+                    { "user_id", uid.GetStr() },
+                    { "rc", stage_rc.ToString() },
+                });
+            Routine_(l);
         }
     } else {
         reply() << "[错误] 退出失败：游戏已经开始，若仍要退出游戏，请使用「" META_COMMAND_SIGN "退出 强制」命令";
@@ -326,7 +380,9 @@ ErrCode Match::Leave(const UserID uid, MsgSenderBase& reply, const bool force)
 
 MsgSenderBase& Match::BoardcastMsgSender()
 {
-    if (group_sender_.has_value()) {
+    if (is_replaying_) {
+        return EmptyMsgSender::Get();
+    } else if (group_sender_.has_value()) {
         return *group_sender_;
     } else {
         return boardcast_private_sender_;
@@ -335,7 +391,9 @@ MsgSenderBase& Match::BoardcastMsgSender()
 
 MsgSenderBase& Match::BoardcastAiInfoMsgSender()
 {
-    if (!group_sender_.has_value()) {
+    if (is_replaying_) {
+        return EmptyMsgSender::Get();
+    } else if (!group_sender_.has_value()) {
         return boardcast_ai_info_private_sender_;
     } else if (std::ranges::any_of(users_, [](const auto& user) { return user.second.is_ai_; })) {
         return *group_sender_;
@@ -347,7 +405,9 @@ MsgSenderBase& Match::BoardcastAiInfoMsgSender()
 MsgSenderBase& Match::TellMsgSender(const PlayerID pid)
 {
     const auto& id = ConvertPid(pid);
-    if (const auto pval = std::get_if<UserID>(&id); !pval) {
+    if (is_replaying_) {
+        return EmptyMsgSender::Get();
+    } else if (const auto pval = std::get_if<UserID>(&id); !pval) {
         return EmptyMsgSender::Get(); // is computer
     } else if (const auto it = users_.find(*pval); it != users_.end() && it->second.state_ != ParticipantUser::State::LEFT) {
         return it->second.sender_;
@@ -358,7 +418,7 @@ MsgSenderBase& Match::TellMsgSender(const PlayerID pid)
 
 MsgSenderBase& Match::GroupMsgSender()
 {
-    if (group_sender_.has_value()) {
+    if (group_sender_.has_value() && !is_replaying_) {
         return *group_sender_;
     } else {
         return EmptyMsgSender::Get();
@@ -434,6 +494,8 @@ void Match::TimerController::Start(Match& match, const uint64_t sec, void* alert
             if (!match) {
                 return; // match is released
             }
+            // Constructed before locking so that the coalesced messages are sent after unlocking.
+            const auto coalescer = match->bot_.MakeMsgCoalescer();
 #ifdef TEST_BOT
             {
                 std::lock_guard<std::mutex> l(before_handle_timeout_mutex_);
@@ -444,7 +506,7 @@ void Match::TimerController::Start(Match& match, const uint64_t sec, void* alert
 #endif
             // Timeout event should not be triggered during request handling, so we need lock here.
             // timer_is_over also should protected in lock. Otherwise, a rquest may be handled after checking timer_is_over and before timeout_timer lock match.
-            std::lock_guard<std::mutex> l(match->mutex_);
+            std::unique_lock<std::mutex> l(match->mutex_);
 
 #ifdef TEST_BOT
             {
@@ -456,8 +518,12 @@ void Match::TimerController::Start(Match& match, const uint64_t sec, void* alert
             // Should NOT use this->timer_is_over_ here which may be belong to a new timer.
             if (!*timer_is_over) {
                 match->MatchLog_(DebugLog()) << "Timer timeout";
-                match->main_stage_->HandleTimeout();
-                match->Routine_();
+                const auto stage_rc = match->main_stage_->HandleTimeout();
+                match->Journal_(nlohmann::json{
+                        { "type", "timeout" },
+                        { "rc", stage_rc.ToString() },
+                    });
+                match->Routine_(l);
             } else {
                 match->MatchLog_(WarnLog()) << "Timer timeout but timer has been already over";
             }
@@ -513,10 +579,21 @@ void Match::TimerController::Stop(const Match& match)
 
 void Match::StartTimer(const uint64_t sec, void* alert_arg, void(*alert_cb)(void*, uint64_t))
 {
+    if (is_replaying_) {
+        replayed_timer_.emplace(sec, alert_arg, alert_cb); // the journaled timeouts are replayed without timers
+        return;
+    }
     return timer_cntl_.Start(*this, sec, alert_arg, alert_cb);
 }
 
-void Match::StopTimer() { return timer_cntl_.Stop(*this); }
+void Match::StopTimer()
+{
+    if (is_replaying_) {
+        replayed_timer_.reset();
+        return;
+    }
+    return timer_cntl_.Stop(*this);
+}
 
 void Match::Eliminate(const PlayerID pid)
 {
@@ -547,12 +624,44 @@ void Match::Activate(const PlayerID pid)
     }
 }
 
+void Match::JournalComputerDecision(const char* const decision)
+{
+    if (!is_replaying_) {
+        computer_act_record_.decision_ = decision;
+    }
+}
+
+void Match::JournalComputerChoice(const char* const choice)
+{
+    if (!is_replaying_) {
+        computer_act_record_.choices_.emplace_back(choice);
+    }
+}
+
+const char* Match::ReplayedComputerDecision()
+{
+    auto& record = computer_act_record_;
+    if (!is_replaying_ || !record.decision_.has_value() || std::exchange(record.is_decision_taken_, true)) {
+        return nullptr;
+    }
+    return record.decision_->c_str();
+}
+
+const char* Match::NextReplayedComputerChoice()
+{
+    auto& record = computer_act_record_;
+    if (!is_replaying_ || record.taken_choice_num_ == record.choices_.size()) {
+        return nullptr;
+    }
+    return record.choices_[record.taken_choice_num_++].c_str();
+}
+
 void Match::ShowInfo(MsgSenderBase& reply) const
 {
     reply.SetMatch(this);
     std::lock_guard<std::mutex> l(mutex_);
     auto sender = reply();
-    sender << "游戏名称：" << game_handle().Info().name_ << "\n";
+    sender << "游戏名称：" << GameName() << "\n";
     sender << "配置信息：" << OptionInfo_() << "\n";
     sender << "电脑数量：" << ComputerNum_() << "\n";
     sender << "游戏状态："
@@ -594,7 +703,7 @@ std::string Match::BriefInfo() const
 std::string Match::BriefInfo_() const
 {
     const auto multiple = Multiple_();
-    return std::string("游戏名称：") + game_handle().Info().name_ +
+    return std::string("游戏名称：") + GameName() +
         "\n- 倍率：" +
         (options_.generic_options_.is_formal_ || multiple == 0 ? std::to_string(multiple) :
                                                                  "0（开启计分后为 " + std::to_string(multiple) + "）") +
@@ -620,6 +729,9 @@ void Match::OnGameOver_()
         MatchLog_(WarnLog()) << "OnGameOver_ but has already been over";
         return;
     }
+    if (is_replaying_) {
+        return; // the journal should have been removed when the match was over, so the replay will fail
+    }
     std::vector<std::pair<UserID, int64_t>> user_game_scores;
     std::vector<std::pair<UserID, std::string>> user_achievements;
     {
@@ -660,7 +772,7 @@ void Match::OnGameOver_()
         } else if (const auto multiple = Multiple_(); !options_.generic_options_.is_formal_ || multiple == 0) {
             sender << "\n\n游戏结果不记录：因为该游戏为非正式游戏";
         } else if (const auto score_info =
-                    bot_.db_manager()->RecordMatch(game_handle_.Info().name_, gid_, host_uid_,
+                    bot_.db_manager()->RecordMatch(GameName(), gid_, host_uid_,
                         multiple, user_game_scores, user_achievements);
                 score_info.empty()) {
             sender << "\n\n[错误] 游戏结果写入数据库失败，请联系管理员";
@@ -713,29 +825,96 @@ void Match::Help_(MsgSenderBase& reply, const bool text_mode)
     }
 }
 
-void Match::Routine_()
+void Match::Routine_(std::unique_lock<std::mutex>& l)
 {
+    if (is_replaying_) {
+        return; // the computer acts are replayed from the journal by `Replay_`
+    }
     if (main_stage_->IsOver()) {
         OnGameOver_();
         return;
     }
+    if (is_computing_computer_decisions_) {
+        return; // the thread computing decisions will continue the routine
+    }
     const uint64_t computer_num = players_.size() - users_.size();
     uint64_t ok_count = 0;
     for (uint64_t pid = 0; !main_stage_->IsOver() && ok_count < computer_num; pid = (pid + 1) % players_.size()) {
         if (!std::get_if<ComputerID>(&players_[pid].id_)) {
             continue;
         }
-        if (players_[pid].state_ == Player::State::ELIMINATED || StageErrCode::OK == main_stage_->HandleComputerAct(pid, false)) {
+        // The previous computer act may start a new round, whose decisions have not been computed. The decisions of
+        // each round are only prepared once, so it is cheap to check for each act.
+        if (!ComputeComputerDecisions_(l)) {
+            return; // the match is gone when the lock is released
+        }
+        if (players_[pid].state_ == Player::State::ELIMINATED) {
             ++ok_count;
-        } else {
-            ok_count = 0;
+            continue;
+        }
+        computer_act_record_ = ComputerActRecord{};
+        const auto stage_rc = [&]
+            {
+                ScopedLatency latency(metrics_.computer_act_latency_);
+                return main_stage_->HandleComputerAct(pid, false);
+            }();
+        // Computers may draw random numbers or compute decisions in the background, so their acts are journaled to
+        // be replayed in the same order, along with what they decide.
+        nlohmann::json record{
+                { "type", "computer_act" },
+                { "pid", pid },
+                { "rc", stage_rc.ToString() },
+            };
+        if (computer_act_record_.decision_.has_value()) {
+            record["decision"] = *computer_act_record_.decision_;
         }
+        if (!computer_act_record_.choices_.empty()) {
+            record["choices"] = computer_act_record_.choices_;
+        }
+        Journal_(record);
+        ok_count = stage_rc == StageErrCode::OK ? ok_count + 1 : 0;
     }
     if (main_stage_->IsOver()) {
         OnGameOver_();
     }
 }
 
+bool Match::PrepareComputerDecisions_()
+{
+    bool has_decision = false;
+    for (uint64_t pid = 0; pid < players_.size(); ++pid) {
+        if (std::get_if<ComputerID>(&players_[pid].id_) && players_[pid].state_ != Player::State::ELIMINATED) {
+            has_decision = main_stage_->PrepareComputerDecision(pid) || has_decision;
+        }
+    }
+    return has_decision;
+}
+
+bool Match::ComputeComputerDecisions_(std::unique_lock<std::mutex>& l)
+{
+    if (!PrepareComputerDecisions_()) {
+        return true;
+    }
+    // Requests handled when the lock is released are journaled between the two records.
+    Journal_(nlohmann::json{ { "type", "computer_decisions" } });
+    MatchLog_(DebugLog()) << "Compute computer decisions without the lock";
+    is_computing_computer_decisions_ = true;
+    l.unlock();
+    {
+        ScopedLatency latency(metrics_.computer_decision_latency_);
+        main_stage_->ComputeComputerDecisions();
+    }
+    l.lock();
+    is_computing_computer_decisions_ = false;
+    if (state_ != State::IS_STARTED) {
+        MatchLog_(InfoLog()) << "The match is gone when computing computer decisions";
+        return false;
+    }
+    main_stage_->ApplyComputerDecisions();
+    Journal_(nlohmann::json{ { "type", "apply_computer_decisions" } });
+    return true;
+}
+
 ErrCode Match::UserInterrupt(const UserID uid, MsgSenderBase& reply, const bool cancel)
 {
     const std::lock_guard<std::mutex> l(mutex_);
@@ -787,18 +966,273 @@ ErrCode Match::Terminate(const bool is_force)
     }
 }
 
+AiInfoChannel Match::GetAiInfoChannel() const
+{
+    if (is_replaying_ || std::ranges::none_of(users_, [](const auto& user) { return user.second.is_ai_; })) {
+        return AiInfoChannel::NONE;
+    }
+    return bot_.IsBinaryAiInfoEnabled() ? AiInfoChannel::BINARY : AiInfoChannel::TEXT;
+}
+
+void Match::BoardcastBinaryAiInfo(const char* const data, const uint64_t size)
+{
+    std::vector<const char*> user_ids;
+    for (const auto& [uid, user_info] : users_) {
+        if (user_info.is_ai_ && user_info.state_ != ParticipantUser::State::LEFT) {
+            user_ids.emplace_back(uid.GetCStr());
+        }
+    }
+    if (!user_ids.empty()) {
+        // all the AI players share the same buffer
+        bot_.SendAiInfo(user_ids.data(), user_ids.size(), data, size);
+    }
+}
+
 void Match::Terminate_()
 {
+    // The thread computing decisions of computers checks it after reacquiring the lock, so it will not continue a
+    // dissolved match.
+    if (state_ == State::IS_STARTED) {
+        state_ = State::IS_OVER;
+    }
+    CloseJournal_();
     for (auto& [uid, user_info] : users_) {
         if (user_info.state_ != ParticipantUser::State::LEFT) {
             match_manager().UnbindMatch(uid);
         }
     }
     Unbind_();
-    BoardcastAiInfo() << nlohmann::json{
+    BoardcastAiState_(nlohmann::json{
             { "match_id", MatchId() },
             { "state", "finished" },
-        }.dump();
+        });
+}
+
+void Match::BoardcastAiState_(const nlohmann::json& state)
+{
+    switch (GetAiInfoChannel()) {
+    case AiInfoChannel::NONE:
+        break;
+    case AiInfoChannel::TEXT:
+        BoardcastAiInfo() << state.dump();
+        break;
+    case AiInfoChannel::BINARY: {
+        const auto data = ai_info::EncodeMatchState(MatchId(), state);
+        BoardcastBinaryAiInfo(data.data(), data.size());
+        break;
+    }
+    }
+}
+
+void Match::StartJournal_()
+{
+    if (bot_.journal_path().empty() || is_replaying_) {
+        return;
+    }
+    journal_filename_ = (std::filesystem::path(bot_.journal_path()) /
+            (std::to_string(std::chrono::system_clock::now().time_since_epoch().count()) + "_" +
+             std::to_string(mid_) + ".journal")).string();
+    if (!(journal_ = JournalWriter::Open(journal_filename_))) {
+        MatchLog_(ErrorLog()) << "Open journal failed, the match cannot be recovered after restarting, filename="
+                              << journal_filename_;
+        journal_filename_.clear();
+        return;
+    }
+    if (JournalSyncer* const syncer = bot_.journal_syncer()) {
+        syncer->Register(journal_);
+    }
+    nlohmann::json players_json_array = nlohmann::json::array();
+    for (const auto& player : players_) {
+        if (const auto uid = std::get_if<UserID>(&player.id_)) {
+            players_json_array.push_back(nlohmann::json{ { "user_id", uid->GetStr() } });
+        } else {
+            players_json_array.push_back(nlohmann::json{ { "computer_id", std::get<ComputerID>(player.id_).Get() } });
+        }
+    }
+    Journal_(nlohmann::json{
+            { "type", "start" },
+            { "game", GameName() },
+            { "host_user_id", host_uid_.GetStr() },
+            { "group_id", gid_.has_value() ? nlohmann::json(gid_->GetStr()) : nlohmann::json(nullptr) },
+            { "option_commands", option_commands_ },
+            { "bench_computers_to_player_num", options_.generic_options_.bench_computers_to_player_num_ },
+            { "is_formal", options_.generic_options_.is_formal_ },
+            { "players", std::move(players_json_array) },
+            { "seed", seed_ },
+        });
+    MatchLog_(InfoLog()) << "Start journal filename=" << journal_filename_;
+}
+
+void Match::Journal_(const nlohmann::json& record)
+{
+    if (!journal_ || is_replaying_) {
+        return;
+    }
+    if (!journal_->Append(record.dump())) {
+        MatchLog_(ErrorLog()) << "Append journal failed, reason: '" << std::strerror(errno) << "', filename="
+                              << journal_filename_;
+    }
+}
+
+void Match::CloseJournal_()
+{
+    if (journal_filename_.empty()) {
+        return;
+    }
+    journal_ = nullptr;
+    std::error_code ec;
+    if (!std::filesystem::remove(journal_filename_, ec)) {
+        MatchLog_(WarnLog()) << "Remove journal failed, reason: '" << ec.message() << "', filename=" << journal_filename_;
+    }
+    journal_filename_.clear();
+}
+
+bool Match::Recover(const std::vector<std::string>& records, const std::string& journal_filename)
+{
+    std::unique_lock<std::mutex> l(mutex_);
+    journal_filename_ = journal_filename;
+    is_replaying_ = true;
+    bool succ = false;
+    try {
+        succ = Replay_(records);
+    } catch (const std::exception& e) {
+        MatchLog_(ErrorLog()) << "Replay failed: " << e.what();
+    }
+    is_replaying_ = false;
+    if (!succ) {
+        replayed_timer_.reset();
+        BoardcastAtAll() << "由于裁判重启，游戏无法从记录中恢复，游戏已解散，结果不会被记录";
+        CloseJournal_();
+        return false;
+    }
+    if (gid_.has_value() && !match_manager().BindMatch(*gid_, shared_from_this())) {
+        MatchLog_(WarnLog()) << "Recover match but the group is in another match";
+    }
+    for (const auto& [uid, user_info] : users_) {
+        if (user_info.state_ != ParticipantUser::State::LEFT && !match_manager().BindMatch(uid, shared_from_this())) {
+            MatchLog_(WarnLog()) << "Recover match but the user is in another match uid=" << uid;
+        }
+    }
+    if (!(journal_ = JournalWriter::Open(journal_filename_))) {
+        MatchLog_(ErrorLog()) << "Reopen journal failed, the match cannot be recovered after restarting, filename="
+                              << journal_filename_;
+        journal_filename_.clear();
+    } else if (JournalSyncer* const syncer = bot_.journal_syncer()) {
+        syncer->Register(journal_);
+    }
+    if (replayed_timer_.has_value()) {
+        // The elapsed time before restarting is not journaled, so the timer restarts from the beginning.
+        timer_cntl_.Start(*this, replayed_timer_->sec_, replayed_timer_->alert_arg_, replayed_timer_->alert_cb_);
+        replayed_timer_.reset();
+    }
+    BoardcastAtAll() << "由于裁判重启，游戏已从记录中恢复，您可以使用「帮助」命令（不带" META_COMMAND_SIGN "号），查看当前的游戏状态";
+    MatchLog_(InfoLog()) << "Recover match successfully, record_num=" << records.size();
+    // The decisions prepared before restarting are not computed when replaying, so the computers act without them.
+    main_stage_->ApplyComputerDecisions();
+    Journal_(nlohmann::json{ { "type", "apply_computer_decisions" } });
+    Routine_(l);
+    return true;
+}
+
+bool Match::Replay_(const std::vector<std::string>& records)
+{
+    const auto start_record = nlohmann::json::parse(records.front());
+    seed_ = start_record["seed"].get<uint64_t>();
+    for (const auto& player_json : start_record["players"]) {
+        if (!player_json.contains("user_id")) {
+            players_.emplace_back(ComputerID(player_json["computer_id"].get<uint32_t>()));
+            continue;
+        }
+        const UserID uid(player_json["user_id"].get<std::string>());
+        if (!Has_(uid)) {
+            EmplaceUser_(uid);
+        }
+        users_.find(uid)->second.pid_ = static_cast<uint32_t>(players_.size());
+        players_.emplace_back(uid);
+    }
+    for (auto& [_, user_info] : users_) {
+        user_info.sender_.SetMatch(this);
+    }
+    options_.generic_options_.user_num_ = static_cast<uint32_t>(users_.size());
+
+    if (!(main_stage_ = options_.module_->MakeMainStage(EmptyMsgSender::Get(), *options_.game_options_, options_.generic_options_, *this))) {
+        MatchLog_(ErrorLog()) << "Replay failed: make main stage failed";
+        return false;
+    }
+    state_ = State::IS_STARTED;
+    main_stage_->HandleStageBegin();
+
+    for (size_t i = 1; i < records.size(); ++i) {
+        if (main_stage_->IsOver()) {
+            MatchLog_(ErrorLog()) << "Replay failed: the match is over before replaying record " << i;
+            return false;
+        }
+        const auto record = nlohmann::json::parse(records[i]);
+        const auto type = record["type"].get<std::string>();
+        StageErrCode stage_rc = StageErrCode::NOT_FOUND;
+        if (type == "timeout") {
+            stage_rc = main_stage_->HandleTimeout();
+        } else if (type == "computer_decisions") {
+            // The decisions are prepared for the side effects (e.g., drawing random numbers), but not computed because
+            // the applied ones are journaled along with the computer acts.
+            if (!PrepareComputerDecisions_()) {
+                MatchLog_(ErrorLog()) << "Replay failed: no computer decisions to prepare in record " << i;
+                return false;
+            }
+            continue;
+        } else if (type == "apply_computer_decisions") {
+            main_stage_->ApplyComputerDecisions();
+            continue;
+        } else if (type == "computer_act") {
+            const auto pid = record["pid"].get<uint64_t>();
+            if (pid >= players_.size() || !std::get_if<ComputerID>(&players_[pid].id_) ||
+                    players_[pid].state_ == Player::State::ELIMINATED) {
+                MatchLog_(ErrorLog()) << "Replay failed: invalid computer in record " << i << ": " << records[i];
+                return false;
+            }
+            // The match prepares decisions before each computer act, which should prepare nothing new here.
+            if (PrepareComputerDecisions_()) {
+                MatchLog_(ErrorLog()) << "Replay failed: the computer decisions diverge before record " << i;
+                return false;
+            }
+            auto& act_record = computer_act_record_ = ComputerActRecord{
+                    .decision_ = record.contains("decision") ?
+                        std::optional(record["decision"].get<std::string>()) : std::nullopt,
+                    .choices_ = record.value("choices", std::vector<std::string>{}),
+                };
+            stage_rc = main_stage_->HandleComputerAct(pid, false);
+            if (act_record.decision_.has_value() != act_record.is_decision_taken_ ||
+                    act_record.taken_choice_num_ != act_record.choices_.size()) {
+                MatchLog_(ErrorLog()) << "Replay failed: the computer decides differently from record " << i << ": "
+                                      << records[i];
+                return false;
+            }
+        } else if (const auto it = users_.find(UserID(record["user_id"].get<std::string>())); it == users_.end()) {
+            MatchLog_(ErrorLog()) << "Replay failed: unknown user in record " << i << ": " << records[i];
+            return false;
+        } else if (type == "request") {
+            stage_rc = main_stage_->HandleRequest(record["msg"].get<std::string>().c_str(), it->second.pid_,
+                    record["is_public"].get<bool>(), EmptyMsgSender::Get());
+        } else if (type == "leave") {
+            it->second.state_ = ParticipantUser::State::LEFT;
+            stage_rc = main_stage_->HandleLeave(it->second.pid_);
+        } else {
+            MatchLog_(ErrorLog()) << "Replay failed: unknown type of record " << i << ": " << records[i];
+            return false;
+        }
+        if (record["rc"].get<std::string>() != stage_rc.ToString()) {
+            // The game may act differently if it is not determined by the journaled inputs, e.g., it uses an unseeded
+            // random engine, or a computer decision runs out of its budget only in one of the runs.
+            MatchLog_(ErrorLog()) << "Replay failed: the result diverges from record " << i << ": " << records[i]
+                                  << ", replayed_rc=" << stage_rc;
+            return false;
+        }
+    }
+    if (main_stage_->IsOver()) {
+        MatchLog_(ErrorLog()) << "Replay failed: the match is over after replaying";
+        return false;
+    }
+    return true;
 }
 
 void Match::KickForConfigChange_()
@@ -19,6 +19,8 @@
 #include "bot_core/game_handle.h"
 #include "bot_core/bot_ctx.h"
 #include "bot_core/db_manager.h"
+#include "utility/journal.h"
+#include "utility/metrics.h"
 
 #define INVALID_MATCH (MatchID)0
 
@@ -49,11 +51,13 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
     static const uint32_t kAvgScoreOffset = 10;
 
     Match(BotCtx& bot, const MatchID id, GameHandle& game_handle, GameHandle::Options options,
-            const UserID host_uid, const std::optional<GroupID> gid);
+            const UserID host_uid, const std::optional<GroupID> gid, std::string init_options_args = "");
     ~Match() = default;
 
     virtual MsgSenderBase& BoardcastMsgSender() override;
     virtual MsgSenderBase& BoardcastAiInfoMsgSender() override;
+    virtual AiInfoChannel GetAiInfoChannel() const override;
+    virtual void BoardcastBinaryAiInfo(const char* data, uint64_t size) override;
     virtual MsgSenderBase& TellMsgSender(const PlayerID pid) override;
     virtual MsgSenderBase& GroupMsgSender() override;
 
@@ -67,9 +71,16 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
     virtual void Hook(const PlayerID pid) override;
     virtual void Activate(const PlayerID pid) override;
 
+    virtual void JournalComputerDecision(const char* decision) override;
+    virtual void JournalComputerChoice(const char* choice) override;
+    virtual const char* ReplayedComputerDecision() override;
+    virtual const char* NextReplayedComputerChoice() override;
+
     virtual bool IsInDeduction() const override { return is_in_deduction_; }
+    virtual bool IsReplaying() const override { return is_replaying_; }
+    virtual uint64_t RandomSeed() const override { return seed_; }
     virtual uint64_t MatchId() const override { return mid_; }
-    virtual const char* GameName() const override { return game_handle_.Info().name_; }
+    virtual const char* GameName() const override { return game_handle_.Name().c_str(); }
 
     ErrCode SetBenchTo(const UserID uid, MsgSenderBase& reply, const uint64_t bench_computers_to_player_num);
     ErrCode SetFormal(const UserID uid, MsgSenderBase& reply, const bool is_formal);
@@ -97,6 +108,14 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
 
     ErrCode Terminate(const bool is_force);
 
+    // Rebuilds a started match by replaying its journal without sending any messages, and then binds the users and the
+    // group to the match. The first record should be the start record. Returns false and removes the journal if the
+    // replay does not end in the journaled state.
+    bool Recover(const std::vector<std::string>& records, const std::string& journal_filename);
+
+    // The commands which have been applied to the game options, including the initial options command at front.
+    const std::vector<std::string>& OptionCommands() const { return option_commands_; }
+
     const GameHandle& game_handle() const { return game_handle_; }
     std::optional<GroupID> gid() const { return gid_; }
     UserID HostUserId() const { return std::lock_guard(mutex_), host_uid_; }
@@ -123,8 +142,8 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
         bool want_interrupt_{false};
     };
 
-    uint32_t MaxPlayerNum_() const { return game_handle_.Info().max_player_num_fn_(options_.game_options_.get()); }
-    uint32_t Multiple_() const { return game_handle_.Info().multiple_fn_(options_.game_options_.get()); }
+    uint32_t MaxPlayerNum_() const { return options_.module_->Handler().max_player_num_fn_(options_.game_options_.get()); }
+    uint32_t Multiple_() const { return options_.module_->Handler().multiple_fn_(options_.game_options_.get()); }
 
     template <typename Logger>
     Logger& MatchLog_(Logger&& logger) const
@@ -142,16 +161,28 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
     std::string BriefInfo_() const;
     void OnGameOver_();
     void Help_(MsgSenderBase& reply, const bool text_mode);
-    void Routine_();
+    // The lock may be released and reacquired when computing decisions of computers.
+    void Routine_(std::unique_lock<std::mutex>& l);
+    // Returns true if any computer has a decision to compute.
+    bool PrepareComputerDecisions_();
+    // Returns false if the match is over or terminated when the lock is released, in which case the match is gone and
+    // the routine should stop.
+    bool ComputeComputerDecisions_(std::unique_lock<std::mutex>& l);
     std::string OptionInfo_() const;
     void KickForConfigChange_();
     void Unbind_();
     void Terminate_();
+    void BoardcastAiState_(const nlohmann::json& state);
     bool Has_(const UserID uid) const;
     std::string HostUserName_() const;
     uint32_t PlayerNum_() const;
     uint32_t ComputerNum_() const;
     void EmplaceUser_(const UserID uid);
+    void PrefetchResources_();
+    void StartJournal_();
+    void Journal_(const nlohmann::json& record);
+    void CloseJournal_();
+    bool Replay_(const std::vector<std::string>& records);
 
     mutable std::mutex mutex_;
 
@@ -165,6 +196,18 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
     const std::optional<GroupID> gid_;
     std::atomic<State> state_{State::NOT_STARTED};
 
+    // metrics of the game module
+    struct Metrics
+    {
+        Metrics(MetricsRegistry& registry, const std::string& module_name);
+
+        LatencyHistogram& request_latency_;
+        LatencyHistogram& stage_request_latency_;
+        LatencyHistogram& computer_act_latency_;
+        LatencyHistogram& computer_decision_latency_;
+    };
+    Metrics metrics_;
+
     struct TimerController
     {
       public:
@@ -203,6 +246,7 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
             std::string saved_image_dir_;
         };
 
+        GameHandle::ModulePtr module_; // declared first to be released after the objects allocated by the module
         ResourceHolder resource_holder_;
         GameHandle::game_options_ptr game_options_;
         lgtbot::game::GenericOptions generic_options_;
@@ -211,6 +255,7 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
 
     // game
     GameHandle::main_stage_ptr main_stage_{nullptr, [](const lgtbot::game::MainStageBase*) {}};
+    bool is_computing_computer_decisions_{false};
 
     // user info
     std::map<UserID, ParticipantUser> users_;
@@ -255,4 +300,28 @@ class Match : public MatchBase, public std::enable_shared_from_this<Match>
     };
 
     bool is_in_deduction_{false};
+
+    // journal
+    std::vector<std::string> option_commands_;
+    uint64_t seed_{0}; // the seed to shuffle players and to draw random numbers in the game
+    std::string journal_filename_;
+    std::shared_ptr<JournalWriter> journal_;
+    bool is_replaying_{false};
+    // The decision and the choices of the computer act being handled, which are journaled along with the act. When
+    // replaying, they are loaded from the record and taken by the act.
+    struct ComputerActRecord
+    {
+        std::optional<std::string> decision_;
+        std::vector<std::string> choices_;
+        bool is_decision_taken_{false};
+        size_t taken_choice_num_{0};
+    };
+    ComputerActRecord computer_act_record_;
+    struct ReplayedTimer
+    {
+        uint64_t sec_;
+        void* alert_arg_;
+        void(*alert_cb_)(void*, uint64_t);
+    };
+    std::optional<ReplayedTimer> replayed_timer_; // the timer is started after replaying
 };
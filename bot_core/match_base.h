@@ -8,6 +8,13 @@
 
 class MsgSenderBase;
 
+// How the information for AI players is delivered.
+enum class AiInfoChannel {
+    NONE,   // no AI players will read the information
+    TEXT,   // sent as json texts by `BoardcastAiInfoMsgSender`
+    BINARY, // sent as binary data by `BoardcastBinaryAiInfo`, see utility/ai_info.h for the encoding
+};
+
 // Cross-module class interface for game level.
 class MatchBase
 {
@@ -20,6 +27,8 @@ class MatchBase
     virtual MsgSenderBase& TellMsgSender(const PlayerID pid) = 0;
     virtual MsgSenderBase& GroupMsgSender() = 0;
     virtual MsgSenderBase& BoardcastAiInfoMsgSender() = 0;
+    virtual AiInfoChannel GetAiInfoChannel() const = 0;
+    virtual void BoardcastBinaryAiInfo(const char* data, uint64_t size) = 0;
 
     // player info
     virtual const char* PlayerName(const PlayerID& pid) = 0;
@@ -34,8 +43,19 @@ class MatchBase
     virtual void Hook(const PlayerID pid) = 0;
     virtual void Activate(const PlayerID pid) = 0;
 
+    // computer acts
+    // What a computer act decides may differ from run to run (e.g., the result of a search bounded by time), so it is
+    // journaled along with the act, and the replayed act takes the journaled one instead of deciding again. The replayed
+    // ones are nullptr if nothing is journaled.
+    virtual void JournalComputerDecision(const char* decision) = 0;
+    virtual void JournalComputerChoice(const char* choice) = 0;
+    virtual const char* ReplayedComputerDecision() = 0;
+    virtual const char* NextReplayedComputerChoice() = 0;
+
     // match info
     virtual bool IsInDeduction() const = 0;
+    virtual bool IsReplaying() const = 0; // the match is being rebuilt from its journal after the bot restarts
     virtual uint64_t MatchId() const = 0;
+    virtual uint64_t RandomSeed() const = 0; // the seed is journaled, so a replayed match draws the same random numbers
     virtual const char* GameName() const = 0;
 };
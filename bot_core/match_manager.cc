@@ -6,8 +6,17 @@
 
 #include <cassert>
 
+#include <algorithm>
+#include <filesystem>
+#include <thread>
+
+#include "utility/journal.h"
+#include "utility/log.h"
+#include "utility/thread_pool.h"
 #include "bot_core/msg_sender.h"
 #include "bot_core/match.h"
+#include "bot_core/bot_ctx.h"
+#include "nlohmann/json.hpp"
 
 static ErrCode StartGame(const lgtbot::game::InitOptionsResult start_mode, const UserID& uid, Match& match, MsgSenderBase& reply)
 {
@@ -48,19 +57,24 @@ ErrCode MatchManager::NewMatch(GameHandle& game_handle, const std::string_view i
             reply() << "[错误] 建立失败：该房间已经开始游戏";
             return EC_MATCH_ALREADY_BEGIN;
         }
-        const MatchID mid = NewMatchID_();
         auto options = game_handle.CopyDefaultGameOptions();
+        if (!options.has_value()) {
+            reply() << "[错误] 建立失败：游戏模块载入失败";
+            return EC_GAME_LOAD_FAILED;
+        }
+        const MatchID mid = NewMatchID_();
         if (!init_options_args.empty()) {
-            start_mode = game_handle.Info().handle_init_options_command_fn_(init_options_args.data(), options.game_options_.get(),
-                    &options.generic_options_);
+            start_mode = options->module_->Handler().handle_init_options_command_fn_(init_options_args.data(),
+                    options->game_options_.get(), &options->generic_options_);
         }
         if (start_mode == lgtbot::game::InitOptionsResult::INVALID_INIT_OPTIONS_COMMAND) {
             // TODO: show all valid preset commands
             reply() << "[错误] 建立失败：非法的预设指令，您可以通过「" META_COMMAND_SIGN "规则 "
-                    << game_handle.Info().name_ << "」查看所有的预设指令";
+                    << game_handle.Name() << "」查看所有的预设指令";
             return EC_INVALID_ARGUMENT;
         }
-        new_match = std::make_shared<Match>(bot_, mid, game_handle, std::move(options), uid, gid);
+        new_match = std::make_shared<Match>(bot_, mid, game_handle, std::move(*options), uid, gid,
+                std::string(init_options_args));
         BindMatch_(mid, new_match);
         BindMatch_(uid, new_match);
         if (gid.has_value()) {
@@ -80,6 +94,92 @@ std::vector<std::shared_ptr<Match>> MatchManager::Matches() const
     return matches;
 }
 
+uint64_t MatchManager::RecoverMatches()
+{
+    if (bot_.journal_path().empty()) {
+        return 0;
+    }
+    std::vector<std::string> journal_filenames;
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(bot_.journal_path(), ec)) {
+        if (entry.is_regular_file() && entry.path().extension() == ".journal") {
+            journal_filenames.emplace_back(entry.path().string());
+        }
+    }
+    if (ec) {
+        ErrorLog() << "RecoverMatches iterate journal directory failed, reason: '" << ec.message() << "', journal_path: '"
+                   << bot_.journal_path() << "'";
+    }
+    const auto begin_time = std::chrono::steady_clock::now();
+    std::atomic<uint64_t> recovered_count{0};
+    {
+        // Matches are independent of each other, so they can be replayed concurrently.
+        ThreadPool thread_pool(std::clamp(std::thread::hardware_concurrency(), 1U, 8U));
+        for (const auto& journal_filename : journal_filenames) {
+            thread_pool.Submit([&] { recovered_count += RecoverMatch_(journal_filename); });
+        }
+    }
+    InfoLog() << "RecoverMatches finished, recovered_count=" << recovered_count << " failed_count="
+              << (journal_filenames.size() - recovered_count) << " cost_ms="
+              << std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin_time).count();
+    return recovered_count;
+}
+
+bool MatchManager::RecoverMatch_(const std::string& journal_filename)
+{
+    const auto records = ReadJournal(journal_filename);
+    std::shared_ptr<Match> match;
+    try {
+        if (records.empty()) {
+            throw std::runtime_error("the journal is empty");
+        }
+        const auto start_record = nlohmann::json::parse(records.front());
+        const auto game_name = start_record["game"].get<std::string>();
+        const auto it = bot_.game_handles().find(game_name);
+        if (it == bot_.game_handles().end()) {
+            // Keep the journal so that the match can be recovered when the game is loaded again.
+            ErrorLog() << "RecoverMatch game not found, skip: " << game_name << ", journal_filename: " << journal_filename;
+            return false;
+        }
+        GameHandle& game_handle = it->second;
+        auto options = game_handle.CopyDefaultGameOptions();
+        if (!options.has_value()) {
+            ErrorLog() << "RecoverMatch load game module failed, skip: " << game_name << ", journal_filename: " << journal_filename;
+            return false;
+        }
+        const auto option_commands = start_record["option_commands"].get<std::vector<std::string>>();
+        for (size_t i = 0; i < option_commands.size(); ++i) {
+            const char* const command = option_commands[i].c_str();
+            if (i == 0 ? !option_commands[i].empty() &&
+                            options->module_->Handler().handle_init_options_command_fn_(command, options->game_options_.get(),
+                                &options->generic_options_) == lgtbot::game::InitOptionsResult::INVALID_INIT_OPTIONS_COMMAND
+                       : !options->game_options_->SetOption(command)) {
+                throw std::runtime_error(std::string("set option failed: ") + command);
+            }
+        }
+        options->generic_options_.bench_computers_to_player_num_ = start_record["bench_computers_to_player_num"].get<uint32_t>();
+        options->generic_options_.is_formal_ = start_record["is_formal"].get<uint8_t>();
+        const auto& gid_json = start_record["group_id"];
+        const auto gid = gid_json.is_null() ? std::nullopt : std::optional<GroupID>(gid_json.get<std::string>());
+        {
+            std::lock_guard<std::mutex> l(mutex_);
+            match = std::make_shared<Match>(bot_, NewMatchID_(), game_handle, std::move(*options),
+                    UserID(start_record["host_user_id"].get<std::string>()), gid, option_commands.empty() ? "" : option_commands.front());
+            BindMatch_(MatchID(match->MatchId()), match); // occupy the match ID
+        }
+    } catch (const std::exception& e) {
+        ErrorLog() << "RecoverMatch parse journal failed: " << e.what() << ", journal_filename: " << journal_filename;
+        std::error_code ec;
+        std::filesystem::remove(journal_filename, ec);
+        return false;
+    }
+    if (!match->Recover(records, journal_filename)) {
+        UnbindMatch(MatchID(match->MatchId()));
+        return false;
+    }
+    return true;
+}
+
 MatchID MatchManager::NewMatchID_()
 {
     const auto& mid2match = id2match<MatchID>();
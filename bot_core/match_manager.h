@@ -54,7 +54,13 @@ class MatchManager
 
     bool HasMatch() const;
 
+    // Rebuilds the matches which were processing when the bot exited, from the journals in the journal path. Returns the
+    // number of recovered matches.
+    uint64_t RecoverMatches();
+
    private:
+    bool RecoverMatch_(const std::string& journal_filename);
+
     void DeleteMatch_(const MatchID id);
 
     template <typename IdType>
@@ -54,14 +54,10 @@ struct ShowCommandOption
 extern const std::vector<MetaCommandGroup> meta_cmds;
 extern const std::vector<MetaCommandGroup> admin_cmds;
 
-static uint32_t DefaultMultiple(const GameHandle& game_handle)
+// The module is loaded only if the cached summary is out of date.
+static GameHandle::DefaultOptionsSummary DefaultSummary(GameHandle& game_handle)
 {
-    return game_handle.Info().multiple_fn_(game_handle.DefaultGameOptions().Lock()->game_options_.get());
-}
-
-static uint32_t DefaultMaxPlayer(const GameHandle& game_handle)
-{
-    return game_handle.Info().max_player_num_fn_(game_handle.DefaultGameOptions().Lock()->game_options_.get());
+    return game_handle.DefaultSummary().value_or(GameHandle::DefaultOptionsSummary{});
 }
 
 static ErrCode help_internal(BotCtx& bot, MsgSenderBase& reply, const std::vector<MetaCommandGroup>& cmd_groups,
@@ -140,16 +136,16 @@ static ErrCode show_gamelist(BotCtx& bot, const UserID uid, const std::optional<
     if (show_text) {
         auto sender = reply();
         sender << "游戏列表：";
-        for (const auto& [name, game_handle] : bot.game_handles()) {
+        for (auto& [name, game_handle] : bot.game_handles()) {
             sender << "\n" << (++i) << ". " << name;
-            if (DefaultMultiple(game_handle) == 0) {
+            if (DefaultSummary(game_handle).multiple_ == 0) {
                 sender << "（试玩）";
             }
         }
     } else {
         html::Table table(0, 5);
         table.SetTableStyle(" align=\"center\" border=\"1px solid #ccc\" cellpadding=\"5\" cellspacing=\"1\" ");
-        const auto game_handles_range = std::views::transform(bot.game_handles(), [](const auto& p) { return &p; });
+        const auto game_handles_range = std::views::transform(bot.game_handles(), [](auto& p) { return &p; });
         auto game_handles = std::vector(std::ranges::begin(game_handles_range), std::ranges::end(game_handles_range));
         std::ranges::sort(game_handles,
                 [](const auto& _1, const auto& _2) { return _1->second.Activity() > _2->second.Activity(); });
@@ -168,27 +164,25 @@ static ErrCode show_gamelist(BotCtx& bot, const UserID uid, const std::optional<
                 i = 1;
             }
             const auto& name = p->first;
-            const auto& game_handle = p->second;
-            const auto locked_options = game_handle.DefaultGameOptions().Lock();
-            const auto default_multiple =
-                locked_options->generic_options_.is_formal_ ? game_handle.Info().multiple_fn_(locked_options->game_options_.get())
-                                                            : 0;
-            const auto default_max_player = game_handle.Info().max_player_num_fn_(locked_options->game_options_.get());
+            auto& game_handle = p->second;
+            const auto summary = DefaultSummary(game_handle);
+            const auto default_multiple = game_handle.DefaultGenericOptions().is_formal_ ? summary.multiple_ : 0;
+            const auto default_max_player = summary.max_player_num_;
             table.AppendRow();
             table.AppendRow();
             table.MergeDown(table.Row() - 2, 0, 2);
             table.MergeDown(table.Row() - 2, 4, 2);
             table.MergeRight(table.Row() - 1, 1, 3);
             table.Get(table.Row() - 2, 0).SetContent("<font size=\"5\"> **" + name + "**</font>\n\n热度：" + std::to_string(game_handle.Activity()));
-            table.Get(table.Row() - 2, 1).SetContent(std::string("开发者：") + game_handle.Info().developer_);
+            table.Get(table.Row() - 2, 1).SetContent(std::string("开发者：") + game_handle.Info()->developer_);
             table.Get(table.Row() - 2, 2).SetContent(default_max_player == 0 ? "无玩家数限制" :
                     ("最多 " HTML_COLOR_FONT_HEADER(blue) "**" + std::to_string(default_max_player) + "**" HTML_FONT_TAIL " 名玩家"));
             table.Get(table.Row() - 2, 3).SetContent(default_multiple == 0 ? "默认不计分" :
                     ("默认 " HTML_COLOR_FONT_HEADER(blue) "**" + std::to_string(default_multiple) + "**" HTML_FONT_TAIL " 倍分数"));
             table.Get(table.Row() - 2, 4).SetContent("<img src=\"file:///" +
-                    (std::filesystem::absolute(bot.game_path()) / game_handle.Info().module_name_ / "icon.png").string() +
+                    (std::filesystem::absolute(bot.game_path()) / game_handle.Info()->module_name_ / "icon.png").string() +
                     "\" style=\"width:70px; height:70px; vertical-align: middle;\">");
-            table.Get(table.Row() - 1, 1).SetContent(std::string("<font size=\"3\"> ") + game_handle.Info().description_ + "</font>");
+            table.Get(table.Row() - 1, 1).SetContent(std::string("<font size=\"3\"> ") + game_handle.Info()->description_ + "</font>");
         }
         send_image();
     }
@@ -335,7 +329,7 @@ static ErrCode show_matches(BotCtx& bot, const UserID uid, const std::optional<G
                 }
                 const auto uid = match->HostUserId();
                 table.GetLastRow(2).SetContent(bot.GetUserAvatar(uid.GetCStr(), 25) + HTML_ESCAPE_SPACE + bot.GetUserName(uid.GetCStr(), nullptr));
-                table.GetLastRow(3).SetContent(match->game_handle().Info().name_);
+                table.GetLastRow(3).SetContent(match->GameName());
                 table.GetLastRow(4).SetContent(std::to_string(match->UserNum()));
                 const auto state = match->state();
                 table.GetLastRow(5).SetContent(
@@ -374,19 +368,19 @@ static ErrCode show_rule(BotCtx& bot, const UserID uid, const std::optional<Grou
         return EC_REQUEST_UNKNOWN_GAME;
     };
     if (!show_text) {
-        reply() << Markdown(it->second.Info().rule_);
+        reply() << Markdown(it->second.Info()->rule_);
         return EC_OK;
     }
     auto sender = reply();
     sender << "最多可参加人数：";
-    if (const auto max_player = DefaultMaxPlayer(it->second); max_player == 0) {
+    if (const auto max_player = DefaultSummary(it->second).max_player_num_; max_player == 0) {
         sender << "无限制";
     } else {
         sender << max_player;
     }
     sender << "人\n";
     sender << "详细规则：\n";
-    sender << it->second.Info().rule_;
+    sender << it->second.Info()->rule_;
     return EC_OK;
 }
 
@@ -403,12 +397,12 @@ static ErrCode show_custom_rule(BotCtx& bot, const UserID uid, const std::option
         s += arg;
         s += " ";
     }
-    const char* const result = it->second.Info().handle_rule_command_fn_(s.c_str());
-    if (!result) {
+    const auto result = it->second.HandleRuleCommand(s);
+    if (!result.has_value()) {
         reply() << "[错误] 查看失败：未知的规则指令，请通过「" META_COMMAND_SIGN "规则 " << gamename << "」查看具体规则指令";
         return EC_INVALID_ARGUMENT;
     }
-    reply() << result;
+    reply() << *result;
     return EC_OK;
 }
 
@@ -424,13 +418,14 @@ static ErrCode show_achievement(BotCtx& bot, const UserID uid, const std::option
         reply() << "[错误] 查看失败：未知的游戏名，请通过「" META_COMMAND_SIGN "游戏列表」查看游戏名称";
         return EC_REQUEST_UNKNOWN_GAME;
     };
-    if (it->second.Info().achievements_.empty()) {
+    const auto game_info = it->second.Info();
+    if (game_info->achievements_.empty()) {
         reply() << "该游戏没有任何成就";
         return EC_OK;
     }
     html::Table table(0, 3);
     table.SetTableStyle(" align=\"center\" border=\"1px solid #ccc\" cellpadding=\"5\" cellspacing=\"1\" ");
-    for (const auto& [achievement_name, description] : it->second.Info().achievements_) {
+    for (const auto& [achievement_name, description] : game_info->achievements_) {
         const auto statistic = bot.db_manager()->GetAchievementStatistic(uid, gamename, achievement_name);
         const std::string color_header = statistic.count_ > 0 ? HTML_COLOR_FONT_HEADER(green) : HTML_COLOR_FONT_HEADER(black);
         table.AppendRow();
@@ -459,8 +454,13 @@ static ErrCode show_game_options(BotCtx& bot, const UserID uid, const std::optio
         reply() << "[错误] 查看失败：未知的游戏名，请通过「" META_COMMAND_SIGN "游戏列表」查看游戏名称";
         return EC_REQUEST_UNKNOWN_GAME;
     };
-    const std::string outstr = std::string("### 「") + gamename + "」配置选项" +
-        it->second.DefaultGameOptions().Lock()->game_options_->Info(true, !text_mode, (ADMIN_COMMAND_SIGN "配置 " + gamename + " ").c_str());
+    const auto options_info =
+        it->second.DefaultGameOptionsInfo(true, !text_mode, (ADMIN_COMMAND_SIGN "配置 " + gamename + " ").c_str());
+    if (!options_info.has_value()) {
+        reply() << "[错误] 查看失败：游戏模块载入失败";
+        return EC_GAME_LOAD_FAILED;
+    }
+    const std::string outstr = std::string("### 「") + gamename + "」配置选项" + *options_info;
     if (text_mode) {
         reply() << outstr;
     } else {
@@ -664,7 +664,8 @@ static ErrCode show_profile(BotCtx& bot, const UserID uid, const std::optional<G
             if (const auto it = bot.game_handles().find(info.game_name_); it == bot.game_handles().end()) {
                 recent_honors_table.GetLastRow(3).SetContent("???");
             } else {
-                for (const auto& [name, description] : it->second.Info().achievements_) {
+                const auto game_info = it->second.Info();
+                for (const auto& [name, description] : game_info->achievements_) {
                     if (name == info.achievement_name_) {
                         recent_honors_table.GetLastRow(3).SetContent(description);
                         break;
@@ -938,12 +939,27 @@ static ErrCode set_game_default_formal(BotCtx& bot, const UserID uid, const std:
         reply() << "[错误] 查看失败：未知的游戏名，请通过「" META_COMMAND_SIGN "游戏列表」查看游戏名称";
         return EC_REQUEST_UNKNOWN_GAME;
     };
-    it->second.DefaultGameOptions().Lock()->generic_options_.is_formal_ = is_formal;
+    it->second.SetDefaultFormal(is_formal);
     reply() << "设置成功，游戏默认" << (is_formal ? "开启" : "关闭") << "计分";
     bot.UpdateGameDefaultFormal(gamename, is_formal);
     return EC_OK;
 }
 
+static ErrCode reload_game(BotCtx& bot, const UserID uid, const std::optional<GroupID> gid, MsgSenderBase& reply,
+        const std::string& gamename)
+{
+    if (bot.game_handles().find(gamename) == bot.game_handles().end()) {
+        reply() << "[错误] 重载失败：未知的游戏名，请通过「" META_COMMAND_SIGN "游戏列表」查看游戏名称";
+        return EC_REQUEST_UNKNOWN_GAME;
+    }
+    if (const char* const errmsg = bot.ReloadGameModule(gamename)) {
+        reply() << "[错误] 重载失败：" << errmsg;
+        return EC_GAME_LOAD_FAILED;
+    }
+    reply() << "重载成功，新的比赛将使用新版本的游戏，进行中的比赛不受影响";
+    return EC_OK;
+}
+
 static ErrCode show_others_profile(BotCtx& bot, const UserID uid, const std::optional<GroupID> gid,
         MsgSenderBase& reply, const std::string& others_uid, const TimeRange time_range)
 {
@@ -993,8 +1009,7 @@ static ErrCode set_game_option(BotCtx& bot, const UserID uid, const std::optiona
     for (const auto& option_arg : option_args) {
         option_str += " " + option_arg;
     }
-    auto locked_option = game_handle_it->second.DefaultGameOptions().Lock(); // lock until updated config to ensure atomic write
-    if (!locked_option->game_options_->SetOption(option_str.c_str())) {
+    if (!game_handle_it->second.SetDefaultOption(option_name, option_str)) {
         reply() << "[错误] 设置配置项失败，请通过「" META_COMMAND_SIGN "配置 " << game_name << "」确认配置项是否存在";
         return EC_INVALID_ARGUMENT;
     }
@@ -1015,6 +1030,62 @@ static ErrCode show_bot_options(BotCtx& bot, const UserID uid, const std::option
     return EC_OK;
 }
 
+template <typename Cache>
+static std::string cache_statistic_info(const std::string_view name, const Cache& cache)
+{
+    const auto statistic = cache.GetStatistic();
+    return std::string(name) + "：命中 " + std::to_string(statistic.hit_count_) + " 次，未命中 " +
+        std::to_string(statistic.miss_count_) + " 次，等待 " + std::to_string(statistic.wait_count_) + " 次，淘汰 " +
+        std::to_string(statistic.evict_count_) + " 次";
+}
+
+static ErrCode show_metrics(BotCtx& bot, const UserID uid, const std::optional<GroupID> gid, MsgSenderBase& reply,
+        const bool text_mode)
+{
+    const std::string cache_info = cache_statistic_info("用户名缓存", bot.user_name_cache()) + "\n" +
+        cache_statistic_info("用户头像缓存", bot.user_avatar_cache());
+    if (text_mode) {
+        reply() << "### 性能统计（耗时单位为微秒）\n" << bot.metrics().ToString() << "\n\n" << cache_info;
+        return EC_OK;
+    }
+    const auto snapshots = bot.metrics().HistogramSnapshots();
+    html::Table latency_table(1 + snapshots.size(), 7);
+    latency_table.SetTableStyle(" align=\"center\" border=\"1px solid #ccc\" cellpadding=\"1\" cellspacing=\"1\" ");
+    for (uint32_t col = 0; const char* const column : {"名称", "次数", "平均", "P50", "P90", "P99", "最大"}) {
+        latency_table.Get(0, col++).SetContent(std::string("**") + column + "**");
+    }
+    for (uint32_t row = 1; const auto& [name, snapshot] : snapshots) {
+        latency_table.Get(row, 0).SetContent(name);
+        latency_table.Get(row, 1).SetContent(std::to_string(snapshot.count_));
+        uint32_t col = 2;
+        for (const uint64_t ns : {snapshot.Mean(), snapshot.Percentile(50), snapshot.Percentile(90),
+                snapshot.Percentile(99), snapshot.max_}) {
+            latency_table.Get(row, col++).SetContent(std::to_string(ns / 1000));
+        }
+        ++row;
+    }
+    const auto counter_values = bot.metrics().CounterValues();
+    html::Table counter_table(1 + counter_values.size(), 2);
+    counter_table.SetTableStyle(" align=\"center\" border=\"1px solid #ccc\" cellpadding=\"1\" cellspacing=\"1\" ");
+    counter_table.Get(0, 0).SetContent("**名称**");
+    counter_table.Get(0, 1).SetContent("**数值**");
+    for (uint32_t row = 1; const auto& [name, value] : counter_values) {
+        counter_table.Get(row, 0).SetContent(name);
+        counter_table.Get(row, 1).SetContent(std::to_string(value));
+        ++row;
+    }
+    reply() << Markdown("### 耗时统计（微秒）\n\n" + latency_table.ToString() + "\n\n### 计数统计\n\n" +
+            counter_table.ToString() + "\n\n### 缓存统计\n\n" + cache_info, 1000);
+    return EC_OK;
+}
+
+static ErrCode reset_metrics(BotCtx& bot, const UserID uid, const std::optional<GroupID> gid, MsgSenderBase& reply)
+{
+    bot.metrics().Reset();
+    reply() << "性能统计已清空";
+    return EC_OK;
+}
+
 static ErrCode add_honor(BotCtx& bot, const UserID uid, const std::optional<GroupID> gid, MsgSenderBase& reply,
         const std::string& honor_uid, const std::string honor_desc)
 {
@@ -1052,12 +1123,17 @@ const std::vector<MetaCommandGroup> admin_cmds = {
                         OptionalDefaultChecker<BoolChecker>(false, "文字", "图片")),
             make_command("查看他人战绩", show_others_profile, VoidChecker(ADMIN_COMMAND_SIGN "战绩"), AnyArg("用户 ID", "123456789"),
                         OptionalDefaultChecker<EnumChecker<TimeRange>>(TimeRange::总)),
+            make_command("查看各项操作的耗时和计数", show_metrics, VoidChecker(ADMIN_COMMAND_SIGN "性能"),
+                        OptionalDefaultChecker<BoolChecker>(false, "文字", "图片")),
         }
     },
     {
         "管理操作", {
             make_command("强制中断比赛", interrupt_game, VoidChecker(ADMIN_COMMAND_SIGN "中断"),
                         OptionalChecker<BasicChecker<MatchID>>("私密比赛编号")),
+            make_command("清空性能统计", reset_metrics, VoidChecker(ADMIN_COMMAND_SIGN "性能"), VoidChecker("清空")),
+            make_command("从游戏目录重新载入游戏（进行中的比赛仍使用旧版本）", reload_game, VoidChecker(ADMIN_COMMAND_SIGN "重载"),
+                        AnyArg("游戏名称", "猜拳游戏")),
             make_command("清除他人战绩，并通知其具体理由", clear_others_profile, VoidChecker(ADMIN_COMMAND_SIGN "清除战绩"),
                         AnyArg("用户 ID", "123456789"), AnyArg("理由", "恶意刷分")),
         }
@@ -6,9 +6,40 @@
 
 #include "msg_sender.h"
 #include "bot_core/match.h"
+#include "bot_core/bot_ctx.h"
 
 bool DownloadUserAvatar(const char* const uid, const char* const dest_filename);
 
+void MsgSender::SaveMarkdown(const char* const markdown, const uint32_t width)
+{
+    if (!image_path_) {
+        return;
+    }
+    std::stringstream ss;
+    ss << std::this_thread::get_id();
+    if (auto* const coalescer = MsgCoalescer::Current()) {
+        ss << '_' << coalescer->NextImageNo();
+    }
+    const std::string path =
+        (std::filesystem::path(*image_path_) / "gen" / ss.str() += ".png").string();
+    {
+        ScopedLatency latency(bot_->metrics().Histogram("image.markdown"));
+        if (MarkdownToImage(markdown, path, width) < 0) {
+            bot_->metrics().Counter("image.markdown_failed").Add();
+        }
+    }
+    SaveImage(path.c_str());
+}
+
+void MsgSender::SaveUser(const UserID& uid, const bool is_at)
+{
+    if (is_at) {
+        messages_.emplace_back(uid.GetStr(), LGTBot_MessageType::LGTBOT_MSG_USER_MENTION);
+        return;
+    }
+    SaveText_(bot_->GetUserName(uid.GetCStr(), is_to_user_ ? nullptr : id_.c_str()));
+}
+
 void MsgSender::SavePlayer(const PlayerID& pid, const bool is_at)
 {
     if (!match_ || match_->state() == Match::State::NOT_STARTED) {
@@ -20,14 +20,115 @@ class PlayerID;
 class UserID;
 class GroupID;
 class Match;
+class BotCtx;
 
 template <typename IdType> struct At { IdType id_; };
 template <typename IdType> struct Name { IdType id_; };
 struct Image { std::string path_; };
 struct Markdown { std::string_view data_; uint32_t width_ = 600; };
+// The markdown is generated by `fn_` only if the message has recipients (e.g., it is not generated during deduction).
+template <typename Fn> struct LazyMarkdown { Fn fn_; uint32_t width_ = 600; };
 
 template <typename T> concept CanToString = requires(T&& t) { std::to_string(std::forward<T>(t)); };
 
+struct OutboundMessage
+{
+    std::string str_;
+    LGTBot_MessageType type_;
+};
+
+// Converts the messages into the raw messages and sends them in one platform send.
+inline void SendOutboundMessages(const LGTBot_Callback& callbacks, void* const handler, const std::string& id,
+        const bool is_to_user, const std::vector<OutboundMessage>& messages)
+{
+    thread_local std::vector<LGTBot_Message> raw_messages; // reused to avoid allocating for each send
+    raw_messages.clear();
+    for (const auto& message : messages) {
+        raw_messages.emplace_back(message.str_.c_str(), message.type_);
+    }
+    callbacks.handle_messages(handler, id.c_str(), is_to_user, raw_messages.data(), raw_messages.size());
+}
+
+// While a `MsgCoalescer` is alive, the messages flushed by `MsgSender`s in the same thread are buffered, and they are
+// sent when it is destructed. Consecutive messages to the same target are merged into one platform send, and the order
+// of messages is kept. If coalescers are nested, only the outermost one takes effect.
+class MsgCoalescer
+{
+  public:
+    // `on_sends_saved` is invoked with the number of platform sends saved when the coalescer is destructed.
+    MsgCoalescer(const bool enabled, std::function<void(uint64_t)> on_sends_saved = nullptr)
+        : is_active_(enabled && !current_), on_sends_saved_(std::move(on_sends_saved))
+    {
+        if (is_active_) {
+            current_ = this;
+        }
+    }
+
+    MsgCoalescer(const MsgCoalescer&) = delete;
+    MsgCoalescer& operator=(const MsgCoalescer&) = delete;
+
+    ~MsgCoalescer()
+    {
+        if (!is_active_) {
+            return;
+        }
+        current_ = nullptr;
+        for (const auto& batch : batches_) {
+            SendOutboundMessages(*batch.callbacks_, batch.handler_, batch.id_, batch.is_to_user_, batch.messages_);
+        }
+        if (on_sends_saved_) {
+            on_sends_saved_(flush_count_ - batches_.size());
+        }
+    }
+
+    // Returns the active coalescer of the current thread, or nullptr if messages should be sent immediately.
+    static MsgCoalescer* Current() { return current_; }
+
+    // Images must not be overwritten before they are sent, so the generated images are numbered in a coalescer.
+    uint64_t NextImageNo() { return image_no_++; }
+
+    void Push(const LGTBot_Callback& callbacks, void* const handler, const std::string& id, const bool is_to_user,
+            std::vector<OutboundMessage>& messages)
+    {
+        ++flush_count_;
+        if (batches_.empty() || !batches_.back().Is(callbacks, handler, id, is_to_user)) {
+            batches_.emplace_back(&callbacks, handler, id, is_to_user, std::move(messages));
+            return;
+        }
+        auto& merged_messages = batches_.back().messages_;
+        auto it = messages.begin();
+        if (it != messages.end() && !merged_messages.empty() && it->type_ == LGTBOT_MSG_TEXT &&
+                merged_messages.back().type_ == LGTBOT_MSG_TEXT) {
+            (merged_messages.back().str_ += '\n') += it->str_;
+            ++it;
+        }
+        merged_messages.insert(merged_messages.end(), std::make_move_iterator(it), std::make_move_iterator(messages.end()));
+    }
+
+  private:
+    struct Batch
+    {
+        bool Is(const LGTBot_Callback& callbacks, void* const handler, const std::string& id, const bool is_to_user) const
+        {
+            return callbacks_ == &callbacks && handler_ == handler && id_ == id && is_to_user_ == is_to_user;
+        }
+
+        const LGTBot_Callback* callbacks_;
+        void* handler_;
+        std::string id_;
+        bool is_to_user_;
+        std::vector<OutboundMessage> messages_;
+    };
+
+    inline static thread_local MsgCoalescer* current_ = nullptr;
+
+    const bool is_active_;
+    const std::function<void(uint64_t)> on_sends_saved_;
+    std::vector<Batch> batches_;
+    uint64_t flush_count_{0};
+    uint64_t image_no_{0};
+};
+
 class MsgSenderBase
 {
   public:
@@ -64,6 +165,16 @@ class MsgSenderBase
         inline MsgSenderGuard& operator<<(const Image&);
         inline MsgSenderGuard& operator<<(const Markdown&);
 
+        template <typename Fn>
+        MsgSenderGuard& operator<<(const LazyMarkdown<Fn>& markdown_msg)
+        {
+            if (sender_->HasRecipients()) {
+                const std::string markdown = markdown_msg.fn_();
+                (*this) << Markdown{markdown, markdown_msg.width_};
+            }
+            return *this;
+        }
+
       private:
         MsgSenderBase* sender_;
     };
@@ -75,6 +186,9 @@ class MsgSenderBase
     virtual MsgSenderGuard operator()() { return MsgSenderGuard(*this); }
     virtual void SetMatch(const Match* const match) = 0;
 
+    // If it returns false, the messages will be dropped, so we need not build them.
+    virtual bool HasRecipients() const { return true; }
+
     friend class MsgSenderGuard;
 
   protected:
@@ -103,6 +217,7 @@ class EmptyMsgSender : public MsgSenderBase
     virtual void SaveMarkdown(const char* const markdown, const uint32_t width) override {};
     virtual void Flush() override {}
     virtual void SetMatch(const Match* const match) override {}
+    virtual bool HasRecipients() const override { return false; }
 
   private:
     EmptyMsgSender() : MsgSenderBase() {}
@@ -112,11 +227,11 @@ class EmptyMsgSender : public MsgSenderBase
 class MsgSender : public MsgSenderBase
 {
   public:
-    MsgSender(void* handler, const std::string& image_path, const LGTBot_Callback& callbacks, const UserID& uid, Match* const match = nullptr)
-        : handler_(handler), image_path_(&image_path), callbacks_(&callbacks), id_(uid.GetStr()), is_to_user_(true), match_(match) {}
+    MsgSender(const BotCtx& bot, void* handler, const std::string& image_path, const LGTBot_Callback& callbacks, const UserID& uid, Match* const match = nullptr)
+        : bot_(&bot), handler_(handler), image_path_(&image_path), callbacks_(&callbacks), id_(uid.GetStr()), is_to_user_(true), match_(match) {}
 
-    MsgSender(void* handler, const std::string& image_path, const LGTBot_Callback& callbacks, const GroupID& gid, Match* const match = nullptr)
-        : handler_(handler), image_path_(&image_path), callbacks_(&callbacks), id_(gid.GetStr()), is_to_user_(false), match_(match) {}
+    MsgSender(const BotCtx& bot, void* handler, const std::string& image_path, const LGTBot_Callback& callbacks, const GroupID& gid, Match* const match = nullptr)
+        : bot_(&bot), handler_(handler), image_path_(&image_path), callbacks_(&callbacks), id_(gid.GetStr()), is_to_user_(false), match_(match) {}
 
     MsgSender(const MsgSender&) = delete;
     MsgSender(MsgSender&& o) = default;
@@ -142,20 +257,7 @@ class MsgSender : public MsgSenderBase
         }
     }
 
-    virtual void SaveUser(const UserID& uid, const bool is_at) override
-    {
-        if (is_at) {
-            messages_.emplace_back(uid.GetStr(), LGTBot_MessageType::LGTBOT_MSG_USER_MENTION);
-            return;
-        }
-        char buffer[128];
-        if (is_to_user_) {
-            callbacks_->get_user_name(handler_, buffer, sizeof(buffer), uid.GetCStr());
-        } else {
-            callbacks_->get_user_name_in_group(handler_, buffer, sizeof(buffer), id_.c_str(), uid.GetCStr());
-        }
-        SaveText(buffer, std::strlen(buffer));
-    }
+    virtual void SaveUser(const UserID& uid, const bool is_at) override;
 
     virtual void SavePlayer(const PlayerID& pid, const bool is_at) override;
 
@@ -164,27 +266,15 @@ class MsgSender : public MsgSenderBase
         messages_.emplace_back(std::string(path), LGTBot_MessageType::LGTBOT_MSG_IMAGE);
     }
 
-    virtual void SaveMarkdown(const char* const markdown, const uint32_t width)
-    {
-        if (!image_path_) {
-            return;
-        }
-        std::stringstream ss;
-        ss << std::this_thread::get_id();
-        const std::string path =
-            (std::filesystem::path(*image_path_) / "gen" / ss.str() += ".png").string();
-        MarkdownToImage(markdown, path, width);
-        SaveImage(path.c_str());
-    }
+    virtual void SaveMarkdown(const char* const markdown, const uint32_t width);
 
     virtual void Flush() override
     {
-        std::vector<LGTBot_Message> raw_messages;
-        raw_messages.reserve(messages_.size());
-        for (const auto& message : messages_) {
-            raw_messages.emplace_back(message.str_.c_str(), message.type_);
+        if (auto* const coalescer = MsgCoalescer::Current()) {
+            coalescer->Push(*callbacks_, handler_, id_, is_to_user_, messages_);
+        } else {
+            SendOutboundMessages(*callbacks_, handler_, id_, is_to_user_, messages_);
         }
-        callbacks_->handle_messages(handler_, id_.c_str(), is_to_user_, raw_messages.data(), raw_messages.size());
         messages_.clear();
     }
 
@@ -194,18 +284,14 @@ class MsgSender : public MsgSenderBase
     }
 
   private:
-    struct Message
-    {
-        std::string str_;
-        LGTBot_MessageType type_;
-    };
+    const BotCtx* bot_;
     void* handler_;
     const std::string* image_path_;
     const LGTBot_Callback* callbacks_;
     std::string id_;
     bool is_to_user_;
     const Match* match_;
-    std::vector<Message> messages_;
+    std::vector<OutboundMessage> messages_;
 };
 
 MsgSenderBase::MsgSenderGuard::~MsgSenderGuard()
@@ -5,7 +5,12 @@
 #ifdef EXTEND_OPTION
 
 EXTEND_OPTION("计时器提示方式，私信提醒，或者群里公开 at 提醒", 计时公开提示, (BoolChecker("开启", "关闭")), false)
-EXTEND_OPTION("AI 玩家列表，当这些玩家加入游戏时，会输出 json 格式的游戏信息", AI列表, (RepeatableChecker<AnyArg>("用户 ID", "123456")), std::vector<std::string>{})
+EXTEND_OPTION("AI 玩家列表，当这些玩家加入游戏时，会输出游戏信息（设置了二进制信息回调时为二进制格式，否则为 json 格式）", AI列表, (RepeatableChecker<AnyArg>("用户 ID", "123456")), std::vector<std::string>{})
+EXTEND_OPTION("用户名称和头像的缓存时间（秒），超时后会重新向客户端获取", 用户信息缓存时间, (ArithChecker<uint32_t>(0, 86400, "秒数")), 600)
+EXTEND_OPTION("比赛记录的刷盘间隔（毫秒），间隔内写入的记录会一起刷入磁盘", 比赛记录刷盘间隔, (ArithChecker<uint32_t>(1, 60000, "毫秒数")), 100)
+EXTEND_OPTION("性能统计的输出间隔（秒），每隔一段时间将性能统计写入文件", 性能统计输出间隔, (ArithChecker<uint32_t>(1, 86400, "秒数")), 60)
+EXTEND_OPTION("合并发送消息，开启后处理一条请求或一次超时期间，发给同一目标的连续多条消息会合并为一条发送", 合并发送消息, (BoolChecker("开启", "关闭")), false)
+EXTEND_OPTION("游戏模块的闲置卸载时间（分钟），没有比赛使用的模块超过该时间后会被卸载，为 0 时不卸载", 游戏模块闲置卸载时间, (ArithChecker<uint32_t>(0, 10080, "分钟数")), 60)
 
 #elif !defined(BOT_CORE_OPTIONS_H)
 #define BOT_CORE_OPTIONS_H
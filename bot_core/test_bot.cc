@@ -29,6 +29,8 @@ EXTEND_OPTION("直接结束游戏", 直接结束, (OptionalDefaultChecker<BoolCh
 #include "bot_core/db_manager.h"
 #include "bot_core/score_calculation.h"
 #include "bot_core/match.h"
+#include "game_framework/mock_match.h"
+#include "utility/ai_info.h"
 
 static_assert(TEST_BOT);
 
@@ -108,8 +110,11 @@ class MockDBManager : public DBManagerBase
     std::map<UserID, std::vector<std::string>> user_achievements_;
 };
 
+static uint64_t g_send_count = 0;
+
 void HandleMessages(void* handler, const char* const id, const int is_uid, const LGTBot_Message* messages, const size_t size)
 {
+    ++g_send_count;
     std::string s = is_uid ? "[BOT -> USER_" : "[BOT -> GROUP_";
     s.append(id);
     s.append("]\n");
@@ -147,6 +152,19 @@ void GetUserNameInGroup(void* handler, char* buffer, size_t size, const char* gr
 
 int DownloadUserAvatar(void* handler, const char* const uid_str, const char* const dest_filename) { return false; }
 
+struct AiInfo
+{
+    std::vector<std::string> user_ids_;
+    std::string data_;
+};
+static std::vector<AiInfo> g_ai_infos;
+
+void HandleAiInfo(void* handler, const char* const* const user_ids, const size_t user_num, const char* const data,
+        const size_t size)
+{
+    g_ai_infos.emplace_back(std::vector<std::string>(user_ids, user_ids + user_num), std::string(data, size));
+}
+
 class TestBot;
 
 static std::mutex substage_blocked_mutex_;
@@ -164,6 +182,13 @@ static void BlockStage()
 }
 
 static bool g_fail_to_create_game = false;
+static std::atomic<uint64_t> g_load_module_count = 0;
+static std::atomic<uint64_t> g_loaded_module_num = 0;
+static bool g_prefetch_resources = false; // whether the loaded module supports prefetching resources
+static std::atomic<bool> g_block_prefetching = false;
+static std::atomic<uint64_t> g_prefetch_count = 0;
+// The number of choices made by computers, which makes the choices differ from run to run as searches bounded by time.
+static std::atomic<uint64_t> g_computer_choice_num = 0;
 
 namespace lgtbot {
 
@@ -192,21 +217,31 @@ class SubStage : public SubGameStage<>
 {
   public:
     SubStage(MainStage& main_stage)
-        : StageFsm(main_stage, "子阶段"
-                , MakeStageCommand(*this, "结束", &SubStage::Over_, VoidChecker("结束子阶段"))
-                , MakeStageCommand(*this, "时间到时重新计时", &SubStage::ToResetTimer_, VoidChecker("重新计时"))
-                , MakeStageCommand(*this, "所有人准备好时重置准备情况", &SubStage::ToResetReadyAll_, VoidChecker("全员重新准备"), ArithChecker(0, 10))
-                , MakeStageCommand(*this, "重置准备情况时将除自己外设置为准备完成", &SubStage::ToResetOthersReady_, VoidChecker("别人重新准备"))
-                , MakeStageCommand(*this, "阻塞", &SubStage::Block_, VoidChecker("阻塞"))
-                , MakeStageCommand(*this, "阻塞并准备", &SubStage::BlockAndReady_, VoidChecker("阻塞并准备"))
-                , MakeStageCommand(*this, "阻塞并结束", &SubStage::BlockAndOver_, VoidChecker("阻塞并结束"))
-                , MakeStageCommand(*this, "准备", &SubStage::Ready_, VoidChecker("准备"))
-                , MakeStageCommand(*this, "断言并清除电脑行动次数", &SubStage::CheckComputerActCount_, VoidChecker("电脑行动次数"), ArithChecker<uint64_t>(0, UINT64_MAX))
-                , MakeStageCommand(*this, "电脑失败次数", &SubStage::ToComputerFailed_, VoidChecker("电脑失败"),
-                    BasicChecker<PlayerID>(), ArithChecker<uint64_t>(0, UINT64_MAX))
-                , MakeStageCommand(*this, "淘汰", &SubStage::Eliminate_, VoidChecker("淘汰"))
-                , MakeStageCommand(*this, "挂机", &SubStage::Hook_, VoidChecker("挂机"))
-          )
+        : StageFsm(main_stage, "子阶段", []
+                {
+                    return std::vector{
+                        MakeStageCommand("结束", &SubStage::Over_, VoidChecker("结束子阶段")),
+                        MakeStageCommand("时间到时重新计时", &SubStage::ToResetTimer_, VoidChecker("重新计时")),
+                        MakeStageCommand("所有人准备好时重置准备情况", &SubStage::ToResetReadyAll_, VoidChecker("全员重新准备"), ArithChecker(0, 10)),
+                        MakeStageCommand("重置准备情况时将除自己外设置为准备完成", &SubStage::ToResetOthersReady_, VoidChecker("别人重新准备")),
+                        MakeStageCommand("阻塞", &SubStage::Block_, VoidChecker("阻塞")),
+                        MakeStageCommand("阻塞并准备", &SubStage::BlockAndReady_, VoidChecker("阻塞并准备")),
+                        MakeStageCommand("阻塞并结束", &SubStage::BlockAndOver_, VoidChecker("阻塞并结束")),
+                        MakeStageCommand("准备", &SubStage::Ready_, VoidChecker("准备")),
+                        MakeStageCommand("断言并清除电脑行动次数", &SubStage::CheckComputerActCount_, VoidChecker("电脑行动次数"), ArithChecker<uint64_t>(0, UINT64_MAX)),
+                        MakeStageCommand("电脑失败次数", &SubStage::ToComputerFailed_, VoidChecker("电脑失败"),
+                            BasicChecker<PlayerID>(), ArithChecker<uint64_t>(0, UINT64_MAX)),
+                        MakeStageCommand("电脑预先计算行动", &SubStage::ToComputeDecisions_, VoidChecker("电脑预先计算")),
+                        MakeStageCommand("电脑预先计算行动并阻塞一次", &SubStage::ToBlockDecision_, VoidChecker("电脑阻塞计算")),
+                        MakeStageCommand("电脑行动时限时选择", &SubStage::ToChooseByTime_, VoidChecker("电脑限时选择")),
+                        MakeStageCommand("断言电脑选择之和", &SubStage::CheckComputerChoiceSum_, VoidChecker("电脑选择和"),
+                            ArithChecker<uint64_t>(0, UINT64_MAX)),
+                        MakeStageCommand("断言并清除电脑预先计算次数", &SubStage::CheckComputerDecisionCount_,
+                            VoidChecker("电脑计算次数"), ArithChecker<uint64_t>(0, UINT64_MAX)),
+                        MakeStageCommand("淘汰", &SubStage::Eliminate_, VoidChecker("淘汰")),
+                        MakeStageCommand("挂机", &SubStage::Hook_, VoidChecker("挂机"))
+                    };
+                })
     {}
 
     virtual void OnStageBegin() override
@@ -241,6 +276,33 @@ class SubStage : public SubGameStage<>
             reply() << "电脑行动失败，剩余次数" << (--to_computer_failed_[pid]);
             return StageErrCode::FAILED;
         }
+        if (to_choose_by_time_ && !Global().IsReady(pid)) {
+            computer_choice_sum_ += std::stoull(Global().ComputerChoice([] { return std::to_string(++g_computer_choice_num); }));
+        }
+        return StageErrCode::READY;
+    }
+
+    virtual std::optional<ComputerDecisionTask> PrepareComputerDecision(const PlayerID pid) override
+    {
+        if (!to_compute_decisions_) {
+            return std::nullopt;
+        }
+        return ComputerDecisionTask{
+            .compute_ = [this, to_block = std::exchange(to_block_decision_, false)]() -> ComputerDecision
+                {
+                    if (to_block) {
+                        BlockStage();
+                    }
+                    return std::to_string(++g_computer_choice_num);
+                },
+        };
+    }
+
+    virtual AtomReqErrCode OnComputerDecision(const PlayerID pid, const ComputerDecision& decision,
+            MsgSenderBase& reply) override
+    {
+        ++computer_decision_count_;
+        computer_choice_sum_ += std::stoull(decision);
         return StageErrCode::READY;
     }
 
@@ -331,6 +393,40 @@ class SubStage : public SubGameStage<>
         return StageErrCode::READY;
     }
 
+    AtomReqErrCode ToComputeDecisions_(const PlayerID pid, const bool is_public, MsgSenderBase& reply)
+    {
+        to_compute_decisions_ = true;
+        return StageErrCode::OK;
+    }
+
+    AtomReqErrCode ToBlockDecision_(const PlayerID pid, const bool is_public, MsgSenderBase& reply)
+    {
+        to_compute_decisions_ = true;
+        to_block_decision_ = true;
+        return StageErrCode::OK;
+    }
+
+    AtomReqErrCode ToChooseByTime_(const PlayerID pid, const bool is_public, MsgSenderBase& reply)
+    {
+        to_choose_by_time_ = true;
+        return StageErrCode::OK;
+    }
+
+    AtomReqErrCode CheckComputerChoiceSum_(const PlayerID pid, const bool is_public, MsgSenderBase& reply,
+            const uint64_t expected)
+    {
+        EXPECT_EQ(expected, computer_choice_sum_);
+        return StageErrCode::OK;
+    }
+
+    AtomReqErrCode CheckComputerDecisionCount_(const PlayerID pid, const bool is_public, MsgSenderBase& reply,
+            const uint64_t expected)
+    {
+        EXPECT_EQ(expected, computer_decision_count_);
+        computer_decision_count_ = 0;
+        return StageErrCode::OK;
+    }
+
     AtomReqErrCode Eliminate_(const PlayerID pid, const bool is_public, MsgSenderBase& reply)
     {
         Global().Eliminate(pid);
@@ -344,6 +440,11 @@ class SubStage : public SubGameStage<>
     }
 
     uint64_t computer_act_count_{0};
+    uint64_t computer_decision_count_{0};
+    bool to_compute_decisions_{false};
+    bool to_block_decision_{false};
+    bool to_choose_by_time_{false};
+    uint64_t computer_choice_sum_{0};
     bool to_reset_timer_{false};
     uint32_t to_reset_ready_{0};
     std::set<PlayerID> to_reset_others_ready_players_;
@@ -461,11 +562,39 @@ class TestBot : public testing::Test
     virtual void SetUp() override
     {
         g_fail_to_create_game = false;
+        g_load_module_count = 0;
+        g_loaded_module_num = 0;
+        g_prefetch_resources = false;
+        g_block_prefetching = false;
+        g_prefetch_count = 0;
+        g_ai_infos.clear();
         Timer::skip_timer_ = false;
+        ResetBot("");
+    }
+
+    MockDBManager& db_manager() { return *db_manager_; }
+
+  protected:
+    // Waits until the resources being prefetched are decoded.
+    void WaitPrefetchingFinish()
+    {
+        std::promise<void> promise;
+        bot_->prefetch_thread_pool().Submit([&promise] { promise.set_value(); }); // the tasks are run in order
+        promise.get_future().wait();
+    }
+
+    // Creating a new bot with the same journal path behaves like restarting the bot process.
+    void ResetBot(const std::string& journal_path)
+    {
+        bot_.reset(); // release the old bot first to close the journals
+        auto db_manager = std::make_unique<MockDBManager>();
+        db_manager_ = db_manager.get(); // the bot wraps it with a MetricsDBManager
         bot_.reset(new BotCtx(
                     "./", // game_path
                     "", // conf_path
                     "/tmp/lgtbot_test_bot", // image_path
+                    journal_path,
+                    "", // metrics_path
                     LGTBot_Callback{
                         .get_user_name = GetUserName,
                         .get_user_name_in_group = GetUserNameInGroup,
@@ -473,18 +602,16 @@ class TestBot : public testing::Test
                         .handle_messages = HandleMessages,
                     },
                     GameHandleMap{},
+                    nlohmann::json{}, // game_manifest
                     std::set<UserID>{k_admin_qq},
 #ifdef WITH_SQLITE
-                    std::make_unique<MockDBManager>(),
+                    std::move(db_manager),
 #endif
                     MutableBotOption{},
                     nlohmann::json{},
                     nullptr));
     }
 
-    MockDBManager& db_manager() { return *static_cast<MockDBManager*>(bot_->db_manager()); }
-
-  protected:
     template <uint64_t k_max_player, class MyMainStage = lgtbot::game::GAME_MODULE_NAME::MainStage>
     void AddGame(const char* const name)
     {
@@ -496,26 +623,28 @@ class TestBot : public testing::Test
         basic_info.description_ = "用来测试的游戏";
         basic_info.module_name_ = name;
         basic_info.rule_ = "没有规则";
-        basic_info.max_player_num_fn_ = [](const lgtbot::game::GameOptionsBase*) -> uint64_t { return k_max_player; };
-        basic_info.multiple_fn_ = [](const lgtbot::game::GameOptionsBase*) -> uint32_t { return 1; };
-        basic_info.handle_rule_command_fn_ = [](const char*) -> const char* { return nullptr; };
-        basic_info.handle_init_options_command_fn_ =
-            [](const char* const cmd, lgtbot::game::GameOptionsBase*, lgtbot::game::MutableGenericOptions*)
-                -> lgtbot::game::InitOptionsResult
-            {
-                const std::string_view cmd_sv{cmd};
-                if (cmd_sv.find("单机") != std::string_view::npos) {
-                    return lgtbot::game::InitOptionsResult::NEW_SINGLE_USER_MODE_GAME;
-                }
-                if (cmd_sv.find("多人") != std::string_view::npos) {
-                    return lgtbot::game::InitOptionsResult::NEW_MULTIPLE_USERS_MODE_GAME;
-                }
-                return lgtbot::game::InitOptionsResult::INVALID_INIT_OPTIONS_COMMAND;
-            };
 
-        bot_->game_handles().emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple(
-                    std::move(basic_info),
-                    GameHandle::InternalHandler{
+        const auto loader = []
+            {
+                ++g_load_module_count;
+                ++g_loaded_module_num;
+                return std::optional<GameHandle::InternalHandler>(GameHandle::InternalHandler{
+                        .max_player_num_fn_ = [](const lgtbot::game::GameOptionsBase*) -> uint64_t { return k_max_player; },
+                        .multiple_fn_ = [](const lgtbot::game::GameOptionsBase*) -> uint32_t { return 1; },
+                        .handle_rule_command_fn_ = [](const char*) -> const char* { return nullptr; },
+                        .handle_init_options_command_fn_ =
+                            [](const char* const cmd, lgtbot::game::GameOptionsBase*, lgtbot::game::MutableGenericOptions*)
+                                -> lgtbot::game::InitOptionsResult
+                            {
+                                const std::string_view cmd_sv{cmd};
+                                if (cmd_sv.find("单机") != std::string_view::npos) {
+                                    return lgtbot::game::InitOptionsResult::NEW_SINGLE_USER_MODE_GAME;
+                                }
+                                if (cmd_sv.find("多人") != std::string_view::npos) {
+                                    return lgtbot::game::InitOptionsResult::NEW_MULTIPLE_USERS_MODE_GAME;
+                                }
+                                return lgtbot::game::InitOptionsResult::INVALID_INIT_OPTIONS_COMMAND;
+                            },
                         .game_options_allocator_ = []() -> lgtbot::game::GameOptionsBase* { return new lgtbot::game::GAME_MODULE_NAME::GameOptions(); },
                         .game_options_deleter_ = [](const lgtbot::game::GameOptionsBase* const options) { delete options; },
                         .main_stage_allocator_ =
@@ -530,10 +659,18 @@ class TestBot : public testing::Test
                                 return new internal::MainStage(std::make_unique<MyMainStage>(StageUtility{*my_game_options, *generic_options, *match}));
                             },
                         .main_stage_deleter_ = [](const lgtbot::game::MainStageBase* const main_stage) { delete main_stage; },
-                        .mod_guard_ = [] {},
-                    },
-                    lgtbot::game::MutableGenericOptions{}
-                    ));
+                        .prefetch_resources_fn_ = !g_prefetch_resources ? nullptr : +[](const char*) -> uint32_t
+                            {
+                                ++g_prefetch_count;
+                                g_block_prefetching.wait(true);
+                                return 0;
+                            },
+                        .mod_guard_ = [] { --g_loaded_module_num; },
+                    });
+            };
+
+        bot_->game_handles().emplace(std::piecewise_construct, std::forward_as_tuple(name), std::forward_as_tuple(
+                    std::move(basic_info), loader, lgtbot::game::MutableGenericOptions{}));
     }
 
     static void SkipTimer()
@@ -573,6 +710,7 @@ class TestBot : public testing::Test
     }
 
     std::unique_ptr<BotCtx, void(*)(void*)> bot_{nullptr, &LGTBot_Release};
+    MockDBManager* db_manager_ = nullptr;
 
 };
 
@@ -1135,6 +1273,31 @@ TEST_F(TestBot, interrupt_private_without_mid)
   ASSERT_PRI_MSG(EC_MATCH_NEED_REQUEST_PUBLIC, k_admin_qq, "%中断");
 }
 
+TEST_F(TestBot, show_metrics)
+{
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "2", "#加入 1");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "准备");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CHECKOUT, "2", "准备");
+  const auto snapshots = bot_->metrics().HistogramSnapshots();
+  const auto count = [&](const std::string_view name)
+    {
+      const auto it = std::ranges::find(snapshots, name, [](const auto& snapshot) { return snapshot.first; });
+      return it == snapshots.end() ? 0 : it->second.count_;
+    };
+  ASSERT_EQ(5, count("request.private"));
+  ASSERT_EQ(2, count("match.request.测试游戏"));
+  ASSERT_EQ(2, count("stage.request.测试游戏"));
+  ASSERT_EQ(1, count("db.RecordMatch"));
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%性能");
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%性能 文字");
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%性能 清空");
+  ASSERT_EQ(1, bot_->metrics().HistogramSnapshots().size()); // only the request to clear
+  ASSERT_PRI_MSG(EC_REQUEST_NOT_ADMIN, "1", "%性能");
+}
+
 TEST_F(TestBot, interrupt_public_not_game)
 {
   AddGame<2>("测试游戏");
@@ -1247,6 +1410,46 @@ TEST_F(TestBot, set_computer_no_limit)
   ASSERT_PRI_MSG(EC_GAME_REQUEST_CHECKOUT, "1", "电脑行动次数 11");
 }
 
+TEST_F(TestBot, computer_decisions_are_computed_for_each_round)
+{
+  AddGame<5>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#替补至 5");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "电脑预先计算");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "全员重新准备 1");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "别人重新准备");
+  // The computers finish the second round, and then act in the third round in the same routine.
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CONTINUE, "1", "准备");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "电脑计算次数 8");
+}
+
+TEST_F(TestBot, terminate_during_computing_computer_decisions)
+{
+  AddGame<5>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#替补至 5");
+  ASSERT_PRI_MSG(EC_OK, "2", "#加入 1");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "电脑阻塞计算");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "别人重新准备");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "2", "别人重新准备");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "准备");
+
+  // The users are still ready in the second round, so the game would be over once the computers act.
+  auto fut = std::async([this]
+        {
+            ASSERT_PRI_MSG(EC_GAME_REQUEST_CONTINUE, "2", "准备");
+        });
+  WaitSubStageBlock();
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%中断 1");
+  NotifySubStage();
+  fut.wait();
+
+  ASSERT_TRUE(db_manager().match_profiles_.empty());
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+}
+
 TEST_F(TestBot, set_computer_not_host)
 {
   AddGame<5>("测试游戏");
@@ -1779,6 +1982,387 @@ TEST_F(TestBot, get_achievement)
   ASSERT_EQ("普通成就", db_manager().user_achievements_[UserID("2")][1]);
 }
 
+// Recover Match
+
+static const char* const k_journal_path = "/tmp/lgtbot_test_bot_journal";
+
+static std::vector<std::string> JournalFilenames()
+{
+  std::vector<std::string> filenames;
+  for (const auto& entry : std::filesystem::directory_iterator(k_journal_path)) {
+    filenames.emplace_back(entry.path().string());
+  }
+  return filenames;
+}
+
+static bool IsTimeoutJournaled()
+{
+  for (const auto& filename : JournalFilenames()) {
+    for (const auto& record : ReadJournal(filename)) {
+      if (nlohmann::json::parse(record)["type"] == "timeout") {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+TEST_F(TestBot, recover_match_after_restart)
+{
+  std::filesystem::remove_all(k_journal_path);
+  std::filesystem::create_directories(k_journal_path);
+  ResetBot(k_journal_path);
+  AddGame<3>("测试游戏");
+  ASSERT_PUB_MSG(EC_OK, "1", "1", "#新游戏 测试游戏");
+  ASSERT_PUB_MSG(EC_GAME_REQUEST_OK, "1", "1", "时限 10");
+  ASSERT_PUB_MSG(EC_OK, "1", "2", "#加入");
+  ASSERT_PUB_MSG(EC_OK, "1", "3", "#加入");
+  ASSERT_PUB_MSG(EC_OK, "1", "1", "#开始");
+  ASSERT_EQ(1, JournalFilenames().size());
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "准备切换 1");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "分数 3");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "2", "分数 2");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CHECKOUT, "1", "结束子阶段");
+  ASSERT_PUB_MSG(EC_OK, "1", "3", "#退出 强制");
+
+  ResetBot(k_journal_path);
+  AddGame<3>("测试游戏");
+  ASSERT_EQ(1, bot_->match_manager().RecoverMatches());
+  ASSERT_PUB_MSG(EC_MATCH_ALREADY_BEGIN, "1", "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "3", "#新游戏 测试游戏"); // the user has left before restarting
+  ASSERT_PRI_MSG(EC_OK, "3", "#退出");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "准备");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CHECKOUT, "2", "准备"); // the second substage is over
+  ASSERT_EQ(3, db_manager().match_profiles_.size());
+  ASSERT_EQ(3, db_manager().match_profiles_[0].game_score_);
+  ASSERT_EQ(2, db_manager().match_profiles_[1].game_score_);
+  ASSERT_TRUE(JournalFilenames().empty()); // the journal is removed after the game is over
+}
+
+TEST_F(TestBot, recover_match_with_timeout)
+{
+  std::filesystem::remove_all(k_journal_path);
+  std::filesystem::create_directories(k_journal_path);
+  ResetBot(k_journal_path);
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "时限 10");
+  ASSERT_PRI_MSG(EC_OK, "2", "#加入 1");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "准备切换 1");
+
+  auto fut = std::async([this]
+        {
+            ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "阻塞");
+        });
+  WaitSubStageBlock();
+  SkipTimer();
+  WaitBeforeHandleTimeout(UserID{"1"});
+  BlockTimer(); // prevent timeout of the next substage
+  NotifySubStage();
+  fut.wait();
+  while (!IsTimeoutJournaled()); // now the first substage is over
+
+  ResetBot(k_journal_path);
+  AddGame<2>("测试游戏");
+  // The journaled request blocks again when replaying.
+  auto recover_fut = std::async([this] { return bot_->match_manager().RecoverMatches(); });
+  WaitSubStageBlock();
+  NotifySubStage();
+  ASSERT_EQ(1, recover_fut.get());
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "准备");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CHECKOUT, "2", "准备"); // the second substage is over
+  ASSERT_EQ(2, db_manager().match_profiles_.size());
+}
+
+TEST_F(TestBot, recover_match_with_computers)
+{
+  std::filesystem::remove_all(k_journal_path);
+  std::filesystem::create_directories(k_journal_path);
+  ResetBot(k_journal_path);
+  AddGame<5>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#替补至 5");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "电脑预先计算");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "全员重新准备 1");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "别人重新准备");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CONTINUE, "1", "准备");
+
+  ResetBot(k_journal_path);
+  AddGame<5>("测试游戏");
+  ASSERT_EQ(1, bot_->match_manager().RecoverMatches());
+  // The computed decisions are applied again when replaying.
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "电脑计算次数 8");
+}
+
+TEST_F(TestBot, recover_match_with_computer_choices_bounded_by_time)
+{
+  std::filesystem::remove_all(k_journal_path);
+  std::filesystem::create_directories(k_journal_path);
+  ResetBot(k_journal_path);
+  AddGame<5>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#替补至 5");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+  const uint64_t choice_num = g_computer_choice_num;
+  // The computers choose in `OnComputerAct` in the second round.
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "电脑限时选择");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "全员重新准备 1");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CONTINUE, "1", "准备");
+  // The computers compute decisions in the third round.
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "电脑预先计算");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "全员重新准备 1");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CONTINUE, "1", "准备");
+  ASSERT_EQ(choice_num + 8, g_computer_choice_num);
+  const std::string check_sum_msg = "电脑选择和 " + std::to_string(choice_num * 8 + 36);
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", check_sum_msg.c_str());
+
+  ResetBot(k_journal_path);
+  AddGame<5>("测试游戏");
+  ASSERT_EQ(1, bot_->match_manager().RecoverMatches());
+  // The journaled choices and decisions are taken without choosing or computing again.
+  ASSERT_EQ(choice_num + 8, g_computer_choice_num);
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", check_sum_msg.c_str());
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "电脑计算次数 4");
+}
+
+TEST_F(TestBot, recover_match_failed_when_replay_diverges)
+{
+  std::filesystem::remove_all(k_journal_path);
+  std::filesystem::create_directories(k_journal_path);
+  ResetBot(k_journal_path);
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "2", "#加入 1");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "准备切换 1");
+
+  ResetBot(k_journal_path);
+  AddGame<2, lgtbot::game::GAME_MODULE_NAME::AtomMainStage>("测试游戏"); // the game has changed
+  ASSERT_EQ(0, bot_->match_manager().RecoverMatches());
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_TRUE(JournalFilenames().empty());
+}
+
+TEST_F(TestBot, keep_journal_when_game_not_loaded)
+{
+  std::filesystem::remove_all(k_journal_path);
+  std::filesystem::create_directories(k_journal_path);
+  ResetBot(k_journal_path);
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "2", "#加入 1");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+
+  ResetBot(k_journal_path);
+  ASSERT_EQ(0, bot_->match_manager().RecoverMatches());
+  ASSERT_EQ(1, JournalFilenames().size());
+
+  ResetBot(k_journal_path);
+  AddGame<2>("测试游戏");
+  ASSERT_EQ(1, bot_->match_manager().RecoverMatches());
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_OK, "1", "准备");
+  ASSERT_PRI_MSG(EC_GAME_REQUEST_CHECKOUT, "2", "准备");
+}
+
+// Game Module Loading
+
+TEST_F(TestBot, load_game_module_when_used)
+{
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#规则 测试游戏"); // the rule is cached in the game handle
+  ASSERT_EQ(0, g_load_module_count);
+  ASSERT_PRI_MSG(EC_OK, "1", "#游戏列表 文字"); // load to compute the summary of default options
+  ASSERT_EQ(1, g_load_module_count);
+  ASSERT_EQ(1, bot_->UnloadIdleGameModules(std::chrono::steady_clock::duration::zero()));
+  ASSERT_EQ(0, g_loaded_module_num);
+  ASSERT_PRI_MSG(EC_OK, "1", "#游戏列表 文字");
+  ASSERT_EQ(1, g_load_module_count);
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "2", "#新游戏 测试游戏");
+  ASSERT_EQ(2, g_load_module_count); // the module is shared by matches
+  ASSERT_EQ(1, g_loaded_module_num);
+}
+
+TEST_F(TestBot, unload_game_module_when_no_match_uses_it)
+{
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_EQ(0, bot_->UnloadIdleGameModules(std::chrono::steady_clock::duration::zero()));
+  ASSERT_EQ(1, g_loaded_module_num);
+  ASSERT_PRI_MSG(EC_OK, "1", "#退出");
+  ASSERT_EQ(0, bot_->UnloadIdleGameModules(std::chrono::hours(1)));
+  ASSERT_EQ(1, bot_->UnloadIdleGameModules(std::chrono::steady_clock::duration::zero()));
+  ASSERT_EQ(0, g_loaded_module_num);
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_EQ(2, g_load_module_count);
+}
+
+TEST_F(TestBot, keep_default_options_after_unloading_game_module)
+{
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%配置 测试游戏 直接结束");
+  ASSERT_EQ(1, bot_->UnloadIdleGameModules(std::chrono::steady_clock::duration::zero()));
+  ASSERT_PRI_MSG(EC_OK, "1", "#游戏列表 文字"); // the summary is updated when setting the option
+  ASSERT_EQ(1, g_load_module_count);
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏 单机"); // game starts then finishes immediately
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_EQ(2, g_load_module_count);
+}
+
+TEST_F(TestBot, preset_invalid_default_option)
+{
+  AddGame<2>("测试游戏");
+  bot_->game_handles().at("测试游戏").PresetDefaultOption("时限", "时限 100");
+  ASSERT_EQ(0, g_load_module_count);
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏"); // the invalid option is dropped when loading the module
+}
+
+TEST_F(TestBot, reload_game_module_when_match_is_running)
+{
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  auto& game_handle = bot_->game_handles().at("测试游戏");
+  auto basic_info = *game_handle.Info();
+  basic_info.rule_ = "新的规则";
+  ASSERT_TRUE(game_handle.Reload(std::move(basic_info)));
+  ASSERT_EQ(2, g_load_module_count);
+  ASSERT_EQ(2, g_loaded_module_num); // the old version is still used by the match
+  ASSERT_EQ("新的规则", game_handle.Info()->rule_);
+  ASSERT_PRI_MSG(EC_OK, "1", "#退出");
+  ASSERT_EQ(1, g_loaded_module_num);
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_EQ(2, g_load_module_count);
+}
+
+TEST_F(TestBot, skip_prefetching_resources_in_flight)
+{
+  g_prefetch_resources = true;
+  g_block_prefetching = true;
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "2", "#新游戏 测试游戏"); // the module is being prefetched for the first match
+  g_block_prefetching = false;
+  g_block_prefetching.notify_all();
+  WaitPrefetchingFinish();
+  ASSERT_EQ(1, g_prefetch_count);
+  ASSERT_PRI_MSG(EC_OK, "3", "#新游戏 测试游戏");
+  WaitPrefetchingFinish();
+  ASSERT_EQ(2, g_prefetch_count);
+}
+
+TEST_F(TestBot, reload_game_module_without_game_path)
+{
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_REQUEST_NOT_ADMIN, "1", "%重载 测试游戏");
+  ASSERT_PRI_MSG(EC_REQUEST_UNKNOWN_GAME, k_admin_qq, "%重载 未知游戏");
+  ASSERT_PRI_MSG(EC_GAME_LOAD_FAILED, k_admin_qq, "%重载 测试游戏");
+}
+
+TEST_F(TestBot, send_binary_ai_info)
+{
+  bot_->callbacks_.handle_ai_info = HandleAiInfo;
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%全局配置 AI列表 2");
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%配置 测试游戏 直接结束");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏 单机"); // no AI players
+  ASSERT_TRUE(g_ai_infos.empty());
+  ASSERT_PRI_MSG(EC_OK, "2", "#新游戏 测试游戏 单机"); // game starts then finishes immediately
+  ASSERT_EQ(2, g_ai_infos.size());
+  for (const auto& info : g_ai_infos) {
+    ASSERT_EQ(std::vector<std::string>{"2"}, info.user_ids_);
+    const auto header = ai_info::ParseHeader(info.data_);
+    ASSERT_TRUE(header.has_value());
+    ASSERT_EQ(ai_info::Kind::MATCH_STATE, header->kind_);
+  }
+  ai_info::Decoder decoder;
+  ASSERT_EQ("started", decoder.Decode(g_ai_infos[0].data_).value()["state"]);
+  ASSERT_EQ("finished", decoder.Decode(g_ai_infos[1].data_).value()["state"]);
+}
+
+TEST_F(TestBot, coalesce_messages_sent_in_request)
+{
+  AddGame<2>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%配置 测试游戏 直接结束");
+  g_send_count = 0;
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏 单机"); // game starts then finishes immediately
+  const uint64_t send_count = g_send_count;
+  ASSERT_PRI_MSG(EC_OK, k_admin_qq, "%全局配置 合并发送消息 开启");
+  g_send_count = 0;
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏 单机");
+  ASSERT_LT(g_send_count, send_count);
+  ASSERT_EQ(send_count - g_send_count, bot_->metrics().Counter("msg.sends_saved").Get());
+}
+
+TEST_F(TestBot, DISABLED_benchmark_handle_game_requests)
+{
+  // Each request passes the main stage and the sub stage, and both of them log it.
+  constexpr uint64_t k_request_num = 10000;
+  AddGame<2>("测试游戏");
+  ASSERT_PUB_MSG(EC_OK, "1", "1", "#新游戏 测试游戏");
+  ASSERT_PUB_MSG(EC_OK, "1", "2", "#加入");
+  ASSERT_PUB_MSG(EC_OK, "1", "1", "#开始");
+  const auto begin = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < k_request_num; ++i) {
+    ASSERT_EQ(EC_GAME_REQUEST_OK, LGTBot_HandlePublicRequest(bot_.get(), "1", "1", "重新计时"));
+  }
+  const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+  std::cout << "Benchmark: handle " << k_request_num << " game requests, " << cost.count() / k_request_num
+            << "ns per request on average" << std::endl;
+}
+
+TEST_F(TestBot, DISABLED_benchmark_recover_match)
+{
+  // Each request is followed by the acts of computers, which are journaled as well.
+  constexpr uint64_t k_request_num = 10000;
+  std::filesystem::remove_all(k_journal_path);
+  std::filesystem::create_directories(k_journal_path);
+  ResetBot(k_journal_path);
+  AddGame<3>("测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#新游戏 测试游戏");
+  ASSERT_PRI_MSG(EC_OK, "1", "#替补至 3");
+  ASSERT_PRI_MSG(EC_OK, "1", "#开始");
+  for (uint64_t i = 0; i < k_request_num; ++i) {
+    ASSERT_EQ(EC_GAME_REQUEST_OK, LGTBot_HandlePrivateRequest(bot_.get(), "1", "重新计时"));
+  }
+  ASSERT_EQ(1, JournalFilenames().size());
+  const uint64_t record_num = ReadJournal(JournalFilenames().front()).size();
+
+  ResetBot(k_journal_path);
+  AddGame<3>("测试游戏");
+  const auto begin = std::chrono::steady_clock::now();
+  ASSERT_EQ(1, bot_->match_manager().RecoverMatches());
+  const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+  std::cout << "Benchmark: recover a match of " << record_num << " records, " << cost.count() / record_num
+            << "ns per record on average" << std::endl;
+}
+
+TEST(TestStage, DISABLED_benchmark_create_round_stages)
+{
+  // A 50-round game creates one sub stage per round. Only the first one builds the command table.
+  constexpr uint64_t k_round_num = 50;
+  MockMatch match(std::filesystem::temp_directory_path(), 2);
+  lgtbot::game::GAME_MODULE_NAME::GameOptions game_options;
+  lgtbot::game::GenericOptions generic_options;
+  generic_options.user_num_ = 2;
+  lgtbot::game::GAME_MODULE_NAME::MainStage main_stage(
+          lgtbot::game::GAME_MODULE_NAME::StageUtility{game_options, generic_options, match});
+  const auto create_stage = [&]
+      {
+        const auto begin = std::chrono::steady_clock::now();
+        lgtbot::game::GAME_MODULE_NAME::SubStage sub_stage(main_stage);
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+      };
+  const auto first_round = create_stage();
+  std::chrono::nanoseconds other_rounds{0};
+  for (uint64_t i = 1; i < k_round_num; ++i) {
+    other_rounds += create_stage();
+  }
+  std::cout << "Benchmark: create " << k_round_num << " round stages, first round " << first_round.count()
+            << "ns, other rounds " << other_rounds.count() / (k_round_num - 1) << "ns on average" << std::endl;
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
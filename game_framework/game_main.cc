@@ -12,7 +12,9 @@
 #include "game_framework/game_achievements.h" // for k_achievements
 #include "game_framework/util.h"
 #include "game_framework/stage.h"
+#include "utility/log.h"
 #include "utility/msg_checker.h"
+#include "utility/sprite_grid.h"
 
 #ifndef GAME_MODULE_NAME
 #error GAME_MODULE_NAME is not defined
@@ -138,4 +140,18 @@ lgtbot::game::InitOptionsResult HandleInitOptionsCommand(const char* const s,
     return lgtbot::game::INVALID_INIT_OPTIONS_COMMAND;
 }
 
+// The sprites are cached in this module, so they must be decoded here rather than in bot_core.
+uint32_t PrefetchResources(const char* const resource_dir)
+{
+    return html::SpriteCache::Instance().Prefetch(resource_dir, this_module::k_properties.resources_);
+}
+
+#if WITH_GLOG
+// The logs of this module are written by the logger of the process, rather than a logging thread of its own.
+void ShareAsyncLogger(AsyncLogger* const logger)
+{
+    ShareGlobalAsyncLogger(logger);
+}
+#endif
+
 } // extern "c"
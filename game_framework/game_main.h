@@ -150,6 +150,17 @@ class MainStageBase : virtual public StageBase
     virtual int64_t PlayerScore(const PlayerID pid) const = 0;
 
     virtual const char* const* VerdictateAchievements(const PlayerID pid) const = 0;
+
+    // Decisions of computers for the current atomic stage can be computed without holding the match lock:
+    // 1. `PrepareComputerDecision` is invoked for each computer under the lock. It starts computing the decision and
+    //    returns true, or returns false if the computer has nothing to compute.
+    // 2. `ComputeComputerDecisions` is invoked without the lock. It waits until all decisions are computed or their
+    //    budgets run out.
+    // 3. `ApplyComputerDecisions` is invoked under the lock. The computed decisions are taken by the following
+    //    `HandleComputerAct` invocations.
+    virtual bool PrepareComputerDecision(const uint64_t pid) = 0;
+    virtual void ComputeComputerDecisions() = 0;
+    virtual void ApplyComputerDecisions() = 0;
 };
 
 } // namespace game
@@ -19,6 +19,8 @@ struct GameProperties
     const char* developer_;          // The game developer which can be shown in the game list image.
     const char* description_;        // The game description which can be shown in the game list image.
     bool shuffled_player_id_{false}; // The true value indicates each user may be assigned with different player IDs in different matches
+    const char* const* resources_{nullptr}; // The PNG files in the resource directory which are decoded in advance when a
+                                            // match is created. The array is terminated by nullptr.
 };
 
 } // namespace game
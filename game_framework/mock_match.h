@@ -6,6 +6,7 @@
 
 #include <memory>
 #include <optional>
+#include <random>
 
 #include "bot_core/match_base.h"
 #include "bot_core/msg_sender.h"
@@ -98,10 +99,12 @@ class MockMsgSender : public MsgSenderBase
 class MockMatch : public MatchBase
 {
   public:
-    MockMatch(const std::filesystem::path& image_dir, const uint64_t player_num)
+    MockMatch(const std::filesystem::path& image_dir, const uint64_t player_num,
+            const uint64_t seed = std::random_device{}())
         : image_dir_(image_dir.string())
         , boardcast_sender_(image_dir_)
-        , is_eliminated_(player_num, false) {}
+        , is_eliminated_(player_num, false)
+        , seed_(seed) {}
 
     virtual ~MockMatch() {}
 
@@ -120,6 +123,10 @@ class MockMatch : public MatchBase
 
     virtual MsgSenderBase& BoardcastAiInfoMsgSender() override { return boardcast_sender_; }
 
+    virtual AiInfoChannel GetAiInfoChannel() const override { return AiInfoChannel::TEXT; }
+
+    virtual void BoardcastBinaryAiInfo(const char* const data, const uint64_t size) override {}
+
     virtual const char* PlayerName(const PlayerID& pid) override
     {
         thread_local static std::string str;
@@ -139,8 +146,20 @@ class MockMatch : public MatchBase
 
     virtual void Activate(const PlayerID pid) override {}
 
+    virtual void JournalComputerDecision(const char* const decision) override {}
+
+    virtual void JournalComputerChoice(const char* const choice) override {}
+
+    virtual const char* ReplayedComputerDecision() override { return nullptr; }
+
+    virtual const char* NextReplayedComputerChoice() override { return nullptr; }
+
     virtual bool IsInDeduction() const override { return false; }
 
+    virtual bool IsReplaying() const override { return false; }
+
+    virtual uint64_t RandomSeed() const override { return seed_; }
+
     virtual uint64_t MatchId() const override
     {
         static uint64_t match_id = 0;
@@ -158,5 +177,6 @@ class MockMatch : public MatchBase
     MockMsgSender boardcast_sender_;
     std::map<uint64_t, MockMsgSender> tell_senders_;
     std::vector<bool> is_eliminated_;
+    const uint64_t seed_;
 };
 
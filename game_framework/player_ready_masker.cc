@@ -7,13 +7,15 @@
 #include "utility/log.h"
 
 #include <cassert>
-#include <numeric>
 #include <algorithm>
 
 #ifndef GAME_MODULE_NAME
 #error GAME_MODULE_NAME is not defined
 #endif
 
+// `ToString_()` is evaluated only if the log is enabled.
+#define MASKER_LOG(level) LAZY_LOG(level, Log_(level##Log()))
+
 namespace lgtbot {
 
 namespace game {
@@ -23,7 +25,10 @@ namespace GAME_MODULE_NAME {
 namespace internal {
 
 PlayerReadyMasker::PlayerReadyMasker(const uint64_t match_id, const char* const game_name, const size_t size)
-    : states_(size), log_header_{"[mid=" + std::to_string(match_id) + "] [game=" + game_name + "] "}
+    : ready_(size, false)
+    , temporarily_inactive_(size, false)
+    , permanently_inactive_(size, false)
+    , log_header_{"[mid=" + std::to_string(match_id) + "] [game=" + game_name + "] "}
 {
 }
 
@@ -31,39 +36,39 @@ PlayerReadyMasker::PlayerReadyMasker(const uint64_t match_id, const char* const
 //       We can remove this function and check whether the player is controlled by a computer in `SetReady`.
 void PlayerReadyMasker::SilentlySetReady(const size_t index)
 {
-    Log_(DebugLog()) << "Begin setting ready silently, index: " << index << ", " << ToString_();
-    states_[index].is_ready_ = true;
+    MASKER_LOG(Debug) << "Begin setting ready silently, index: " << index << ", " << ToString_();
+    Update_(index, [&] { ready_[index] = true; });
     // We do not set `any_ready_` flag when computers completing actions. The reason is computers act before users. If
     // all users are temporarily inactive, we should ensure one of them have the opportunity to take action again. By
     // not setting this flag, stage will not be checked out until timeout or one of the user take action again.
-    Log_(DebugLog()) << "Finish setting ready silently, index: " << index << ", " << ToString_();
+    MASKER_LOG(Debug) << "Finish setting ready silently, index: " << index << ", " << ToString_();
 }
 
 void PlayerReadyMasker::SetReady(const size_t index)
 {
-    Log_(DebugLog()) << "Begin setting ready, index: " << index << ", " << ToString_();
+    MASKER_LOG(Debug) << "Begin setting ready, index: " << index << ", " << ToString_();
     any_ready_ = true;
-    states_[index].is_ready_ = true;
-    Log_(DebugLog()) << "Finish setting ready, index: " << index << ", " << ToString_();
+    Update_(index, [&] { ready_[index] = true; });
+    MASKER_LOG(Debug) << "Finish setting ready, index: " << index << ", " << ToString_();
 }
 
 void PlayerReadyMasker::UnsetReady(const size_t index)
 {
-    Log_(DebugLog()) << "Begin unsetting ready, index: " << index << ", " << ToString_();
-    states_[index].is_ready_ = false;
+    MASKER_LOG(Debug) << "Begin unsetting ready, index: " << index << ", " << ToString_();
+    Update_(index, [&] { ready_[index] = false; });
     // If the unset ready player is temporarily inactive, we need wait for him until timeout.
     any_ready_ = false;
-    Log_(DebugLog()) << "Finish unsetting ready, index: " << index << ", " << ToString_();
+    MASKER_LOG(Debug) << "Finish unsetting ready, index: " << index << ", " << ToString_();
 }
 
 void PlayerReadyMasker::ClearReady()
 {
-    Log_(DebugLog()) << "Begin clearing ready, " << ToString_();
-    for (auto& state : states_) {
-        state.is_ready_ = false;
-    }
+    MASKER_LOG(Debug) << "Begin clearing ready, " << ToString_();
+    std::fill(ready_.begin(), ready_.end(), false);
+    ready_or_inactive_num_ = inactive_num_;
+    ready_or_permanently_inactive_num_ = permanently_inactive_num_;
     any_ready_ = false;
-    Log_(DebugLog()) << "Finish clearing ready, " << ToString_();
+    MASKER_LOG(Debug) << "Finish clearing ready, " << ToString_();
 }
 
 void PlayerReadyMasker::SetTemporaryInactive(const size_t index)
@@ -74,20 +79,19 @@ void PlayerReadyMasker::SetTemporaryInactive(const size_t index)
 void PlayerReadyMasker::SetPermanentInactive(const size_t index)
 {
     Inactivate_(index, ActiveState::PERMANENTLY_INACTIVE);
-    if (std::ranges::all_of(states_, [](const State state) { return state.active_state_ == ActiveState::PERMANENTLY_INACTIVE; })) {
+    if (permanently_inactive_num_ == ready_.size()) {
         is_all_permanent_inactive_ = true;
-        Log_(WarnLog()) << "Begin deduction, index: " << index << ", " << ToString_();
+        MASKER_LOG(Warn) << "Begin deduction, index: " << index << ", " << ToString_();
     }
 }
 
 bool PlayerReadyMasker::SetActive(const size_t index)
 {
-    auto& state = states_[index];
-    assert(state.active_state_ != ActiveState::PERMANENTLY_INACTIVE);
-    if (state.active_state_ == ActiveState::TEMPORARILY_INACTIVE) {
-        Log_(DebugLog()) << "Begin setting active, index: " << index << ", " << ToString_();
-        state.active_state_ = ActiveState::ACTIVE;
-        Log_(DebugLog()) << "Finish setting active, index: " << index << ", " << ToString_();
+    assert(!permanently_inactive_[index]);
+    if (temporarily_inactive_[index]) {
+        MASKER_LOG(Debug) << "Begin setting active, index: " << index << ", " << ToString_();
+        Update_(index, [&] { temporarily_inactive_[index] = false; });
+        MASKER_LOG(Debug) << "Finish setting active, index: " << index << ", " << ToString_();
         return true;
     }
     return false;
@@ -95,44 +99,48 @@ bool PlayerReadyMasker::SetActive(const size_t index)
 
 bool PlayerReadyMasker::Ok() const
 {
-    static const auto ready_or_permanent_inactive =
-        [](const State state) { return state.active_state_ == ActiveState::PERMANENTLY_INACTIVE || state.is_ready_; };
-    static const auto ready_or_inactive =
-        [](const State state) { return state.active_state_ != ActiveState::ACTIVE || state.is_ready_; };
-    return is_all_permanent_inactive_ || std::ranges::all_of(states_, ready_or_permanent_inactive) ||
-        (std::ranges::all_of(states_, ready_or_inactive) && any_ready_);
+    return is_all_permanent_inactive_ || ready_or_permanently_inactive_num_ == ready_.size() ||
+        (ready_or_inactive_num_ == ready_.size() && any_ready_);
+}
+
+void PlayerReadyMasker::Count_(const size_t index, const int delta)
+{
+    const bool is_permanently_inactive = permanently_inactive_[index];
+    const bool is_inactive = is_permanently_inactive || temporarily_inactive_[index];
+    permanently_inactive_num_ += delta * is_permanently_inactive;
+    inactive_num_ += delta * is_inactive;
+    ready_or_inactive_num_ += delta * (ready_[index] || is_inactive);
+    ready_or_permanently_inactive_num_ += delta * (ready_[index] || is_permanently_inactive);
 }
 
 void PlayerReadyMasker::Inactivate_(const size_t index, const ActiveState new_active_state)
 {
     assert(new_active_state != ActiveState::ACTIVE);
-    auto& active_state = states_[index].active_state_;
-    if (active_state == ActiveState::ACTIVE) {
-        Log_(DebugLog()) << "Inactivate game stage mask begin index: " << index << ", " << ToString_();
+    if (ActiveState_(index) == ActiveState::ACTIVE) {
+        MASKER_LOG(Debug) << "Inactivate game stage mask begin index: " << index << ", " << ToString_();
         any_ready_ = true;
-        Log_(DebugLog()) << "Inactivate game stage mask finish index: " << index << ", " << ToString_();
+        MASKER_LOG(Debug) << "Inactivate game stage mask finish index: " << index << ", " << ToString_();
     }
-    active_state = new_active_state;
+    Update_(index, [&]
+            {
+                temporarily_inactive_[index] = new_active_state == ActiveState::TEMPORARILY_INACTIVE;
+                permanently_inactive_[index] = new_active_state == ActiveState::PERMANENTLY_INACTIVE;
+            });
 }
 
-std::string PlayerReadyMasker::StateToString_(const PlayerReadyMasker::State state)
+std::string PlayerReadyMasker::ToString_() const
 {
     constexpr const char* k_active_state_strs[] = {
         [static_cast<std::underlying_type_t<ActiveState>>(ActiveState::ACTIVE)] = "",
         [static_cast<std::underlying_type_t<ActiveState>>(ActiveState::TEMPORARILY_INACTIVE)] = ", temp_inactive",
         [static_cast<std::underlying_type_t<ActiveState>>(ActiveState::PERMANENTLY_INACTIVE)] = ", inactive",
     };
-    return "ready: " + std::to_string(state.is_ready_) +
-        k_active_state_strs[static_cast<std::underlying_type_t<ActiveState>>(state.active_state_)];
-}
-
-std::string PlayerReadyMasker::ToString_()
-{
-    return std::accumulate(states_.begin(), states_.end(), std::string{},
-            [i = 0](std::string str, const State state) mutable
-            {
-                return std::move(str) + "[" + std::to_string(i++) + "] {" + StateToString_(state) + "}, ";
-            }) + "any_ready: " + std::to_string(any_ready_);
+    std::string str;
+    for (size_t i = 0; i < ready_.size(); ++i) {
+        str += "[" + std::to_string(i) + "] {ready: " + std::to_string(ready_[i]) +
+            k_active_state_strs[static_cast<std::underlying_type_t<ActiveState>>(ActiveState_(i))] + "}, ";
+    }
+    return str + "any_ready: " + std::to_string(any_ready_);
 }
 
 } // namespace internal
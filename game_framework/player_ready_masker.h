@@ -21,6 +21,9 @@ namespace GAME_MODULE_NAME {
 namespace internal {
 
 // `PlayerReadyMasker` records which players have completed actions and which players are not able to act.
+//
+// The states are stored as bits, and the numbers of players in each state are counted along with changes, so each
+// change and `Ok` take constant time no matter how many players there are.
 class PlayerReadyMasker
 {
     enum class ActiveState
@@ -30,13 +33,6 @@ class PlayerReadyMasker
         PERMANENTLY_INACTIVE,  // The player is Permanently unable to act. We no longer need not to wait his action.
     };
 
-    struct State
-    {
-        bool is_ready_ = false;  // Whether the player has finished current stage's action.
-                                 // `is_ready_` can be true even if `active_state_` is not `ACTIVE` because the `is_ready_` flag can be set by stage.
-        ActiveState active_state_ = ActiveState::ACTIVE;
-    };
-
   public:
     PlayerReadyMasker(const uint64_t match_id, const char* const game_name, const size_t size);
 
@@ -56,25 +52,49 @@ class PlayerReadyMasker
     // check
 
     bool IsAllPermanentInactive() const { return is_all_permanent_inactive_; }
-    bool IsReady(const size_t index) const { return states_[index].is_ready_; }
-    bool IsInactive(const size_t index) const { return states_[index].active_state_ != ActiveState::ACTIVE; }
-    bool IsTemporaryInactive(const size_t index) const { return states_[index].active_state_ == ActiveState::TEMPORARILY_INACTIVE; }
+    bool IsReady(const size_t index) const { return ready_[index]; }
+    bool IsInactive(const size_t index) const { return ActiveState_(index) != ActiveState::ACTIVE; }
+    bool IsTemporaryInactive(const size_t index) const { return ActiveState_(index) == ActiveState::TEMPORARILY_INACTIVE; }
 
     // The returned value of true indicates we no longer need to wait more players to get ready.
     bool Ok() const;
 
   private:
+    ActiveState ActiveState_(const size_t index) const
+    {
+        return permanently_inactive_[index] ? ActiveState::PERMANENTLY_INACTIVE :
+               temporarily_inactive_[index] ? ActiveState::TEMPORARILY_INACTIVE : ActiveState::ACTIVE;
+    }
+
+    // Changes the state of the player by `fn` and updates the counts.
+    template <typename Fn>
+    void Update_(const size_t index, Fn&& fn)
+    {
+        Count_(index, -1);
+        fn();
+        Count_(index, 1);
+    }
+    void Count_(const size_t index, const int delta);
+
     void Inactivate_(const size_t index, const ActiveState new_active_state);
 
-    static std::string StateToString_(const State state);
-    std::string ToString_();
+    std::string ToString_() const;
 
     template <typename Logger>
     auto& Log_(Logger&& logger) { return logger << log_header_; }
 
-    std::vector<State> states_;
+    // `ready_[index]` can be true even if the player is inactive because the ready flag can be set by stage.
+    std::vector<bool> ready_;
+    std::vector<bool> temporarily_inactive_;
+    std::vector<bool> permanently_inactive_;
+
+    size_t inactive_num_{0};
+    size_t permanently_inactive_num_{0};
+    size_t ready_or_inactive_num_{0};
+    size_t ready_or_permanently_inactive_num_{0};
+
     bool any_ready_{false};                  // be true if any user complete action
-    bool is_all_permanent_inactive_{false};  // not necessary, to prevent always checking all ready flags
+    bool is_all_permanent_inactive_{false};
     std::string log_header_;
 };
 
@@ -23,6 +23,8 @@ DEFINE_string(resource_dir, "./resource_dir/", "The path of game image resources
 DEFINE_bool(gen_image, false, "Whether generate image or not");
 DEFINE_string(image_dir, "./.lgtbot_image/", "The path of directory to store generated images");
 DEFINE_bool(input_options, false, "Input the game options by stdin");
+DEFINE_bool(benchmark, false, "Print the elapsed time and the throughput of running games");
+DEFINE_bool(deduction, false, "Run games in the deduction mode, in which messages and images are not generated");
 
 extern bool enable_markdown_to_image;
 
@@ -43,6 +45,8 @@ class RunGameMockMatch : public MockMatch
             std::to_string(size) + "px; border-radius:50%; vertical-align: middle;\"/>";
         return str.c_str();
     }
+
+    virtual bool IsInDeduction() const override { return FLAGS_deduction; }
 };
 
 struct SkipTestException : public std::runtime_error
@@ -145,12 +149,27 @@ std::unique_ptr<internal::MainStage> StartMainStage(Options& options, RunGameMoc
     return main_stage;
 }
 
+void ComputeComputerDecisions(const Options& options, const RunGameMockMatch& match, MainStageBase& main_stage)
+{
+    bool has_decision = false;
+    for (uint64_t i = 0; i < options.generic_options_.bench_computers_to_player_num_; ++i) {
+        if (!match.IsEliminated(i)) {
+            has_decision = main_stage.PrepareComputerDecision(i) || has_decision;
+        }
+    }
+    if (has_decision) {
+        main_stage.ComputeComputerDecisions();
+        main_stage.ApplyComputerDecisions();
+    }
+}
+
 void KeepPlayersActUntilGameOver(const Options& options, const RunGameMockMatch& match, MainStageBase& main_stage)
 {
     uint64_t ok_count = 0;
     for (uint64_t i = 0;
             !main_stage.IsOver() && ok_count < options.generic_options_.bench_computers_to_player_num_;
             i = (i + 1) % options.generic_options_.bench_computers_to_player_num_) {
+        ComputeComputerDecisions(options, match, main_stage);
         if (match.IsEliminated(i) || StageErrCode::OK == main_stage.HandleComputerAct(i, true)) {
             ++ok_count;
         } else {
@@ -208,9 +227,16 @@ int main(int argc, char** argv)
     enable_markdown_to_image = FLAGS_gen_image && !FLAGS_image_dir.empty();
 
     try {
+        const auto begin_time = std::chrono::steady_clock::now();
         for (uint64_t i = 0; i < FLAGS_repeat; ++i) {
             lgtbot::game::GAME_MODULE_NAME::Run(i);
         }
+        if (FLAGS_benchmark) {
+            const auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::steady_clock::now() - begin_time).count();
+            std::cout << "Benchmark: finish " << FLAGS_repeat << " games in " << elapsed_ms << " ms ("
+                << (elapsed_ms == 0 ? 0 : FLAGS_repeat * 1000.0 / elapsed_ms) << " games/sec)" << std::endl;
+        }
     } catch (const FailTestException& fail_exception) {
         std::cerr << "Test failure: " << fail_exception.what() << std::endl;
         return 1;
@@ -4,10 +4,19 @@
 
 #include "game_framework/stage.h"
 
+#include <algorithm>
+#include <atomic>
+
+#include "utility/log.h"
+#include "utility/thread_pool.h"
+
 #ifndef GAME_MODULE_NAME
 #error GAME_MODULE_NAME is not defined
 #endif
 
+// Logs are written for each request, so the values are evaluated only if the log is enabled.
+#define STAGE_LOG(level) LAZY_LOG(level, StageLog_(level##Log()))
+
 namespace lgtbot {
 
 namespace game {
@@ -31,8 +40,17 @@ static std::string CommandInfo(const std::vector<Command>& commands, const std::
     return outstr;
 }
 
+static std::atomic<uint64_t> next_atomic_stage_serial{0};
+
+// Computer decisions of all matches of this game share the thread pool.
+static ThreadPool& ComputerDecisionThreadPool()
+{
+    static ThreadPool thread_pool(std::clamp(std::thread::hardware_concurrency(), 1U, 8U));
+    return thread_pool;
+}
+
 AtomicStage::AtomicStage(AtomicStageFsm& fsm, std::string upper_stage_info)
-    : fsm_(fsm), upper_stage_info_(std::move(upper_stage_info))
+    : fsm_(fsm), upper_stage_info_(std::move(upper_stage_info)), serial_(next_atomic_stage_serial++)
 {
 }
 
@@ -57,7 +75,7 @@ std::string AtomicStage::CommandInfo(const bool text_mode) const
 
 void AtomicStage::HandleStageBegin()
 {
-    StageLog_(InfoLog()) << "HandleStageBegin begin";
+    STAGE_LOG(Info) << "HandleStageBegin begin";
     fsm_.Global().Boardcast() << "【当前阶段】\n" << StageInfo();
     fsm_.OnStageBegin();
     Handle_(StageErrCode::OK);
@@ -65,15 +83,17 @@ void AtomicStage::HandleStageBegin()
 
 StageErrCode AtomicStage::HandleTimeout()
 {
-    StageLog_(InfoLog()) << "HandleTimeout begin";
+    STAGE_LOG(Info) << "HandleTimeout begin";
+    NextSerial_();
     return Handle_(fsm_.OnStageTimeout());
 }
 
 StageErrCode AtomicStage::HandleRequest(MsgReader& reader, const uint64_t pid, const bool is_public, MsgSenderBase& reply)
 {
-    for (const auto& cmd : fsm_.Commands()) {
-        if (const auto rc = cmd.CallIfValid(reader, pid, is_public, reply); rc.has_value()) {
-            StageLog_(InfoLog()) << "HandleRequest matched pid=" << pid << " is_public="
+    const auto& commands = fsm_.Commands();
+    for (const uint32_t i : fsm_.CommandsIndex().Candidates(reader)) {
+        if (const auto rc = commands[i].CallIfValid(reader, fsm_, pid, is_public, reply); rc.has_value()) {
+            STAGE_LOG(Info) << "HandleRequest matched pid=" << pid << " is_public="
                 << Bool2Str(is_public) << " rc=" << *rc;
             return Handle_(pid, true, *rc);
         }
@@ -83,13 +103,13 @@ StageErrCode AtomicStage::HandleRequest(MsgReader& reader, const uint64_t pid, c
 
 void AtomicStage::Terminate()
 {
-    StageLog_(InfoLog()) << " terminate";
+    STAGE_LOG(Info) << " terminate";
     Handle_(StageErrCode::CHECKOUT);
 }
 
 StageErrCode AtomicStage::HandleLeave(const PlayerID pid)
 {
-    StageLog_(InfoLog()) << "HandleLeave begin pid=" << pid;
+    STAGE_LOG(Info) << "HandleLeave begin pid=" << pid;
     fsm_.Global().Leave(pid);
     return Handle_(pid, true, fsm_.OnPlayerLeave(pid));
 }
@@ -97,31 +117,76 @@ StageErrCode AtomicStage::HandleLeave(const PlayerID pid)
 StageErrCode AtomicStage::HandleComputerAct(const uint64_t pid, const bool ready_as_user)
 {
     // For run_game_xxx, the tell msg will be output, so do not use EmptyMsgSender here.
-    StageLog_(InfoLog()) << "HandleComputerAct begin pid=" << pid << " ready_as_user=" << Bool2Str(ready_as_user);
+    STAGE_LOG(Info) << "HandleComputerAct begin pid=" << pid << " ready_as_user=" << Bool2Str(ready_as_user);
+    if (const auto decision = TakeComputerDecision_(pid); decision.has_value()) {
+        STAGE_LOG(Info) << "HandleComputerAct take the computed decision pid=" << pid;
+        return Handle_(pid, ready_as_user, fsm_.OnComputerDecision(pid, *decision, fsm_.Global().TellMsgSender(pid)));
+    }
     return Handle_(pid, ready_as_user, fsm_.OnComputerAct(pid, fsm_.Global().TellMsgSender(pid)));
 }
 
+std::optional<AtomicStageFsm::ComputerDecision> AtomicStage::TakeComputerDecision_(const PlayerID pid)
+{
+    // The decisions are not computed when replaying, but the applied ones are journaled.
+    if (const char* const decision = fsm_.Global().ReplayedComputerDecision()) {
+        return decision;
+    }
+    const auto it = computer_decisions_.find(pid);
+    if (it == computer_decisions_.end()) {
+        return std::nullopt;
+    }
+    auto decision = std::move(it->second);
+    computer_decisions_.erase(it);
+    if (fsm_.Global().IsReady(pid)) {
+        return std::nullopt;
+    }
+    fsm_.Global().JournalComputerDecision(decision);
+    return decision;
+}
+
+std::optional<AtomicStageFsm::ComputerDecisionTask> AtomicStage::PrepareComputerDecision(const PlayerID pid)
+{
+    if (fsm_.Global().IsReady(pid) || computer_decisions_.contains(pid)) {
+        return std::nullopt;
+    }
+    return fsm_.PrepareComputerDecision(pid);
+}
+
+void AtomicStage::SetComputerDecision(const PlayerID pid, AtomicStageFsm::ComputerDecision decision)
+{
+    computer_decisions_[pid] = std::move(decision);
+}
+
+void AtomicStage::NextSerial_()
+{
+    serial_ = next_atomic_stage_serial++;
+    computer_decisions_.clear();
+}
+
 StageErrCode AtomicStage::Handle_(StageErrCode rc)
 {
-    StageLog_(InfoLog()) << "Handle errcode rc=" << rc << " is_ok_to_checkout=" << Bool2Str(fsm_.Global().IsOkToCheckout());
+    STAGE_LOG(Info) << "Handle errcode rc=" << rc << " is_ok_to_checkout=" << Bool2Str(fsm_.Global().IsOkToCheckout());
     const auto trigger_all_player_ready = [&]() { return rc != StageErrCode::CHECKOUT && fsm_.Global().IsOkToCheckout(); };
     if (trigger_all_player_ready()) {
         while (true) {
             // We do not check IsReady only when rc is READY to handle all player force exit.
+            NextSerial_();
             rc = fsm_.OnStageOver();
-            StageLog_(InfoLog()) << "OnStageOver finish rc=" << rc;
+            STAGE_LOG(Info) << "OnStageOver finish rc=" << rc;
             if (!trigger_all_player_ready()) {
                 break;
             }
 #ifndef TEST_BOT
-            std::this_thread::sleep_for(std::chrono::seconds(5)); // prevent frequent messages
+            if (!fsm_.Global().IsMuted()) {
+                std::this_thread::sleep_for(std::chrono::seconds(5)); // prevent frequent messages
+            }
 #endif
         }
     }
     if (rc == StageErrCode::CHECKOUT) {
         fsm_.Global().StopTimer();
         SetOver();
-        StageLog_(InfoLog()) << "Over";
+        STAGE_LOG(Info) << "Over";
     }
     return rc;
 }
@@ -129,7 +194,7 @@ StageErrCode AtomicStage::Handle_(StageErrCode rc)
 StageErrCode AtomicStage::Handle_(const PlayerID pid, const bool is_user, StageErrCode rc)
 {
     if (rc == StageErrCode::READY) {
-        StageLog_(InfoLog()) << "Handle READY pid=" << pid << " is_user=" << Bool2Str(is_user);
+        STAGE_LOG(Info) << "Handle READY pid=" << pid << " is_user=" << Bool2Str(is_user);
         if (is_user) {
             fsm_.Global().SetReady(pid);
         } else {
@@ -138,7 +203,7 @@ StageErrCode AtomicStage::Handle_(const PlayerID pid, const bool is_user, StageE
         rc = StageErrCode::OK;
     }
 #ifndef TEST_BOT
-    if (!is_user && fsm_.Global().IsOkToCheckout()) { // computer action
+    if (!is_user && fsm_.Global().IsOkToCheckout() && !fsm_.Global().IsMuted()) { // computer action
         std::this_thread::sleep_for(std::chrono::seconds(5)); // prevent frequent messages
     }
 #endif
@@ -157,25 +222,26 @@ std::string CompoundStage::CommandInfo(const bool text_mode) const
 
 void CompoundStage::HandleStageBegin()
 {
-    StageLog_(InfoLog()) << "HandleStageBegin begin";
+    STAGE_LOG(Info) << "HandleStageBegin begin";
     variant_sub_stage_.Init(upper_stage_info_ + fsm_.Name());
     SwitchSubStage_(variant_sub_stage_.Get(), "begin");
 }
 
 StageErrCode CompoundStage::HandleTimeout()
 {
-    StageLog_(InfoLog()) << "HandleTimeout begin";
+    STAGE_LOG(Info) << "HandleTimeout begin";
     return PassToSubStage_([](StageBaseInternal& sub_stage) { return sub_stage.HandleTimeout(); }, CheckoutReason::BY_TIMEOUT);
 }
 
 StageErrCode CompoundStage::HandleRequest(MsgReader& reader, const uint64_t pid, const bool is_public, MsgSenderBase& reply)
 {
-    for (const auto& cmd : fsm_.Commands()) {
-        const auto rc = cmd.CallIfValid(reader, pid, is_public, reply);
+    const auto& commands = fsm_.Commands();
+    for (const uint32_t i : fsm_.CommandsIndex().Candidates(reader)) {
+        const auto rc = commands[i].CallIfValid(reader, fsm_, pid, is_public, reply);
         if (!rc.has_value()) {
             continue;
         }
-        StageLog_(InfoLog()) << "handle request pid=" << pid << " is_public="
+        STAGE_LOG(Info) << "handle request pid=" << pid << " is_public="
             << Bool2Str(is_public) << " rc=" << *rc;
         if (*rc == StageErrCode::CHECKOUT) {
             Terminate();
@@ -189,7 +255,7 @@ StageErrCode CompoundStage::HandleRequest(MsgReader& reader, const uint64_t pid,
 
 void CompoundStage::Terminate()
 {
-    StageLog_(InfoLog()) << " terminate";
+    STAGE_LOG(Info) << " terminate";
     SetOver();
     variant_sub_stage_.Get()->Terminate();
 }
@@ -197,7 +263,7 @@ void CompoundStage::Terminate()
 StageErrCode CompoundStage::HandleLeave(const PlayerID pid)
 {
     // We must call CompoundStage's OnPlayerLeave first so that it can deceide whether to finish game when substage is over.
-    StageLog_(InfoLog()) << "HandleLeave begin pid=" << pid;
+    STAGE_LOG(Info) << "HandleLeave begin pid=" << pid;
     fsm_.OnPlayerLeave(pid);
     return PassToSubStage_(
             [pid](StageBaseInternal& sub_stage) { return sub_stage.HandleLeave(pid); },
@@ -207,7 +273,7 @@ StageErrCode CompoundStage::HandleLeave(const PlayerID pid)
 StageErrCode CompoundStage::HandleComputerAct(const uint64_t pid, const bool ready_as_user)
 {
     // For run_game_xxx, the tell msg will be output, so do not use EmptyMsgSender here.
-    StageLog_(InfoLog()) << "HandleComputerAct begin pid=" << pid << " ready_as_user=" << Bool2Str(ready_as_user);
+    STAGE_LOG(Info) << "HandleComputerAct begin pid=" << pid << " ready_as_user=" << Bool2Str(ready_as_user);
     const auto rc = fsm_.OnComputerAct(pid, fsm_.Global().TellMsgSender(pid));
     if (rc == StageErrCode::CHECKOUT) {
         Terminate();
@@ -221,11 +287,17 @@ StageErrCode CompoundStage::HandleComputerAct(const uint64_t pid, const bool rea
             CheckoutReason::BY_REQUEST); // game logic not care abort computer
 }
 
+AtomicStage* CompoundStage::CurrentAtomicStage()
+{
+    StageBaseInternal* const sub_stage = variant_sub_stage_.Get();
+    return sub_stage ? sub_stage->CurrentAtomicStage() : nullptr;
+}
+
 void CompoundStage::CheckoutSubStage_(const CheckoutReason reason)
 {
     variant_sub_stage_.Checkout(reason, upper_stage_info_ + fsm_.Name());
 #ifndef TEST_BOT
-    if (!fsm_.Global().IsInDeduction()) {
+    if (!fsm_.Global().IsMuted()) {
         std::this_thread::sleep_for(std::chrono::seconds(1)); // avoid banned by chatting service
     }
 #endif
@@ -236,17 +308,17 @@ void CompoundStage::CheckoutSubStage_(const CheckoutReason reason)
 void CompoundStage::SwitchSubStage_(StageBaseInternal* const sub_stage, const char* const tag)
 {
     if (!sub_stage) {
-        StageLog_(InfoLog()) << tag << " no more substages";
+        STAGE_LOG(Info) << tag << " no more substages";
         SetOver();
-        StageLog_(InfoLog()) << "Over";
+        STAGE_LOG(Info) << "Over";
         return;
     }
     sub_stage->HandleStageBegin();
     if (sub_stage->IsOver()) {
-        StageLog_(WarnLog()) << tag << " substage skipped";
+        STAGE_LOG(Warn) << tag << " substage skipped";
         CheckoutSubStage_(CheckoutReason::SKIP);
     } else {
-        StageLog_(InfoLog()) << tag << " substage to \"" << sub_stage->StageName() << "\"";
+        STAGE_LOG(Info) << tag << " substage to \"" << sub_stage->StageName() << "\"";
     }
 }
 
@@ -314,6 +386,71 @@ const char* const* MainStage::VerdictateAchievements(const PlayerID pid) const
     return achieved_list.data();
 }
 
+bool MainStage::PrepareComputerDecision(const uint64_t pid)
+{
+    AtomicStage* const stage = Stage_().CurrentAtomicStage();
+    // During deduction the stage does not wait for computers, so it is not worth computing decisions in advance.
+    if (!stage || stage->IsOver() || fsm_->Global().IsInDeduction()) {
+        return false;
+    }
+    if (computing_decisions_.stage_ != stage || computing_decisions_.stage_serial_ != stage->Serial()) {
+        computing_decisions_ = ComputingDecisions{.stage_ = stage, .stage_serial_ = stage->Serial()};
+    }
+    // The decision of each round is prepared only once, so the match can check it before each computer act.
+    if (!computing_decisions_.prepared_pids_.emplace(pid).second) {
+        return false;
+    }
+    auto task = stage->PrepareComputerDecision(pid);
+    if (!task.has_value()) {
+        return false;
+    }
+    // The applied decisions are journaled along with the computer acts, so they need not be computed when replaying.
+    if (fsm_->Global().IsReplaying()) {
+        return true;
+    }
+    // The task is shared with the worker thread because it keeps running after the budget runs out.
+    auto packaged_task =
+        std::make_shared<std::packaged_task<AtomicStageFsm::ComputerDecision()>>(std::move(task->compute_));
+    computing_decisions_.decisions_.emplace_back(ComputingDecision{
+            .pid_ = pid,
+            .future_ = packaged_task->get_future(),
+            .deadline_ = std::chrono::steady_clock::now() + task->budget_,
+        });
+    ComputerDecisionThreadPool().Submit([packaged_task] { (*packaged_task)(); });
+    return true;
+}
+
+void MainStage::ComputeComputerDecisions()
+{
+    for (auto& decision : computing_decisions_.decisions_) {
+        decision.is_computed_ = decision.future_.wait_until(decision.deadline_) == std::future_status::ready;
+    }
+}
+
+void MainStage::ApplyComputerDecisions()
+{
+    AtomicStage* const stage = Stage_().CurrentAtomicStage();
+    const bool is_same_round = stage && stage == computing_decisions_.stage_ &&
+        stage->Serial() == computing_decisions_.stage_serial_;
+    for (auto& decision : computing_decisions_.decisions_) {
+        if (!is_same_round) {
+            fsm_->Global().StageLog(WarnLog(), fsm_->Name()) << "[main_stage] Discard the computer decision computed "
+                "for the previous round pid=" << decision.pid_;
+        } else if (!decision.is_computed_) {
+            fsm_->Global().StageLog(WarnLog(), fsm_->Name()) << "[main_stage] The computer decision runs out of "
+                "budget pid=" << decision.pid_;
+        } else {
+            try {
+                stage->SetComputerDecision(decision.pid_, decision.future_.get());
+            } catch (const std::exception& e) {
+                fsm_->Global().StageLog(ErrorLog(), fsm_->Name()) << "[main_stage] Compute the computer decision "
+                    "failed pid=" << decision.pid_ << " what=" << e.what();
+            }
+        }
+    }
+    computing_decisions_.decisions_.clear();
+}
+
 inline StageBaseInternal& MainStage::Stage_()
 {
     return std::visit([](auto& stage) -> StageBaseInternal& { return stage; }, internal_stage_);
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <future>
+#include <map>
+#include <set>
+
 #include "game_framework/stage_utility.h"
 #include "game_framework/game_main.h"
 #include "game_framework/stage_fsm.h"
@@ -20,6 +24,8 @@ namespace GAME_MODULE_NAME {
 
 namespace internal {
 
+class AtomicStage;
+
 class StageBaseInternal : public StageBase
 {
   public:
@@ -31,6 +37,9 @@ class StageBaseInternal : public StageBase
 
     virtual void Terminate() = 0;
 
+    // Returns the working atomic stage, or NULL if there are no working atomic stages.
+    virtual AtomicStage* CurrentAtomicStage() = 0;
+
     bool IsOver() const final { return is_over_; }
 
   protected:
@@ -60,6 +69,17 @@ class AtomicStage : public StageBaseInternal
 
     void Terminate() final;
 
+    AtomicStage* CurrentAtomicStage() final { return this; }
+
+    // The serial number changes when the stage begins a new round (`OnStageOver` or `OnStageTimeout` is invoked). It is
+    // unique among all atomic stages, even if a new stage is allocated at the same address.
+    uint64_t Serial() const { return serial_; }
+
+    std::optional<AtomicStageFsm::ComputerDecisionTask> PrepareComputerDecision(const PlayerID pid);
+
+    // The decision will be taken by the next `HandleComputerAct` for the player.
+    void SetComputerDecision(const PlayerID pid, AtomicStageFsm::ComputerDecision decision);
+
   private:
     template <typename Logger>
     auto& StageLog_(Logger&& logger) const
@@ -70,8 +90,15 @@ class AtomicStage : public StageBaseInternal
     StageErrCode Handle_(StageErrCode rc);
     StageErrCode Handle_(const PlayerID pid, const bool is_user, StageErrCode rc);
 
+    // Returns the decision computed for the computer, or the journaled one when replaying.
+    std::optional<AtomicStageFsm::ComputerDecision> TakeComputerDecision_(const PlayerID pid);
+
+    void NextSerial_();
+
     AtomicStageFsm& fsm_;
     std::string upper_stage_info_;
+    uint64_t serial_;
+    std::map<PlayerID, AtomicStageFsm::ComputerDecision> computer_decisions_;
 };
 
 // `VariantSubStage` use type erasure to hide the real type of the current stage and its substage's FSMs. It holds the
@@ -145,6 +172,8 @@ class CompoundStage : public StageBaseInternal
 
     void Terminate() final;
 
+    AtomicStage* CurrentAtomicStage() final;
+
   private:
     void CheckoutSubStage_(const CheckoutReason reason);
 
@@ -223,12 +252,34 @@ class MainStage : public MainStageBase
     int64_t PlayerScore(const PlayerID pid) const final;
     const char* const* VerdictateAchievements(const PlayerID pid) const final;
 
+    bool PrepareComputerDecision(const uint64_t pid) final;
+    void ComputeComputerDecisions() final;
+    void ApplyComputerDecisions() final;
+
   private:
     inline StageBaseInternal& Stage_();
     inline const StageBaseInternal& Stage_() const;
 
+    // The decisions being computed. Only `ComputeComputerDecisions` visits them without the match lock, so they cannot
+    // be stored in the atomic stage, which may be destructed at the same time.
+    struct ComputingDecision
+    {
+        PlayerID pid_;
+        std::future<AtomicStageFsm::ComputerDecision> future_;
+        std::chrono::steady_clock::time_point deadline_;
+        bool is_computed_{false};
+    };
+    struct ComputingDecisions
+    {
+        const AtomicStage* stage_{nullptr};
+        uint64_t stage_serial_{0};
+        std::set<PlayerID> prepared_pids_;
+        std::vector<ComputingDecision> decisions_;
+    };
+
     std::unique_ptr<MainStageFsm> fsm_;
     std::variant<AtomicStage, CompoundStage> internal_stage_;
+    ComputingDecisions computing_decisions_;
 };
 
 template <typename ...Subs>
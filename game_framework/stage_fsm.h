@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <optional>
+
 #include "game_framework/stage_utility.h"
 
 #ifndef GAME_MODULE_NAME
@@ -29,8 +33,27 @@ using CheckoutErrCode = StageErrCode::SubSet<StageErrCode::CONTINUE, StageErrCod
 
 namespace internal {
 
+struct AtomicStageFsm;
+struct CompoundStageFsmBase;
+
+template <typename RetType>
+using CommandStageFsm = std::conditional_t<std::is_same_v<RetType, AtomReqErrCode>, AtomicStageFsm, CompoundStageFsmBase>;
+
+// The stage FSM is passed when the command is called rather than bound when it is built, so that the commands can be
+// shared by stages of the same type.
 template <typename RetType>
-using GameCommand = Command<RetType(const uint64_t pid, const bool is_public, MsgSenderBase& reply)>;
+using GameCommand =
+    Command<RetType(CommandStageFsm<RetType>& fsm, const uint64_t pid, const bool is_public, MsgSenderBase& reply)>;
+
+// The commands of a stage, which are indexed to dispatch requests.
+template <typename Command>
+struct CommandTable
+{
+    explicit CommandTable(std::vector<Command> commands) : commands_(std::move(commands)), index_(commands_) {}
+
+    const std::vector<Command> commands_;
+    const CommandIndex index_;
+};
 
 template <typename ...Fsms>
     requires (sizeof...(Fsms) > 0)
@@ -126,7 +149,38 @@ struct AtomicStageFsm : virtual public StageFsmBase
     //   repeated action, it can be necessary to check whether the player has completed its action by `Global().IsReady(pid)`.
     virtual AtomReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply) { return StageErrCode::READY; }
 
+    // The action of a computer decided by `ComputerDecisionTask`, encoded as a string (e.g., the index of the chosen
+    // grid). It is journaled, so a match replayed from its journal applies the same decision without computing it again.
+    using ComputerDecision = std::string;
+
+    struct ComputerDecisionTask
+    {
+        // This function is invoked on a worker thread while other requests may be handled at the same time. So it must
+        // not visit the stage, but only the data captured by value.
+        std::function<ComputerDecision()> compute_;
+
+        // If `compute_` does not finish within the budget, the decision is discarded and `OnComputerAct` is invoked.
+        std::chrono::milliseconds budget_{std::chrono::seconds(10)};
+    };
+
+    // This function is invoked for each unready computer before `OnComputerAct`. We can override this function to
+    // compute the decision of a computer from a copy of the stage state, so that decisions of different computers are
+    // computed in parallel, and requests of users are not blocked. The decisions are applied in the order of player IDs.
+    // If the stage is over before the decisions are applied, they are discarded.
+    //
+    // The return value of std::nullopt indicates `OnComputerAct` is invoked as usual.
+    virtual std::optional<ComputerDecisionTask> PrepareComputerDecision(const PlayerID pid) { return std::nullopt; }
+
+    // This function is invoked in place of `OnComputerAct` to apply the decision computed by `ComputerDecisionTask`, so
+    // the return value has the same meaning.
+    virtual AtomReqErrCode OnComputerDecision(const PlayerID pid, const ComputerDecision& decision, MsgSenderBase& reply)
+    {
+        return OnComputerAct(pid, reply);
+    }
+
     virtual const std::vector<GameCommand<AtomReqErrCode>>& Commands() const = 0;
+
+    virtual const CommandIndex& CommandsIndex() const = 0;
 };
 
 template <typename ...Subs>
@@ -171,6 +225,8 @@ struct CompoundStageFsmBase : virtual public StageFsmBase
     virtual CompReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply) { return StageErrCode::OK; }
 
     virtual const std::vector<GameCommand<CompReqErrCode>>& Commands() const = 0;
+
+    virtual const CommandIndex& CommandsIndex() const = 0;
 };
 
 // The finite-state machine corresponding to `CompoundStage`.
@@ -253,7 +309,7 @@ class StageFsm : public internal::StageFsmTypeBaseType<Subs...>::Type
     StageFsm(internal::StageFsmConstructArgType<Main>::Type arg, std::string name, Commands&& ...commands)
         : LevelBase(std::forward<typename internal::StageFsmConstructArgType<Main>::Type>(arg))
         , name_(name)
-        , commands_{std::forward<Commands>(commands)...}
+        , commands_{std::make_shared<const internal::CommandTable<Command>>(std::vector<Command>{std::forward<Commands>(commands)...})}
     {
     }
 
@@ -261,20 +317,34 @@ class StageFsm : public internal::StageFsmTypeBaseType<Subs...>::Type
     StageFsm(internal::StageFsmConstructArgType<Main>::Type arg, Commands&& ...commands)
         : LevelBase(std::forward<typename internal::StageFsmConstructArgType<Main>::Type>(arg))
         , name_(std::is_void_v<Main> ? "主阶段" : "匿名子阶段")
-        , commands_{std::forward<Commands>(commands)...}
+        , commands_{std::make_shared<const internal::CommandTable<Command>>(std::vector<Command>{std::forward<Commands>(commands)...})}
+    {
+    }
+
+    // The commands are built by `command_factory` only when the first stage constructed with this type of factory in
+    // the match, and then shared by the following stages. It saves building checkers for stages created repeatedly
+    // (e.g., a stage for each round). So the commands must not depend on the state of a single stage, and stages which
+    // need different commands should use different factories (e.g., different lambdas).
+    template <typename CommandFactory> requires std::is_invocable_r_v<std::vector<Command>, CommandFactory&>
+    StageFsm(internal::StageFsmConstructArgType<Main>::Type arg, std::string name, CommandFactory&& command_factory)
+        : LevelBase(std::forward<typename internal::StageFsmConstructArgType<Main>::Type>(arg))
+        , name_(name)
+        , commands_{Global().template SharedCommands<internal::CommandTable<Command>>(command_factory)}
     {
     }
 
     const std::string& Name() const final { return name_; }
 
-    const std::vector<Command>& Commands() const final { return commands_; }
+    const std::vector<Command>& Commands() const final { return commands_->commands_; }
+
+    const CommandIndex& CommandsIndex() const final { return commands_->index_; }
 
   protected:
     using TypeBase::SubStageFsmSetter;
 
   private:
     std::string name_;
-    std::vector<Command> commands_;
+    std::shared_ptr<const internal::CommandTable<Command>> commands_;
 };
 
 enum CommandFlag : uint8_t
@@ -284,18 +354,13 @@ enum CommandFlag : uint8_t
 };
 
 template <typename Fsm, typename RetType, typename... Args, typename... Checkers>
-internal::GameCommand<RetType> MakeStageCommand(Fsm& fsm, const char* const description, RetType (Fsm::*cb)(Args...),
+internal::GameCommand<RetType> MakeStageCommand(const char* const description, const uint8_t flags, RetType (Fsm::*cb)(Args...),
         Checkers&&... checkers)
 {
-    return MakeStageCommand(fsm, description, 0, cb, std::forward<Checkers>(checkers)...);
-}
-
-template <typename Fsm, typename RetType, typename... Args, typename... Checkers>
-internal::GameCommand<RetType> MakeStageCommand(Fsm& fsm, const char* const description, const uint8_t flags, RetType (Fsm::*cb)(Args...),
-        Checkers&&... checkers)
-{
-    auto callback = [flags, cb, &fsm]<typename ...CbArgs>(const uint64_t pid, const bool is_public, MsgSenderBase& reply, CbArgs&& ...args) -> RetType
+    auto callback = [flags, cb]<typename ...CbArgs>(internal::CommandStageFsm<RetType>& stage_fsm, const uint64_t pid,
+            const bool is_public, MsgSenderBase& reply, CbArgs&& ...args) -> RetType
     {
+        auto& fsm = static_cast<Fsm&>(stage_fsm);
         if ((flags & CommandFlag::PRIVATE_ONLY) && is_public) {
             reply() << "[错误] 请私信执行该指令";
             return StageErrCode::FAILED;
@@ -309,6 +374,28 @@ internal::GameCommand<RetType> MakeStageCommand(Fsm& fsm, const char* const desc
     return internal::GameCommand<RetType>(description, std::move(callback), std::forward<Checkers>(checkers)...);
 }
 
+template <typename Fsm, typename RetType, typename... Args, typename... Checkers>
+internal::GameCommand<RetType> MakeStageCommand(const char* const description, RetType (Fsm::*cb)(Args...),
+        Checkers&&... checkers)
+{
+    return MakeStageCommand(description, 0, cb, std::forward<Checkers>(checkers)...);
+}
+
+// The `fsm` is only used to deduce the type. The commands are not bound to it.
+template <typename Fsm, typename RetType, typename... Args, typename... Checkers>
+internal::GameCommand<RetType> MakeStageCommand(Fsm& fsm, const char* const description, RetType (Fsm::*cb)(Args...),
+        Checkers&&... checkers)
+{
+    return MakeStageCommand(description, 0, cb, std::forward<Checkers>(checkers)...);
+}
+
+template <typename Fsm, typename RetType, typename... Args, typename... Checkers>
+internal::GameCommand<RetType> MakeStageCommand(Fsm& fsm, const char* const description, const uint8_t flags, RetType (Fsm::*cb)(Args...),
+        Checkers&&... checkers)
+{
+    return MakeStageCommand(description, flags, cb, std::forward<Checkers>(checkers)...);
+}
+
 #define GAME_OPTION(name) GET_OPTION_VALUE(this->Global().Options(), name)
 
 } // namespace GAME_MODULE_NAME
@@ -4,6 +4,8 @@
 
 #include "game_framework/stage_utility.h"
 
+#include <fstream>
+
 #include "game_framework/util.h"
 
 #ifndef GAME_MODULE_NAME
@@ -24,32 +26,45 @@ PublicStageUtility::PublicStageUtility(const MyGameOptions& game_options, const
     , match_(match)
     , masker_(match.MatchId(), match.GameName(), generic_options.PlayerNum())
     , achievement_counts_(generic_options.PlayerNum())
+    , random_engine_(match.RandomSeed())
 {
     std::ranges::for_each(achievement_counts_, [](AchievementCounts& counts) { std::ranges::fill(counts, 0); });
 }
 
 MsgSenderBase& PublicStageUtility::BoardcastMsgSender() const
 {
-    return IsInDeduction() ? EmptyMsgSender::Get() : match_.BoardcastMsgSender();
+    return IsMuted() ? EmptyMsgSender::Get() : match_.BoardcastMsgSender();
 }
 
 MsgSenderBase& PublicStageUtility::TellMsgSender(const PlayerID pid) const
 {
-    return IsInDeduction() ? EmptyMsgSender::Get() : match_.TellMsgSender(pid);
+    return IsMuted() ? EmptyMsgSender::Get() : match_.TellMsgSender(pid);
 }
 
 MsgSenderBase& PublicStageUtility::GroupMsgSender() const
 {
-    return IsInDeduction() ? EmptyMsgSender::Get() : match_.GroupMsgSender();
+    return IsMuted() ? EmptyMsgSender::Get() : match_.GroupMsgSender();
 }
 
 MsgSenderBase& PublicStageUtility::BoardcastAiInfoMsgSender() const
 {
-    return IsInDeduction() ? EmptyMsgSender::Get() : match_.BoardcastAiInfoMsgSender();
+    return IsMuted() ? EmptyMsgSender::Get() : match_.BoardcastAiInfoMsgSender();
 }
 
 void PublicStageUtility::BoardcastAiInfo(nlohmann::json j)
 {
+    if (IsMuted()) {
+        return;
+    }
+    const auto channel = match_.GetAiInfoChannel();
+    if (channel == AiInfoChannel::NONE) {
+        return;
+    }
+    if (channel == AiInfoChannel::BINARY) {
+        const auto data = ai_info_encoder_.Encode(match_.MatchId(), bot_message_id_++, std::move(j));
+        match_.BoardcastBinaryAiInfo(data.data(), data.size());
+        return;
+    }
     BoardcastAiInfoMsgSender()() << nlohmann::json{
             { "match_id", match_.MatchId() },
             { "info_id", bot_message_id_++ },
@@ -59,11 +74,33 @@ void PublicStageUtility::BoardcastAiInfo(nlohmann::json j)
 
 int PublicStageUtility::SaveMarkdown(const std::string& markdown, const uint32_t width)
 {
+    if (IsMuted()) {
+        return false; // no one will see the image
+    }
     const std::filesystem::path path = std::filesystem::path(generic_options_.saved_image_dir_) /
         ("match_saved_" + std::to_string(saved_image_no_ ++) + ".png");
     return MarkdownToImage(markdown, path.string(), width);
 }
 
+std::optional<Image> PublicStageUtility::SaveSpriteGrid(const html::SpriteGrid& grid, const std::string& frame_key)
+{
+    if (IsMuted() || !enable_markdown_to_image) {
+        return std::nullopt;
+    }
+    const auto png = sprite_grid_renderers_[frame_key].Render(grid);
+    if (!png.has_value()) {
+        return std::nullopt;
+    }
+    const std::filesystem::path dir(generic_options_.saved_image_dir_);
+    std::error_code ec;
+    std::filesystem::create_directories(dir, ec); // if failed, the saving below fails too
+    std::string path = (dir / ("match_grid_" + std::to_string(saved_image_no_ ++) + ".png")).string();
+    if (!std::ofstream(path, std::ios::binary).write(png->data(), png->size()).good()) {
+        return std::nullopt;
+    }
+    return Image{std::move(path)};
+}
+
 void PublicStageUtility::Eliminate(const PlayerID pid)
 {
     match_.Eliminate(pid);
@@ -87,6 +124,9 @@ void PublicStageUtility::Hook(const PlayerID pid)
 
 void PublicStageUtility::StartTimer(const uint64_t sec)
 {
+    if (IsInDeduction()) {
+        return; // all players are computers and act immediately
+    }
     timer_finish_time_ = std::chrono::steady_clock::now() + std::chrono::seconds(sec);
     // cannot pass substage pointer because substage may has been released when alert
     match_.StartTimer(sec, this,
@@ -10,9 +10,17 @@
 #include "game_framework/game_options.h"
 #include "game_framework/player_ready_masker.h"
 #include "nlohmann/json.hpp"
+#include "utility/ai_info.h"
 #include "utility/msg_checker.h"
+#include "utility/sprite_grid.h"
 
 #include <array>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
 
 #ifndef GAME_MODULE_NAME
 #error GAME_MODULE_NAME is not defined
@@ -51,6 +59,26 @@ class PublicStageUtility
 
     int SaveMarkdown(const std::string& markdown, const uint32_t width = 600);
 
+    // Composes the sprite grid into an image in the match directory, which is much faster than rendering
+    // `grid.ToHtml()`. Returns std::nullopt if images are disabled or the grid cannot be composed, in which case we can
+    // send `grid.ToHtml()` in markdown instead.
+    //
+    // The last frame of each `frame_key` is kept, and only the boxes changed since then are rendered again. So a board
+    // sent repeatedly should use the same key, and different boards (e.g., the private boards of different players)
+    // should use different keys.
+    std::optional<Image> SaveSpriteGrid(const html::SpriteGrid& grid, const std::string& frame_key = "");
+
+    // Stage commands built by the same factory type are shared by all stages in a match, see `StageFsm`.
+    template <typename Commands, typename Factory>
+    std::shared_ptr<const Commands> SharedCommands(Factory& factory)
+    {
+        auto& commands = shared_commands_[typeid(Factory)];
+        if (!commands) {
+            commands = std::make_shared<const Commands>(factory());
+        }
+        return std::static_pointer_cast<const Commands>(commands);
+    }
+
     // Player information
 
     std::string PlayerName(const PlayerID pid) const { return match_.PlayerName(pid); }
@@ -85,6 +113,31 @@ class PublicStageUtility
     auto PlayerNum() const { return generic_options_.PlayerNum(); }
     const char* ResourceDir() const { return generic_options_.resource_dir_; }
 
+    // Random
+
+    // The engine is seeded by the match, so a match replayed from its journal draws the same random numbers. Games should
+    // draw random numbers from it rather than from `rand()` or `std::random_device`.
+    std::mt19937& RandomEngine() { return random_engine_; }
+
+    // Returns a number in [0, RAND_MAX] drawn from `RandomEngine()`, which can take the place of `rand()`.
+    int Rand() { return std::uniform_int_distribution<int>(0, RAND_MAX)(random_engine_); }
+
+    // Computer
+
+    // Returns the choice of a computer made by `decide`, encoded as a string, e.g., the result of a search bounded by
+    // time. It should be invoked in `OnComputerAct`, whose choices are journaled, so a match replayed from its journal
+    // takes the same choices without invoking `decide`.
+    template <typename Decide>
+    std::string ComputerChoice(Decide&& decide)
+    {
+        if (const char* const choice = match_.NextReplayedComputerChoice()) {
+            return choice;
+        }
+        std::string choice = std::forward<Decide>(decide)();
+        match_.JournalComputerChoice(choice.c_str());
+        return choice;
+    }
+
     // Log
 
     template <typename Logger>
@@ -96,6 +149,8 @@ class PublicStageUtility
   private:
     // TODO: Stage should identify which players are computers. `match_.IsInDeduction()` condition should be removed.
     bool IsInDeduction() const { return match_.IsInDeduction() || masker_.IsAllPermanentInactive(); }
+    // No one will read the messages, so we need not send them or wait for users to read them.
+    bool IsMuted() const { return IsInDeduction() || match_.IsReplaying(); }
 
     void Leave(const PlayerID pid);
 
@@ -108,8 +163,12 @@ class PublicStageUtility
     PlayerReadyMasker masker_;
     std::vector<AchievementCounts> achievement_counts_;
     int32_t bot_message_id_{0}; // the ID of each bot message
+    ai_info::Encoder ai_info_encoder_;
+    std::unordered_map<std::type_index, std::shared_ptr<const void>> shared_commands_;
     int32_t saved_image_no_{0};
+    std::unordered_map<std::string, html::SpriteGridRenderer> sprite_grid_renderers_;
     std::optional<std::chrono::time_point<std::chrono::steady_clock>> timer_finish_time_;
+    std::mt19937 random_engine_;
 };
 
 class AtomicStage;
@@ -130,9 +189,14 @@ class StageUtility : public internal::PublicStageUtility
   private:
     using PublicStageUtility::Leave;
     using PublicStageUtility::IsInDeduction;
+    using PublicStageUtility::IsMuted;
 
     void SetReadyAsComputer(const PlayerID pid) { masker_.SilentlySetReady(pid); }
 
+    bool IsReplaying() const { return match_.IsReplaying(); }
+    const char* ReplayedComputerDecision() { return match_.ReplayedComputerDecision(); }
+    void JournalComputerDecision(const std::string& decision) { match_.JournalComputerDecision(decision.c_str()); }
+
     uint8_t AchievementCount(const PlayerID pid, const Achievement& achievement) const;
 
     void Activate(const PlayerID pid);
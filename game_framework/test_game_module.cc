@@ -0,0 +1,111 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include <dlfcn.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+
+#if WITH_GLOG
+#include <glog/logging.h>
+#endif
+
+DEFINE_string(module_path, "", "The path of a game module");
+DEFINE_string(another_module_path, "", "The path of another build of the same game module");
+
+// The static variable in an inline function, which every game module has.
+static constexpr const char* const k_inline_static_symbol = "_ZZN14EmptyMsgSender3GetEvE6sender";
+
+static std::string CanonicalPath(const std::string& path) { return std::filesystem::canonical(path).string(); }
+
+static bool IsMapped(const std::string& path)
+{
+    const std::string canonical_path = CanonicalPath(path);
+    std::ifstream maps("/proc/self/maps");
+    for (std::string line; std::getline(maps, line); ) {
+        if (line.ends_with(canonical_path)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns the path of the module where the symbol found from `mod` is defined.
+static std::string DefiningModulePath(void* const mod, const char* const symbol)
+{
+    Dl_info info;
+    const void* const address = dlsym(mod, symbol);
+    if (!address || !dladdr(address, &info)) {
+        return "";
+    }
+    return CanonicalPath(info.dli_fname);
+}
+
+class TestGameModule : public testing::Test
+{
+  public:
+    virtual void SetUp() override
+    {
+        if (FLAGS_module_path.empty()) {
+            GTEST_SKIP() << "The path of the game module is not specified";
+        }
+    }
+};
+
+TEST_F(TestGameModule, unmap_module_after_closing)
+{
+    void* const mod = dlopen(FLAGS_module_path.c_str(), RTLD_LAZY);
+    ASSERT_NE(nullptr, mod) << dlerror();
+    ASSERT_TRUE(IsMapped(FLAGS_module_path));
+    ASSERT_NE(nullptr, dlsym(mod, "GetGameInfo"));
+    ASSERT_EQ(0, dlclose(mod));
+    ASSERT_FALSE(IsMapped(FLAGS_module_path));
+}
+
+#if WITH_GLOG
+// bot_core shares its logger with the module through it, so the module does not start a logging thread of its own.
+TEST_F(TestGameModule, export_logger_sharing)
+{
+    void* const mod = dlopen(FLAGS_module_path.c_str(), RTLD_LAZY);
+    ASSERT_NE(nullptr, mod) << dlerror();
+    ASSERT_NE(nullptr, dlsym(mod, "ShareAsyncLogger"));
+    ASSERT_EQ(0, dlclose(mod));
+}
+#endif
+
+// It is what happens when a game module is reloaded.
+TEST_F(TestGameModule, load_two_builds_side_by_side)
+{
+    if (FLAGS_another_module_path.empty()) {
+        GTEST_SKIP() << "The path of another build is not specified";
+    }
+    void* const old_mod = dlopen(FLAGS_module_path.c_str(), RTLD_LAZY);
+    ASSERT_NE(nullptr, old_mod) << dlerror();
+    void* const new_mod = dlopen(FLAGS_another_module_path.c_str(), RTLD_LAZY);
+    ASSERT_NE(nullptr, new_mod) << dlerror();
+
+    // The new build uses its own instances rather than the ones of the old build.
+    ASSERT_EQ(CanonicalPath(FLAGS_module_path), DefiningModulePath(old_mod, k_inline_static_symbol));
+    ASSERT_EQ(CanonicalPath(FLAGS_another_module_path), DefiningModulePath(new_mod, k_inline_static_symbol));
+
+    ASSERT_EQ(0, dlclose(old_mod));
+    ASSERT_FALSE(IsMapped(FLAGS_module_path));
+    ASSERT_TRUE(IsMapped(FLAGS_another_module_path));
+
+    ASSERT_EQ(0, dlclose(new_mod));
+    ASSERT_FALSE(IsMapped(FLAGS_another_module_path));
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+#if WITH_GLOG
+    google::InitGoogleLogging(argv[0]); // game modules use glog provided by the process
+#endif
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,113 @@
+// Copyright (c) 2024-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include <chrono>
+#include <iostream>
+
+#include <gtest/gtest.h>
+
+#include "game_framework/player_ready_masker.h"
+
+using lgtbot::game::GAME_MODULE_NAME::internal::PlayerReadyMasker;
+
+TEST(TestPlayerReadyMasker, ready_player_becomes_permanently_inactive_then_clear_ready)
+{
+    PlayerReadyMasker masker(0, "测试游戏", 2);
+    masker.SetReady(0);
+    masker.SetPermanentInactive(0);
+    masker.ClearReady();
+    ASSERT_FALSE(masker.IsReady(0));
+    ASSERT_TRUE(masker.IsInactive(0));
+    ASSERT_FALSE(masker.Ok()); // the player 1 is still active
+    masker.SetReady(1);
+    ASSERT_TRUE(masker.Ok());
+    masker.ClearReady();
+    ASSERT_FALSE(masker.Ok());
+}
+
+TEST(TestPlayerReadyMasker, unset_ready_temporarily_inactive_player)
+{
+    PlayerReadyMasker masker(0, "测试游戏", 2);
+    masker.SetTemporaryInactive(0);
+    masker.SetReady(1);
+    ASSERT_TRUE(masker.Ok());
+    masker.UnsetReady(0);
+    ASSERT_FALSE(masker.IsReady(0));
+    ASSERT_TRUE(masker.IsTemporaryInactive(0));
+    ASSERT_FALSE(masker.Ok()); // the temporarily inactive player should be waited until timeout
+    masker.SetReady(0);
+    ASSERT_TRUE(masker.Ok());
+    masker.UnsetReady(0);
+    masker.SetReady(1);
+    ASSERT_TRUE(masker.Ok()); // the player 0 is counted only once
+}
+
+TEST(TestPlayerReadyMasker, set_active_ready_temporarily_inactive_player)
+{
+    PlayerReadyMasker masker(0, "测试游戏", 2);
+    masker.SetReady(0);
+    masker.SetTemporaryInactive(0);
+    ASSERT_TRUE(masker.SetActive(0));
+    ASSERT_FALSE(masker.SetActive(0));
+    ASSERT_TRUE(masker.IsReady(0));
+    ASSERT_FALSE(masker.IsInactive(0));
+    ASSERT_FALSE(masker.Ok());
+    masker.SetReady(1);
+    ASSERT_TRUE(masker.Ok());
+    masker.ClearReady();
+    ASSERT_FALSE(masker.Ok());
+}
+
+TEST(TestPlayerReadyMasker, all_players_permanently_inactive)
+{
+    PlayerReadyMasker masker(0, "测试游戏", 2);
+    masker.SetPermanentInactive(0);
+    ASSERT_FALSE(masker.IsAllPermanentInactive());
+    ASSERT_FALSE(masker.Ok());
+    masker.SetTemporaryInactive(1);
+    ASSERT_FALSE(masker.IsAllPermanentInactive());
+    masker.SetPermanentInactive(1);
+    ASSERT_TRUE(masker.IsAllPermanentInactive());
+    ASSERT_TRUE(masker.Ok());
+    masker.ClearReady();
+    ASSERT_TRUE(masker.Ok());
+}
+
+TEST(TestPlayerReadyMasker, not_ok_if_no_user_ready)
+{
+    PlayerReadyMasker masker(0, "测试游戏", 2);
+    masker.SetTemporaryInactive(1);
+    masker.ClearReady();
+    // The computer acts before the temporarily inactive user, so the user has the opportunity to act.
+    masker.SilentlySetReady(0);
+    ASSERT_FALSE(masker.Ok());
+    masker.SetReady(1);
+    ASSERT_TRUE(masker.Ok());
+}
+
+TEST(TestPlayerReadyMasker, DISABLED_benchmark_set_ready)
+{
+    // In each round, every player gets ready and the stage checks whether it can be checked out after each one.
+    constexpr uint64_t k_round_num = 100;
+    for (const size_t player_num : {100, 1000}) {
+        PlayerReadyMasker masker(0, "测试游戏", player_num);
+        for (size_t pid = 0; pid < player_num; pid += 10) {
+            masker.SetTemporaryInactive(pid);
+        }
+        uint64_t ok_count = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        for (uint64_t round = 0; round < k_round_num; ++round) {
+            for (size_t pid = 0; pid < player_num; ++pid) {
+                masker.SetReady(pid);
+                ok_count += masker.Ok();
+            }
+            masker.ClearReady();
+        }
+        const auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+        // Temporarily inactive players need not be waited for, so it is ok once the last active player gets ready.
+        ASSERT_EQ(k_round_num, ok_count);
+        std::cout << "Benchmark: " << player_num << " players, " << cost.count() / (k_round_num * player_num)
+                  << "ns to set ready and check on average" << std::endl;
+    }
+}
@@ -10,6 +10,7 @@
 #include <glog/logging.h>
 #endif
 
+#include "utility/log.h"
 #include "game_framework/util.h"
 #include "game_framework/stage.h"
 #include "game_framework/game_options.h"
@@ -25,6 +26,7 @@ namespace GAME_MODULE_NAME {
 DEFINE_string(resource_dir, "./resource_dir/", "The path of game image resources");
 DEFINE_bool(gen_image, false, "Whether generate image or not");
 DEFINE_string(image_dir, "./.lgtbot_image/", "The path of directory to store generated images");
+DEFINE_uint64(option_benchmark_iterations, 1000, "The number of times each option is set in the option benchmark");
 
 internal::MainStage* MakeMainStage(MainStageFactory factory);
 
@@ -56,6 +58,7 @@ class TestGame : public MockMatch, public testing::Test
     virtual void TearDown() override
     {
 #ifdef WITH_GLOG
+        GlobalAsyncLogger().Flush();
         google::ShutdownGoogleLogging();
 #endif
     }
@@ -239,6 +242,40 @@ class TestGame : public MockMatch, public testing::Test
 
 #define ASSERT_ELIMINATED(pid) ASSERT_TRUE(IsEliminated(pid))
 
+// Every game can run this benchmark with its own options. Each option is set to its current value, which is exactly
+// what `ShortInfo` shows. Options whose current values cannot be typed (e.g., empty strings) are skipped. Like other
+// benchmarks, it is disabled so that ctest does not run it. Run it with `--gtest_also_run_disabled_tests`.
+TEST(TestGameOptions, DISABLED_benchmark_set_option)
+{
+    const GameOptions default_options;
+    GameOptions options;
+    std::vector<std::string> commands;
+    const char* const* const infos = default_options.ShortInfo();
+    for (uint32_t i = 0; i < GameOptions::Count(); ++i) {
+        if (options.SetOption(infos[i])) {
+            commands.emplace_back(infos[i]);
+        }
+    }
+    ASSERT_FALSE(options.SetOption("not_exist_option 1"));
+
+    const uint64_t iterations = std::max<uint64_t>(FLAGS_option_benchmark_iterations, 1);
+    const auto set_begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        for (const auto& command : commands) {
+            options.SetOption(command.c_str());
+        }
+    }
+    const auto set_time = std::chrono::steady_clock::now() - set_begin;
+    const auto copy_begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; ++i) {
+        delete default_options.Copy();
+    }
+    const auto copy_time = std::chrono::steady_clock::now() - copy_begin;
+    std::cout << "Benchmark: " << commands.size() << " options, "
+              << set_time.count() / iterations / std::max<size_t>(commands.size(), 1) << " ns to set an option, "
+              << copy_time.count() / iterations << " ns to copy the default options" << std::endl;
+}
+
 } // namespace GAME_MODULE_NAME
 
 } // namespace game
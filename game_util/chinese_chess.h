@@ -32,6 +32,7 @@ ENUM_END(KingdomId)
 #include <map>
 #include <bitset>
 #include <optional>
+#include <chrono>
 
 
 #include "utility/html.h"
@@ -139,6 +140,10 @@ class Area
 
     auto move_state() const { return move_state_; }
 
+    bool HasChessMovedHere() const { return !chesses_moved_here_.empty(); }
+
+    const std::vector<Chess>& ChessesMovedHere() const { return chesses_moved_here_; }
+
     static void Move(Area& src, Area& dst, ChessRule* const chess_rule = nullptr)
     {
         assert(src.chess_.has_value());
@@ -246,10 +251,18 @@ struct KingdomInfo
     uint32_t eat_count_;
 };
 
+struct ComputerMove
+{
+    uint32_t map_id_;
+    Coor src_;
+    Coor dst_;
+};
+
 class BoardMgr
 {
   public:
-    BoardMgr(const uint32_t player_num, const uint32_t kingdom_num_each_player)
+    BoardMgr(const uint32_t player_num, const uint32_t kingdom_num_each_player,
+            const uint64_t seed = std::random_device{}())
     {
         assert(player_num * kingdom_num_each_player <= KingdomId::Count());
         for (uint32_t player_id = 0; player_id < player_num; ++player_id) {
@@ -267,8 +280,7 @@ class BoardMgr
             kingdom_oppo_pairs_.emplace_back(kingdom_num - 1 - i);
         }
         if (player_num >= 4) {
-            std::random_device rd;
-            std::mt19937 g(rd());
+            std::mt19937 g(seed);
             std::shuffle(kingdom_oppo_pairs_.begin(), kingdom_oppo_pairs_.end(), g);
         }
         SetOppoBoards_();
@@ -342,6 +354,11 @@ class BoardMgr
         return result;
     }
 
+    // Searches a move for the kingdom on the boards where it has chesses, which share the budget. Returns nullopt if the
+    // kingdom cannot move.
+    std::optional<ComputerMove> SearchComputerMove(const uint32_t player_id, const KingdomId kingdom_id,
+            const std::chrono::milliseconds budget) const;
+
     void Switch()
     {
         SwitchOppoPairs_(kingdom_oppo_pairs_);
@@ -682,6 +699,520 @@ class PromotedZuChessRule : public ChessRule, public EnableSingleton<PromotedZuC
     virtual const char* ChineseName() const override { return "过河卒"; }
 };
 
+// ========== COMPUTER PLAYER ==========
+
+struct SearchMove
+{
+    bool operator==(const SearchMove&) const = default;
+    uint8_t src_{0};
+    uint8_t dst_{0};
+};
+
+class SearchMoveList
+{
+  public:
+    void Add(const int32_t src, const int32_t dst)
+    {
+        if (size_ < k_capacity) {
+            moves_[size_++] = SearchMove{static_cast<uint8_t>(src), static_cast<uint8_t>(dst)};
+        }
+    }
+
+    uint32_t Size() const { return size_; }
+
+    SearchMove& operator[](const uint32_t i) { return moves_[i]; }
+
+    const SearchMove& operator[](const uint32_t i) const { return moves_[i]; }
+
+  private:
+    // Even two kingdoms with all their chesses on one board cannot have so many moves.
+    static constexpr uint32_t k_capacity = 256;
+
+    std::array<SearchMove, k_capacity> moves_;
+    uint32_t size_{0};
+};
+
+static constexpr uint64_t SplitMix64(uint64_t& state)
+{
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// A compact board for the computer player to search. The areas are indexed by |m * k_max_n + n|, where the coordinate is in the
+// view of the half board from which the board is made, which is the same as the coordinate passed to |HalfBoard::Move|.
+//
+// The rounds are played simultaneously, but the search sequentializes them: the opponent moves after seeing our move in each
+// round, so chesses never crash.
+class SearchBoard
+{
+  public:
+    static constexpr int32_t k_max_m = HalfBoard::k_max_m * 2;
+    static constexpr int32_t k_max_n = HalfBoard::k_max_n;
+    static constexpr int32_t k_area_num = k_max_m * k_max_n;
+
+    // The NEUTRAL chesses belong to destroyed kingdoms, which cannot move but can be eaten by anyone.
+    enum class Side : uint8_t { SELF, OPPO, NEUTRAL };
+
+    // The restriction of an area only takes effect in the recorded round.
+    struct Restriction
+    {
+        Area::MoveState state_{Area::MoveState::MOVABLE};
+        int32_t round_{0};
+    };
+
+    struct Undo
+    {
+        SearchMove move_;
+        uint8_t moved_piece_;
+        uint8_t ate_piece_;
+        Side side_to_move_;
+        int32_t round_;
+        Restriction src_restriction_;
+        Restriction dst_restriction_;
+        uint64_t hash_;
+    };
+
+    template <typename GetSide>
+    static SearchBoard Make(const HalfBoard& half_board, const GetSide& get_side)
+    {
+        SearchBoard board;
+        for (int32_t m = 0; m < k_max_m; ++m) {
+            for (int32_t n = 0; n < k_max_n; ++n) {
+                const auto& area = half_board.Get(Coor{m, n});
+                if (area.GetChess().has_value()) {
+                    board.Set_(ToIndex(m, n), area.GetChess()->chess_rule_->Type(), get_side(*area.GetChess()));
+                }
+                if (area.move_state() == Area::MoveState::FREEZE || area.move_state() == Area::MoveState::CANNOT_EAT) {
+                    board.restrictions_[ToIndex(m, n)] = Restriction{area.move_state(), 0};
+                }
+            }
+        }
+        return board;
+    }
+
+    static constexpr int32_t ToIndex(const int32_t m, const int32_t n) { return m * k_max_n + n; }
+
+    static constexpr Coor ToCoor(const int32_t index) { return Coor{index / k_max_n, index % k_max_n}; }
+
+    // Generates moves for the side to move. Moves which eat chesses are generated only if |k_eat_only| is true.
+    template <bool k_eat_only = false>
+    void GenerateMoves(SearchMoveList& moves) const
+    {
+        for (int32_t src = 0; src < k_area_num; ++src) {
+            const uint8_t piece = pieces_[src];
+            if (piece == k_empty || PieceSide_(piece) != side_to_move_ || IsRestricted_(src, Area::MoveState::FREEZE)) {
+                continue;
+            }
+            const bool can_eat = !IsRestricted_(src, Area::MoveState::CANNOT_EAT);
+            const auto try_add = [&](const int32_t m, const int32_t n)
+                {
+                    if (!IsValid_(m, n)) {
+                        return;
+                    }
+                    const int32_t dst = ToIndex(m, n);
+                    if (pieces_[dst] == k_empty ? !k_eat_only : can_eat && PieceSide_(pieces_[dst]) != side_to_move_) {
+                        moves.Add(src, dst);
+                    }
+                };
+            const auto [src_m, src_n] = ToCoor(src);
+            switch (PieceType_(piece)) {
+            case ChessType::JU:
+                for (const auto [dm, dn] : k_orthogonal_steps) {
+                    int32_t m = src_m + dm, n = src_n + dn;
+                    for (; IsValid_(m, n) && pieces_[ToIndex(m, n)] == k_empty; m += dm, n += dn) {
+                        try_add(m, n);
+                    }
+                    try_add(m, n);
+                }
+                break;
+            case ChessType::PAO:
+                for (const auto [dm, dn] : k_orthogonal_steps) {
+                    int32_t m = src_m + dm, n = src_n + dn;
+                    for (; IsValid_(m, n) && pieces_[ToIndex(m, n)] == k_empty; m += dm, n += dn) {
+                        try_add(m, n);
+                    }
+                    for (m += dm, n += dn; IsValid_(m, n) && pieces_[ToIndex(m, n)] == k_empty; m += dm, n += dn) {
+                    }
+                    if (IsValid_(m, n)) {
+                        try_add(m, n);
+                    }
+                }
+                break;
+            case ChessType::MA:
+                for (const auto [dm, dn] : k_ma_steps) {
+                    if (IsValid_(src_m + dm, src_n + dn) && pieces_[ToIndex(src_m + dm / 2, src_n + dn / 2)] == k_empty) {
+                        try_add(src_m + dm, src_n + dn);
+                    }
+                }
+                break;
+            case ChessType::XIANG:
+                for (const auto [dm, dn] : k_diagonal_steps) {
+                    if (const int32_t mid_m = src_m + dm; mid_m != HalfBoard::k_max_m && mid_m != HalfBoard::k_max_m - 1) {
+                        try_add(src_m + dm * 2, src_n + dn * 2);
+                    }
+                }
+                break;
+            case ChessType::SHI:
+                for (const auto [dm, dn] : k_diagonal_steps) {
+                    if (IsInHouse(Coor{src_m + dm, src_n + dn})) {
+                        try_add(src_m + dm, src_n + dn);
+                    }
+                }
+                break;
+            case ChessType::JIANG:
+                for (const auto [dm, dn] : k_orthogonal_steps) {
+                    if (IsInHouse(Coor{src_m + dm, src_n + dn})) {
+                        try_add(src_m + dm, src_n + dn);
+                    }
+                    // the jiang can eat the facing jiang
+                    int32_t m = src_m + dm, n = src_n + dn;
+                    for (; IsValid_(m, n) && pieces_[ToIndex(m, n)] == k_empty; m += dm, n += dn) {
+                    }
+                    if ((m != src_m + dm || n != src_n + dn) && IsValid_(m, n) && IsInHouse(Coor{m, n}) &&
+                            PieceType_(pieces_[ToIndex(m, n)]) == ChessType::JIANG) {
+                        try_add(m, n);
+                    }
+                }
+                break;
+            case ChessType::ZU:
+                try_add(src_m + (src_m < HalfBoard::k_max_m ? 1 : -1), src_n);
+                break;
+            case ChessType::PROMOTED_ZU:
+                try_add(src_m + (src_m < HalfBoard::k_max_m ? -1 : 1), src_n);
+                try_add(src_m, src_n - 1);
+                try_add(src_m, src_n + 1);
+                break;
+            }
+        }
+    }
+
+    void Make(const SearchMove move, Undo& undo)
+    {
+        const uint8_t moved_piece = pieces_[move.src_];
+        const uint8_t ate_piece = pieces_[move.dst_];
+        undo = Undo{move, moved_piece, ate_piece, side_to_move_, round_, restrictions_[move.src_], restrictions_[move.dst_], hash_};
+        const int32_t src_m = move.src_ / k_max_n;
+        const int32_t dst_m = move.dst_ / k_max_n;
+        const bool need_promote_zu = PieceType_(moved_piece) == ChessType::ZU &&
+                std::min(src_m, dst_m) == HalfBoard::k_max_m - 1 && std::max(src_m, dst_m) == HalfBoard::k_max_m;
+        const uint8_t piece = need_promote_zu ? MakePiece_(ChessType::PROMOTED_ZU, PieceSide_(moved_piece)) : moved_piece;
+        if (ate_piece != k_empty) {
+            materials_[static_cast<uint32_t>(PieceSide_(ate_piece))] -= PieceValue_(ate_piece);
+            hash_ ^= k_zobrist_keys_[move.dst_][ate_piece];
+        }
+        materials_[static_cast<uint32_t>(side_to_move_)] += PieceValue_(piece) - PieceValue_(moved_piece);
+        hash_ ^= k_zobrist_keys_[move.src_][moved_piece] ^ k_zobrist_keys_[move.dst_][piece] ^ k_zobrist_side_key_;
+        pieces_[move.src_] = k_empty;
+        pieces_[move.dst_] = piece;
+        restrictions_[move.src_] = Restriction{};
+        restrictions_[move.dst_] = Restriction{ate_piece == k_empty ? Area::MoveState::CANNOT_EAT : Area::MoveState::FREEZE, round_ + 1};
+        if (side_to_move_ == Side::OPPO) {
+            ++round_;
+        }
+        side_to_move_ = side_to_move_ == Side::SELF ? Side::OPPO : Side::SELF;
+    }
+
+    void Unmake(const Undo& undo)
+    {
+        const auto& move = undo.move_;
+        if (undo.ate_piece_ != k_empty) {
+            materials_[static_cast<uint32_t>(PieceSide_(undo.ate_piece_))] += PieceValue_(undo.ate_piece_);
+        }
+        materials_[static_cast<uint32_t>(undo.side_to_move_)] += PieceValue_(undo.moved_piece_) - PieceValue_(pieces_[move.dst_]);
+        pieces_[move.src_] = undo.moved_piece_;
+        pieces_[move.dst_] = undo.ate_piece_;
+        restrictions_[move.src_] = undo.src_restriction_;
+        restrictions_[move.dst_] = undo.dst_restriction_;
+        side_to_move_ = undo.side_to_move_;
+        round_ = undo.round_;
+        hash_ = undo.hash_;
+    }
+
+    // The material difference in the view of the side to move.
+    int32_t Evaluate() const
+    {
+        return materials_[static_cast<uint32_t>(side_to_move_)] -
+            materials_[static_cast<uint32_t>(side_to_move_ == Side::SELF ? Side::OPPO : Side::SELF)];
+    }
+
+    // The value of the chess which is eaten by the move, used to order moves.
+    int32_t EatValue(const SearchMove move) const
+    {
+        return pieces_[move.dst_] == k_empty ? 0 : PieceValue_(pieces_[move.dst_]);
+    }
+
+    int32_t MovedValue(const SearchMove move) const { return PieceValue_(pieces_[move.src_]); }
+
+    uint64_t Hash() const { return hash_; }
+
+    Side SideToMove() const { return side_to_move_; }
+
+  private:
+    static constexpr uint8_t k_empty = 0;
+    static constexpr uint32_t k_piece_kind_num = 1 + 8 * 3;
+    static constexpr std::pair<int32_t, int32_t> k_orthogonal_steps[] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+    static constexpr std::pair<int32_t, int32_t> k_diagonal_steps[] = {{-1, -1}, {-1, 1}, {1, -1}, {1, 1}};
+    static constexpr std::pair<int32_t, int32_t> k_ma_steps[] = {{-2, -1}, {-2, 1}, {2, -1}, {2, 1}, {-1, -2}, {-1, 2}, {1, -2}, {1, 2}};
+
+    static constexpr int32_t k_values[] = {
+        [static_cast<uint32_t>(ChessType::JU)] = 90,
+        [static_cast<uint32_t>(ChessType::MA)] = 40,
+        [static_cast<uint32_t>(ChessType::XIANG)] = 20,
+        [static_cast<uint32_t>(ChessType::SHI)] = 20,
+        [static_cast<uint32_t>(ChessType::JIANG)] = 1000, // all chesses of the kingdom are captured together
+        [static_cast<uint32_t>(ChessType::PAO)] = 45,
+        [static_cast<uint32_t>(ChessType::ZU)] = 10,
+        [static_cast<uint32_t>(ChessType::PROMOTED_ZU)] = 20,
+    };
+
+    static constexpr auto k_zobrist_keys_ = []() constexpr
+        {
+            std::array<std::array<uint64_t, k_piece_kind_num>, k_area_num> result{};
+            uint64_t state = 0;
+            for (auto& keys : result) {
+                for (auto& key : keys) {
+                    key = SplitMix64(state);
+                }
+            }
+            return result;
+        }();
+
+    static constexpr uint64_t k_zobrist_side_key_ = []() constexpr { uint64_t state = 1; return SplitMix64(state); }();
+
+    static constexpr uint8_t MakePiece_(const ChessType type, const Side side)
+    {
+        return 1 + static_cast<uint8_t>(type) + static_cast<uint8_t>(side) * 8;
+    }
+
+    static constexpr ChessType PieceType_(const uint8_t piece) { return static_cast<ChessType>((piece - 1) % 8); }
+
+    static constexpr Side PieceSide_(const uint8_t piece) { return static_cast<Side>((piece - 1) / 8); }
+
+    static constexpr int32_t PieceValue_(const uint8_t piece)
+    {
+        return PieceSide_(piece) == Side::NEUTRAL ? 0 : k_values[static_cast<uint32_t>(PieceType_(piece))];
+    }
+
+    static constexpr bool IsValid_(const int32_t m, const int32_t n) { return 0 <= m && m < k_max_m && 0 <= n && n < k_max_n; }
+
+    bool IsRestricted_(const int32_t index, const Area::MoveState state) const
+    {
+        return restrictions_[index].state_ == state && restrictions_[index].round_ == round_;
+    }
+
+    void Set_(const int32_t index, const ChessType type, const Side side)
+    {
+        const uint8_t piece = MakePiece_(type, side);
+        pieces_[index] = piece;
+        materials_[static_cast<uint32_t>(side)] += PieceValue_(piece);
+        hash_ ^= k_zobrist_keys_[index][piece];
+    }
+
+    std::array<uint8_t, k_area_num> pieces_{};
+    std::array<Restriction, k_area_num> restrictions_;
+    std::array<int32_t, 3> materials_{};
+    Side side_to_move_{Side::SELF};
+    int32_t round_{0};
+    uint64_t hash_{0};
+};
+
+// Iterative deepening alpha-beta search with a transposition table.
+class SearchEngine
+{
+  public:
+    struct Result
+    {
+        SearchMove move_;
+        int32_t score_{0};
+        int32_t depth_{0};
+    };
+
+    explicit SearchEngine(const uint32_t transposition_table_bits = 16)
+        : transposition_table_(size_t{1} << transposition_table_bits)
+    {
+    }
+
+    // Searches until the budget runs out, except that the depth 1 is always finished. Only the moves which satisfy
+    // |is_root_move_allowed| are searched for the root. Returns nullopt if no moves can be searched.
+    template <typename IsRootMoveAllowed>
+    std::optional<Result> Search(SearchBoard board, const std::chrono::milliseconds budget,
+            const IsRootMoveAllowed& is_root_move_allowed, const int32_t max_depth = k_max_depth)
+    {
+        deadline_ = std::chrono::steady_clock::now() + budget;
+        stopped_ = false;
+        SearchMoveList moves;
+        board.GenerateMoves(moves);
+        SearchMoveList root_moves;
+        for (uint32_t i = 0; i < moves.Size(); ++i) {
+            if (is_root_move_allowed(moves[i])) {
+                root_moves.Add(moves[i].src_, moves[i].dst_);
+            }
+        }
+        if (root_moves.Size() == 0) {
+            return std::nullopt;
+        }
+        std::optional<Result> result;
+        for (int32_t depth = 1; depth <= max_depth && !stopped_; ++depth) {
+            can_stop_ = depth > 1;
+            Result depth_result{.score_ = -k_infinity, .depth_ = depth};
+            SortMoves_(board, root_moves, result.has_value() ? result->move_ : SearchMove{});
+            for (uint32_t i = 0; i < root_moves.Size() && !stopped_; ++i) {
+                SearchBoard::Undo undo;
+                board.Make(root_moves[i], undo);
+                const int32_t score = -Negamax_(board, depth - 1, -k_infinity, -depth_result.score_);
+                board.Unmake(undo);
+                if (!stopped_ && score > depth_result.score_) {
+                    depth_result.score_ = score;
+                    depth_result.move_ = root_moves[i];
+                }
+            }
+            if (!stopped_) {
+                result = depth_result;
+            }
+        }
+        return result;
+    }
+
+    uint64_t VisitedNodes() const { return visited_nodes_; }
+
+  private:
+    static constexpr int32_t k_max_depth = 64;
+    static constexpr int32_t k_max_quiescence_depth = 6;
+    static constexpr int32_t k_infinity = 1000000;
+    static constexpr uint64_t k_check_time_interval = 1024;
+
+    enum class Bound : uint8_t { EXACT, LOWER, UPPER };
+
+    struct Entry
+    {
+        uint64_t hash_{0};
+        int32_t score_{0};
+        int16_t depth_{-1};
+        Bound bound_{Bound::EXACT};
+        SearchMove move_;
+    };
+
+    int32_t Negamax_(SearchBoard& board, const int32_t depth, int32_t alpha, const int32_t beta)
+    {
+        if (depth <= 0) {
+            return Quiesce_(board, k_max_quiescence_depth, alpha, beta);
+        }
+        if (IsTimeout_()) {
+            return 0;
+        }
+        auto& entry = transposition_table_[board.Hash() & (transposition_table_.size() - 1)];
+        SearchMove hash_move;
+        if (entry.hash_ == board.Hash()) {
+            hash_move = entry.move_;
+            if (entry.depth_ >= depth && (entry.bound_ == Bound::EXACT ||
+                        (entry.bound_ == Bound::LOWER && entry.score_ >= beta) ||
+                        (entry.bound_ == Bound::UPPER && entry.score_ <= alpha))) {
+                return entry.score_;
+            }
+        }
+        SearchMoveList moves;
+        board.GenerateMoves(moves);
+        if (moves.Size() == 0) {
+            return board.Evaluate();
+        }
+        SortMoves_(board, moves, hash_move);
+        const int32_t old_alpha = alpha;
+        int32_t best_score = -k_infinity;
+        SearchMove best_move = moves[0];
+        for (uint32_t i = 0; i < moves.Size(); ++i) {
+            SearchBoard::Undo undo;
+            board.Make(moves[i], undo);
+            const int32_t score = -Negamax_(board, depth - 1, -beta, -alpha);
+            board.Unmake(undo);
+            if (stopped_) {
+                return 0;
+            }
+            if (score > best_score) {
+                best_score = score;
+                best_move = moves[i];
+            }
+            alpha = std::max(alpha, score);
+            if (alpha >= beta) {
+                break;
+            }
+        }
+        entry = Entry{
+            .hash_ = board.Hash(),
+            .score_ = best_score,
+            .depth_ = static_cast<int16_t>(depth),
+            .bound_ = best_score <= old_alpha ? Bound::UPPER : best_score >= beta ? Bound::LOWER : Bound::EXACT,
+            .move_ = best_move,
+        };
+        return best_score;
+    }
+
+    int32_t Quiesce_(SearchBoard& board, const int32_t depth, int32_t alpha, const int32_t beta)
+    {
+        if (IsTimeout_()) {
+            return 0;
+        }
+        const int32_t stand_pat = board.Evaluate();
+        if (depth == 0 || stand_pat >= beta) {
+            return stand_pat;
+        }
+        alpha = std::max(alpha, stand_pat);
+        SearchMoveList moves;
+        board.GenerateMoves<true>(moves);
+        SortMoves_(board, moves, SearchMove{});
+        for (uint32_t i = 0; i < moves.Size(); ++i) {
+            SearchBoard::Undo undo;
+            board.Make(moves[i], undo);
+            const int32_t score = -Quiesce_(board, depth - 1, -beta, -alpha);
+            board.Unmake(undo);
+            if (stopped_) {
+                return 0;
+            }
+            if (score >= beta) {
+                return score;
+            }
+            alpha = std::max(alpha, score);
+        }
+        return alpha;
+    }
+
+    // The hash move goes first, and then the moves eating more valuable chesses with less valuable chesses.
+    static void SortMoves_(const SearchBoard& board, SearchMoveList& moves, const SearchMove hash_move)
+    {
+        std::array<int32_t, 256> scores;
+        for (uint32_t i = 0; i < moves.Size(); ++i) {
+            scores[i] = moves[i] == hash_move && hash_move != SearchMove{} ? k_infinity :
+                board.EatValue(moves[i]) * 16 - (board.EatValue(moves[i]) > 0 ? board.MovedValue(moves[i]) : 0);
+        }
+        for (uint32_t i = 1; i < moves.Size(); ++i) {
+            const auto move = moves[i];
+            const auto score = scores[i];
+            uint32_t j = i;
+            for (; j > 0 && scores[j - 1] < score; --j) {
+                moves[j] = moves[j - 1];
+                scores[j] = scores[j - 1];
+            }
+            moves[j] = move;
+            scores[j] = score;
+        }
+    }
+
+    bool IsTimeout_()
+    {
+        if (++visited_nodes_ % k_check_time_interval == 0 && can_stop_ && std::chrono::steady_clock::now() >= deadline_) {
+            stopped_ = true;
+        }
+        return stopped_;
+    }
+
+    std::vector<Entry> transposition_table_;
+    std::chrono::steady_clock::time_point deadline_;
+    bool can_stop_{false};
+    bool stopped_{false};
+    uint64_t visited_nodes_{0};
+};
+
 HalfBoard::HalfBoard(const KingdomId kingdom_id) : kingdom_id_(kingdom_id), oppo_board_(this)
 {
     areas_[0][0].SetChess(Chess(&JuChessRule::Singleton(), kingdom_id));
@@ -780,6 +1311,59 @@ std::string HalfBoard::ToHtml(const HalfBoard& b1, const HalfBoard& b2, const st
     return "<style>html,body{color:#6b421d; background:#d8bf81;}</style>\n" + table.ToString();
 }
 
+std::optional<ComputerMove> BoardMgr::SearchComputerMove(const uint32_t player_id, const KingdomId kingdom_id,
+        const std::chrono::milliseconds budget) const
+{
+    struct Candidate
+    {
+        uint32_t map_id_;
+        std::bitset<SearchBoard::k_area_num> src_areas_;
+        std::bitset<SearchBoard::k_area_num> occupied_dst_areas_; // other kingdoms of the player have moved here
+    };
+    std::vector<Candidate> candidates;
+    for (uint32_t map_id = 0; map_id < kingdom_oppo_pairs_.size() / 2; ++map_id) {
+        const auto& half_board = kingdoms_[kingdom_oppo_pairs_[map_id].ToUInt()]->half_board_;
+        Candidate candidate{.map_id_ = map_id};
+        for (int32_t i = 0; i < SearchBoard::k_area_num; ++i) {
+            const auto& area = half_board.Get(SearchBoard::ToCoor(i));
+            candidate.src_areas_[i] = area.GetChess().has_value() && area.GetChess()->kingdom_id_ == kingdom_id;
+            // The pending moves of other players are hidden, so only the ones of the player are visible.
+            candidate.occupied_dst_areas_[i] = std::ranges::any_of(area.ChessesMovedHere(), [&](const Chess& chess)
+                    {
+                        return chess.kingdom_id_ != kingdom_id &&
+                               kingdoms_[chess.kingdom_id_.ToUInt()]->player_id_ == player_id;
+                    });
+        }
+        if (candidate.src_areas_.any()) {
+            candidates.emplace_back(std::move(candidate));
+        }
+    }
+    const auto get_side = [&](const Chess& chess)
+        {
+            const auto& kingdom = *kingdoms_[chess.kingdom_id_.ToUInt()];
+            return kingdom.state_ == KingdomInfo::State::DESTROYED ? SearchBoard::Side::NEUTRAL :
+                   kingdom.player_id_ == player_id                 ? SearchBoard::Side::SELF    :
+                                                                     SearchBoard::Side::OPPO;
+        };
+    std::optional<ComputerMove> best_move;
+    int32_t best_gain = 0;
+    SearchEngine engine;
+    for (const auto& candidate : candidates) {
+        const auto& half_board = kingdoms_[kingdom_oppo_pairs_[candidate.map_id_].ToUInt()]->half_board_;
+        const auto board = SearchBoard::Make(half_board, get_side);
+        const auto result = engine.Search(board, budget / candidates.size(), [&](const SearchMove move)
+                {
+                    return candidate.src_areas_[move.src_] && !candidate.occupied_dst_areas_[move.dst_];
+                });
+        if (result.has_value() && (!best_move.has_value() || result->score_ - board.Evaluate() > best_gain)) {
+            best_gain = result->score_ - board.Evaluate();
+            best_move = ComputerMove{candidate.map_id_, SearchBoard::ToCoor(result->move_.src_),
+                SearchBoard::ToCoor(result->move_.dst_)};
+        }
+    }
+    return best_move;
+}
+
 } // namespace chinese_chess
 
 } // namespace game_util
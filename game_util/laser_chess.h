@@ -11,6 +11,9 @@
 #include <array>
 #include <bitset>
 #include <iostream>
+#include <memory>
+#include <chrono>
+#include <algorithm>
 #include <utility> // g++12 has a bug which will cause 'exchange' is not a member of 'std'
 
 #include "utility/html.h"
@@ -332,17 +335,26 @@ class Area
         return std::visit([is_clock_wise](auto& chess) { return chess.Rotate(is_clock_wise); }, chess_);
     }
 
-    std::bitset<4> HandleLaser(const int direct)
+    bool CanRotate(const bool is_clock_wise) const
     {
-        if (laser_tracker_.test(direct)) {
-            return {};
-        }
-        laser_tracker_.set(direct);
-        const auto result = std::visit([direct](const auto& chess) { return chess.HandleLaser(direct); }, chess_);
-        is_dead_ |= result.is_dead_;
-        return result.next_directs_;
+        auto chess = chess_;
+        return std::visit([is_clock_wise](auto& chess) { return chess.Rotate(is_clock_wise); }, chess);
+    }
+
+    LaserResult HandleLaser(const int direct) const
+    {
+        return std::visit([direct](const auto& chess) { return chess.HandleLaser(direct); }, chess_);
     }
 
+    // Record the laser passing through this area, which will be rendered and settled.
+    void SetLaser(const std::bitset<4>& laser_tracker, const bool is_dead)
+    {
+        laser_tracker_ = laser_tracker;
+        is_dead_ = is_dead;
+    }
+
+    bool IsKing() const { return CheckType<KingChess<0>>() || CheckType<KingChess<1>>(); }
+
     std::string Image() const
     {
         return std::visit([&](const auto& chess) { return chess.Image(laser_tracker_); }, chess_);
@@ -379,6 +391,39 @@ class Area
 
 auto coor_to_str (const Coor& coor) { return char('A' + coor.m_) + std::to_string(coor.n_); };
 
+static constexpr uint32_t k_max_area_num = 256;
+
+// The result of tracing the lasers of both shooters. The tracing does not modify the board and needs no heap allocation.
+class LaserTrace
+{
+  public:
+    std::bitset<4> Tracker(const uint32_t area_idx) const
+    {
+        std::bitset<4> tracker;
+        for (const Direct direct : {UP, RIGHT, DOWN, LEFT}) {
+            tracker[direct] = trackers_[area_idx * 4 + direct];
+        }
+        return tracker;
+    }
+
+    bool IsDead(const uint32_t area_idx) const { return dead_areas_.test(area_idx); }
+
+  private:
+    friend class Board;
+
+    std::bitset<k_max_area_num * 4> trackers_;
+    std::bitset<k_max_area_num> dead_areas_;
+};
+
+struct Action
+{
+    enum class Type : uint8_t { PASS, MOVE, CLOCKWISE, ANTICLOCKWISE };
+
+    Type type_ = Type::PASS;
+    Coor src_;
+    Coor dst_; // only valid for MOVE
+};
+
 class Board
 {
   public:
@@ -386,16 +431,45 @@ class Board
         : max_m_(max_m)
         , max_n_(max_n)
         , image_path_(std::move(image_path))
-        , areas_(max_m * max_n)
+        , areas_(std::make_shared<std::vector<Area>>(max_m * max_n))
         , chess_count_{0}
-        , is_shooting_(false)
     {
         assert(max_m > 0);
         assert(max_n > 0);
+        assert(max_m * max_n <= k_max_area_num);
     }
 
+    // Copying a board is cheap because the areas are shared until one of the boards is modified.
+    Board(const Board&) = default;
     Board(Board&&) = default;
 
+    // A snapshot shares the areas with the board as well, so taking a snapshot before trying actions and restoring it
+    // afterwards only copies the areas once.
+    class Snapshot
+    {
+      private:
+        friend class Board;
+        std::shared_ptr<std::vector<Area>> areas_;
+        std::array<Coor, 2> shooter_pos_;
+        std::array<uint32_t, 2> chess_count_;
+    };
+
+    Snapshot TakeSnapshot() const
+    {
+        Snapshot snapshot;
+        snapshot.areas_ = areas_;
+        snapshot.shooter_pos_ = shooter_pos_;
+        snapshot.chess_count_ = chess_count_;
+        return snapshot;
+    }
+
+    void Restore(const Snapshot& snapshot)
+    {
+        areas_ = snapshot.areas_;
+        shooter_pos_ = snapshot.shooter_pos_;
+        chess_count_ = snapshot.chess_count_;
+    }
+
     bool IsMyChess(const Coor& coor, const bool pid) const
     {
         return GetArea_(coor).IsMyChess(pid);
@@ -413,12 +487,10 @@ class Board
             std::is_same_v<std::decay_t<T>, ShooterChess<true>> || std::is_same_v<std::decay_t<T>, ShooterChess<false>>;
         const bool pid = chess.IsMyChess(1);
         auto& shooter_pos = shooter_pos_[pid];
-        assert(!is_shooting_);
-        auto& area = GetArea_(coor);
-        if (!area.Empty() || (is_shooter && IsValidCoor(shooter_pos))) {
+        if (!GetArea_(coor).Empty() || (is_shooter && IsValidCoor(shooter_pos))) {
             return false;
         }
-        area.SetChess(std::forward<T>(chess));
+        MutableArea_(coor).SetChess(std::forward<T>(chess));
         ++chess_count_[pid];
         if (is_shooter) {
             shooter_pos = coor;
@@ -428,41 +500,17 @@ class Board
 
     std::string Move(const Coor& src, const Coor& dst, const bool pid)
     {
-        assert(!is_shooting_);
-        if (!IsValidCoor(src)) {
-            return std::string("位置 ") + coor_to_str(src) + " 并不位于棋盘上";
-        }
-        if (!IsValidCoor(dst)) {
-            return "您无法将棋子移动至棋盘外";
-        }
-        auto& src_area = GetArea_(src);
-        auto& dst_area = GetArea_(dst);
-        if (!src_area.IsMyChess(pid) || src_area.GetState() != Area::IDL) {
-            return std::string("移动前位置 ") + coor_to_str(src) + " 上无可移动的本方棋子";
-        }
-        if (IsNearbyKing(src)) {
-            return std::string("移动前位置 ") + coor_to_str(src) + " 与王相邻，无法移动";
-        }
-        if (!src_area.CanMove()) {
-            return std::string("移动前位置 ") + coor_to_str(src) + " 上的棋子无法被移动";
+        if (const auto errmsg = ErrMsg_(CheckMove_(src, dst, pid), src); !errmsg.empty()) {
+            return errmsg;
         }
+        auto& src_area = MutableArea_(src);
+        auto& dst_area = MutableArea_(dst);
         if (dst_area.GetState() == Area::DST) { // crash
             src_area.SetChess(EmptyChess());
             src_area.SetState(Area::SRC);
             dst_area.SetChess(EmptyChess());
             return "";
         }
-        if (dst_area.IsMyChess(1 - pid) || dst_area.GetState() != Area::IDL) {
-            return std::string("移动后位置 ") + coor_to_str(src) + " 上无可移动的本方棋子，故无法交换棋子位置";
-        }
-        if (!dst_area.Empty()) {
-            if (IsNearbyKing(dst)) {
-                return std::string("移动后位置 ") + coor_to_str(src) + " 与王相邻，无法移动，故无法交换棋子位置";
-            }
-            if (!src_area.CanMove()) {
-                return std::string("移动后位置 ") + coor_to_str(src) + " 上的棋子无法被移动，故无法交换棋子位置";
-            }
-        }
         src_area.SetState(Area::SRC);
         dst_area.SetState(dst_area.Empty() ? Area::DST : Area::SRC);
         Area::SwapChess(dst_area, src_area);
@@ -471,49 +519,119 @@ class Board
 
     std::string Rotate(const Coor& coor, const bool is_clock_wise, const bool pid)
     {
-        assert(!is_shooting_);
-        if (!IsValidCoor(coor)) {
-            return std::string("位置 ") + coor_to_str(coor) + " 并不位于棋盘上";
-        }
-        if (IsNearbyKing(coor)) {
-            return std::string("位置") + coor_to_str(coor) + " 与王相邻，无法旋转";
-        }
-        auto& area = GetArea_(coor);
-        if (!area.IsMyChess(pid) || area.GetState() != Area::IDL) {
-            return std::string("位置 ") + coor_to_str(coor) + " 上无可旋转的本方棋子";
-        }
-        if (!area.Rotate(is_clock_wise)) {
-            return std::string("位置 ") + coor_to_str(coor) + " 上的棋子无法被如此旋转";
+        if (const auto errmsg = ErrMsg_(CheckRotate_(coor, is_clock_wise, pid), coor); !errmsg.empty()) {
+            return errmsg;
         }
+        auto& area = MutableArea_(coor);
+        area.Rotate(is_clock_wise);
         area.SetState(Area::SRC);
         return "";
     }
 
+    std::string Act(const Action& action, const bool pid)
+    {
+        switch (action.type_) {
+            case Action::Type::MOVE: return Move(action.src_, action.dst_, pid);
+            case Action::Type::CLOCKWISE: return Rotate(action.src_, true, pid);
+            case Action::Type::ANTICLOCKWISE: return Rotate(action.src_, false, pid);
+            default: return "";
+        }
+    }
+
+    // Append all legal actions of the player to `actions`, including passing. The vector can be reused between calls
+    // to avoid allocation.
+    void LegalActions(const bool pid, std::vector<Action>& actions) const
+    {
+        actions.clear();
+        actions.emplace_back();
+        for (int32_t m = 0; m < max_m_; ++m) {
+            for (int32_t n = 0; n < max_n_; ++n) {
+                const Coor src{m, n};
+                if (!GetArea_(src).IsMyChess(pid)) {
+                    continue;
+                }
+                for (const auto type : {Action::Type::CLOCKWISE, Action::Type::ANTICLOCKWISE}) {
+                    if (CheckRotate_(src, type == Action::Type::CLOCKWISE, pid) == ErrCode::OK) {
+                        actions.emplace_back(type, src);
+                    }
+                }
+                for (int32_t dm = -1; dm <= 1; ++dm) {
+                    for (int32_t dn = -1; dn <= 1; ++dn) {
+                        if (const Coor dst{m + dm, n + dn}; (dm != 0 || dn != 0) && CheckMove_(src, dst, pid) == ErrCode::OK) {
+                            actions.emplace_back(Action::Type::MOVE, src, dst);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     uint32_t ChessCount(const bool pid) const { return chess_count_[pid]; }
 
-    SettleResult Settle()
+    SettleResult Settle(const bool with_html = true)
     {
-        is_shooting_ = true;
-        RecursiveHandleLaser_(shooter_pos_[0], UP);
-        RecursiveHandleLaser_(shooter_pos_[1], UP);
+        const auto trace = TraceLaser();
+        auto& areas = MutableAreas_();
+        for (uint32_t i = 0; i < areas.size(); ++i) {
+            areas[i].SetLaser(trace.Tracker(i), trace.IsDead(i));
+        }
 
-        assert(is_shooting_);
-        is_shooting_ = false;
         SettleResult result {0};
 
-        result.html_ += ToHtml();
+        if (with_html) {
+            result.html_ += ToHtml();
+        }
 
-        for (auto& area : areas_) {
+        for (auto& area : areas) {
             area.Settle(result);
         }
         chess_count_[0] -= result.chess_dead_num_[0] + result.crashed_;
         chess_count_[1] -= result.chess_dead_num_[1] + result.crashed_;
 
-        result.html_ += "<br />\n\n" + ToHtml();
+        if (with_html) {
+            result.html_ += "<br />\n\n" + ToHtml();
+        }
 
         return result;
     }
 
+    // Each pair of area and incoming direct is visited at most once, so the pending lasers are bounded by the number
+    // of areas and can be kept in a fixed-size stack.
+    LaserTrace TraceLaser() const
+    {
+        LaserTrace trace;
+        std::array<std::pair<uint8_t, uint8_t>, k_max_area_num * 4> pending_lasers;
+        uint32_t pending_num = 0;
+        const auto push = [&](const Coor& coor, const int direct)
+            {
+                if (!IsValidCoor(coor)) {
+                    return;
+                }
+                const uint32_t area_idx = coor.m_ * max_n_ + coor.n_;
+                if (trace.trackers_.test(area_idx * 4 + direct)) {
+                    return;
+                }
+                trace.trackers_.set(area_idx * 4 + direct);
+                pending_lasers[pending_num++] = {area_idx, direct};
+            };
+        push(shooter_pos_[0], UP);
+        push(shooter_pos_[1], UP);
+        while (pending_num > 0) {
+            const auto [area_idx, direct] = pending_lasers[--pending_num];
+            const auto result = (*areas_)[area_idx].HandleLaser(direct);
+            if (result.is_dead_) {
+                trace.dead_areas_.set(area_idx);
+            }
+            const Coor coor{static_cast<int32_t>(area_idx / max_n_), static_cast<int32_t>(area_idx % max_n_)};
+            for (const Direct next_direct : {UP, RIGHT, DOWN, LEFT}) {
+                if (result.next_directs_.test(next_direct)) {
+                    push(coor + DirectMove(next_direct), next_direct);
+                }
+            }
+        }
+        return trace;
+    }
+
     bool IsValidCoor(const Coor& coor) const
     {
         return coor.m_ >= 0 && coor.n_ >= 0 && coor.m_ < max_m_ && coor.n_ < max_n_;
@@ -545,15 +663,92 @@ class Board
     uint32_t max_m() const { return max_m_; }
     uint32_t max_n() const { return max_n_; }
 
+    const Area& GetArea(const Coor& coor) const { return GetArea_(coor); }
+
   private:
+    enum class ErrCode { OK, SRC_OUT_OF_BOARD, DST_OUT_OF_BOARD, SRC_NOT_MOVABLE, SRC_NEARBY_KING, SRC_CANNOT_MOVE,
+                         DST_NOT_SWAPPABLE, DST_NEARBY_KING, DST_CANNOT_MOVE, NOT_ROTATABLE, ROTATE_NEARBY_KING, CANNOT_ROTATE };
+
+    ErrCode CheckMove_(const Coor& src, const Coor& dst, const bool pid) const
+    {
+        if (!IsValidCoor(src)) {
+            return ErrCode::SRC_OUT_OF_BOARD;
+        }
+        if (!IsValidCoor(dst)) {
+            return ErrCode::DST_OUT_OF_BOARD;
+        }
+        const auto& src_area = GetArea_(src);
+        const auto& dst_area = GetArea_(dst);
+        if (!src_area.IsMyChess(pid) || src_area.GetState() != Area::IDL) {
+            return ErrCode::SRC_NOT_MOVABLE;
+        }
+        if (IsNearbyKing(src)) {
+            return ErrCode::SRC_NEARBY_KING;
+        }
+        if (!src_area.CanMove()) {
+            return ErrCode::SRC_CANNOT_MOVE;
+        }
+        if (dst_area.GetState() == Area::DST) { // crash
+            return ErrCode::OK;
+        }
+        if (dst_area.IsMyChess(1 - pid) || dst_area.GetState() != Area::IDL) {
+            return ErrCode::DST_NOT_SWAPPABLE;
+        }
+        if (!dst_area.Empty()) {
+            if (IsNearbyKing(dst)) {
+                return ErrCode::DST_NEARBY_KING;
+            }
+            if (!src_area.CanMove()) {
+                return ErrCode::DST_CANNOT_MOVE;
+            }
+        }
+        return ErrCode::OK;
+    }
+
+    ErrCode CheckRotate_(const Coor& coor, const bool is_clock_wise, const bool pid) const
+    {
+        if (!IsValidCoor(coor)) {
+            return ErrCode::SRC_OUT_OF_BOARD;
+        }
+        if (IsNearbyKing(coor)) {
+            return ErrCode::ROTATE_NEARBY_KING;
+        }
+        const auto& area = GetArea_(coor);
+        if (!area.IsMyChess(pid) || area.GetState() != Area::IDL) {
+            return ErrCode::NOT_ROTATABLE;
+        }
+        if (!area.CanRotate(is_clock_wise)) {
+            return ErrCode::CANNOT_ROTATE;
+        }
+        return ErrCode::OK;
+    }
+
+    static std::string ErrMsg_(const ErrCode errcode, const Coor& coor)
+    {
+        switch (errcode) {
+            case ErrCode::OK: return "";
+            case ErrCode::SRC_OUT_OF_BOARD: return std::string("位置 ") + coor_to_str(coor) + " 并不位于棋盘上";
+            case ErrCode::DST_OUT_OF_BOARD: return "您无法将棋子移动至棋盘外";
+            case ErrCode::SRC_NOT_MOVABLE: return std::string("移动前位置 ") + coor_to_str(coor) + " 上无可移动的本方棋子";
+            case ErrCode::SRC_NEARBY_KING: return std::string("移动前位置 ") + coor_to_str(coor) + " 与王相邻，无法移动";
+            case ErrCode::SRC_CANNOT_MOVE: return std::string("移动前位置 ") + coor_to_str(coor) + " 上的棋子无法被移动";
+            case ErrCode::DST_NOT_SWAPPABLE: return std::string("移动后位置 ") + coor_to_str(coor) + " 上无可移动的本方棋子，故无法交换棋子位置";
+            case ErrCode::DST_NEARBY_KING: return std::string("移动后位置 ") + coor_to_str(coor) + " 与王相邻，无法移动，故无法交换棋子位置";
+            case ErrCode::DST_CANNOT_MOVE: return std::string("移动后位置 ") + coor_to_str(coor) + " 上的棋子无法被移动，故无法交换棋子位置";
+            case ErrCode::NOT_ROTATABLE: return std::string("位置 ") + coor_to_str(coor) + " 上无可旋转的本方棋子";
+            case ErrCode::ROTATE_NEARBY_KING: return std::string("位置") + coor_to_str(coor) + " 与王相邻，无法旋转";
+            case ErrCode::CANNOT_ROTATE: return std::string("位置 ") + coor_to_str(coor) + " 上的棋子无法被如此旋转";
+        }
+        return "";
+    }
+
     bool IsNearbyKing(const Coor& coor) const
     {
         for (int32_t m = coor.m_ - 1; m <= coor.m_ + 1; ++m) {
             for (int32_t n = coor.n_ - 1; n <= coor.n_ + 1; ++n) {
                 const Coor cur_coor{.m_ = m, .n_ = n};
-                const auto& area = GetArea_(cur_coor);
-                if ((m != coor.m_ || n != coor.n_) && IsValidCoor(cur_coor) && area.GetState() != Area::DST &&
-                        (area.CheckType<KingChess<0>>() || area.CheckType<KingChess<1>>())) {
+                if ((m != coor.m_ || n != coor.n_) && IsValidCoor(cur_coor) && GetArea_(cur_coor).GetState() != Area::DST &&
+                        GetArea_(cur_coor).IsKing()) {
                     return true;
                 }
             }
@@ -561,31 +756,126 @@ class Board
         return false;
     }
 
-    void RecursiveHandleLaser_(const Coor& coor, const int direct)
+    // Copy the areas before modification if they are shared with other boards or snapshots.
+    std::vector<Area>& MutableAreas_()
     {
-        if (!IsValidCoor(coor)) {
-            return;
-        }
-        const auto next_directs = GetArea_(coor).HandleLaser(direct);
-        for (const Direct next_direct : {UP, RIGHT, DOWN, LEFT}) {
-            if (next_directs.test(next_direct)) {
-                RecursiveHandleLaser_(coor + DirectMove(next_direct), next_direct);
-            }
+        if (areas_.use_count() > 1) {
+            areas_ = std::make_shared<std::vector<Area>>(*areas_);
         }
+        return *areas_;
     }
 
-    Area& GetArea_(const Coor& coor) { return areas_[coor.m_ * max_n_ + coor.n_]; }
-    const Area& GetArea_(const Coor& coor) const { return areas_[coor.m_ * max_n_ + coor.n_]; }
+    Area& MutableArea_(const Coor& coor) { return MutableAreas_()[coor.m_ * max_n_ + coor.n_]; }
+    const Area& GetArea_(const Coor& coor) const { return (*areas_)[coor.m_ * max_n_ + coor.n_]; }
 
     const uint32_t max_m_;
     const uint32_t max_n_;
     const std::string image_path_;
-    std::vector<Area> areas_;
+    std::shared_ptr<std::vector<Area>> areas_;
     std::array<Coor, 2> shooter_pos_;
     std::array<uint32_t, 2> chess_count_;
-    bool is_shooting_;
 };
 
+// `Minimax` chooses an action by a shallow minimax search: each action is scored by the worst result among the
+// opponent's replies, and each result is the material after both lasers are shot. Actions are searched in order
+// until the budget is exhausted, so the time of each search is bounded by the budget plus the time of evaluating one
+// action.
+class Minimax
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    Minimax(const Board& board, const bool pid) : board_(board), pid_(pid) {}
+
+    // If the opponent has already acted in this round, its action is on the board and its replies are not searched.
+    Action Search(const bool is_opponent_acted, const Clock::duration budget)
+    {
+        const auto deadline = Clock::now() + budget;
+        board_.LegalActions(pid_, actions_);
+        const auto snapshot = board_.TakeSnapshot();
+        Action best_action;
+        int64_t best_value = INT64_MIN;
+        for (const auto& action : actions_) {
+            const auto errmsg = board_.Act(action, pid_);
+            assert(errmsg.empty());
+            const int64_t value = is_opponent_acted ? Evaluate_() : WorstReply_();
+            board_.Restore(snapshot);
+            if (value > best_value) {
+                best_value = value;
+                best_action = action;
+            }
+            if (Clock::now() > deadline) {
+                break;
+            }
+        }
+        return best_action;
+    }
+
+  private:
+    static constexpr int64_t k_king_value = 1000;
+    static constexpr int64_t k_chess_value = 10;
+
+    int64_t WorstReply_()
+    {
+        board_.LegalActions(!pid_, reply_actions_);
+        const auto snapshot = board_.TakeSnapshot();
+        int64_t worst_value = INT64_MAX;
+        for (const auto& action : reply_actions_) {
+            const auto errmsg = board_.Act(action, !pid_);
+            assert(errmsg.empty());
+            worst_value = std::min(worst_value, Evaluate_());
+            board_.Restore(snapshot);
+        }
+        return worst_value;
+    }
+
+    int64_t Evaluate_() const
+    {
+        const auto trace = board_.TraceLaser();
+        int64_t value = 0;
+        for (int32_t m = 0; m < board_.max_m(); ++m) {
+            for (int32_t n = 0; n < board_.max_n(); ++n) {
+                const auto& area = board_.GetArea(Coor{m, n});
+                if (area.Empty() || trace.IsDead(m * board_.max_n() + n)) {
+                    continue;
+                }
+                value += (area.IsMyChess(pid_) ? 1 : -1) * (area.IsKing() ? k_king_value : k_chess_value);
+            }
+        }
+        return value;
+    }
+
+    Board board_;
+    const bool pid_;
+    std::vector<Action> actions_;
+    std::vector<Action> reply_actions_;
+};
+
+// Count the leaves of the action tree with `depth` actions, in which players act alternately and the board is settled
+// after both players acted. It is used to verify and benchmark the action generation.
+inline uint64_t Perft(Board& board, const uint32_t depth, const bool pid = 0)
+{
+    if (depth == 0) {
+        return 1;
+    }
+    std::vector<Action> actions;
+    board.LegalActions(pid, actions);
+    if (depth == 1) {
+        return actions.size();
+    }
+    const auto snapshot = board.TakeSnapshot();
+    uint64_t count = 0;
+    for (const auto& action : actions) {
+        board.Act(action, pid);
+        if (pid) {
+            board.Settle(false);
+        }
+        count += Perft(board, depth - 1, !pid);
+        board.Restore(snapshot);
+    }
+    return count;
+}
+
 } // namespace laser_chess
 
 } // namespace game_util
@@ -13,6 +13,10 @@
 #include <numeric>
 #include <iostream>
 #include <map>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
 
 #include "../utility/html.h"
 
@@ -27,20 +31,20 @@ enum class Direct { TOP_LEFT = 0, VERT = 1, TOP_RIGHT = 2};
 
 struct Coordinate
 {
-    Coordinate& operator+=(const Coordinate& c)
+    constexpr Coordinate& operator+=(const Coordinate& c)
     {
         x_ += c.x_;
         y_ += c.y_;
         return *this;
     }
 
-    friend Coordinate operator+(const Coordinate& _1, const Coordinate& _2)
+    friend constexpr Coordinate operator+(const Coordinate& _1, const Coordinate& _2)
     {
         Coordinate tmp(_1);
         return tmp += _2;
     }
 
-    Coordinate operator-() const { return Coordinate{-x_, -y_}; }
+    constexpr Coordinate operator-() const { return Coordinate{-x_, -y_}; }
 
     auto operator<=>(const Coordinate&) const = default;
 
@@ -48,10 +52,23 @@ struct Coordinate
     int32_t y_;
 };
 
-template <Direct direct> const Coordinate k_direct_step;
-template <> const Coordinate k_direct_step<Direct::TOP_LEFT>{1, 1};
-template <> const Coordinate k_direct_step<Direct::VERT>{0, 2};
-template <> const Coordinate k_direct_step<Direct::TOP_RIGHT>{-1, 1};
+static constexpr std::array<Coordinate, k_direct_max> k_direct_steps{Coordinate{1, 1}, Coordinate{0, 2}, Coordinate{-1, 1}};
+
+template <Direct direct> constexpr Coordinate k_direct_step = k_direct_steps[static_cast<uint32_t>(direct)];
+
+// A packed card keeps the point of each direct in 4 bits (0 means wild), and the highest bit is set once the area is
+// filled, so that an empty area is simply 0.
+using PackedCard = uint16_t;
+static constexpr PackedCard k_empty_card = 0;
+static constexpr PackedCard k_wild_card = 0x8000;
+static constexpr int32_t k_wild_score_sum = 30;
+
+constexpr int32_t PackedPoint(const PackedCard card, const uint32_t direct) { return (card >> (direct * 4)) & 0xF; }
+
+constexpr int32_t PackedPointSum(const PackedCard card)
+{
+    return card == k_wild_card ? k_wild_score_sum : PackedPoint(card, 0) + PackedPoint(card, 1) + PackedPoint(card, 2);
+}
 
 class AreaCard
 {
@@ -60,6 +77,12 @@ class AreaCard
 
     AreaCard(const int32_t a, const int32_t b, const int32_t c) : points_(std::in_place, std::array<int32_t, k_direct_max>{a, b, c}) {}
 
+    static AreaCard Unpack(const PackedCard card)
+    {
+        assert(card != k_empty_card);
+        return card == k_wild_card ? AreaCard() : AreaCard(PackedPoint(card, 0), PackedPoint(card, 1), PackedPoint(card, 2));
+    }
+
     template <Direct direct>
     bool IsMatch(const int32_t point) const { return !points_.has_value() || points_->at(static_cast<uint32_t>(direct)) == point; }
 
@@ -97,243 +120,539 @@ class AreaCard
 
     bool IsWild() const { return !points_.has_value(); }
 
+    PackedCard Pack() const
+    {
+        if (!points_.has_value()) {
+            return k_wild_card;
+        }
+        PackedCard card = k_wild_card;
+        for (uint32_t i = 0; i < k_direct_max; ++i) {
+            assert((*points_)[i] > 0 && (*points_)[i] < 16);
+            card |= (*points_)[i] << (i * 4);
+        }
+        return card;
+    }
+
   private:
-    static constexpr int32_t k_wild_score_sum = 30;
     std::optional<std::array<int32_t, k_direct_max>> points_;
 };
 
-class Wall
+struct FillResult
 {
-  public:
-    friend class Comb;
+    int32_t point_;
+    uint32_t line_;
+    friend FillResult operator+(const FillResult& _1, const FillResult& _2)
+    {
+        return FillResult{.point_ = _1.point_ + _2.point_, .line_ = _1.line_ + _2.line_};
+    }
+};
 
-    Wall(html::Box& box) : box_(box), has_line_{false, false, false} {}
+static constexpr uint32_t k_size = 3;
+static constexpr uint32_t k_area_num = 20; // the zero area and the 19 areas of the hexagon
+static constexpr uint32_t k_line_num_per_direct = k_size * 2 - 1;
+static constexpr uint32_t k_line_num = k_line_num_per_direct * k_direct_max;
 
-    template <Direct direct>
-    void SetLine() { has_line_.at(static_cast<uint32_t>(direct)) = true; }
+// The zero area is out of the hexagon, and the card filled into it does not form any lines.
+static constexpr Coordinate k_zero_coordinate{2, -6};
 
-    std::string ImageName() const
+constexpr bool IsValidCoordinate(const Coordinate coordinate)
+{
+    const int32_t abs_x = coordinate.x_ < 0 ? -coordinate.x_ : coordinate.x_;
+    const int32_t abs_y = coordinate.y_ < 0 ? -coordinate.y_ : coordinate.y_;
+    return abs_x + abs_y < k_size * 2 && abs_x < k_size && (coordinate.x_ + coordinate.y_) % 2 == 0;
+}
+
+// -2 -1  0  1  2       value of coordinate.x
+//              x
+//           x
+//        .     x
+//     .     .          (. + x) is the initial count (left of coordinate.x)
+//  .     .     .
+//     .     .          x is to-remove count
+//  .     .     .
+//     .     .          . is the real count
+//  .     .     .
+//     .     .
+//        .     x
+//           x          then idx the real count + (coordinate.y offset value)
+//              x
+constexpr uint32_t CoordinateToIndex(const Coordinate coordinate)
+{
+    const int32_t level = coordinate.x_ + k_size - 1;
+    uint32_t idx = (k_size + k_size + level - 1) * level / 2;
+    if (coordinate.x_ > 1) { // x == 2
+        idx -= (coordinate.x_ - 1) * coordinate.x_; // idx -= 2
+    }
+    idx += (coordinate.y_ + k_size * 2 - (coordinate.x_ < 0 ? -coordinate.x_ : coordinate.x_)) / 2;
+    return idx;
+}
+
+// The static geometry of the comb, which is shared by all comb states.
+struct Layout
+{
+    struct Line
     {
-        std::string str = "wall_";
-        for (const bool has_line : has_line_) {
-            str += std::to_string(has_line);
+        std::array<uint8_t, k_size * 2 - 1> areas_; // ordered from the tail to the head of the line
+        uint8_t size_;
+    };
+
+    static constexpr uint8_t k_no_line = UINT8_MAX;
+
+    std::array<Coordinate, k_area_num> coordinates_;
+    std::array<Line, k_line_num> lines_; // the line of `direct` has the index of `direct * k_line_num_per_direct + n`
+    std::array<std::array<uint8_t, k_direct_max>, k_area_num> area_lines_;
+};
+
+constexpr Layout MakeLayout()
+{
+    Layout layout{};
+    uint32_t area_idx = 0;
+    layout.coordinates_[area_idx++] = k_zero_coordinate;
+    layout.area_lines_[0].fill(Layout::k_no_line);
+    for (int32_t x = 1 - static_cast<int32_t>(k_size); x < static_cast<int32_t>(k_size); ++x) {
+        for (int32_t y = 1 - static_cast<int32_t>(k_size) * 2; y < static_cast<int32_t>(k_size) * 2; ++y) {
+            if (IsValidCoordinate(Coordinate{x, y})) {
+                layout.coordinates_[area_idx++] = Coordinate{x, y};
+            }
         }
-        return str;
     }
+    for (uint32_t direct = 0; direct < k_direct_max; ++direct) {
+        uint32_t line_idx = direct * k_line_num_per_direct;
+        for (uint32_t tail_idx = 1; tail_idx < k_area_num; ++tail_idx) {
+            if (IsValidCoordinate(layout.coordinates_[tail_idx] + -k_direct_steps[direct])) {
+                continue; // not the tail of a line
+            }
+            auto& line = layout.lines_[line_idx];
+            for (auto coor = layout.coordinates_[tail_idx]; IsValidCoordinate(coor); coor += k_direct_steps[direct]) {
+                const uint32_t idx = CoordinateToIndex(coor);
+                line.areas_[line.size_++] = idx;
+                layout.area_lines_[idx][direct] = line_idx;
+            }
+            ++line_idx;
+        }
+    }
+    return layout;
+}
 
-  private:
-    html::Box& box_;
-    std::array<bool, k_direct_max> has_line_;
-};
+inline constexpr Layout k_layout = MakeLayout();
 
-class Area
+// `CombState` is the compact value-type state of a comb. It has nothing to do with rendering, so it can be copied
+// cheaply when searching.
+class CombState
 {
   public:
-    friend class Comb;
+    FillResult Fill(const uint32_t idx, const PackedCard card)
+    {
+        assert(idx < k_area_num && !IsFilled(idx) && card != k_empty_card);
+        cards_[idx] = card;
+        FillResult result{0, 0};
+        if (idx == 0) {
+            result.point_ = PackedPointSum(card);
+        } else {
+            for (uint32_t direct = 0; direct < k_direct_max; ++direct) {
+                const uint32_t line_idx = k_layout.area_lines_[idx][direct];
+                if (const auto point = LinePoint(line_idx); point.has_value()) {
+                    // TODO: all wild is an impossible case, we should limit number of wild card less than k_size
+                    result.point_ += *point == 0 ? 10000 : *point * k_layout.lines_[line_idx].size_;
+                    ++result.line_;
+                    completed_lines_ |= 1 << line_idx;
+                }
+            }
+        }
+        score_ += result.point_;
+        return result;
+    }
+
+    FillResult Fill(const uint32_t idx, const AreaCard& card) { return Fill(idx, card.Pack()); }
+
+    bool IsFilled(const uint32_t idx) const { return cards_[idx] != k_empty_card; }
+
+    PackedCard Card(const uint32_t idx) const { return cards_[idx]; }
 
-    Area(html::Box& box, const Coordinate coordinate) : box_(box), coordinate_(coordinate) {}
+    // Returns `k_area_num` if all areas are filled.
+    uint32_t FirstEmpty() const
+    {
+        return std::find(cards_.begin(), cards_.end(), k_empty_card) - cards_.begin();
+    }
+
+    int32_t Score() const { return score_; }
+
+    uint32_t LineCount() const { return std::popcount(completed_lines_); }
+
+    bool IsLineCompleted(const uint32_t line_idx) const { return (completed_lines_ >> line_idx) & 1; }
+
+    // Returns the point of the line if it is completed (0 if all cards are wild), otherwise returns `nullopt`.
+    std::optional<int32_t> LinePoint(const uint32_t line_idx) const
+    {
+        const auto& line = k_layout.lines_[line_idx];
+        const uint32_t direct = line_idx / k_line_num_per_direct;
+        int32_t point = 0;
+        for (uint32_t i = 0; i < line.size_; ++i) {
+            const PackedCard card = cards_[line.areas_[i]];
+            if (card == k_empty_card) {
+                return std::nullopt;
+            }
+            const int32_t card_point = PackedPoint(card, direct);
+            if (card_point == 0) { // wild card
+                continue;
+            }
+            if (point == 0) {
+                point = card_point;
+            } else if (point != card_point) {
+                return std::nullopt;
+            }
+        }
+        return point;
+    }
+
+    // Returns the matching requirement of an uncompleted line: `nullopt` if the line can never be completed, 0 if any
+    // point is acceptable, otherwise the point that each empty area must match.
+    std::optional<int32_t> LineRequirement(const uint32_t line_idx, uint32_t& empty_count) const
+    {
+        const auto& line = k_layout.lines_[line_idx];
+        const uint32_t direct = line_idx / k_line_num_per_direct;
+        int32_t point = 0;
+        empty_count = 0;
+        for (uint32_t i = 0; i < line.size_; ++i) {
+            const PackedCard card = cards_[line.areas_[i]];
+            if (card == k_empty_card) {
+                ++empty_count;
+                continue;
+            }
+            const int32_t card_point = PackedPoint(card, direct);
+            if (card_point == 0) {
+                continue;
+            }
+            if (point == 0) {
+                point = card_point;
+            } else if (point != card_point) {
+                return std::nullopt;
+            }
+        }
+        return point;
+    }
 
   private:
-    html::Box& box_;
-    Coordinate coordinate_;
-    std::optional<AreaCard> card_;
+    std::array<PackedCard, k_area_num> cards_{};
+    uint16_t completed_lines_{0};
+    int32_t score_{0};
 };
 
+static_assert(std::is_trivially_copyable_v<CombState>);
+
+// `Comb` renders a `CombState` with the images under `image_path`.
 class Comb
 {
   public:
-    Comb(std::string image_path) : image_path_(std::move(image_path)), table_(k_max_row, k_max_column)
+    using FillResult = numcomb::FillResult;
+
+    Comb(std::string image_path) : image_path_(std::move(image_path)) {}
+
+    FillResult Fill(const uint32_t idx, const AreaCard& card) { return state_.Fill(idx, card); }
+
+    std::pair<uint32_t, FillResult> SeqFill(const AreaCard& card)
     {
-        table_.SetTableStyle(" align=\"center\" cellpadding=\"0\" cellspacing=\"0\" ");
+        const uint32_t idx = state_.FirstEmpty();
+        if (idx == k_area_num) {
+            assert(false);
+            return {UINT32_MAX, FillResult{0, 0}}; // unexpected case
+        }
+        return {idx, state_.Fill(idx, card)};
+    }
 
-        static constexpr int32_t k_zero_row = 0;
-        static constexpr int32_t k_zero_col = k_size + 2;
-        static constexpr int32_t k_mid_row = k_size * 2;
-        static constexpr int32_t k_mid_col = k_size;
+    bool IsFilled(const uint32_t idx) const { return state_.IsFilled(idx); }
 
-        static const Coordinate zero_coor{k_zero_col - k_mid_col, k_zero_row - k_mid_row};
-        html::Box& zero_box = table_.Get(k_zero_row, k_zero_col);
-        areas_.emplace_back(zero_box, zero_coor);
+    const CombState& State() const { return state_; }
 
-        for (int32_t col = 0; col < table_.Column(); ++col) {
-            for (int32_t row = 0; row < table_.Row(); ++row) {
-                const Coordinate coor{col - k_mid_col, row - k_mid_row};
-                const bool is_full_box = (coor.x_ + coor.y_) % 2 == 0 && row != table_.Row() - 1;
+    std::string ToHtml() const
+    {
+        html::Table table(k_max_row, k_max_column);
+        table.SetTableStyle(" align=\"center\" cellpadding=\"0\" cellspacing=\"0\" ");
+        for (int32_t col = 0; col < table.Column(); ++col) {
+            for (int32_t row = 0; row < table.Row(); ++row) {
+                const Coordinate coor = TableCoordinate_(row, col);
+                const bool is_full_box = IsFullBox_(coor);
                 if (is_full_box) {
-                    table_.MergeDown(row, col, 2);
+                    table.MergeDown(row, col, 2);
                 }
-                html::Box& box = table_.Get(row, col);
-                if (IsValid_(coor) && is_full_box) {
-                    box.SetContent(Image_("num_" + std::to_string(areas_.size())));
-                    areas_.emplace_back(box, coor);
+                html::Box& box = table.Get(row, col);
+                if (coor == k_zero_coordinate || (IsValidCoordinate(coor) && is_full_box)) {
+                    const uint32_t idx = coor == k_zero_coordinate ? 0 : ToIndex(coor);
+                    box.SetContent(Image_(state_.IsFilled(idx) ? AreaCard::Unpack(state_.Card(idx)).ImageName() :
+                                                                 "num_" + std::to_string(idx)));
                 } else if (is_full_box) {
-                    const auto [it, succ] = walls_.emplace(coor, Wall(box));
-                    assert(succ);
-                    box.SetContent(Image_(it->second.ImageName()));
+                    box.SetContent(Image_(WallImageName_(coor)));
                 } else if (box.IsVisable()) {
                     box.SetContent(Image_("wall_half"));
                 }
             }
         }
+        return table.ToString();
+    }
+
+    static uint32_t ToIndex(const Coordinate coordinate) { return CoordinateToIndex(coordinate); }
 
-        const auto num = walls_.erase(zero_coor);
-        assert(num == 1);
-        zero_box.SetContent(Image_("num_0"));
+  private:
+    static constexpr uint32_t k_max_row = k_size * 4 + 2;
+    static constexpr uint32_t k_max_column = k_size * 2 + 1;
+    static constexpr int32_t k_mid_row = k_size * 2;
+    static constexpr int32_t k_mid_col = k_size;
+
+    static Coordinate TableCoordinate_(const int32_t row, const int32_t col) { return Coordinate{col - k_mid_col, row - k_mid_row}; }
+
+    static bool IsFullBox_(const Coordinate coor)
+    {
+        const int32_t row = coor.y_ + k_mid_row;
+        const int32_t col = coor.x_ + k_mid_col;
+        return row >= 0 && row < k_max_row - 1 && col >= 0 && col < k_max_column && (coor.x_ + coor.y_) % 2 == 0;
     }
 
-    Comb(const Comb& comb) = delete;
-    Comb(Comb&& comb) = delete;
+    static bool IsWall_(const Coordinate coor)
+    {
+        return IsFullBox_(coor) && !IsValidCoordinate(coor) && coor != k_zero_coordinate;
+    }
+
+    // A wall has a line of `direct` if walls between it and a completed line of `direct` are contiguous.
+    bool HasLine_(Coordinate coor, const uint32_t direct, const Coordinate step) const
+    {
+        for (; IsWall_(coor); coor += step)
+            ;
+        return IsValidCoordinate(coor) && state_.IsLineCompleted(k_layout.area_lines_[ToIndex(coor)][direct]);
+    }
 
-    struct FillResult
+    std::string WallImageName_(const Coordinate coor) const
     {
-        int32_t point_;
-        uint32_t line_;
-        friend FillResult operator+(const FillResult& _1, const FillResult& _2)
-        {
-            return FillResult{.point_ = _1.point_ + _2.point_, .line_ = _1.line_ + _2.line_};
+        std::string str = "wall_";
+        for (uint32_t direct = 0; direct < k_direct_max; ++direct) {
+            str += std::to_string(HasLine_(coor, direct, k_direct_steps[direct]) ||
+                                  HasLine_(coor, direct, -k_direct_steps[direct]));
         }
-    };
+        return str;
+    }
 
-    FillResult Fill(const uint32_t idx, const AreaCard& card)
+    std::string Image_(std::string name) const { return "![](file:///" + image_path_ + std::move(name) + ".png)"; }
+
+    std::string image_path_;
+    CombState state_;
+};
+
+// `CardPool` counts the cards which have not been revealed yet.
+class CardPool
+{
+  public:
+    void Add(const PackedCard card, const uint32_t num = 1)
     {
-        auto& area = areas_[idx];
-        area.card_ = card;
-        const auto img_str = Image_(card.ImageName());
-        area.box_.SetContent(img_str);
-        if (idx == 0) {
-            return {card.PointSum(), 0};
+        if (const auto it = std::ranges::find(kinds_, card, &Kind::card_); it != kinds_.end()) {
+            it->count_ += num;
         } else {
-            return Check_(area.coordinate_);
+            kinds_.emplace_back(card, num);
         }
+        total_ += num;
     }
 
-    std::pair<uint32_t, FillResult> SeqFill(const AreaCard& card)
+    void Add(const AreaCard& card, const uint32_t num = 1) { Add(card.Pack(), num); }
+
+    void Remove(const AreaCard& card)
     {
-        const auto img_str = Image_(card.ImageName());
-        if (!areas_[0].card_.has_value()) {
-            areas_[0].box_.SetContent(img_str);
-            areas_[0].card_ = card;
-            return {0, FillResult{card.PointSum(), 0}};
-        }
-        for (uint32_t i = 1; i < areas_.size(); ++i) {
-            auto& area = areas_[i];
-            if (!area.card_.has_value()) {
-                area.box_.SetContent(img_str);
-                area.card_ = card;
-                return {i, Check_(area.coordinate_)};
-            }
+        const auto it = std::ranges::find(kinds_, card.Pack(), &Kind::card_);
+        if (it != kinds_.end() && it->count_ > 0) {
+            --it->count_;
+            --total_;
         }
-        assert(false);
-        return {UINT32_MAX, FillResult{0, 0}}; // unexpected case
     }
 
-    void Clear(const uint32_t idx);
-
-    bool IsFilled(const uint32_t idx) const { return areas_[idx].card_.has_value(); }
-
-    std::string ToHtml() const { return table_.ToString(); } 
-
-    // -2 -1  0  1  2       value of coordinate.x
-    //              x
-    //           x
-    //        .     x
-    //     .     .          (. + x) is the initial count (left of coordinate.x)
-    //  .     .     .
-    //     .     .          x is to-remove count
-    //  .     .     .
-    //     .     .          . is the real count
-    //  .     .     .
-    //     .     .
-    //        .     x
-    //           x          then idx the real count + (coordinate.y offset value)
-    //              x
-    static uint32_t ToIndex(const Coordinate coordinate)
+    uint32_t Total() const { return total_; }
+
+  private:
+    friend class Expectimax;
+
+    struct Kind
+    {
+        PackedCard card_;
+        uint32_t count_;
+    };
+
+    std::vector<Kind> kinds_;
+    uint32_t total_{0};
+};
+
+// `Expectimax` chooses the area for a card by searching over the distribution of the unrevealed cards with iterative
+// deepening. Each depth contains a max node to fill a card and a chance node to reveal the next card. The leaf states
+// are estimated by the probability of completing each line with the remaining cards.
+class Expectimax
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // `remaining_rounds` is the number of cards to be revealed after the current card.
+    Expectimax(CardPool pool, const uint32_t remaining_rounds)
+        : pool_(std::move(pool)), remaining_rounds_(std::min(remaining_rounds, k_area_num))
+    {
+        InitLinePotentials_();
+    }
+
+    // Returns the index of the area to fill. The search of the first depth always finishes, so the result is valid even
+    // if the budget is exhausted.
+    uint32_t Search(const CombState& state, const AreaCard& card, const Clock::duration budget,
+            const uint32_t max_depth = k_area_num)
     {
-        const int32_t level = coordinate.x_ + k_size - 1;
-        uint32_t idx = (k_size + k_size + level - 1) * level / 2;
-        if (coordinate.x_ > 1) { // x == 2
-            idx -= (coordinate.x_ - 1) * coordinate.x_; // idx -= 2
+        deadline_ = Clock::now() + budget;
+        is_timeout_ = false;
+        finished_depth_ = 0;
+        uint32_t best_idx = state.FirstEmpty();
+        for (uint32_t depth = 1; depth <= std::min(max_depth, remaining_rounds_ + 1); ++depth) {
+            uint32_t idx = best_idx;
+            Decide_(state, card.Pack(), depth, remaining_rounds_, &idx);
+            if (is_timeout_) {
+                break;
+            }
+            best_idx = idx;
+            finished_depth_ = depth;
         }
-        idx += (coordinate.y_ + k_size * 2 - std::abs(coordinate.x_)) / 2;
-        return idx;
+        return best_idx;
     }
 
-  private:
-    static constexpr uint32_t k_size = 3;
-    static constexpr uint32_t k_max_row = k_size * 4 + 2;
-    static constexpr uint32_t k_max_column = k_size * 2 + 1;
+    uint32_t FinishedDepth() const { return finished_depth_; }
 
-    std::string Image_(std::string name) { return "![](file:///" + image_path_ + std::move(name) + ".png)"; }
+    uint64_t VisitedNodes() const { return visited_nodes_; }
 
-    template <Direct direct>
-    FillResult CheckOneDirect_(const Coordinate coordinate)
+  private:
+    static constexpr uint32_t k_max_point = 16;
+    static constexpr uint32_t k_max_line_size = k_size * 2 - 1;
+
+    double Decide_(const CombState& state, const PackedCard card, const uint32_t depth, const uint32_t remaining_rounds,
+            uint32_t* const best_idx)
     {
-        assert(Get_(coordinate).card_.has_value());
-        auto point = Get_(coordinate).card_->Point<direct>();
-        int32_t count = 1;
-        const auto check = [&](Coordinate& coor, const Coordinate& step)
-            {
-                for (; IsValid_(coor); coor += step) {
-                    ++count;
-                    const auto& area = Get_(coor);
-                    if (!area.card_.has_value()) { // happens when the area is empty
-                        return false;
-                    }
-                    if (!point.has_value()) { // happens when previous card are wild
-                        point = area.card_->Point<direct>();
-                        continue;
-                    }
-                    if (!area.card_->IsMatch<direct>(*point)) {
-                        return false;
-                    }
-                }
-                return true;
-            };
-
-        const auto wall_line = [&](Coordinate& coor, const Coordinate& step)
-            {
-                for (auto it = walls_.find(coor); it != walls_.end(); it = walls_.find(coor += step)) {
-                    Wall& wall = it->second;
-                    wall.SetLine<direct>();
-                    wall.box_.SetContent(Image_(wall.ImageName()));
+        double best_value = -1;
+        for (uint32_t idx = 0; idx < k_area_num; ++idx) {
+            if (state.IsFilled(idx)) {
+                continue;
+            }
+            CombState next_state = state;
+            const double value = next_state.Fill(idx, card).point_ + (depth > 1 && remaining_rounds > 0 ?
+                    Chance_(next_state, depth - 1, remaining_rounds - 1) : Evaluate_(next_state, remaining_rounds));
+            if (IsTimeout_()) {
+                return 0;
+            }
+            if (value > best_value) {
+                best_value = value;
+                if (best_idx) {
+                    *best_idx = idx;
                 }
-            };
-
-        auto head_coor = coordinate + k_direct_step<direct>;
-        auto tail_coor = coordinate + -k_direct_step<direct>;
-        if (!check(head_coor, k_direct_step<direct>) || !check(tail_coor, -k_direct_step<direct>)) {
-            return {0, 0};
+            }
         }
+        return best_value < 0 ? Evaluate_(state, remaining_rounds) : best_value;
+    }
 
-        wall_line(head_coor, k_direct_step<direct>);
-        wall_line(tail_coor, -k_direct_step<direct>);
+    double Chance_(const CombState& state, const uint32_t depth, const uint32_t remaining_rounds)
+    {
+        if (pool_.total_ == 0) {
+            return Evaluate_(state, remaining_rounds);
+        }
+        double value = 0;
+        const uint32_t total = pool_.total_;
+        for (auto& kind : pool_.kinds_) {
+            if (kind.count_ == 0) {
+                continue;
+            }
+            const double probability = static_cast<double>(kind.count_) / total;
+            --kind.count_;
+            --pool_.total_;
+            value += probability * Decide_(state, kind.card_, depth, remaining_rounds, nullptr);
+            ++kind.count_;
+            ++pool_.total_;
+            if (is_timeout_) {
+                return 0;
+            }
+        }
+        return value;
+    }
 
-        // TODO: set around success line
-        if (point.has_value()) {
-            return {*point * count, 1};
-        } else {
-            return {10000, 1}; // TODO: is an impossible case, we should limit number of wild card less than k_size
+    double Evaluate_(const CombState& state, const uint32_t remaining_rounds) const
+    {
+        double value = state.IsFilled(0) || remaining_rounds == 0 ? 0 : mean_point_sum_;
+        for (uint32_t line_idx = 0; line_idx < k_line_num; ++line_idx) {
+            if (state.IsLineCompleted(line_idx)) {
+                continue;
+            }
+            uint32_t empty_count = 0;
+            const auto point = state.LineRequirement(line_idx, empty_count);
+            if (!point.has_value() || empty_count > remaining_rounds) {
+                continue;
+            }
+            const auto& potentials = line_potentials_[remaining_rounds][line_idx / k_line_num_per_direct];
+            value += k_layout.lines_[line_idx].size_ * potentials[*point][empty_count];
         }
+        return value;
     }
 
-    FillResult Check_(const Coordinate coordinate)
+    bool IsTimeout_()
     {
-        return CheckOneDirect_<Direct::VERT>(coordinate) +
-               CheckOneDirect_<Direct::TOP_LEFT>(coordinate) +
-               CheckOneDirect_<Direct::TOP_RIGHT>(coordinate);
+        if ((++visited_nodes_ & 0x3FF) == 0 && !is_timeout_ && finished_depth_ > 0 && Clock::now() > deadline_) {
+            is_timeout_ = true;
+        }
+        return is_timeout_;
     }
 
-    Area& Get_(const Coordinate coordinate) { return areas_[ToIndex(coordinate)]; }
+    // Precompute the expected point of a line for each requirement, which is the point multiplied by the probability of
+    // revealing enough matched cards in the remaining rounds. The index 0 of the requirement means any point is
+    // acceptable, in which case the best point is taken.
+    void InitLinePotentials_()
+    {
+        std::array<std::array<uint32_t, k_max_point>, k_direct_max> matched_counts{};
+        double point_sum = 0;
+        for (const auto& kind : pool_.kinds_) {
+            point_sum += static_cast<double>(PackedPointSum(kind.card_)) * kind.count_;
+            for (uint32_t direct = 0; direct < k_direct_max; ++direct) {
+                if (kind.card_ == k_wild_card) {
+                    for (auto& count : matched_counts[direct]) {
+                        count += kind.count_;
+                    }
+                } else {
+                    matched_counts[direct][PackedPoint(kind.card_, direct)] += kind.count_;
+                }
+            }
+        }
+        mean_point_sum_ = pool_.total_ == 0 ? 0 : point_sum / pool_.total_;
+        line_potentials_.resize(remaining_rounds_ + 1);
+        for (uint32_t rounds = 0; rounds <= remaining_rounds_; ++rounds) {
+            for (uint32_t direct = 0; direct < k_direct_max; ++direct) {
+                auto& potentials = line_potentials_[rounds][direct];
+                for (uint32_t point = 1; point < k_max_point; ++point) {
+                    const double p = pool_.total_ == 0 ? 0 : static_cast<double>(matched_counts[direct][point]) / pool_.total_;
+                    for (uint32_t empty_count = 0; empty_count <= k_max_line_size; ++empty_count) {
+                        potentials[point][empty_count] = point * AtLeastProbability_(rounds, p, empty_count);
+                        potentials[0][empty_count] = std::max(potentials[0][empty_count], potentials[point][empty_count]);
+                    }
+                }
+            }
+        }
+    }
 
-    bool IsValid_(const Coordinate coordinate)
+    // The probability of at least `k` successes in `n` trials with success probability `p`.
+    static double AtLeastProbability_(const uint32_t n, const double p, const uint32_t k)
     {
-        return std::abs(coordinate.x_) + std::abs(coordinate.y_) < k_size * 2 && std::abs(coordinate.x_) < k_size;
+        if (k > n) {
+            return 0;
+        }
+        double less_probability = 0;
+        double combination = 1;
+        for (uint32_t i = 0; i < k; ++i) {
+            less_probability += combination * std::pow(p, i) * std::pow(1 - p, n - i);
+            combination = combination * (n - i) / (i + 1);
+        }
+        return std::max(0.0, 1 - less_probability);
     }
 
-    const std::string image_path_;
-    std::vector<Area> areas_;
-    std::map<Coordinate, Wall> walls_;
-    html::Table table_;
+    CardPool pool_;
+    const uint32_t remaining_rounds_;
+    double mean_point_sum_{0};
+    // [remaining rounds][direct][required point][empty count]
+    std::vector<std::array<std::array<std::array<double, k_max_line_size + 1>, k_max_point>, k_direct_max>> line_potentials_;
+    Clock::time_point deadline_;
+    bool is_timeout_{false};
+    uint32_t finished_depth_{0};
+    uint64_t visited_nodes_{0};
 };
 
 } // namespace numcomb
@@ -224,14 +224,13 @@ std::array<Card<k_type>, k_card_num<k_type>> UnshuffledPokers()
     return cards;
 }
 
+// The pokers are shuffled by `engine` if `sv` is empty, or by an engine seeded with `sv` otherwise.
 template <CardType k_type>
-std::array<Card<k_type>, k_card_num<k_type>> ShuffledPokers(const std::string_view& sv = "")
+std::array<Card<k_type>, k_card_num<k_type>> ShuffledPokers(const std::string_view& sv, std::mt19937& engine)
 {
     auto cards = UnshuffledPokers<k_type>();
     if (sv.empty()) {
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(cards.begin(), cards.end(), g);
+        std::shuffle(cards.begin(), cards.end(), engine);
     } else {
         std::seed_seq seed(sv.begin(), sv.end());
         std::mt19937 g(seed);
@@ -240,6 +239,14 @@ std::array<Card<k_type>, k_card_num<k_type>> ShuffledPokers(const std::string_vi
     return cards;
 }
 
+template <CardType k_type>
+std::array<Card<k_type>, k_card_num<k_type>> ShuffledPokers(const std::string_view& sv = "")
+{
+    std::random_device rd;
+    std::mt19937 g(rd());
+    return ShuffledPokers<k_type>(sv, g);
+}
+
 template <CardType k_type>
 std::string Card<k_type>::ToHtml() const
 {
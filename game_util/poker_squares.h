@@ -27,6 +27,10 @@ ENUM_END(GridType)
 #include "utility/util_func.h"
 
 #include <array>
+#include <chrono>
+#include <numeric>
+#include <random>
+#include <thread>
 #include <variant>
 
 namespace lgtbot {
@@ -102,119 +106,210 @@ static constexpr int32_t GetPatternPoint(const poker::PatternType type) {
     return k_points[type.ToUInt()];
 }
 
-class PokerSquare
+// The grid indexes of each group: the rows, the columns, the main diagonal and the anti-diagonal.
+inline constexpr auto k_group_grids = MakeArray<k_group_num>([](const int32_t group_index) constexpr
+        {
+            return MakeArray<k_square_size>([=](const int32_t n) constexpr
+                    {
+                        return group_index < k_square_size      ? group_index * k_square_size + n :
+                               group_index < k_square_size * 2  ? n * k_square_size + (group_index - k_square_size) :
+                               group_index == k_square_size * 2 ? n * k_square_size + n :
+                                                                  n * k_square_size + (k_square_size - 1 - n);
+                    });
+        });
+
+// The diagonals score double.
+inline constexpr auto k_group_multiples = MakeArray<k_group_num>([](const int32_t group_index) constexpr
+        {
+            return group_index < k_square_size * 2 ? 1 : 2;
+        });
+
+struct GridGroups
 {
-    class Grid;
+    int32_t num_{0};
+    std::array<int32_t, 4> indexes_{}; // the central grid is contained by the maximum four groups
+};
 
-    struct Multiple
+inline constexpr auto k_grid_groups = []() constexpr
     {
-        int value_{1};
-    };
+        std::array<GridGroups, k_grid_num> result;
+        for (int32_t group_index = 0; group_index < k_group_num; ++group_index) {
+            for (const int32_t grid_index : k_group_grids[group_index]) {
+                auto& grid_groups = result[grid_index];
+                grid_groups.indexes_[grid_groups.num_++] = group_index;
+            }
+        }
+        return result;
+    }();
+
+// Indexed by the number of card pairs with the same number. For five cards, the count identifies the pattern without
+// considering flushes and straights (a count of five is impossible).
+inline constexpr poker::PatternType k_pair_count_pattern_types[] = {
+    poker::PatternType::HIGH_CARD,
+    poker::PatternType::ONE_PAIR,
+    poker::PatternType::TWO_PAIRS,
+    poker::PatternType::THREE_OF_A_KIND,
+    poker::PatternType::FULL_HOUSE,
+    poker::PatternType::HIGH_CARD,
+    poker::PatternType::FOUR_OF_A_KIND,
+};
 
-    struct Group
+// Indexed by the bitmask of five distinct card numbers.
+inline constexpr auto k_straight_table = []() constexpr
     {
-      public:
-        using Grids = std::array<std::reference_wrapper<Grid>, k_square_size>;
-
-        Group(const Multiple basic_multiple, html::Box& point_multiple_html_box, html::Box& pattern_score_html_box)
-            : basic_multiple_{basic_multiple}, point_multiple_html_box_{point_multiple_html_box}, pattern_score_html_box_{pattern_score_html_box}
-        {
-            point_multiple_html_box_.SetContent(MakePointMultipleInfo_(0, 0, basic_multiple_, false));
+        constexpr uint32_t k_straight_mask = (1 << k_square_size) - 1;
+        constexpr uint32_t k_number_num = poker::PokerNumber::Count();
+        std::array<bool, 1 << k_number_num> result{};
+        for (uint32_t lowest = 0; lowest + k_square_size <= k_number_num; ++lowest) {
+            result[k_straight_mask << lowest] = true;
         }
+        // A can also be the lowest card of a straight
+        result[(k_straight_mask >> 1) | (1 << (k_number_num - 1))] = true;
+        return result;
+    }();
 
-        void Fill(const Card card, const Multiple extra_multiple, Statistic& statistic)
-        {
-            if (!hand_.Add(card)) {
-                // A repeated card is filled, which is unexpected.
-                assert(false);
-                return;
-            }
-            number_point_ += GetNumberPoint(card.number_);
-            if (++filled_count_ < k_square_size) {
-                point_multiple_html_box_.SetContent(MakePointMultipleInfo_(number_point_, 0, basic_multiple_, false));
-                return;
-            }
-            // All grids are filled with cards.
-            const OptionalDeck deck = hand_.BestDeck();
-            assert(deck.has_value());
-            const int32_t pattern_point = GetPatternPoint(deck->type_);
-            const Multiple multiple{basic_multiple_.value_ + extra_multiple.value_};
-            const int32_t score = number_point_ * pattern_point * (basic_multiple_.value_ + extra_multiple.value_);
-            statistic.pattern_type_bitset_[deck->type_] = true;
-            statistic.pattern_score_ += score;
-            point_multiple_html_box_.SetContent(MakePointMultipleInfo_(number_point_, pattern_point, multiple, true));
-            if (pattern_point == 0) {
-                pattern_score_html_box_.SetContent(
-                        std::string("<font size=\"3\"><span style=\"background-color:#d3d3d3; text-align:center;\">" HTML_ESCAPE_SPACE) +
-                        GetPatternTypeName(deck->type_) +
-                        HTML_ESCAPE_SPACE "</span></font><br>" HTML_COLOR_FONT_HEADER(grey) HTML_SIZE_FONT_HEADER(5) "-" HTML_FONT_TAIL HTML_FONT_TAIL);
-            } else if (pattern_point < 10) {
-                pattern_score_html_box_.SetContent(
-                        std::string("<font size=\"3\"><span style=\"background-color:#f3b13d; text-align:center;\">" HTML_ESCAPE_SPACE) +
-                        GetPatternTypeName(deck->type_) +
-                        HTML_ESCAPE_SPACE "</span></font><br>" HTML_SIZE_FONT_HEADER(5) + std::to_string(score) + HTML_FONT_TAIL);
-            } else {
-                pattern_score_html_box_.SetContent(
-                        std::string("<font size=\"3\"><span style=\"background-color:#c5b4e3; text-align:center;\">" HTML_ESCAPE_SPACE) +
-                        GetPatternTypeName(deck->type_) +
-                        HTML_ESCAPE_SPACE "</span></font><br>" HTML_SIZE_FONT_HEADER(5) + std::to_string(score) + HTML_FONT_TAIL);
-            }
-        }
+// The cards in a group, which are packed to evaluate the pattern by table lookups.
+class GroupHand
+{
+  public:
+    void Add(const Card card)
+    {
+        const uint32_t number = card.number_.ToUInt();
+        const uint32_t shift = number * k_count_bits;
+        pair_count_ += (number_counts_ >> shift) & k_count_mask;
+        number_counts_ += uint64_t{1} << shift;
+        number_mask_ |= 1 << number;
+        suit_mask_ |= 1 << card.suit_.ToUInt();
+        number_point_ += GetNumberPoint(card.number_);
+        ++filled_count_;
+    }
 
-        OptionalDeck GetOptionalDeck() const { return hand_.BestDeck(); }
+    bool IsFull() const { return filled_count_ == k_square_size; }
 
-      private:
-        Multiple basic_multiple_{1};
-        html::Box& point_multiple_html_box_;
-        html::Box& pattern_score_html_box_;
-        int32_t filled_count_{0};
-        int32_t number_point_{0};
-        Hand hand_;
-    };
+    int32_t NumberPoint() const { return number_point_; }
 
-    class Grid
+    // requires: IsFull()
+    poker::PatternType Pattern() const
     {
-      public:
-        using Groups = std::array<Group*, 4>;
+        if (pair_count_ > 0) {
+            return k_pair_count_pattern_types[pair_count_];
+        }
+        const bool is_flush = (suit_mask_ & (suit_mask_ - 1)) == 0;
+        const bool is_straight = k_straight_table[number_mask_];
+        if (is_flush) {
+            return poker::PatternType::Condition(is_straight, poker::PatternType::STRAIGHT_FLUSH, poker::PatternType::FLUSH);
+        }
+        return poker::PatternType::Condition(is_straight, poker::PatternType::STRAIGHT, poker::PatternType::HIGH_CARD);
+    }
 
-        Grid(const GridType type, const Groups& groups) : type_{type}, groups_{groups} {}
+  private:
+    static constexpr uint32_t k_count_bits = 4;
+    static constexpr uint64_t k_count_mask = (1 << k_count_bits) - 1;
+
+    uint64_t number_counts_{0}; // the count of each card number takes four bits
+    uint16_t number_mask_{0};
+    uint8_t suit_mask_{0};
+    uint8_t pair_count_{0};
+    uint8_t filled_count_{0};
+    uint8_t number_point_{0};
+};
 
-        bool Fill(const Card card, Statistic& statistic)
-        {
-            if (type_ == GridType::card) {
-                return false;
-            }
-            const Multiple extra_multiple{type_ == GridType::double_score};
-            statistic.skip_next_ = type_ == GridType::skip_next;
-            std::ranges::for_each(groups_ | std::views::filter([](Group* const group) { return group != nullptr; }),
-                    [&](Group* const group) { group->Fill(card, extra_multiple, statistic); });
-            if (const bool is_red_card = card.suit_ == poker::PokerSuit::HEARTS || card.suit_ == poker::PokerSuit::DIAMONDS;
-                    (type_ == GridType::red_bonus && is_red_card) || (type_ == GridType::black_bonus && !is_red_card)) {
-                constexpr int32_t k_bonus_score_base = 20;
-                statistic.bonus_score_ += GetNumberPoint(card.number_) * k_bonus_score_base;
+// The scoring state of a square without rendering, which is cheap to copy.
+class SquareState
+{
+  public:
+    explicit SquareState(const std::array<GridType, k_grid_num>& grid_types) : grid_types_{grid_types} {}
+
+    bool Fill(const int32_t index, const Card card)
+    {
+        const GridType type = grid_types_[index];
+        if (type == GridType::card) {
+            return false;
+        }
+        const int32_t extra_multiple = type == GridType::double_score;
+        statistic_.skip_next_ = type == GridType::skip_next;
+        const auto& grid_groups = k_grid_groups[index];
+        for (int32_t i = 0; i < grid_groups.num_; ++i) {
+            const int32_t group_index = grid_groups.indexes_[i];
+            auto& group = groups_[group_index];
+            group.Add(card);
+            if (!group.IsFull()) {
+                continue;
             }
-            type_ = GridType::card;
-            return true;
+            const poker::PatternType pattern = group.Pattern();
+            statistic_.pattern_type_bitset_[pattern] = true;
+            statistic_.pattern_score_ += group.NumberPoint() * GetPatternPoint(pattern) * (k_group_multiples[group_index] + extra_multiple);
+        }
+        if (const bool is_red_card = card.suit_ == poker::PokerSuit::HEARTS || card.suit_ == poker::PokerSuit::DIAMONDS;
+                (type == GridType::red_bonus && is_red_card) || (type == GridType::black_bonus && !is_red_card)) {
+            constexpr int32_t k_bonus_score_base = 20;
+            statistic_.bonus_score_ += GetNumberPoint(card.number_) * k_bonus_score_base;
         }
+        grid_types_[index] = GridType::card;
+        ++filled_count_;
+        return true;
+    }
 
-        bool IsFilled() const { return type_ == GridType::card; }
+    bool IsFilled(const int32_t index) const { return grid_types_[index] == GridType::card; }
 
-      private:
-        GridType type_;
-        Groups groups_; // the grid which maximum groups contain is the central grid
-    };
+    int32_t EmptyCount() const { return k_grid_num - filled_count_; }
 
+    GridType GetGridType(const int32_t index) const { return grid_types_[index]; }
+
+    const GroupHand& GetGroup(const int32_t group_index) const { return groups_[group_index]; }
+
+    const Statistic& GetStatistic() const { return statistic_; }
+
+    bool ResetSkipNext() { return std::exchange(statistic_.skip_next_, false); }
+
+  private:
+    std::array<GridType, k_grid_num> grid_types_;
+    std::array<GroupHand, k_group_num> groups_;
+    Statistic statistic_;
+    int32_t filled_count_{0};
+};
+
+class PokerSquare
+{
   public:
     PokerSquare(std::string image_path, const std::array<GridType, k_grid_num>& grid_types)
-        : PokerSquare(std::move(image_path), MakeArray<k_group_num>(&MakeGroupDesc_), grid_types)
+        : image_path_{std::move(image_path)}
+        , state_{grid_types}
     {
+        // Initialize html table.
+        html_table_.SetTableStyle("style=\"table-layout: fixed;\" align=\"center\" cellpadding=\"0\" cellspacing=\"0\" width=448px ");
+        html_table_.SetRowStyle("align=\"center\" valign=\"middle\" height=64px ");
+        for (size_t i = 0; i < k_group_num; ++i) {
+            GetPointMultipleHtmlBox_(i).SetContent(MakePointMultipleInfo_(0, 0, k_group_multiples[i], false));
+        }
+        for (size_t i = 0; i < k_grid_num; ++i) {
+            const auto grid_type = grid_types[i];
+            const std::string html_head =
+                grid_type == GridType::red_bonus    ? HTML_COLOR_FONT_HEADER(red)     :
+                grid_type == GridType::double_score ? HTML_COLOR_FONT_HEADER(#b1a637) :
+                grid_type == GridType::skip_next    ? HTML_COLOR_FONT_HEADER(#db3af7) :
+                grid_type == GridType::empty        ? HTML_COLOR_FONT_HEADER(#4046a8) :
+                                                      HTML_COLOR_FONT_HEADER(black);
+            GetHtmlBox_(i).SetContent(Image_(k_background_image_names[i], grid_types[i].ToString(),
+                        html_head + HTML_SIZE_FONT_HEADER(5) + static_cast<char>('a' + i) + HTML_FONT_TAIL HTML_FONT_TAIL));
+        }
     }
 
     bool Fill(const int32_t index, const Card card)
     {
-        if (!grids_[index].Fill(card, statistic_)) {
+        const int32_t extra_multiple = state_.GetGridType(index) == GridType::double_score;
+        if (!state_.Fill(index, card)) {
             return false;
         }
+        const auto& grid_groups = k_grid_groups[index];
+        for (int32_t i = 0; i < grid_groups.num_; ++i) {
+            const int32_t group_index = grid_groups.indexes_[i];
+            if (!hands_[group_index].Add(card)) {
+                // A repeated card is filled, which is unexpected.
+                assert(false);
+            }
+            UpdateGroupHtml_(group_index, extra_multiple);
+        }
         UpdateBoxHtml_(index, card);
         return true;
     }
@@ -228,50 +323,45 @@ class PokerSquare
     }
 
     // requires: an empty grid exists
-    int32_t FillRandomly(const Card card)
+    int32_t FillRandomly(const Card card, std::mt19937& g)
     {
         std::vector<int32_t> empty_positions;
         for (int32_t i = 0; i < k_grid_num; ++i) {
-            if (!grids_[i].IsFilled()) {
+            if (!state_.IsFilled(i)) {
                 empty_positions.emplace_back(i);
             }
         }
-        const int32_t index = empty_positions[rand() % empty_positions.size()];
+        const int32_t index = empty_positions[g() % empty_positions.size()];
         if (!Fill(index, card)) {
             assert(false);
         }
         return index;
     }
 
-    bool ResetSkipNext() { return std::exchange(statistic_.skip_next_, false); }
+    bool ResetSkipNext() { return state_.ResetSkipNext(); }
 
     std::string ToHtml() const
     {
-        return "### " HTML_COLOR_FONT_HEADER(green) "当前积分：" + std::to_string(GetScore(statistic_)) +
+        const auto& statistic = state_.GetStatistic();
+        return "### " HTML_COLOR_FONT_HEADER(green) "当前积分：" + std::to_string(GetScore(statistic)) +
             HTML_ESCAPE_SPACE HTML_ESCAPE_SPACE HTML_ESCAPE_SPACE "非高牌牌型：" +
-            std::to_string(statistic_.pattern_type_bitset_.count() - statistic_.pattern_type_bitset_[poker::PatternType::HIGH_CARD]) +
-            (statistic_.skip_next_ ? HTML_ESCAPE_SPACE HTML_ESCAPE_SPACE HTML_ESCAPE_SPACE HTML_COLOR_FONT_HEADER(red) "（过牌中）" : "") +
+            std::to_string(statistic.pattern_type_bitset_.count() - statistic.pattern_type_bitset_[poker::PatternType::HIGH_CARD]) +
+            (statistic.skip_next_ ? HTML_ESCAPE_SPACE HTML_ESCAPE_SPACE HTML_ESCAPE_SPACE HTML_COLOR_FONT_HEADER(red) "（过牌中）" : "") +
             "\n\n" + html_table_.ToString();
     }
 
-    const Statistic& GetStatistic() const { return statistic_; }
+    const Statistic& GetStatistic() const { return state_.GetStatistic(); }
+
+    const SquareState& GetState() const { return state_; }
 
     auto GetDecks() const
     {
-        return groups_ | std::views::transform([](const Group& group) { return group.GetOptionalDeck(); })
-                       | std::views::filter([](const OptionalDeck& optional_deck) { return optional_deck.has_value(); })
-                       | std::views::transform([](const OptionalDeck& optional_deck) { return *optional_deck; });
+        return hands_ | std::views::transform([](const Hand& hand) { return hand.BestDeck(); })
+                      | std::views::filter([](const OptionalDeck& optional_deck) { return optional_deck.has_value(); })
+                      | std::views::transform([](const OptionalDeck& optional_deck) { return *optional_deck; });
     }
 
   private:
-    struct GroupDesc
-    {
-        Multiple multiple_;
-        Coordinate html_point_multiple_coor_;
-        Coordinate html_pattern_score_coor_;
-        std::array<Coordinate, k_square_size> grid_coors_;
-    };
-
     static constexpr const char* k_background_image_names[] = {
         "b_2", "b_0", "b_0", "b_0", "b_1",
         "b_0", "b_2", "b_0", "b_1", "b_0",
@@ -280,9 +370,7 @@ class PokerSquare
         "b_1", "b_0", "b_0", "b_0", "b_2",
     };
 
-    static size_t ToIndex_(const Coordinate coor) { return coor.row_ * k_square_size + coor.col_; }
-
-    static std::string MakePointMultipleInfo_(const int32_t number_point, const int32_t pattern_point, const Multiple multiple,
+    static std::string MakePointMultipleInfo_(const int32_t number_point, const int32_t pattern_point, const int32_t multiple,
             const bool ready)
     {
         std::string result = "<div align=\"left\" style=\"height:100\% text-valign:middle\">";
@@ -294,126 +382,74 @@ class PokerSquare
             result += "<br>" HTML_ESCAPE_SPACE HTML_ESCAPE_SPACE "型 ";
             result += std::to_string(pattern_point);
         }
-        if (multiple.value_ > 1) {
+        if (multiple > 1) {
             result += "<br>" HTML_ESCAPE_SPACE HTML_ESCAPE_SPACE "倍 ";
-            result += std::to_string(multiple.value_);
+            result += std::to_string(multiple);
         }
         result += "</div>";
         return result;
     }
 
-    static constexpr GroupDesc MakeGroupDesc_(int32_t group_index)
+    void UpdateGroupHtml_(const int32_t group_index, const int32_t extra_multiple)
     {
-        if (group_index < k_square_size) { // a row group
-            return GroupDesc{
-                .multiple_{1},
-                .html_point_multiple_coor_{group_index + 1, 0},
-                .html_pattern_score_coor_{group_index + 1, k_square_size + 1},
-                .grid_coors_ = MakeArray<k_square_size>(
-                        [=](const int n) constexpr { return Coordinate{static_cast<int32_t>(group_index), n}; }),
-            };
-        } else if (group_index < k_square_size * 2) { // a column group
-            return GroupDesc{
-                .multiple_{1},
-                .html_point_multiple_coor_{0, group_index - k_square_size + 1},
-                .html_pattern_score_coor_{k_square_size + 1, group_index - k_square_size + 1},
-                .grid_coors_ = MakeArray<k_square_size>(
-                        [=](const int n) constexpr { return Coordinate{n, static_cast<int32_t>(group_index - k_square_size)}; }),
-            };
-        } else if (group_index == k_square_size * 2) {
-            return GroupDesc{
-                .multiple_{2},
-                .html_point_multiple_coor_{0, 0},
-                .html_pattern_score_coor_{k_square_size + 1, k_square_size + 1},
-                .grid_coors_ = MakeArray<k_square_size>([=](const int n) constexpr { return Coordinate{n, n}; }),
-            };
-        } else if (k_square_size * 2 + 1) {
-            return GroupDesc{
-                .multiple_{2},
-                .html_point_multiple_coor_{k_square_size + 1, 0},
-                .html_pattern_score_coor_{0, k_square_size + 1},
-                .grid_coors_ = MakeArray<k_square_size>(
-                        [=](const int n) constexpr { return Coordinate{n, static_cast<int32_t>(k_square_size - 1 - n)}; }),
-            };
-        } else {
-            // unexpected
-            return {};
+        const auto& group = state_.GetGroup(group_index);
+        const int32_t basic_multiple = k_group_multiples[group_index];
+        if (!group.IsFull()) {
+            GetPointMultipleHtmlBox_(group_index).SetContent(MakePointMultipleInfo_(group.NumberPoint(), 0, basic_multiple, false));
+            return;
         }
-    }
-
-    PokerSquare(std::string&& image_path, const std::array<GroupDesc, k_group_num>& group_descs, const std::array<GridType, k_grid_num>& grid_types)
-        : image_path_{std::move(image_path)}
-        , groups_(MakeGroups_(group_descs))
-        , grids_(MakeGrids_(group_descs, grid_types))
-    {
-        // Initialize html table.
-        html_table_.SetTableStyle("style=\"table-layout: fixed;\" align=\"center\" cellpadding=\"0\" cellspacing=\"0\" width=448px ");
-        html_table_.SetRowStyle("align=\"center\" valign=\"middle\" height=64px ");
-        for (size_t i = 0; i < k_grid_num; ++i) {
-            const auto grid_type = grid_types[i];
-            const std::string html_head =
-                grid_type == GridType::red_bonus    ? HTML_COLOR_FONT_HEADER(red)     :
-                grid_type == GridType::double_score ? HTML_COLOR_FONT_HEADER(#b1a637) :
-                grid_type == GridType::skip_next    ? HTML_COLOR_FONT_HEADER(#db3af7) :
-                grid_type == GridType::empty        ? HTML_COLOR_FONT_HEADER(#4046a8) :
-                                                      HTML_COLOR_FONT_HEADER(black);
-            GetHtmlBox_(i).SetContent(Image_(k_background_image_names[i], grid_types[i].ToString(),
-                        html_head + HTML_SIZE_FONT_HEADER(5) + static_cast<char>('a' + i) + HTML_FONT_TAIL HTML_FONT_TAIL));
+        // All grids are filled with cards.
+        const poker::PatternType pattern = group.Pattern();
+        const int32_t pattern_point = GetPatternPoint(pattern);
+        const int32_t multiple = basic_multiple + extra_multiple;
+        const int32_t score = group.NumberPoint() * pattern_point * multiple;
+        GetPointMultipleHtmlBox_(group_index).SetContent(MakePointMultipleInfo_(group.NumberPoint(), pattern_point, multiple, true));
+        auto& pattern_score_html_box = GetPatternScoreHtmlBox_(group_index);
+        if (pattern_point == 0) {
+            pattern_score_html_box.SetContent(
+                    std::string("<font size=\"3\"><span style=\"background-color:#d3d3d3; text-align:center;\">" HTML_ESCAPE_SPACE) +
+                    GetPatternTypeName(pattern) +
+                    HTML_ESCAPE_SPACE "</span></font><br>" HTML_COLOR_FONT_HEADER(grey) HTML_SIZE_FONT_HEADER(5) "-" HTML_FONT_TAIL HTML_FONT_TAIL);
+        } else if (pattern_point < 10) {
+            pattern_score_html_box.SetContent(
+                    std::string("<font size=\"3\"><span style=\"background-color:#f3b13d; text-align:center;\">" HTML_ESCAPE_SPACE) +
+                    GetPatternTypeName(pattern) +
+                    HTML_ESCAPE_SPACE "</span></font><br>" HTML_SIZE_FONT_HEADER(5) + std::to_string(score) + HTML_FONT_TAIL);
+        } else {
+            pattern_score_html_box.SetContent(
+                    std::string("<font size=\"3\"><span style=\"background-color:#c5b4e3; text-align:center;\">" HTML_ESCAPE_SPACE) +
+                    GetPatternTypeName(pattern) +
+                    HTML_ESCAPE_SPACE "</span></font><br>" HTML_SIZE_FONT_HEADER(5) + std::to_string(score) + HTML_FONT_TAIL);
         }
     }
 
-    std::array<Group, k_group_num> MakeGroups_(const std::array<GroupDesc, k_group_num>& group_descs)
+    void UpdateBoxHtml_(const int32_t index, const Card card)
     {
-        return MakeArray<k_group_num>([&](const int group_index)
-                {
-                    auto& group_desc = group_descs[group_index];
-                    return Group{
-                        group_desc.multiple_,
-                        html_table_.Get(group_desc.html_point_multiple_coor_.row_, group_desc.html_point_multiple_coor_.col_),
-                        html_table_.Get(group_desc.html_pattern_score_coor_.row_, group_desc.html_pattern_score_coor_.col_),
-                    };
-                });
+        GetHtmlBox_(index).SetContent(Image_(k_background_image_names[index], GetCardImgName(card).data()));
     }
 
-    std::array<Grid, k_grid_num> MakeGrids_(const std::array<GroupDesc, k_group_num>& group_descs, const std::array<GridType, k_grid_num>& grid_types)
+    html::Box& GetHtmlBox_(const size_t index)
     {
-        class GroupPointersForGrid
-        {
-          public:
-            void AppendGroup(Group& group) { group_ptrs_[group_num_++] = &group; }
-
-            const Grid::Groups& GetGroupPointers() const { return group_ptrs_; }
-
-          private:
-            Grid::Groups group_ptrs_{nullptr};
-            int group_num_{0};
-        };
-
-        const auto group_pointers_for_grids = [&]()
-            {
-                std::array<GroupPointersForGrid, k_grid_num> result;
-                for (size_t i = 0; i < k_group_num; ++i) {
-                    for (const Coordinate coor : group_descs[i].grid_coors_) {
-                        result[ToIndex_(coor)].AppendGroup(groups_[i]);
-                    }
-                }
-                return result;
-            }();
-
-        return MakeArray<k_grid_num>([&](const int grid_index)
-                {
-                    return Grid{grid_types[grid_index], group_pointers_for_grids[grid_index].GetGroupPointers()};
-                });
+        return html_table_.Get(index / k_square_size + 1, index % k_square_size + 1);
     }
 
-    void UpdateBoxHtml_(const int32_t index, const Card card)
+    // The point and multiple of a row are shown at its left side, of a column are shown at its upper side, and of a diagonal are
+    // shown at the corner where it starts.
+    html::Box& GetPointMultipleHtmlBox_(const size_t group_index)
     {
-        GetHtmlBox_(index).SetContent(Image_(k_background_image_names[index], GetCardImgName(card).data()));
+        return group_index < k_square_size      ? html_table_.Get(group_index + 1, 0) :
+               group_index < k_square_size * 2  ? html_table_.Get(0, group_index - k_square_size + 1) :
+               group_index == k_square_size * 2 ? html_table_.Get(0, 0) :
+                                                  html_table_.Get(k_square_size + 1, 0);
     }
 
-    html::Box& GetHtmlBox_(const size_t index)
+    // The pattern score of a group is shown at the opposite side of its point and multiple.
+    html::Box& GetPatternScoreHtmlBox_(const size_t group_index)
     {
-        return html_table_.Get(index / k_square_size + 1, index % k_square_size + 1);
+        return group_index < k_square_size      ? html_table_.Get(group_index + 1, k_square_size + 1) :
+               group_index < k_square_size * 2  ? html_table_.Get(k_square_size + 1, group_index - k_square_size + 1) :
+               group_index == k_square_size * 2 ? html_table_.Get(k_square_size + 1, k_square_size + 1) :
+                                                  html_table_.Get(0, k_square_size + 1);
     }
 
     std::string Image_(const std::string_view background_name, const std::string_view name, const std::string_view text = "") const
@@ -428,9 +464,106 @@ class PokerSquare
 
     std::string image_path_;
     html::Table html_table_{k_square_size + 2, k_square_size + 2};
-    Statistic statistic_;
-    std::array<Group, k_group_num> groups_;
-    std::array<Grid, k_grid_num> grids_;
+    SquareState state_;
+    std::array<Hand, k_group_num> hands_; // only for showing the best decks
+};
+
+// Flat Monte Carlo search for the grid to place a card. Each empty grid is evaluated by the average final score of random
+// completions, in which the other empty grids are filled with the known upcoming cards first and then with random unrevealed
+// cards. Samples are run by several threads, each of which owns its random engine and its statistics, so no synchronization is
+// needed until the threads are joined.
+class MonteCarlo
+{
+  public:
+    MonteCarlo(const SquareState& state, std::vector<Card> upcoming_cards, std::vector<Card> unrevealed_cards)
+        : state_{state}, upcoming_cards_{std::move(upcoming_cards)}, unrevealed_cards_{std::move(unrevealed_cards)}
+    {
+    }
+
+    // Samples until the budget runs out, except that each empty grid is sampled at least once by each thread.
+    // requires: an empty grid exists
+    int32_t Search(const Card card, const std::chrono::milliseconds budget, const uint32_t thread_num,
+            const uint64_t seed = std::random_device{}())
+    {
+        const auto deadline = std::chrono::steady_clock::now() + budget;
+        std::vector<int32_t> candidates;
+        for (int32_t i = 0; i < k_grid_num; ++i) {
+            if (!state_.IsFilled(i)) {
+                candidates.emplace_back(i);
+            }
+        }
+        assert(!candidates.empty());
+
+        std::vector<std::vector<int64_t>> score_sums(std::max(thread_num, 1U));
+        std::vector<uint64_t> sample_nums(score_sums.size(), 0);
+        const auto sample = [&](const uint32_t thread_index)
+            {
+                std::mt19937 g(seed + thread_index);
+                std::vector<Card> unrevealed_cards = unrevealed_cards_;
+                std::vector<int64_t> score_sum(candidates.size(), 0);
+                uint64_t sample_num = 0;
+                do {
+                    for (size_t i = 0; i < candidates.size(); ++i) {
+                        score_sum[i] += Sample_(g, unrevealed_cards, candidates[i], card);
+                    }
+                    sample_num += candidates.size();
+                } while (std::chrono::steady_clock::now() < deadline);
+                score_sums[thread_index] = std::move(score_sum);
+                sample_nums[thread_index] = sample_num;
+            };
+        std::vector<std::thread> threads;
+        for (uint32_t thread_index = 1; thread_index < score_sums.size(); ++thread_index) {
+            threads.emplace_back(sample, thread_index);
+        }
+        sample(0);
+        std::ranges::for_each(threads, [](std::thread& thread) { thread.join(); });
+
+        size_t best = 0;
+        std::vector<int64_t> total_scores(candidates.size(), 0);
+        for (size_t i = 0; i < candidates.size(); ++i) {
+            for (const auto& score_sum : score_sums) {
+                total_scores[i] += score_sum[i];
+            }
+            if (total_scores[i] > total_scores[best]) {
+                best = i;
+            }
+        }
+        sample_num_ = std::accumulate(sample_nums.begin(), sample_nums.end(), uint64_t{0});
+        return candidates[best];
+    }
+
+    uint64_t SampleNum() const { return sample_num_; }
+
+  private:
+    int32_t Sample_(std::mt19937& g, std::vector<Card>& unrevealed_cards, const int32_t index, const Card card) const
+    {
+        SquareState state = state_;
+        state.Fill(index, card);
+        std::array<Card, k_grid_num> cards;
+        const size_t card_num = std::min<size_t>(state.EmptyCount(), upcoming_cards_.size() + unrevealed_cards.size());
+        const size_t upcoming_card_num = std::min(card_num, upcoming_cards_.size());
+        std::copy_n(upcoming_cards_.begin(), upcoming_card_num, cards.begin());
+        // partial Fisher-Yates shuffle to draw the rest cards
+        for (size_t i = upcoming_card_num; i < card_num; ++i) {
+            const size_t drawn = i - upcoming_card_num;
+            std::swap(unrevealed_cards[drawn],
+                    unrevealed_cards[std::uniform_int_distribution<size_t>(drawn, unrevealed_cards.size() - 1)(g)]);
+            cards[i] = unrevealed_cards[drawn];
+        }
+        std::shuffle(cards.begin(), cards.begin() + card_num, g);
+        auto it = cards.begin();
+        for (int32_t i = 0; i < k_grid_num && it != cards.begin() + card_num; ++i) {
+            if (!state.IsFilled(i)) {
+                state.Fill(i, *(it++));
+            }
+        }
+        return GetScore(state.GetStatistic());
+    }
+
+    const SquareState state_;
+    const std::vector<Card> upcoming_cards_;
+    const std::vector<Card> unrevealed_cards_;
+    uint64_t sample_num_{0};
 };
 
 }
@@ -9,6 +9,7 @@
 #include <algorithm>
 
 #include "../utility/html.h"
+#include "../utility/sprite_grid.h"
 
 namespace lgtbot {
 
@@ -67,23 +68,18 @@ class Board
         }
     }
 
-    std::string ToHtml() const
+    html::SpriteGrid ToSpriteGrid() const
     {
-        html::Table table(7, 7);
-        table.SetTableStyle(" align=\"center\" cellpadding=\"1\" cellspacing=\"1\" ");
-        const auto set_image = [&](const uint32_t row, const uint32_t col, std::string name)
-            {
-                table.Get(row, col).SetContent("![](file:///" + image_path_ + "/" + std::move(name) + ".png)");
-            };
+        html::SpriteGrid grid(image_path_, 7, 7);
         for (uint32_t i = 0; i < 5; ++i) {
-            set_image(0, 1 + i, "num_" + std::to_string(0 + i));
-            set_image(1 + i, 6, "num_" + std::to_string(4 + i));
-            set_image(6, 5 - i, "num_" + std::to_string(8 + i));
-            set_image(5 - i, 0, "num_" + std::to_string((12 + i) % 16));
+            grid.Set(0, 1 + i, "num_" + std::to_string(0 + i));
+            grid.Set(1 + i, 6, "num_" + std::to_string(4 + i));
+            grid.Set(6, 5 - i, "num_" + std::to_string(8 + i));
+            grid.Set(5 - i, 0, "num_" + std::to_string((12 + i) % 16));
         }
         const auto set_box_image = [&](const uint32_t x, const uint32_t y, const char* const prefix)
             {
-                set_image(x + 1, y + 1, std::string(prefix) + static_cast<char>(areas_[x][y]));
+                grid.Set(x + 1, y + 1, std::string(prefix) + static_cast<char>(areas_[x][y]));
             };
         for (uint32_t x = 0; x < 5; ++x) {
             for (uint32_t y = 0; y < 5; ++y) {
@@ -97,10 +93,11 @@ class Board
                 {
                     std::ranges::for_each(coors, [&](const Coor& coor) { set_box_image(coor.x_, coor.y_, "light_"); });
                 });
-
-        return table.ToString();
+        return grid;
     }
 
+    std::string ToHtml() const { return ToSpriteGrid().ToHtml(); }
+
     ErrCode Push(const uint32_t src, const uint32_t dst, const Type type)
     {
         assert(src < k_edge_num && dst < k_edge_num);
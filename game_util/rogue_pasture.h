@@ -53,14 +53,9 @@ class Pasture
 public:
     Pasture() {}
 
-    std::vector<std::string> ShuffleN()
+    std::vector<std::string> ShuffleN(std::mt19937& g)
     {
         std::vector<std::string> animals = {"母鸡", "鸭鸭", "天鹅", "火鸡", "猪猪", "牛牛", "山羊", "袋鼠", "狗狗", "狐狸", "灰狼", "老虎"};
-        std::random_device rd;
-        std::uniform_int_distribution<unsigned long long> dis;
-        std::string seed_str = std::to_string(dis(rd));
-        std::seed_seq seed(seed_str.begin(), seed_str.end());
-        std::mt19937 g(seed);
         std::shuffle(animals.begin(), animals.end(), g);
         if (++mShuffleTime <= 3) {
             return std::vector<std::string>(animals.begin(), animals.begin() + 6);
@@ -119,15 +114,10 @@ public:
         return mRest;
     }
 
-    void Rand()
+    void Rand(std::mt19937& g)
     {
         // 抽卡
         std::vector<std::string> animals = All();
-        std::random_device rd;
-        std::uniform_int_distribution<unsigned long long> dis;
-        std::string seed_str = std::to_string(dis(rd));
-        std::seed_seq seed(seed_str.begin(), seed_str.end());
-        std::mt19937 g(seed);
         std::shuffle(animals.begin(), animals.end(), g);
         if (animals.size() > 3) 
         {
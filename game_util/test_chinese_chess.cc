@@ -7,6 +7,9 @@
 #include <gtest/gtest.h>
 #include <gflags/gflags.h>
 
+#include <set>
+#include <tuple>
+
 using namespace lgtbot::game_util::chinese_chess;
 
 class TestChineseChess_ChessRule : public testing::Test
@@ -480,3 +483,157 @@ TEST(TestChineseChess, cannot_move_after_pass)
     ASSERT_FAIL(board.Move(0, 0, Coor{0, 0}, Coor{1, 0}));
 }
 
+
+class TestChineseChess_Search : public testing::Test
+{
+  public:
+    TestChineseChess_Search() : hb_0_(KingdomId(0)), hb_1_(KingdomId(1))
+    {
+        hb_0_.SetOppoBoard(hb_1_);
+        hb_1_.SetOppoBoard(hb_0_);
+    }
+
+  protected:
+    SearchBoard MakeSearchBoard() const
+    {
+        return SearchBoard::Make(hb_0_, [](const Chess& chess)
+                {
+                    return chess.kingdom_id_ == KingdomId(0) ? SearchBoard::Side::SELF : SearchBoard::Side::OPPO;
+                });
+    }
+
+    void Clear()
+    {
+        for (int32_t m = 0; m < SearchBoard::k_max_m; ++m) {
+            for (int32_t n = 0; n < SearchBoard::k_max_n; ++n) {
+                hb_0_.Get(Coor{m, n}).GetChess().reset();
+            }
+        }
+    }
+
+    HalfBoard hb_0_;
+    HalfBoard hb_1_;
+};
+
+static std::set<std::pair<int32_t, int32_t>> GeneratedMoves(const SearchBoard& board)
+{
+    SearchMoveList moves;
+    board.GenerateMoves(moves);
+    std::set<std::pair<int32_t, int32_t>> result;
+    for (uint32_t i = 0; i < moves.Size(); ++i) {
+        result.emplace(moves[i].src_, moves[i].dst_);
+    }
+    return result;
+}
+
+TEST_F(TestChineseChess_Search, initial_moves)
+{
+    ASSERT_EQ(44, GeneratedMoves(MakeSearchBoard()).size());
+}
+
+TEST_F(TestChineseChess_Search, generated_moves_same_as_chess_rules)
+{
+    ChessRule* const chess_rules[] = {
+        &JuChessRule::Singleton(), &MaChessRule::Singleton(), &XiangChessRule::Singleton(), &ShiChessRule::Singleton(),
+        &JiangChessRule::Singleton(), &PaoChessRule::Singleton(), &ZuChessRule::Singleton(), &PromotedZuChessRule::Singleton(),
+    };
+    std::mt19937 g(0);
+    for (int round = 0; round < 1000; ++round) {
+        Clear();
+        for (int i = 0; i < 24; ++i) {
+            hb_0_.Get(SearchBoard::ToCoor(g() % SearchBoard::k_area_num))
+                .SetChess(Chess(chess_rules[g() % std::size(chess_rules)], KingdomId(g() % 2)));
+        }
+        std::set<std::pair<int32_t, int32_t>> expected_moves;
+        for (int32_t src = 0; src < SearchBoard::k_area_num; ++src) {
+            const auto& src_chess = hb_0_.Get(SearchBoard::ToCoor(src)).GetChess();
+            if (!src_chess.has_value() || src_chess->kingdom_id_ != KingdomId(0)) {
+                continue;
+            }
+            for (int32_t dst = 0; dst < SearchBoard::k_area_num; ++dst) {
+                const auto& dst_chess = hb_0_.Get(SearchBoard::ToCoor(dst)).GetChess();
+                if (src != dst && (!dst_chess.has_value() || dst_chess->kingdom_id_ != KingdomId(0)) &&
+                        src_chess->chess_rule_->CanMove(hb_0_, SearchBoard::ToCoor(src), SearchBoard::ToCoor(dst))) {
+                    expected_moves.emplace(src, dst);
+                }
+            }
+        }
+        ASSERT_EQ(expected_moves, GeneratedMoves(MakeSearchBoard())) << "round " << round;
+    }
+}
+
+TEST_F(TestChineseChess_Search, make_and_unmake)
+{
+    std::mt19937 g(0);
+    SearchBoard board = MakeSearchBoard();
+    std::vector<std::tuple<SearchBoard::Undo, uint64_t, int32_t, std::set<std::pair<int32_t, int32_t>>>> history;
+    for (int i = 0; i < 200; ++i) {
+        SearchMoveList moves;
+        board.GenerateMoves(moves);
+        if (moves.Size() == 0) {
+            break;
+        }
+        const uint64_t hash = board.Hash();
+        const int32_t score = board.Evaluate();
+        auto generated_moves = GeneratedMoves(board);
+        SearchBoard::Undo undo;
+        board.Make(moves[g() % moves.Size()], undo);
+        history.emplace_back(undo, hash, score, std::move(generated_moves));
+    }
+    for (auto it = history.rbegin(); it != history.rend(); ++it) {
+        const auto& [undo, hash, score, generated_moves] = *it;
+        board.Unmake(undo);
+        ASSERT_EQ(hash, board.Hash());
+        ASSERT_EQ(score, board.Evaluate());
+        ASSERT_EQ(generated_moves, GeneratedMoves(board));
+    }
+    ASSERT_EQ(MakeSearchBoard().Hash(), board.Hash());
+}
+
+TEST_F(TestChineseChess_Search, eat_free_ju)
+{
+    Clear();
+    hb_0_.Get(Coor{0, 4}).SetChess(Chess(&JiangChessRule::Singleton(), KingdomId(0)));
+    hb_0_.Get(Coor{4, 1}).SetChess(Chess(&MaChessRule::Singleton(), KingdomId(0)));
+    hb_0_.Get(Coor{9, 3}).SetChess(Chess(&JiangChessRule::Singleton(), KingdomId(1)));
+    hb_0_.Get(Coor{6, 2}).SetChess(Chess(&JuChessRule::Singleton(), KingdomId(1)));
+    const auto result = SearchEngine().Search(MakeSearchBoard(), std::chrono::milliseconds(50), [](auto&&) { return true; });
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ((Coor{4, 1}), SearchBoard::ToCoor(result->move_.src_));
+    ASSERT_EQ((Coor{6, 2}), SearchBoard::ToCoor(result->move_.dst_));
+}
+
+TEST_F(TestChineseChess_Search, search_move_for_kingdom)
+{
+    BoardMgr board(2, 1);
+    const auto move = board.SearchComputerMove(0, KingdomId(0), std::chrono::milliseconds(20));
+    ASSERT_TRUE(move.has_value());
+    ASSERT_SUCC(board.Move(0, move->map_id_, move->src_, move->dst_));
+}
+
+TEST_F(TestChineseChess_Search, DISABLED_benchmark_nodes_per_second)
+{
+    constexpr int32_t k_depth = 5;
+    SearchEngine engine;
+    const auto begin = std::chrono::steady_clock::now();
+    const auto result = engine.Search(MakeSearchBoard(), std::chrono::hours(1), [](auto&&) { return true; }, k_depth);
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(k_depth, result->depth_);
+    std::cout << "depth " << k_depth << ": " << engine.VisitedNodes() << " nodes in " << elapsed.count() << " us ("
+              << engine.VisitedNodes() * 1000000 / std::max<int64_t>(elapsed.count(), 1) << " nodes/sec)" << std::endl;
+}
+
+TEST(TestChineseChess, DISABLED_benchmark_to_html)
+{
+    constexpr uint64_t k_iterations = 200;
+    BoardMgr board(3, 2); // all the six kingdoms
+    uint64_t output_size = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < k_iterations; ++i) {
+        output_size += board.ToHtml().size();
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+    std::cout << "ToHtml: " << elapsed.count() / k_iterations << " us per board (" << output_size / k_iterations
+              << " bytes)" << std::endl;
+}
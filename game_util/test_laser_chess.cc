@@ -3,6 +3,7 @@
 // This source code is licensed under LGPLv2 (found in the LICENSE file).
 
 #include "game_util/laser_chess.h"
+#include "games/laser_chess/game_maps.h"
 
 #include <gtest/gtest.h>
 #include <gflags/gflags.h>
@@ -208,3 +209,59 @@ TEST_F(TestLaserChess, kill_two_chess)
     ASSERT_EQ(0, b.ChessCount(1));
 }
 
+
+TEST_F(TestLaserChess, snapshot_restore)
+{
+    Board b = InitAceBoard("");
+    const auto html = b.ToHtml();
+    const auto snapshot = b.TakeSnapshot();
+    const Board copied_board = b;
+    ASSERT_SUCC(b.Move(Coor{3, 0}, Coor{2, 0}, 0));
+    b.Settle();
+    ASSERT_NE(html, b.ToHtml());
+    ASSERT_EQ(html, copied_board.ToHtml());
+    b.Restore(snapshot);
+    ASSERT_EQ(html, b.ToHtml());
+}
+
+TEST_F(TestLaserChess, legal_actions_succeed)
+{
+    Board b = InitAceBoard("");
+    std::vector<Action> actions;
+    for (const bool pid : {false, true}) {
+        b.LegalActions(pid, actions);
+        ASSERT_FALSE(actions.empty());
+        const auto snapshot = b.TakeSnapshot();
+        for (const auto& action : actions) {
+            ASSERT_SUCC(b.Act(action, pid));
+            b.Restore(snapshot);
+        }
+    }
+}
+
+TEST_F(TestLaserChess, minimax_kill_king)
+{
+    Board b(8, 8, "");
+    b.SetChess(Coor{1, 0}, ShooterChess<0>(RIGHT, std::bitset<4>().set(RIGHT).set(DOWN)));
+    b.SetChess(Coor{7, 7}, KingChess<0>());
+    b.SetChess(Coor{4, 0}, KingChess<1>());
+    const auto action = Minimax(b, 0).Search(true, std::chrono::milliseconds(100));
+    ASSERT_EQ(Action::Type::CLOCKWISE, action.type_);
+    ASSERT_EQ(1, action.src_.m_);
+    ASSERT_EQ(0, action.src_.n_);
+}
+
+TEST_F(TestLaserChess, perft)
+{
+    Board b = InitAceBoard("");
+    const std::array<uint64_t, 4> expected_counts{1, 77, 5929, 447133};
+    for (uint32_t depth = 0; depth < expected_counts.size(); ++depth) {
+        const auto begin = std::chrono::steady_clock::now();
+        const auto count = Perft(b, depth);
+        const auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - begin).count();
+        std::cout << "perft(" << depth << ") = " << count << ", " << elapsed_us << " us, "
+            << (elapsed_us == 0 ? 0 : count * 1000000 / elapsed_us) << " nodes/sec" << std::endl;
+        ASSERT_EQ(expected_counts[depth], count);
+    }
+}
@@ -125,6 +125,76 @@ TEST_F(TestComb, fill_zero)
     ASSERT_EQ(30, comb::Comb("").Fill(0, comb::AreaCard()).point_);
 }
 
+TEST_F(TestComb, layout_lines)
+{
+    for (uint32_t direct = 0; direct < comb::k_direct_max; ++direct) {
+        uint32_t area_count = 0;
+        for (uint32_t i = 0; i < comb::k_line_num_per_direct; ++i) {
+            area_count += comb::k_layout.lines_[direct * comb::k_line_num_per_direct + i].size_;
+        }
+        ASSERT_EQ(19, area_count);
+    }
+    for (uint32_t idx = 1; idx < comb::k_area_num; ++idx) {
+        ASSERT_EQ(idx, comb::Comb::ToIndex(comb::k_layout.coordinates_[idx])) << idx;
+    }
+}
+
+TEST_F(TestComb, state_is_copied_independently)
+{
+    comb::CombState state;
+    for (const uint32_t idx : {8, 9, 10, 11}) {
+        ASSERT_EQ(0, state.Fill(idx, comb::AreaCard(8, 9, 6)).point_);
+    }
+    comb::CombState copied_state = state;
+    ASSERT_EQ(45, copied_state.Fill(12, comb::AreaCard(8, 9, 6)).point_);
+    ASSERT_EQ(45, copied_state.Score());
+    ASSERT_EQ(1, copied_state.LineCount());
+    ASSERT_FALSE(state.IsFilled(12));
+    ASSERT_EQ(0, state.Score());
+    ASSERT_EQ(0, state.LineCount());
+}
+
+TEST_F(TestComb, expectimax_complete_line)
+{
+    comb::Comb cb("");
+    for (const uint32_t idx : {8, 9, 10, 11}) {
+        cb.Fill(idx, comb::AreaCard(8, 9, 6));
+    }
+    comb::CardPool pool;
+    pool.Add(comb::AreaCard(3, 1, 2), 10);
+    ASSERT_EQ(12, comb::Expectimax(pool, 5).Search(cb.State(), comb::AreaCard(4, 9, 7), std::chrono::milliseconds(10)));
+}
+
+TEST_F(TestComb, expectimax_avoid_breaking_line)
+{
+    comb::Comb cb("");
+    for (const uint32_t idx : {8, 9, 10, 11}) {
+        cb.Fill(idx, comb::AreaCard(8, 9, 6));
+    }
+    comb::CardPool pool;
+    pool.Add(comb::AreaCard(8, 9, 6), 10);
+    const uint32_t idx = comb::Expectimax(pool, 5).Search(cb.State(), comb::AreaCard(3, 1, 2), std::chrono::milliseconds(10));
+    ASSERT_NE(12, idx);
+    ASSERT_FALSE(cb.IsFilled(idx));
+}
+
+TEST_F(TestComb, DISABLED_benchmark_to_html)
+{
+    constexpr uint64_t k_iterations = 1000;
+    comb::Comb cb("");
+    for (uint32_t idx = 0; idx < 10; ++idx) {
+        cb.Fill(idx, comb::AreaCard(8, 9, 6));
+    }
+    uint64_t output_size = 0;
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < k_iterations; ++i) {
+        output_size += cb.ToHtml().size();
+    }
+    const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin);
+    std::cout << "ToHtml: " << elapsed.count() / k_iterations << " ns per board (" << output_size / k_iterations
+              << " bytes)" << std::endl;
+}
+
 int main(int argc, char** argv)
 {
     testing::InitGoogleTest(&argc, argv);
@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 #include <gflags/gflags.h>
 
+#include <iostream>
+
 namespace poker = lgtbot::game_util::poker;
 namespace ps = lgtbot::game_util::poker_squares;
 
@@ -181,6 +183,145 @@ TEST(TestPokerSquares, pattern_type_num_bonus)
     ASSERT_RESULT_EQ(10 * 1 * 1 + 5 * 12 * 2 + 200 + 400, square.Fill(24, ps::Card{poker::PokerNumber::_6, poker::PokerSuit::HEARTS})); // ONE_PAIR + STRAIGHT
 }
 
+TEST(TestPokerSquares, group_hand_pattern_same_as_hand)
+{
+    std::mt19937 g(0);
+    auto cards = poker::UnshuffledPokers<ps::k_card_type>();
+    for (int i = 0; i < 100000; ++i) {
+        std::shuffle(cards.begin(), cards.end(), g);
+        ps::GroupHand group_hand;
+        ps::Hand hand;
+        for (int j = 0; j < ps::k_square_size; ++j) {
+            group_hand.Add(cards[j]);
+            hand.Add(cards[j]);
+        }
+        ASSERT_EQ(hand.BestDeck()->type_, group_hand.Pattern()) << hand.ToString();
+    }
+}
+
+TEST(TestPokerSquares, state_is_copied_independently)
+{
+    std::array<ps::GridType, ps::k_grid_num> grid_types;
+    grid_types.fill(ps::GridType::empty);
+
+    ps::SquareState state{grid_types};
+    ASSERT_TRUE(state.Fill(0, ps::Card{poker::PokerNumber::_A, poker::PokerSuit::SPADES}));
+
+    ps::SquareState copied_state = state;
+    ASSERT_TRUE(copied_state.Fill(1, ps::Card{poker::PokerNumber::_A, poker::PokerSuit::HEARTS}));
+    ASSERT_FALSE(copied_state.Fill(0, ps::Card{poker::PokerNumber::_2, poker::PokerSuit::HEARTS}));
+
+    ASSERT_FALSE(state.IsFilled(1));
+    ASSERT_EQ(ps::k_grid_num - 1, state.EmptyCount());
+    ASSERT_EQ(ps::k_grid_num - 2, copied_state.EmptyCount());
+}
+
+TEST(TestPokerSquares, monte_carlo_complete_straight_flush)
+{
+    std::array<ps::GridType, ps::k_grid_num> grid_types;
+    grid_types.fill(ps::GridType::empty);
+
+    ps::SquareState state{grid_types};
+    std::vector<ps::Card> unrevealed_cards;
+    for (const auto card : poker::UnshuffledPokers<ps::k_card_type>()) {
+        unrevealed_cards.emplace_back(card);
+    }
+    const auto fill = [&](const int32_t index, const ps::Card card)
+        {
+            ASSERT_TRUE(state.Fill(index, card));
+            unrevealed_cards.erase(std::ranges::find(unrevealed_cards, card));
+        };
+    fill(0, ps::Card{poker::PokerNumber::_2, poker::PokerSuit::SPADES});
+    fill(6, ps::Card{poker::PokerNumber::_3, poker::PokerSuit::SPADES});
+    fill(12, ps::Card{poker::PokerNumber::_4, poker::PokerSuit::SPADES});
+    fill(18, ps::Card{poker::PokerNumber::_5, poker::PokerSuit::SPADES});
+    const ps::Card card{poker::PokerNumber::_6, poker::PokerSuit::SPADES};
+    unrevealed_cards.erase(std::ranges::find(unrevealed_cards, card));
+
+    ps::MonteCarlo monte_carlo(state, {}, std::move(unrevealed_cards));
+    ASSERT_EQ(24, monte_carlo.Search(card, std::chrono::milliseconds(20), 2));
+}
+
+namespace {
+
+// Plays a solo game with the placement strategy and returns the final score.
+int32_t PlayGame(const uint32_t seed, const auto& choose)
+{
+    constexpr int32_t k_upcoming_card_num = 2;
+    std::mt19937 g(seed);
+    auto cards = poker::UnshuffledPokers<ps::k_card_type>();
+    std::ranges::shuffle(cards, g);
+    std::array<ps::GridType, ps::k_grid_num> grid_types;
+    grid_types.fill(ps::GridType::empty);
+    grid_types[g() % ps::k_grid_num] = ps::GridType::double_score;
+    ps::SquareState state{grid_types};
+    for (auto it = cards.begin(); state.EmptyCount() > 0; ++it) {
+        if (state.ResetSkipNext()) {
+            continue;
+        }
+        const std::vector<ps::Card> upcoming_cards(it + 1, it + 1 + k_upcoming_card_num);
+        const std::vector<ps::Card> unrevealed_cards(it + 1 + k_upcoming_card_num, cards.end());
+        state.Fill(choose(state, *it, upcoming_cards, unrevealed_cards), *it);
+    }
+    return ps::GetScore(state.GetStatistic());
+}
+
+void PrintScoreDistribution(const char* const name, std::vector<int32_t> scores)
+{
+    std::ranges::sort(scores);
+    std::cout << name << ": mean " << std::accumulate(scores.begin(), scores.end(), 0) / static_cast<double>(scores.size())
+              << " min " << scores.front() << " p25 " << scores[scores.size() / 4] << " median " << scores[scores.size() / 2]
+              << " p75 " << scores[scores.size() * 3 / 4] << " max " << scores.back() << std::endl;
+}
+
+}
+
+TEST(TestPokerSquares, monte_carlo_score_distribution)
+{
+    constexpr uint32_t k_game_num = 20;
+    std::vector<int32_t> random_scores;
+    std::vector<int32_t> monte_carlo_scores;
+    for (uint32_t seed = 0; seed < k_game_num; ++seed) {
+        random_scores.emplace_back(PlayGame(seed, [](const ps::SquareState& state, auto&&...)
+                    {
+                        int32_t index = rand() % ps::k_grid_num;
+                        while (state.IsFilled(index)) {
+                            index = (index + 1) % ps::k_grid_num;
+                        }
+                        return index;
+                    }));
+        monte_carlo_scores.emplace_back(PlayGame(seed, [](const ps::SquareState& state, const ps::Card card,
+                        std::vector<ps::Card> upcoming_cards, std::vector<ps::Card> unrevealed_cards)
+                    {
+                        return ps::MonteCarlo(state, std::move(upcoming_cards), std::move(unrevealed_cards))
+                            .Search(card, std::chrono::milliseconds(5), 2, card.number_.ToUInt());
+                    }));
+    }
+    PrintScoreDistribution("random", random_scores);
+    PrintScoreDistribution("monte carlo", monte_carlo_scores);
+    ASSERT_GT(std::accumulate(monte_carlo_scores.begin(), monte_carlo_scores.end(), 0),
+              std::accumulate(random_scores.begin(), random_scores.end(), 0));
+}
+
+TEST(TestPokerSquares, monte_carlo_decision_latency)
+{
+    constexpr auto k_budget = std::chrono::milliseconds(20);
+    std::array<ps::GridType, ps::k_grid_num> grid_types;
+    grid_types.fill(ps::GridType::empty);
+    const ps::SquareState state{grid_types};
+    const auto cards = poker::ShuffledPokers<ps::k_card_type>("latency");
+    for (const uint32_t thread_num : {1, 2, 4}) {
+        ps::MonteCarlo monte_carlo(state, {cards.begin() + 1, cards.begin() + 3}, {cards.begin() + 3, cards.end()});
+        const auto begin = std::chrono::steady_clock::now();
+        monte_carlo.Search(cards[0], k_budget, thread_num);
+        const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin);
+        std::cout << "threads " << thread_num << ": " << elapsed.count() << " us, " << monte_carlo.SampleNum() << " samples ("
+                  << monte_carlo.SampleNum() * 1000000 / std::max<int64_t>(elapsed.count(), 1) << " samples/sec)" << std::endl;
+        // an empty square is the slowest case: one pass samples every grid
+        ASSERT_LT(elapsed, k_budget * 5);
+    }
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
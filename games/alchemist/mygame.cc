@@ -103,15 +103,13 @@ class MainStage : public MainGameStage<RoundStage>
         }
 
         const std::string& seed_str = GAME_OPTION(种子);
-        std::variant<std::random_device, std::seed_seq> rd;
+        std::optional<std::seed_seq> rd;
         std::mt19937 g([&]
             {
                 if (seed_str.empty()) {
-                    auto& real_rd = rd.emplace<std::random_device>();
-                    return std::mt19937(real_rd());
+                    return std::mt19937(Global().RandomEngine()());
                 } else {
-                    auto& real_rd = rd.emplace<std::seed_seq>(seed_str.begin(), seed_str.end());
-                    return std::mt19937(real_rd);
+                    return std::mt19937(rd.emplace(seed_str.begin(), seed_str.end()));
                 }
             }());
 
@@ -332,7 +330,7 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 
 void MainStage::MatchOver_()
 {
-    Global().Boardcast() << Markdown(BoardHtml("## 终局"));
+    Global().Boardcast() << LazyMarkdown{[&] { return BoardHtml("## 终局"); }};
     if (!GAME_OPTION(种子).empty() || GAME_OPTION(颜色) < 6 ||
             GAME_OPTION(点数) < 6) {
         return; // in this case, we do not save achievement
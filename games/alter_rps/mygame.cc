@@ -95,7 +95,7 @@ static std::string StarsString(const uint32_t n) {
 
 using CardMap = std::map<Card, CardState>;
 
-static CardMap GetCardMap(const MyGameOptions& option)
+static CardMap GetCardMap(const MyGameOptions& option, std::mt19937& g)
 {
     CardMap cards;
     const auto emplace_card = [&](const auto& card) {
@@ -119,8 +119,6 @@ static CardMap GetCardMap(const MyGameOptions& option)
         Card{ Type::ROCK, 10 }, Card{ Type::PAPER, 10 }, Card{ Type::SCISSOR, 10 },
         Card{ Type::BLANK, 2},  Card{ Type::BLANK, 5 },  Card{ Type::BLANK, 8 },
     };
-    std::random_device rd;
-    std::mt19937 g(rd());
     std::ranges::shuffle(shuffled_cards, g);
     uint32_t type_count[k_card_type_num] = {0};
     uint32_t max_num_each_type = 4;
@@ -294,7 +292,7 @@ class MainStage : public MainGameStage<RoundStage>
     MainStage(StageUtility&& utility)
         : StageFsm(std::move(utility),
                 MakeStageCommand(*this, "查看比赛情况", &MainStage::Info_, VoidChecker("赛况")))
-        , k_origin_card_map_(GetCardMap(Global().Options()))
+        , k_origin_card_map_(GetCardMap(Global().Options(), Global().RandomEngine()))
         , players_{k_origin_card_map_, k_origin_card_map_}
         , round_(1)
         , tables_{ThreeRoundTable(Global().ResourceDir()),
@@ -453,7 +451,7 @@ class ChooseStage : public SubGameStage<>
                 its.emplace_back(it);
             }
         }
-        SetCard_(pid, its[rand() % its.size()]);
+        SetCard_(pid, its[Global().Rand() % its.size()]);
 
         return StageErrCode::READY;
     }
@@ -537,7 +535,7 @@ class AlterStage : public SubGameStage<>
             return StageErrCode::OK;
         }
         auto& player = Main().players_[pid];
-        SetAlter_(pid, rand() % 2 ? player.left_ : player.right_);
+        SetAlter_(pid, Global().Rand() % 2 ? player.left_ : player.right_);
         return StageErrCode::READY;
     }
 
@@ -665,7 +663,7 @@ class RoundStage : public SubGameStage<ChooseStage<true>, ChooseStage<false>, Al
 
 void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 {
-    Global().Boardcast() << Markdown(CardInfoStr_());
+    Global().Boardcast() << LazyMarkdown{[&] { return CardInfoStr_(); }};
     setter.Emplace<RoundStage>(*this, 1);
 }
 
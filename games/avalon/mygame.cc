@@ -160,12 +160,10 @@ static std::vector<Player> InitializePlayers(const uint32_t player_num, const bo
     return {};
 }
 
-static std::array<Mission, k_mission_num> InitializeMissions(const uint32_t player_num, const LancelotMode lancelot_mode, const bool shuffle = true)
+static std::array<Mission, k_mission_num> InitializeMissions(const uint32_t player_num, const LancelotMode lancelot_mode, std::mt19937& gen, const bool shuffle = true)
 {
     std::array<bool, k_mission_num> to_convert_lancelots;
     to_convert_lancelots.fill(false);
-    std::random_device rd;
-    std::mt19937 gen {rd()};
     if (lancelot_mode == LancelotMode::explicit_five_rounds) {
         std::array<bool, 7> values = {true, true, false, false, false, false, false};
         if (shuffle) {
@@ -222,7 +220,7 @@ class MainStage : public MainGameStage<TeamUpStage, VoteStage, ActStage, DetectS
                 MakeStageCommand(*this, "查看当前游戏进展情况", &MainStage::Status_, VoidChecker("赛况")),
                 MakeStageCommand(*this, "尝试刺杀梅林", &MainStage::Assassin_, VoidChecker("刺杀"), ArithChecker<uint32_t>(0, utility.PlayerNum() - 1, "玩家 ID")))
         , players_(InitializePlayers(utility.PlayerNum(), GAME_OPTION(兰斯洛特模式) != LancelotMode::disable))
-        , missions_(InitializeMissions(utility.PlayerNum(), GAME_OPTION(兰斯洛特模式)
+        , missions_(InitializeMissions(utility.PlayerNum(), GAME_OPTION(兰斯洛特模式), Global().RandomEngine()
 #ifdef TEST_BOT
                     , !GAME_OPTION(测试模式)
 #endif
@@ -246,14 +244,12 @@ class MainStage : public MainGameStage<TeamUpStage, VoteStage, ActStage, DetectS
                 }())
         , mission_table_{1 + k_mission_num, static_cast<uint32_t>(5 + NeedLancelotCard(GAME_OPTION(兰斯洛特模式)))}
     {
-        std::random_device rd;
-        std::mt19937 gen {rd()};
 #ifdef TEST_BOT
         if (!GAME_OPTION(测试模式)) {
 #else
         if (true) {
 #endif
-            std::ranges::shuffle(players_, gen);
+            std::ranges::shuffle(players_, Global().RandomEngine());
         }
 
         const bool with_lancelot_card = NeedLancelotCard(GAME_OPTION(兰斯洛特模式));
@@ -490,7 +486,7 @@ class DetectStage : public SubGameStage<>
             return StageErrCode::OK;
         }
         PlayerID random_pid;
-        while (random_pid = rand() % Global().PlayerNum(), Main().GetPlayers()[random_pid].has_been_witch_)
+        while (random_pid = Global().Rand() % Global().PlayerNum(), Main().GetPlayers()[random_pid].has_been_witch_)
             ;
         detected_pid_ = random_pid;
         return StageErrCode::CHECKOUT;
@@ -560,9 +556,9 @@ class ActStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        players_succ_[pid] = Main().GetPlayers()[pid].team_ == Team::好 || rand() % 2 == 0;
-        if (GAME_OPTION(王者之剑) && pid == member_pids_.front() && rand() % 2 == 0) {
-            reverse_pid_ = member_pids_[rand() % member_pids_.size()];
+        players_succ_[pid] = Main().GetPlayers()[pid].team_ == Team::好 || Global().Rand() % 2 == 0;
+        if (GAME_OPTION(王者之剑) && pid == member_pids_.front() && Global().Rand() % 2 == 0) {
+            reverse_pid_ = member_pids_[Global().Rand() % member_pids_.size()];
             if (reverse_pid_ == pid) {
                 reverse_pid_ = std::nullopt;
             }
@@ -674,7 +670,7 @@ class VoteStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        players_agree_[pid] = rand() % 2;
+        players_agree_[pid] = Global().Rand() % 2;
         return StageErrCode::READY;
     }
 
@@ -733,9 +729,7 @@ class TeamUpStage : public SubGameStage<>
         std::vector<PlayerID> pids;
         pids.reserve(Global().PlayerNum());
         std::ranges::copy(std::views::iota(0U, Global().PlayerNum()), std::back_inserter(pids));
-        std::random_device rd;
-        std::mt19937 gen {rd()};
-        std::ranges::shuffle(pids, gen);
+        std::ranges::shuffle(pids, Global().RandomEngine());
         std::ranges::copy(pids | std::views::take(member_num_), std::back_inserter(member_pids_));
         if (member_pids_[0] == pid) {
             std::swap(member_pids_[0], member_pids_[1]);
@@ -343,7 +343,7 @@ class BidStage : public SubGameStage<k_type>
     {
         const auto max_bid_coins = this->Main().players()[pid].coins_ / 4;
         if (max_bid_coins > 0) {
-            Bid_(pid, false, reply, std::rand() % max_bid_coins + 1);
+            Bid_(pid, false, reply, this->Global().Rand() % max_bid_coins + 1);
         }
         return StageErrCode::READY;
     }
@@ -502,13 +502,13 @@ class MainBidStage : public SubGameStage<k_type, BidStage<k_type>>
 
     CompReqErrCode Status_(const PlayerID pid, const bool is_public, MsgSenderBase& reply)
     {
-        this->Global().Boardcast() << Markdown(InfoHtml_());
+        this->Global().Boardcast() << LazyMarkdown{[&] { return InfoHtml_(); }};
         return StageErrCode::OK;
     }
 
     void CreateBidStage(StageFsm::SubStageFsmSetter& setter)
     {
-        this->Global().Boardcast() << Markdown(InfoHtml_());
+        this->Global().Boardcast() << LazyMarkdown{[&] { return InfoHtml_(); }};
         setter.template Emplace<BidStage<k_type>>(this->Main(), std::to_string(index_ + 1) + "号商品", this->Main().poker_items()[index_].first,
                 this->Main().poker_items()[index_].second);
     }
@@ -531,7 +531,7 @@ class DiscardStage : public SubGameStage<k_type>
 
     void OnStageBegin()
     {
-        this->Global().Boardcast() << Markdown(InfoHtml_());
+        this->Global().Boardcast() << LazyMarkdown{[&] { return InfoHtml_(); }};
         this->Global().Boardcast() << "弃牌阶段开始，请一次性私信裁判**所有的**弃牌，当到达时间限制，或所有玩家皆选择完毕后，回合结束。"
                        "\n回合结束前您可以随意更改您的选择。";
         this->Global().StartTimer(GAME_OPTION(弃牌时间));
@@ -544,12 +544,12 @@ class DiscardStage : public SubGameStage<k_type>
 
     virtual AtomReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply)
     {
-        if (std::rand() % 2) {
+        if (this->Global().Rand() % 2) {
             return StageErrCode::READY;
         }
         const auto best_deck = this->Main().players()[pid].hand_.BestDeck();
         std::vector<std::string> discard_poker_strs;
-        const auto shuffled_pokers = poker::ShuffledPokers<k_type>();
+        const auto shuffled_pokers = poker::ShuffledPokers<k_type>("", this->Global().RandomEngine());
         for (const auto& poker : shuffled_pokers) {
             // should not break the best deck
             if (this->Main().players()[pid].hand_.Has(poker) &&
@@ -572,7 +572,7 @@ class DiscardStage : public SubGameStage<k_type>
 
     AtomReqErrCode Status_(const PlayerID pid, const bool is_public, MsgSenderBase& reply)
     {
-        this->Global().Boardcast() << Markdown(InfoHtml_());
+        this->Global().Boardcast() << LazyMarkdown{[&] { return InfoHtml_(); }};
         return StageErrCode::OK;
     }
 
@@ -680,7 +680,7 @@ template <poker::CardType k_type>
 void MainStage<k_type>::FirstStageFsm(StageFsm::SubStageFsmSetter setter)
 {
     int pos = 0;
-    const auto shuffled_pokers = poker::ShuffledPokers<k_type>(GAME_OPTION(种子));
+    const auto shuffled_pokers = poker::ShuffledPokers<k_type>(GAME_OPTION(种子), this->Global().RandomEngine());
     const auto emplace_pockers = [this, &shuffled_pokers, &pos](const int num)
         {
             poker_items_.emplace_back(std::nullopt, std::set<poker::Card<k_type>>(shuffled_pokers.begin() + pos, shuffled_pokers.begin() + pos + num));
@@ -709,7 +709,7 @@ void MainStage<k_type>::NextStageFsm(RoundStage<k_type>& sub_stage, const Checko
         setter.template Emplace<RoundStage<k_type>>(*this, round_);
         return;
     }
-    this->Global().Boardcast() << Markdown(TitleHtml() + "\n\n" + PlayerInfoHtml());
+    this->Global().Boardcast() << LazyMarkdown{[&] { return TitleHtml() + "\n\n" + PlayerInfoHtml(); }};
 }
 
 internal::MainStage* MakeMainStage(MainStageFactory factory)
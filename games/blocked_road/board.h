@@ -23,7 +23,7 @@ public:
 	int score[2], targetScore;
 
     // 初始化棋盘
-    void Initialize()
+    void Initialize(std::mt19937& g)
     {
         lastX1 = lastX2 = lastY1 = lastY2 = -1;
         for(int j = 0; j <= size; j++)
@@ -32,8 +32,8 @@ public:
 		// 随机生成开局棋子
 		int temp = 0;
 		while (temp < 4) {
-			int X = rand() % size + 1;
-			int Y = rand() % size + 1;
+			int X = g() % size + 1;
+			int Y = g() % size + 1;
 			if (chess[X][Y] == 0) {
 				chess[X][Y] = temp / 2 + 1;
 				temp++;
@@ -84,8 +84,7 @@ class MainStage : public MainGameStage<StartStage, RoundStage>
     void FirstStageFsm(SubStageFsmSetter setter)
     {
         // 随机先后手
-        srand((unsigned int)time(NULL));
-        currentPlayer = rand() % 2;
+        currentPlayer = Global().Rand() % 2;
 
         board.targetScore = GAME_OPTION(目标);
         board.size = GAME_OPTION(边长);
@@ -96,7 +95,7 @@ class MainStage : public MainGameStage<StartStage, RoundStage>
             }
             board.score[pid] = 0;
         }
-        board.Initialize();
+        board.Initialize(Global().RandomEngine());
 
         setter.Emplace<StartStage>(*this, ++round_);
     }
@@ -105,7 +104,7 @@ class MainStage : public MainGameStage<StartStage, RoundStage>
     {
         // 超时直接结束游戏
         if (reason == CheckoutReason::BY_TIMEOUT || reason == CheckoutReason::BY_LEAVE) {
-            Global().Boardcast() << Markdown(board.GetUI(false));
+            Global().Boardcast() << LazyMarkdown{[&] { return board.GetUI(false); }};
             return;
         }
         currentPlayer = 1- currentPlayer;
@@ -127,7 +126,7 @@ class MainStage : public MainGameStage<StartStage, RoundStage>
         if (round_ > GAME_OPTION(回合数)) {
             Global().Boardcast() << "回合数已达上限，游戏平局！";
         }
-        Global().Boardcast() << Markdown(board.GetUI(false));
+        Global().Boardcast() << LazyMarkdown{[&] { return board.GetUI(false); }};
     }
 };
 
@@ -141,7 +140,7 @@ class StartStage : public SubGameStage<>
 
     virtual void OnStageBegin() override
     {
-        Global().Boardcast() << Markdown(Main().board.GetUI(true));
+        Global().Boardcast() << LazyMarkdown{[&] { return Main().board.GetUI(true); }};
         Main().board.ClearLast();
         if (Main().round_ == 1) {
             Global().Boardcast() << "游戏开始！\n" << At(Main().currentPlayer) << " 先手，执" << color_ch[Main().currentPlayer] << "。请为对手放置棋子";
@@ -188,8 +187,8 @@ class StartStage : public SubGameStage<>
         if (pid == Main().currentPlayer) {
             string result;
             while (result != "OK") {
-                int X = rand() % Main().board.size + 1;
-                int Y = rand() % Main().board.size + 1;
+                int X = Global().Rand() % Main().board.size + 1;
+                int Y = Global().Rand() % Main().board.size + 1;
                 result = Main().board.PlaceChess(string(1, 'A' + X - 1) + to_string(Y), 1 - Main().currentPlayer);
             }
             return StageErrCode::READY;
@@ -211,12 +210,12 @@ class RoundStage : public SubGameStage<>
 
     virtual void OnStageBegin() override
     {
-        Global().Boardcast() << Markdown(Main().board.GetUI(true));
+        Global().Boardcast() << LazyMarkdown{[&] { return Main().board.GetUI(true); }};
         Global().Boardcast() << "请 " << color_ch[Main().currentPlayer] << "方" << At(Main().currentPlayer) << " 私信裁判移动棋子\n"
                              << "请 " << At(PlayerID(1 - Main().currentPlayer)) << " 设定本回合的禁走方向\n"
                              << "时限 " << GAME_OPTION(时限) << " 秒，超时未行动即判负";
-        Global().Tell(0) << Markdown(Main().board.GetUI(false));
-        Global().Tell(1) << Markdown(Main().board.GetUI(false));
+        Global().Tell(0) << LazyMarkdown{[&] { return Main().board.GetUI(false); }};
+        Global().Tell(1) << LazyMarkdown{[&] { return Main().board.GetUI(false); }};
         Global().StartTimer(GAME_OPTION(时限));
     }
 
@@ -287,7 +286,7 @@ class RoundStage : public SubGameStage<>
             // 猜测正确，阻止移动并获得1分
             Main().board.score[1 - Main().currentPlayer]++;
 
-            Global().Boardcast() << Markdown(Main().board.GetUI(true));
+            Global().Boardcast() << LazyMarkdown{[&] { return Main().board.GetUI(true); }};
 
             Global().Boardcast() << At(Main().currentPlayer) << " 将棋子从 " << start_pos << " 移动至 " << end_pos << "\n"
                                  << At(PlayerID(1 - Main().currentPlayer)) << " 设定禁止向" << direction_ch[guess_] << "走\n"
@@ -297,7 +296,7 @@ class RoundStage : public SubGameStage<>
             Main().board.chess[Main().board.lastX1][Main().board.lastY1] = 0;
             Main().board.chess[Main().board.lastX2][Main().board.lastY2] = Main().currentPlayer + 1;
 
-            Global().Boardcast() << Markdown(Main().board.GetUI(true));
+            Global().Boardcast() << LazyMarkdown{[&] { return Main().board.GetUI(true); }};
 
             Global().Boardcast() << At(Main().currentPlayer) << " 将棋子从 " << start_pos << " 移动至 " << end_pos << "\n"
                                  << At(PlayerID(1 - Main().currentPlayer)) << " 设定禁止向" << direction_ch[guess_] << "走\n"
@@ -329,7 +328,7 @@ class RoundStage : public SubGameStage<>
             int X, Y, addx, addy;
             string result;
             while (result != "OK") {
-                int c = rand() % GAME_OPTION(棋子) + 1;
+                int c = Global().Rand() % GAME_OPTION(棋子) + 1;
                 for (int i = 1; i <= Main().board.size; i++) {
                     for (int j = 1; j <= Main().board.size; j++) {
                         if (Main().board.chess[i][j] == pid + 1 && c >= 0) {
@@ -338,17 +337,17 @@ class RoundStage : public SubGameStage<>
                     }
                 }
                 addx = addy = 0;
-                if (rand() % 2) {
-                    addx = rand() % 2 == 1 ? 1 : -1;
+                if (Global().Rand() % 2) {
+                    addx = Global().Rand() % 2 == 1 ? 1 : -1;
                 } else {
-                    addy = rand() % 2 == 1 ? 1 : -1;
+                    addy = Global().Rand() % 2 == 1 ? 1 : -1;
                 }
                 string start_pos = string(1, 'A' + X - 1) + to_string(Y);
                 string end_pos = string(1, 'A' + X + addx - 1) + to_string(Y + addy);
                 result = Main().board.RecordChessMove(start_pos, end_pos, pid);
             }
         } else {
-            guess_ = rand() % 4 + 1;
+            guess_ = Global().Rand() % 4 + 1;
         }
         return StageErrCode::READY;
     }
@@ -158,7 +158,7 @@ class RoundStage : public SubGameStage<> {
         Global().Boardcast() << "玩家 " << Main().Global().PlayerName(i) << " 超时仍未行动，已被淘汰";
         Main().player_hp_[i] = 0;
         Main().player_select_[i] = 'N';
-        Main().player_number_[i] = rand() % 5 + 1;
+        Main().player_number_[i] = Global().Rand() % 5 + 1;
         Main().player_target_[i] = 0;
       }
     }
@@ -173,7 +173,7 @@ class RoundStage : public SubGameStage<> {
     //        Global().Boardcast() << Global().PlayerName(i) << "退出游戏";
     Main().player_hp_[i] = 0;
     Main().player_select_[i] = 'N';
-    Main().player_number_[i] = rand() % 5 + 1;
+    Main().player_number_[i] = Global().Rand() % 5 + 1;
     Main().player_target_[i] = 0;
     // Returning |CONTINUE| means the current stage will be continued.
     return StageErrCode::CONTINUE;
@@ -182,7 +182,7 @@ class RoundStage : public SubGameStage<> {
   virtual AtomReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply) override {
     int i = pid;
     Main().player_select_[i] = 'N';
-    Main().player_number_[i] = rand() % 4 + 2;
+    Main().player_number_[i] = Global().Rand() % 4 + 2;
     Main().player_target_[i] = 0;
 
     return StageErrCode::READY;
@@ -353,7 +353,6 @@ std::string MainStage::GetName(std::string x) {
 }
 
 void MainStage::FirstStageFsm(SubStageFsmSetter setter) {
-  srand((unsigned int)time(NULL));
   alive_ = Global().PlayerNum();
   for (int i = 0; i < Global().PlayerNum(); i++) {
     player_hp_[i] = GAME_OPTION(血量);
@@ -7,7 +7,9 @@
 #include <functional>
 #include <memory>
 #include <vector>
+#include <optional>
 #include <random>
+#include <sstream>
 #include <ranges>
 #include <algorithm>
 
@@ -70,8 +72,36 @@ const std::vector<InitOptionsCommand> k_init_options_commands = {
 
 // ========== GAME STAGES ==========
 
+#ifdef TEST_BOT
+constexpr auto k_computer_think_budget = std::chrono::milliseconds(5);
+#else
+constexpr auto k_computer_think_budget = std::chrono::milliseconds(1000);
+#endif
+
 static std::ostream& operator<<(std::ostream& os, const Coor& coor) { return os << ('A' + coor.m_) << coor.n_; }
 
+// The move searched by a computer is journaled as its choice, where an empty string means passing.
+static std::string EncodeMove(const std::optional<ComputerMove>& move)
+{
+    if (!move.has_value()) {
+        return {};
+    }
+    std::ostringstream ss;
+    ss << move->map_id_ << ' ' << move->src_.m_ << ' ' << move->src_.n_ << ' ' << move->dst_.m_ << ' ' << move->dst_.n_;
+    return ss.str();
+}
+
+static std::optional<ComputerMove> DecodeMove(const std::string& str)
+{
+    if (str.empty()) {
+        return std::nullopt;
+    }
+    std::istringstream ss(str);
+    ComputerMove move;
+    ss >> move.map_id_ >> move.src_.m_ >> move.src_.n_ >> move.dst_.m_ >> move.dst_.n_;
+    return move;
+}
+
 class MainStage : public MainGameStage<>
 {
   public:
@@ -88,7 +118,7 @@ class MainStage : public MainGameStage<>
                 MakeStageCommand(*this, "移动棋子", &MainStage::Move_,
                     ArithChecker<uint32_t>(0, utility.PlayerNum() * GET_OPTION_VALUE(utility.Options(), 阵营), "棋盘编号"),
                     AnyArg("移动前位置", "A1"), AnyArg("移动后位置", "B1")))
-        , board_(Global().PlayerNum(), GAME_OPTION(阵营))
+        , board_(Global().PlayerNum(), GAME_OPTION(阵营), Global().RandomEngine()())
         , round_(0)
     {}
 
@@ -104,6 +134,20 @@ class MainStage : public MainGameStage<>
 
     virtual AtomReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply)
     {
+        if (Global().IsReady(pid)) {
+            return StageErrCode::OK;
+        }
+        const auto unready_kingdom_ids = board_.GetUnreadyKingdomIds(pid);
+        for (const KingdomId kingdom_id : unready_kingdom_ids) {
+            const auto move = DecodeMove(Global().ComputerChoice([&]
+                        {
+                            return EncodeMove(board_.SearchComputerMove(pid, kingdom_id,
+                                        k_computer_think_budget / unready_kingdom_ids.size()));
+                        }));
+            if (!move.has_value() || !board_.Move(pid, move->map_id_, move->src_, move->dst_).empty()) {
+                board_.Pass(pid, kingdom_id);
+            }
+        }
         return StageErrCode::READY;
     }
 
@@ -0,0 +1,151 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#ifndef EQUILIBRIUM_
+#define EQUILIBRIUM_
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#include "problems.h"
+
+// Scores a question on scratch copies of players, so the state of the match is never touched. The question is created
+// and initialized again with the copies, because `calc` changes the state of the question.
+class QuestionEvaluator
+{
+public:
+	QuestionEvaluator(const uint32_t question_index, const vector<Player>& players)
+		: question_(create_question[question_index]()), players_(players), gains_(players.size(), 0)
+	{
+		question_->init(players_);
+		question_->initTexts(players_);
+		question_->initOptions();
+		question_->initExpects();
+		// The same as what `RoundStage::calc` does before scoring.
+		for (auto& player : players_) {
+			player.realLastScore = player.lastScore;
+			player.lastScore = player.score;
+		}
+		prepared_players_ = players_;
+	}
+
+	const Question& GetQuestion() const { return *question_; }
+	uint32_t OptionNum() const { return question_->options.size(); }
+	uint32_t PlayerNum() const { return players_.size(); }
+
+	// Returns the scores players gain when they choose `selects`.
+	const vector<double>& Evaluate(const vector<int>& selects)
+	{
+		for (size_t pid = 0; pid < players_.size(); ++pid) {
+			players_[pid] = prepared_players_[pid];
+			players_[pid].select = players_[pid].lastSelect = selects[pid];
+		}
+		question_->initCalc(players_);
+		question_->calc(players_);
+		question_->quickScore(players_);
+		for (size_t pid = 0; pid < players_.size(); ++pid) {
+			gains_[pid] = players_[pid].score - prepared_players_[pid].score;
+		}
+		return gains_;
+	}
+
+private:
+	std::unique_ptr<Question> question_;
+	vector<Player> players_;
+	vector<Player> prepared_players_;
+	vector<double> gains_;
+};
+
+// Computes a mixed strategy which is approximately a symmetric equilibrium of the question by regret matching: in each
+// iteration, all players choose options by the current strategy, and one of them (in turn) regrets not choosing each
+// other option by the score difference. The next strategy chooses options in proportion to the positive accumulated
+// regrets, and the average of strategies of all iterations is returned.
+inline vector<double> SolveEquilibrium(QuestionEvaluator& evaluator, const uint32_t iterations, std::mt19937& engine)
+{
+	const uint32_t option_num = evaluator.OptionNum();
+	if (option_num == 0) {
+		return {};
+	}
+	vector<double> regrets(option_num, 0);
+	vector<double> strategy(option_num, 1.0 / option_num);
+	vector<double> strategy_sum(option_num, 0);
+	vector<double> option_scores(option_num, 0);
+	vector<int> selects(evaluator.PlayerNum(), 0);
+	for (uint32_t iteration = 0; iteration < iterations; ++iteration) {
+		std::discrete_distribution<int> distribution(strategy.begin(), strategy.end());
+		for (auto& select : selects) {
+			select = distribution(engine);
+		}
+		const uint32_t pid = iteration % selects.size();
+		double expected_score = 0;
+		for (uint32_t option = 0; option < option_num; ++option) {
+			selects[pid] = option;
+			option_scores[option] = evaluator.Evaluate(selects)[pid];
+			expected_score += strategy[option] * option_scores[option];
+		}
+		double regret_sum = 0;
+		for (uint32_t option = 0; option < option_num; ++option) {
+			strategy_sum[option] += strategy[option];
+			// Regret matching+ forgets negative regrets, which converges faster.
+			regrets[option] = std::max(0.0, regrets[option] + option_scores[option] - expected_score);
+			regret_sum += regrets[option];
+		}
+		for (uint32_t option = 0; option < option_num; ++option) {
+			strategy[option] = regret_sum > 0 ? regrets[option] / regret_sum : 1.0 / option_num;
+		}
+	}
+	const double sum = std::max<double>(iterations, 1);
+	for (auto& probability : strategy_sum) {
+		probability /= sum;
+	}
+	return iterations > 0 ? strategy_sum : strategy;
+}
+
+// The equilibrium of a round shared by all computers. It is solved only once by the first computer needing it, and is
+// thread-safe.
+class SharedEquilibrium
+{
+public:
+	SharedEquilibrium(const uint32_t question_index, vector<Player> players, const uint32_t iterations,
+			const uint32_t seed)
+		: question_index_(question_index), players_(std::move(players)), iterations_(iterations), seed_(seed)
+	{
+	}
+
+	// Returns the index of the option. The option `excluded_option` is never chosen unless it is the only one.
+	int Choose(std::mt19937& engine, const int excluded_option = -1)
+	{
+		std::call_once(once_flag_, [this]
+				{
+					QuestionEvaluator evaluator(question_index_, players_);
+					std::mt19937 engine(seed_);
+					strategy_ = SolveEquilibrium(evaluator, iterations_, engine);
+				});
+		if (strategy_.empty()) {
+			return 0;
+		}
+		vector<double> strategy = strategy_;
+		if (excluded_option >= 0 && excluded_option < static_cast<int>(strategy.size()) && strategy.size() > 1) {
+			strategy[excluded_option] = 0;
+			if (std::ranges::all_of(strategy, [](const double probability) { return probability <= 0; })) {
+				strategy.assign(strategy.size(), 1);
+				strategy[excluded_option] = 0;
+			}
+		}
+		return std::discrete_distribution<int>(strategy.begin(), strategy.end())(engine);
+	}
+
+private:
+	const uint32_t question_index_;
+	const vector<Player> players_;
+	const uint32_t iterations_;
+	const uint32_t seed_;
+	std::once_flag once_flag_;
+	vector<double> strategy_;
+};
+
+#endif
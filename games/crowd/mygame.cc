@@ -17,6 +17,7 @@
 #include "utility/html.h"
 
 #include "problems.h"
+#include "equilibrium.h"
 #include "rules.h"
 
 using namespace std;
@@ -41,129 +42,12 @@ uint32_t Multiple(const MyGameOptions& options) {
 } // the default score multiple for the game, 0 for a testing game, 1 for a formal game, 2 or 3 for a long formal game
 const MutableGenericOptions k_default_generic_options;
 
-
-// formal questions
-constexpr static uint32_t k_question_num = 72;
-// with test questions
-constexpr static uint32_t all_question_num = 113;
-
-
-static const std::array<Question*(*)(), all_question_num> create_question{
-    []() -> Question* { return new Q1(); },
-    []() -> Question* { return new Q2(); },
-    []() -> Question* { return new Q3(); },
-    []() -> Question* { return new Q4(); },
-    []() -> Question* { return new Q5(); },
-    []() -> Question* { return new Q6(); },
-    []() -> Question* { return new Q7(); },
-    []() -> Question* { return new Q8(); },
-    []() -> Question* { return new Q9(); },
-    []() -> Question* { return new Q10(); },
-    []() -> Question* { return new Q11(); },
-    []() -> Question* { return new Q12(); },
-    []() -> Question* { return new Q13(); },
-    []() -> Question* { return new Q14(); },
-    []() -> Question* { return new Q15(); },
-    []() -> Question* { return new Q16(); },
-    []() -> Question* { return new Q17(); },
-    []() -> Question* { return new Q18(); },
-    []() -> Question* { return new Q19(); },
-    []() -> Question* { return new Q20(); },
-    []() -> Question* { return new Q21(); },
-    []() -> Question* { return new Q22(); },
-    []() -> Question* { return new Q23(); },
-    []() -> Question* { return new Q24(); },
-    []() -> Question* { return new Q25(); },
-    []() -> Question* { return new Q26(); },
-    []() -> Question* { return new Q27(); },
-    []() -> Question* { return new Q28(); },
-    []() -> Question* { return new Q29(); },
-    []() -> Question* { return new Q30(); },
-    []() -> Question* { return new Q31(); },
-    []() -> Question* { return new Q32(); },
-    []() -> Question* { return new Q33(); },
-    []() -> Question* { return new Q34(); },
-    []() -> Question* { return new Q35(); },
-    []() -> Question* { return new Q36(); },
-    []() -> Question* { return new Q37(); },
-    []() -> Question* { return new Q38(); },
-    []() -> Question* { return new Q39(); },
-    []() -> Question* { return new Q40(); },
-    []() -> Question* { return new Q41(); },
-    []() -> Question* { return new Q42(); },
-    []() -> Question* { return new Q43(); },
-    []() -> Question* { return new Q44(); },
-    []() -> Question* { return new Q45(); },
-    []() -> Question* { return new Q46(); },
-    []() -> Question* { return new Q47(); },
-    []() -> Question* { return new Q48(); },
-    []() -> Question* { return new Q49(); },
-    []() -> Question* { return new Q50(); },
-    []() -> Question* { return new Q51(); },
-    []() -> Question* { return new Q52(); },
-    []() -> Question* { return new Q53(); },
-    []() -> Question* { return new Q54(); },
-    []() -> Question* { return new Q55(); },
-    []() -> Question* { return new Q56(); },
-    []() -> Question* { return new Q57(); },
-    []() -> Question* { return new Q58(); },
-    []() -> Question* { return new Q59(); },
-    []() -> Question* { return new Q60(); },
-    []() -> Question* { return new Q61(); },
-    []() -> Question* { return new Q62(); },
-    []() -> Question* { return new Q63(); },
-    []() -> Question* { return new Q64(); },
-    []() -> Question* { return new Q65(); },
-    []() -> Question* { return new Q66(); },
-    []() -> Question* { return new Q67(); },
-    []() -> Question* { return new Q68(); },
-    []() -> Question* { return new Q69(); },
-    []() -> Question* { return new Q70(); },
-    []() -> Question* { return new Q71(); },
-    []() -> Question* { return new Q72(); },
-    // test questions
-    []() -> Question* { return new Q73(); },
-    []() -> Question* { return new Q74(); },
-    []() -> Question* { return new Q75(); },
-    []() -> Question* { return new Q76(); },
-    []() -> Question* { return new Q77(); },
-    []() -> Question* { return new Q78(); },
-    []() -> Question* { return new Q79(); },
-    []() -> Question* { return new Q80(); },
-    []() -> Question* { return new Q81(); },
-    []() -> Question* { return new Q82(); },
-    []() -> Question* { return new Q83(); },
-    []() -> Question* { return new Q84(); },
-    []() -> Question* { return new Q85(); },
-    []() -> Question* { return new Q86(); },
-    []() -> Question* { return new Q87(); },
-    []() -> Question* { return new Q88(); },
-    []() -> Question* { return new Q89(); },
-    []() -> Question* { return new Q90(); },
-    []() -> Question* { return new Q91(); },
-    []() -> Question* { return new Q92(); },
-    []() -> Question* { return new Q93(); },
-    []() -> Question* { return new Q94(); },
-    []() -> Question* { return new Q95(); },
-    []() -> Question* { return new Q96(); },
-    []() -> Question* { return new Q97(); },
-    []() -> Question* { return new Q98(); },
-    []() -> Question* { return new Q99(); },
-    []() -> Question* { return new Q100(); },
-    []() -> Question* { return new Q101(); },
-    []() -> Question* { return new Q102(); },
-    []() -> Question* { return new Q103(); },
-    []() -> Question* { return new Q104(); },
-    []() -> Question* { return new Q105(); },
-    []() -> Question* { return new Q106(); },
-    []() -> Question* { return new Q107(); },
-    []() -> Question* { return new Q108(); },
-    []() -> Question* { return new Q109(); },
-    []() -> Question* { return new Q110(); },
-    []() -> Question* { return new Q111(); },
-    []() -> Question* { return new Q112(); },
-    []() -> Question* { return new Q113(); },
-};
+// The number of iterations for computers to solve the equilibrium of a question. It takes about 4ms on average and no
+// more than 25ms for 20 players.
+constexpr uint32_t k_equilibrium_iterations = 3000;
+// The special rules under which computers solve the equilibrium, which do not change the scoring: no rule, hiding the
+// results, and forbidding the same option in adjacent rounds.
+const std::set<uint32_t> k_equilibrium_special_rules = {0, 1, 9};
 
 
 string init_question(int id)
@@ -310,9 +194,9 @@ class RoundStage : public SubGameStage<>
         int count = 0;
         while(r == -1 || Main().used.find(r) != Main().used.end())
         {
-            r = rand() % k_question_num;
+            r = Global().Rand() % k_question_num;
             if (GAME_OPTION(测试模式)) {
-                r = rand() % (all_question_num - k_question_num) + k_question_num;
+                r = Global().Rand() % (all_question_num - k_question_num) + k_question_num;
             }
             if(count++ > 1000) {
                 Main().used.clear();
@@ -329,6 +213,7 @@ class RoundStage : public SubGameStage<>
         }
 
         q = create_question[r]();
+        question_index_ = r;
 
         if(q == NULL)
         {
@@ -338,6 +223,7 @@ class RoundStage : public SubGameStage<>
             return;
         }
 
+        q -> engine.seed(Global().RandomEngine()());
         q -> init(Main().players);
         q -> initTexts(Main().players);
         q -> initOptions();
@@ -385,12 +271,40 @@ class RoundStage : public SubGameStage<>
         if(q -> expects.size() == 0 || q -> expects[0].length() == 0)
             return SubmitInternal_(pid, reply, x);
 
-        x[0] = q -> expects[0][rand() % (q -> expects[0].length())];
+        x[0] = q -> expects[0][Global().Rand() % (q -> expects[0].length())];
         if(x[0] <= 'z' && x[0] >= 'a') x[0] = x[0] - 'a' + 'A';
+        if(IsForbidden_(pid, x[0] - 'A'))
+            x[0] = 'A' + (x[0] - 'A' + 1) % q -> options.size();
 
         return SubmitInternal_(pid, reply, x);
     }
 
+    // Computers choose options by the equilibrium of the question, which is solved from copies of players by the first
+    // computer and shared by the others. If the solving runs out of the budget, `OnComputerAct` is invoked instead.
+    // The solver only knows the scoring of the question, so it is skipped if a special rule changes the scoring.
+    virtual std::optional<ComputerDecisionTask> PrepareComputerDecision(const PlayerID pid) override
+    {
+        if (question_index_ < 0 || !k_equilibrium_special_rules.contains(GAME_OPTION(特殊规则))) {
+            return std::nullopt;
+        }
+        if (!equilibrium_) {
+            equilibrium_ = std::make_shared<SharedEquilibrium>(question_index_, Main().players, k_equilibrium_iterations, Global().Rand());
+        }
+        return ComputerDecisionTask{
+            .compute_ = [equilibrium = equilibrium_, seed = Global().Rand(),
+                         forbidden_option = GAME_OPTION(特殊规则) == 9 ? Main().players[pid].lastSelect : -1]() -> ComputerDecision
+                {
+                    std::mt19937 engine(seed);
+                    return string(1, 'A' + equilibrium->Choose(engine, forbidden_option));
+                },
+        };
+    }
+
+    virtual AtomReqErrCode OnComputerDecision(const PlayerID pid, const ComputerDecision& decision, MsgSenderBase& reply) override
+    {
+        return SubmitInternal_(pid, reply, decision);
+    }
+
     virtual CheckoutErrCode OnStageOver() override
     {
         for(int i=0;i<Global().PlayerNum();i++)
@@ -523,7 +437,7 @@ class RoundStage : public SubGameStage<>
             return StageErrCode::FAILED;
         }
 
-        if(GAME_OPTION(特殊规则) == 9 && Main().players[pid].lastSelect == submission[0] - 'A') {
+        if(IsForbidden_(pid, submission[0] - 'A')) {
             reply() << "[错误] 特殊规则限制：本回合您不能选择此选项。";
             return StageErrCode::FAILED;
         }
@@ -531,17 +445,24 @@ class RoundStage : public SubGameStage<>
         return SubmitInternal_(pid, reply, submission);
     }
 
+    // The special rule 9 forbids choosing the same option in adjacent rounds.
+    bool IsForbidden_(const PlayerID pid, const int option) const
+    {
+        return GAME_OPTION(特殊规则) == 9 && Main().players[pid].lastSelect == option;
+    }
+
     AtomReqErrCode SubmitInternal_(const PlayerID pid, MsgSenderBase& reply, string submission)
     {
         Main().players[pid].select = submission[0] - 'A';
         return StageErrCode::READY;
     }
+
+    int question_index_ = -1;
+    std::shared_ptr<SharedEquilibrium> equilibrium_;
 };
 
 void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 {
-    srand((unsigned int)time(NULL));
-
     Player tempP;
     for(int i = 0; i < Global().PlayerNum(); i++)
     {
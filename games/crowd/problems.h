@@ -1,6 +1,7 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <random>
 #include <set>
 
 #include <map>
@@ -42,7 +43,7 @@ public:
 
 
 //---------------------------------------------------------------------------//
-double dec2(double x)
+inline double dec2(double x)
 {
     x = x * 100;
     if(x > 0) x += 0.5;
@@ -52,7 +53,7 @@ double dec2(double x)
 
     return x;
 }
-string str(double x)
+inline string str(double x)
 {
     string ret = "";
     x = dec2(x);
@@ -75,7 +76,7 @@ string str(double x)
     }
     return ret;
 }
-string strName(string x)
+inline string strName(string x)
 {
     string ret = "";
     int n = x.length();
@@ -102,11 +103,6 @@ class Question
 {
 public:
 	
-	Question()
-	{
-		vars.clear();
-	} 
-
     virtual ~Question() {};
 	
 	int id;
@@ -116,8 +112,6 @@ public:
 	vector<string> options;
 	vector<string> expects;
 	
-	map<string,double> vars;
-	
 	
 	double playerNum;
 	double maxScore;
@@ -128,6 +122,10 @@ public:
 	double nonZero_minSelect;
 	vector<double> tempScore;
 	
+	// the engine to draw random numbers in calc, which is seeded by the match
+	std::mt19937 engine;
+	int randInt() { return std::uniform_int_distribution<int>(0, RAND_MAX)(engine); }
+	
 	
 	// init playerNum
 	void init(vector<Player>& players)
@@ -150,10 +148,8 @@ public:
 		maxSelect = -99999;
 		minSelect = 99999;
 		nonZero_minSelect = 99999;
-		optionCount.clear();
-		
-		for(int i = 0; i < options.size(); i++) optionCount.push_back(0);
-		for(int i = 0; i < options.size(); i++) tempScore.push_back(0);
+		optionCount.assign(options.size(), 0);
+		tempScore.assign(options.size(), 0);
 		
 		for(int i = 0; i < playerNum; i++)
 		{
@@ -257,8 +253,8 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["v1"] = 1.36;
-		options.push_back("我是选项1，选我获得" + str(vars["v1"]) + "分");
+		v1_ = 1.36;
+		options.push_back("我是选项1，选我获得" + str(v1_) + "分");
 		options.push_back("我是选项2，选我获得2.17分");
 	}
 	virtual void initExpects() override
@@ -267,9 +263,12 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		tempScore[0] = vars["v1"];
+		tempScore[0] = v1_;
 		tempScore[1] = 2.17;
 	}
+
+private:
+	double v1_ = 0;
 };
 
 class Q1 : public Question
@@ -351,8 +350,8 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["A"] = playerNum/4;
-		options.push_back("中立：获得 " + str(vars["A"]) + " 分。");
+		A_ = playerNum/4;
+		options.push_back("中立：获得 " + str(A_) + " 分。");
 		options.push_back("激进：获得 [ 选择 A 选项的玩家个数 / 2 ] 分。");
 	}
 	virtual void initExpects() override
@@ -361,9 +360,12 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		tempScore[0] = vars["A"];
+		tempScore[0] = A_;
 		tempScore[1] = optionCount[0] / 2;
 	}
+
+private:
+	double A_ = 0;
 };
 
 class Q4 : public Question
@@ -382,12 +384,12 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["E"] = (int)playerNum / 2 + 1;
+		E_ = (int)playerNum / 2 + 1;
 		options.push_back("谨慎：+1分。");
 		options.push_back("团结：如果选择这项的人数最多，+3.5分。");
 		options.push_back("智慧：如果选择这项的人数最少，+3分。");
 		options.push_back("勇敢：如果只有一人选择这项，+5分。");
-		options.push_back("公正：选择这项的人平分 " + str(vars["E"]) + " 分。");
+		options.push_back("公正：选择这项的人平分 " + str(E_) + " 分。");
 	}
 	virtual void initExpects() override
 	{
@@ -399,8 +401,11 @@ public:
 		if(optionCount[1] == maxSelect) tempScore[1] = 3.5;
 		if(optionCount[2] == minSelect) tempScore[2] = 3;
 		if(optionCount[3] == 1) tempScore[3] = 5;
-		tempScore[4] = vars["E"] / optionCount[4];
+		tempScore[4] = E_ / optionCount[4];
 	}
+
+private:
+	double E_ = 0;
 };
 
 class Q5 : public Question
@@ -536,12 +541,12 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["A"] = playerNum;
-		vars["B1"] = (int)(playerNum / 4);
-		vars["B2"] = (int)(playerNum * 1.5); 
-		options.push_back("均势：选择本项的人平分" + str(vars["A"]) + "分。");
-		options.push_back("幽灵：选择本项的人，按人数+" + str(vars["B1"]) + "计算，平分"
-		 + str(vars["B2"]) + "分。");
+		A_ = playerNum;
+		B1_ = (int)(playerNum / 4);
+		B2_ = (int)(playerNum * 1.5); 
+		options.push_back("均势：选择本项的人平分" + str(A_) + "分。");
+		options.push_back("幽灵：选择本项的人，按人数+" + str(B1_) + "计算，平分"
+		 + str(B2_) + "分。");
 	}
 	virtual void initExpects() override
 	{
@@ -549,9 +554,14 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		tempScore[0] = vars["A"] / optionCount[0];
-		tempScore[1] = vars["B2"] / (optionCount[1] + vars["B1"]);
+		tempScore[0] = A_ / optionCount[0];
+		tempScore[1] = B2_ / (optionCount[1] + B1_);
 	}
+
+private:
+	double A_ = 0;
+	double B1_ = 0;
+	double B2_ = 0;
 };
 
 class Q9 : public Question
@@ -621,7 +631,7 @@ public:
 		if(optionCount[1] > 0) tempScore[0] = -2;
 		
 		tempScore[3] -= 0.6;
-		if(rand() % 1000 < 9)
+		if(randInt() % 1000 < 9)
 		{
 			tempScore[3] = 77;
 		} 
@@ -680,12 +690,12 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["D"] = (int)(playerNum / 3) + 2;
+		D_ = (int)(playerNum / 3) + 2;
 		options.push_back("智慧：人数比 B 少则 +3");
 		options.push_back("体能：人数比 A 多则 +2");
 		options.push_back("坚持：+1");
-		options.push_back("好运：如果恰有 " + str(vars["D"]) + " 玩家选择这个选项，+" + 
-		str(vars["D"]));
+		options.push_back("好运：如果恰有 " + str(D_) + " 玩家选择这个选项，+" + 
+		str(D_));
 	}
 	virtual void initExpects() override
 	{
@@ -696,8 +706,11 @@ public:
 		if(optionCount[0] < optionCount[1]) tempScore[0] = 3;
 		if(optionCount[0] < optionCount[1]) tempScore[1] = 2;
 		tempScore[2] = 1;
-		if(optionCount[3] == vars["D"]) tempScore[3] = vars["D"];
+		if(optionCount[3] == D_) tempScore[3] = D_;
 	}
+
+private:
+	double D_ = 0;
 };
 
 class Q13 : public Question
@@ -758,14 +771,14 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["A"] = 1;
-		vars["B"] = (int)(playerNum * 2 / 10) + 1;
-		vars["C"] = (int)(playerNum * 3 / 10) + 1;
-		vars["D"] = (int)(playerNum * 4 / 10);
-		options.push_back(str(vars["A"]) + "人，3分");
-		options.push_back(str(vars["B"]) + "人，2分");
-		options.push_back(str(vars["C"]) + "人，1分");
-		options.push_back(str(vars["D"]) + "人，2分");
+		A_ = 1;
+		B_ = (int)(playerNum * 2 / 10) + 1;
+		C_ = (int)(playerNum * 3 / 10) + 1;
+		D_ = (int)(playerNum * 4 / 10);
+		options.push_back(str(A_) + "人，3分");
+		options.push_back(str(B_) + "人，2分");
+		options.push_back(str(C_) + "人，1分");
+		options.push_back(str(D_) + "人，2分");
 	}
 	virtual void initExpects() override
 	{
@@ -773,11 +786,17 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		if(optionCount[0] <= vars["A"]) tempScore[0] = 3;
-		if(optionCount[1] <= vars["B"]) tempScore[1] = 2;
-		if(optionCount[2] <= vars["C"]) tempScore[2] = 1;
-		if(optionCount[3] <= vars["D"]) tempScore[3] = 2;
+		if(optionCount[0] <= A_) tempScore[0] = 3;
+		if(optionCount[1] <= B_) tempScore[1] = 2;
+		if(optionCount[2] <= C_) tempScore[2] = 1;
+		if(optionCount[3] <= D_) tempScore[3] = 2;
 	}
+
+private:
+	double A_ = 0;
+	double B_ = 0;
+	double C_ = 0;
+	double D_ = 0;
 };
 
 class Q15 : public Question
@@ -901,17 +920,17 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["S1"] = (int)(playerNum / 3);
-		vars["S2"] = (int)(playerNum / 2);
+		S1_ = (int)(playerNum / 3);
+		S2_ = (int)(playerNum / 2);
 		texts.push_back("选择一个阵营加入，每个阵营内部平分 " + 
-		str(vars["S1"]) + " 分，然后战斗力最高的阵营平分 " + str(vars["S2"]) + " 分");
+		str(S1_) + " 分，然后战斗力最高的阵营平分 " + str(S2_) + " 分");
 	}
 	virtual void initOptions() override
 	{
 		options.push_back("团结：每有一个加入者，+3战力。");
 		options.push_back("科技：战力固定为 " + str(playerNum) + "。");
 		options.push_back("经济：战力为 -1 。该阵营有 2 个或更多加入者时，不平分 " + 
-		str(vars["S1"]) + " 分，而是 " + str(vars["S2"]) + " 分。");
+		str(S1_) + " 分，而是 " + str(S2_) + " 分。");
 	}
 	virtual void initExpects() override
 	{
@@ -919,14 +938,18 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		tempScore[0] += vars["S1"] / optionCount[0];
-		tempScore[1] += vars["S1"] / optionCount[1];
-		tempScore[2] += vars["S1"] / optionCount[2];
+		tempScore[0] += S1_ / optionCount[0];
+		tempScore[1] += S1_ / optionCount[1];
+		tempScore[2] += S1_ / optionCount[2];
 		
-		if(optionCount[0] * 3 >= playerNum) tempScore[0] += vars["S2"] / optionCount[0];
-		if(optionCount[0] * 3 <= playerNum) tempScore[1] += vars["S2"] / optionCount[1];
-		if(optionCount[2] >= 2) tempScore[2] = vars["S2"] / optionCount[2];
+		if(optionCount[0] * 3 >= playerNum) tempScore[0] += S2_ / optionCount[0];
+		if(optionCount[0] * 3 <= playerNum) tempScore[1] += S2_ / optionCount[1];
+		if(optionCount[2] >= 2) tempScore[2] = S2_ / optionCount[2];
 	}
+
+private:
+	double S1_ = 0;
+	double S2_ = 0;
 };
 
 class Q19 : public Question
@@ -945,11 +968,11 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["A"] = (int)(playerNum / 3);
-		vars["B"] = (int)(playerNum * 3 / 5);
-		options.push_back("传谣：若选择人数<= " + str(vars["A"]) + "，+2。否则 -1。");
+		A_ = (int)(playerNum / 3);
+		B_ = (int)(playerNum * 3 / 5);
+		options.push_back("传谣：若选择人数<= " + str(A_) + "，+2。否则 -1。");
 		options.push_back("沉默：+0。");
-		options.push_back("思考：若选择人数>= " + str(vars["B"]) + "，+1。否则 -2。");
+		options.push_back("思考：若选择人数>= " + str(B_) + "，+1。否则 -2。");
 	}
 	virtual void initExpects() override
 	{
@@ -957,14 +980,18 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		if(optionCount[0] <= vars["A"]) tempScore[0] = 2;
+		if(optionCount[0] <= A_) tempScore[0] = 2;
 		else tempScore[0] = -1;
 		
 		tempScore[1] = 0;
 		
-		if(optionCount[2] >= vars["B"]) tempScore[2] = 1;
+		if(optionCount[2] >= B_) tempScore[2] = 1;
 		else tempScore[2] = -2;
 	}
+
+private:
+	double A_ = 0;
+	double B_ = 0;
 };
 
 class Q20 : public Question
@@ -1053,12 +1080,12 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["E"] = - 4 - playerNum / 4;
+		E_ = - 4 - playerNum / 4;
 		options.push_back("+0");
 		options.push_back("-1");
 		options.push_back("-2");
 		options.push_back("-3");
-		options.push_back(str(vars["E"]));
+		options.push_back(str(E_));
 	}
 	virtual void initExpects() override
 	{
@@ -1078,8 +1105,11 @@ public:
 		tempScore[1] += -1;
 		tempScore[2] += -2;
 		tempScore[3] += -3;
-		tempScore[4] += vars["E"];
+		tempScore[4] += E_;
 	}
+
+private:
+	double E_ = 0;
 };
 
 class Q23 : public Question
@@ -1450,9 +1480,9 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["coins"] = playerNum * 2.5;
-		vars["del"] = playerNum / 2 + 2;
-		texts.push_back("金库中有" + str(vars["coins"]) + "金币。");
+		coins_ = playerNum * 2.5;
+		del_ = playerNum / 2 + 2;
+		texts.push_back("金库中有" + str(coins_) + "金币。");
 		texts.push_back("玩家获得的金币将折合成同等的分数。");
 	}
 	virtual void initOptions() override
@@ -1460,7 +1490,7 @@ public:
 		options.push_back("投资：-1。所有投资者将均分金库中的金币。");
 		options.push_back("储蓄：+0.5，并使金库中金币 +1。");
 		options.push_back("等待：+0，并使金库中金币 -1。");
-		options.push_back("盗窃：-2，并使金库中金币 -" + str(vars["del"]));
+		options.push_back("盗窃：-2，并使金库中金币 -" + str(del_));
 	}
 	virtual void initExpects() override
 	{
@@ -1473,13 +1503,17 @@ public:
 		tempScore[2] = 0;
 		tempScore[3] = -2;
 		
-		int coins = vars["coins"];
+		int coins = coins_;
 		coins += optionCount[1];
 		coins -= optionCount[2];
-		coins -= optionCount[3] * vars["del"];
+		coins -= optionCount[3] * del_;
 		
 		tempScore[0] += coins / optionCount[0];
 	}
+
+private:
+	double coins_ = 0;
+	double del_ = 0;
 };
 
 class Q32 : public Question
@@ -1559,9 +1593,9 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["D"] = playerNum / 3;
-		options.push_back("分歧：如若 MAX - MIN > " + str(vars["D"]) + " ，+1");
-		options.push_back("秩序：如若 MAX - MIN <= " + str(vars["D"]) + " ，+3");
+		D_ = playerNum / 3;
+		options.push_back("分歧：如若 MAX - MIN > " + str(D_) + " ，+1");
+		options.push_back("秩序：如若 MAX - MIN <= " + str(D_) + " ，+3");
 		options.push_back("完美：如果 MAX - MIN <= 1， +6");
 	}
 	virtual void initExpects() override
@@ -1570,10 +1604,13 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		if(maxSelect - minSelect > vars["D"]) tempScore[0] = 1;
-		if(maxSelect - minSelect <= vars["D"]) tempScore[1] = 3;
+		if(maxSelect - minSelect > D_) tempScore[0] = 1;
+		if(maxSelect - minSelect <= D_) tempScore[1] = 3;
 		if(maxSelect - minSelect <= 1) tempScore[2] = 6;
 	}
+
+private:
+	double D_ = 0;
 };
 
 class Q34 : public Question
@@ -1588,9 +1625,9 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["coins"] = playerNum;
+		coins_ = playerNum;
 		texts.push_back("选择一项。");
-		texts.push_back("金库中一共有 " + str(vars["coins"]) + " 枚金币。");
+		texts.push_back("金库中一共有 " + str(coins_) + " 枚金币。");
 		texts.push_back("从数字最大的选项开始，所有选择了该项的玩家拿去等量的金币，依次执行下去。");
 		texts.push_back("但是，如果金币的数量不够某选项的玩家分，则会跳过这个选项。");
 	}
@@ -1608,7 +1645,7 @@ public:
 	virtual void calc(vector<Player>& players) override
 	{
 		double need[4] = {3, 2, 1, 0.5};
-		int coins = vars["coins"];
+		int coins = coins_;
 		for(int i = 0; i < 4; i++)
 		{
 			if(coins >= optionCount[i] * need[i])
@@ -1618,6 +1655,9 @@ public:
 			}
 		}
 	}
+
+private:
+	double coins_ = 0;
 };
 
 class Q35 : public Question
@@ -1972,25 +2012,25 @@ public:
 	virtual void initTexts(vector<Player>& players) override
 	{
 		if (playerNum > 5) {
-			vars["win1"] = 8;
-			vars["win2"] = 5;
-			vars["B"] = playerNum / 2 - 0.5;
+			win1_ = 8;
+			win2_ = 5;
+			B_ = playerNum / 2 - 0.5;
 		} else {
-			vars["win1"] = 6;
-			vars["win2"] = 3;
-			vars["B"] = playerNum / 2 + 0.5;
+			win1_ = 6;
+			win2_ = 3;
+			B_ = playerNum / 2 + 0.5;
 		}
-		vars["C"] = round(playerNum / 3);
-		texts.push_back("最先到达的队伍平分 " + str(vars["win1"]) + " 分");
-		texts.push_back("第二到达的队伍平分 " + str(vars["win2"]) + " 分");
+		C_ = round(playerNum / 3);
+		texts.push_back("最先到达的队伍平分 " + str(win1_) + " 分");
+		texts.push_back("第二到达的队伍平分 " + str(win2_) + " 分");
 		texts.push_back("最后到达的队伍视为迟到，每人-1分");
 		texts.push_back("如果有队伍同时到达，则按照 飞机→拼车→高铁 排列");
 	}
 	virtual void initOptions() override
 	{
         options.push_back("高铁：2h，每多一人时间增加0.5h");
-        options.push_back("拼车：" + str(vars["B"]) + "h，每多一人时间减少0.5h");
-        options.push_back("飞机：1h，若人数小于 " + str(vars["C"]) + " 则不出发");
+        options.push_back("拼车：" + str(B_) + "h，每多一人时间减少0.5h");
+        options.push_back("飞机：1h，若人数小于 " + str(C_) + " 则不出发");
 	}
 	virtual void initExpects() override
 	{
@@ -1998,10 +2038,10 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		vector<int> time = {17, int(vars["B"]*10+6), 10};
+		vector<int> time = {17, int(B_*10+6), 10};
 		time[0] += optionCount[0] * 5;
 		time[1] -= optionCount[1] * 5;
-		time[2] = (optionCount[2] < vars["C"]) ? 999 : time[2];
+		time[2] = (optionCount[2] < C_) ? 999 : time[2];
 		for (int i = 0; i < 3; i++) {
 			if (optionCount[i] == 0) {
 				time[i] = 999;
@@ -2012,10 +2052,16 @@ public:
 		int lose = distance(time.begin(), minmax.second);
 		int win2 = 3 - win1 - lose;
 
-		tempScore[win1] = vars["win1"] / optionCount[win1];
-		tempScore[win2] = vars["win2"] / optionCount[win2];
+		tempScore[win1] = win1_ / optionCount[win1];
+		tempScore[win2] = win2_ / optionCount[win2];
 		tempScore[lose] = -1;
 	}
+
+private:
+	double win1_ = 0;
+	double win2_ = 0;
+	double B_ = 0;
+	double C_ = 0;
 };
 
 class Q44 : public Question
@@ -2035,14 +2081,14 @@ public:
 	virtual void initOptions() override
 	{
 		if (playerNum <= 10) {
-			vars["A"] = 6;
-			vars["B"] = 4;
+			A_ = 6;
+			B_ = 4;
 		} else {
-			vars["A"] = 8;
-			vars["B"] = 5;
+			A_ = 8;
+			B_ = 5;
 		}
-        options.push_back("串联：2人及以上选择时平分 " + str(vars["A"]) + " 分。");
-        options.push_back("并联：获得 2<sup>" + str(vars["B"]) + "-N</sup> 分（N为选择此选项的人数）");
+        options.push_back("串联：2人及以上选择时平分 " + str(A_) + " 分。");
+        options.push_back("并联：获得 2<sup>" + str(B_) + "-N</sup> 分（N为选择此选项的人数）");
 	}
 	virtual void initExpects() override
 	{
@@ -2050,9 +2096,13 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		tempScore[0] = optionCount[0] >= 2 ? vars["A"] / optionCount[0] : 0;
-		tempScore[1] = pow(2, vars["B"] - optionCount[1]);
+		tempScore[0] = optionCount[0] >= 2 ? A_ / optionCount[0] : 0;
+		tempScore[1] = pow(2, B_ - optionCount[1]);
 	}
+
+private:
+	double A_ = 0;
+	double B_ = 0;
 };
 
 class Q45 : public Question
@@ -2380,20 +2430,20 @@ public:
 			tmp_score.push_back(players[i].score);
 		}
 		sort(tmp_score.begin(),tmp_score.end());
-		vars["med"] = int(tmp_score[int(playerNum / 2 + 1)]);
+		med_ = int(tmp_score[int(playerNum / 2 + 1)]);
 		for (int i = 0; i < playerNum; i++) {
-			if (players[i].score >= vars["med"]) {
+			if (players[i].score >= med_) {
 				large_med_count++;
 			}
 		}
-		vars["limit"] = large_med_count / 2 + 1;
+		limit_ = large_med_count / 2 + 1;
 		texts.push_back("战争爆发，你的策略是？");
 	}
 	virtual void initOptions() override
 	{
         options.push_back("和平：+1。但如果核武器研制成功，改为-1");
         options.push_back("人海战术：+2。但如果核武器研制成功，改为-3");
-        options.push_back("研究核武器：如果当前分数达到 " + str(vars["med"]) + " 的玩家至少有 " + str(vars["limit"]) + " 人选择此选项，则研制成功，所有选择此选项的玩家+1，否则-2");
+        options.push_back("研究核武器：如果当前分数达到 " + str(med_) + " 的玩家至少有 " + str(limit_) + " 人选择此选项，则研制成功，所有选择此选项的玩家+1，否则-2");
 		options.push_back("投降：-0.5");
 	}
 	virtual void initExpects() override
@@ -2408,16 +2458,20 @@ public:
 		tempScore[3] = -0.5;
 		int count = 0;
 		for(int i = 0; i < playerNum; i++) {
-			if (players[i].score >= vars["med"] && players[i].select == 2) {
+			if (players[i].score >= med_ && players[i].select == 2) {
 				count++;
 			}
 		}
-		if (count >= vars["limit"]) {
+		if (count >= limit_) {
 			tempScore[0] = -1;
 			tempScore[1] = -3;
 			tempScore[2] = 1;
 		}
 	}
+
+private:
+	double med_ = 0;
+	double limit_ = 0;
 };
 
 class Q54 : public Question
@@ -2475,14 +2529,14 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["num"] = int(playerNum / 3);
+		num_ = int(playerNum / 3);
 		texts.push_back("选择一个身份。");
 	}
 	virtual void initOptions() override
 	{
         options.push_back("民：如果没有警，-2");
         options.push_back("贼：+2");
-		options.push_back("警：如果选贼的人数不少于 " + str(vars["num"]) + "：警+1，并使选贼的玩家改为-2；否则警-2");
+		options.push_back("警：如果选贼的人数不少于 " + str(num_) + "：警+1，并使选贼的玩家改为-2；否则警-2");
 	}
 	virtual void initExpects() override
 	{
@@ -2493,11 +2547,14 @@ public:
 		tempScore[0] = optionCount[2] == 0 ? -2 : 0;
 		tempScore[1] = 2;
 		tempScore[2] = -2;
-		if (optionCount[2] > 0 && optionCount[1] >= vars["num"]) {
+		if (optionCount[2] > 0 && optionCount[1] >= num_) {
 			tempScore[2] = 1;
 			tempScore[1] = -2;
 		}
 	}
+
+private:
+	double num_ = 0;
 };
 
 class Q56 : public Question
@@ -2661,7 +2718,7 @@ public:
 			if (optionCount[2] > 0 && optionCount[1] == maxSelect) {
 				tempScore[1] = -1;
 			}
-			if (rand() % 1000 < 16) {
+			if (randInt() % 1000 < 16) {
 				tempScore[4] = 64;
 			}
 		} else {
@@ -2771,27 +2828,30 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["num"] = playerNum > 20 ? 20 : playerNum;
-		for (int i = 0; i < vars["num"]; i++) {
+		num_ = playerNum > 20 ? 20 : playerNum;
+		for (int i = 0; i < num_; i++) {
         	options.push_back("+" + str(i * 0.5 + 0.5));
 		}
 	}
 	virtual void initExpects() override
 	{
 		string expect = "";
-		for (int i = 0; i < vars["num"]; i++) {
+		for (int i = 0; i < num_; i++) {
         	expect += 'a' + i;
 		}
 		expects.push_back(expect);
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		for (int i = 0; i < vars["num"]; i++) {
+		for (int i = 0; i < num_; i++) {
         	if (optionCount[i] == 1) {
 				tempScore[i] = i * 0.5 + 0.5;
 			}
 		}
 	}
+
+private:
+	double num_ = 0;
 };
 
 class Q62 : public Question
@@ -2811,18 +2871,18 @@ public:
 	virtual void initOptions() override
 	{
 		if (playerNum < 5) {
-			vars["num"] = 4;
+			num_ = 4;
 		} else {
-			vars["num"] = round(4 + (playerNum - 5) / 2);
+			num_ = round(4 + (playerNum - 5) / 2);
 		}
-		for (int i = 1; i <= vars["num"]; i++) {
+		for (int i = 1; i <= num_; i++) {
 			options.push_back("[" + to_string(i) + "]号");
 		}
 	}
 	virtual void initExpects() override
 	{
 		string expect = "";
-		for (int i = 0; i < vars["num"]; i++) {
+		for (int i = 0; i < num_; i++) {
         	expect += 'a' + i;
 		}
 		expects.push_back(expect);
@@ -2830,7 +2890,7 @@ public:
 	virtual void calc(vector<Player>& players) override
 	{
 		bool min = true;
-		for (int i = 0; i < vars["num"]; i++) {
+		for (int i = 0; i < num_; i++) {
 			if (optionCount[i] == 1 && min) {
 				tempScore[i] = 2;
 				min = false;
@@ -2840,6 +2900,9 @@ public:
 			}
 		}
 	}
+
+private:
+	double num_ = 0;
 };
 
 class Q63: public Question
@@ -2858,9 +2921,9 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["leave"] = ceil(playerNum / 3);
+		leave_ = ceil(playerNum / 3);
 		options.push_back("继续：均分 " + str(playerNum) + " 分");
-		options.push_back("撤离：均分 " + str(vars["leave"]) + " 分，除不尽的部分无法被均分");
+		options.push_back("撤离：均分 " + str(leave_) + " 分，除不尽的部分无法被均分");
 		options.push_back("地狱犬（怪物）：-0.5");
 		options.push_back("美杜莎（怪物）：-1");
 		options.push_back("不死鸟（怪物）：-1.5");
@@ -2871,7 +2934,7 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		tempScore[1] = int(vars["leave"] / optionCount[1]);
+		tempScore[1] = int(leave_ / optionCount[1]);
 		if (optionCount[2] >= 2 || optionCount[3] >= 2 || optionCount[4] >= 2) {
 			tempScore[0] = -1;
 			tempScore[2] = optionCount[0] / optionCount[2];
@@ -2884,6 +2947,9 @@ public:
 			tempScore[4] = -1.5;
 		}
 	}
+
+private:
+	double leave_ = 0;
 };
 
 class Q64: public Question
@@ -2975,15 +3041,15 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["num"] = int(playerNum / 2) + 2;
-		for (int i = 1; i <= vars["num"]; i++) {
+		num_ = int(playerNum / 2) + 2;
+		for (int i = 1; i <= num_; i++) {
 			options.push_back(to_string(i));
 		}
 	}
 	virtual void initExpects() override
 	{
 		string expect = "";
-		for (int i = 0; i < vars["num"]; i++) {
+		for (int i = 0; i < num_; i++) {
         	expect += 'a' + i;
 		}
 		expects.push_back(expect);
@@ -2991,17 +3057,20 @@ public:
 	virtual void calc(vector<Player>& players) override
 	{
 		int count = 0;
-		for (int i = 0; i < vars["num"]; i++) {
+		for (int i = 0; i < num_; i++) {
         	if (optionCount[i] > 0) {
 				count++;
 			}
 		}
-		for (int i = 0; i < vars["num"]; i++) {
+		for (int i = 0; i < num_; i++) {
         	if (count >= i + 1) {
 				tempScore[i] = i + 1;
 			}
 		}
 	}
+
+private:
+	double num_ = 0;
 };
 
 class Q67: public Question
@@ -3468,14 +3537,14 @@ public:
 	virtual void initOptions() override
 	{
 		if (playerNum > 8) {
-			vars["percent"] = 10;
+			percent_ = 10;
 		} else {
-			vars["percent"] = 16;
+			percent_ = 16;
 		}
-        options.push_back("+2，有 [(B+C) *" + str(vars["percent"]) + "]% 的概率-4");
-        options.push_back("+1，有 [(A-B) *" + str(vars["percent"]) + "]% 的概率使C+2");
-		options.push_back("-2，有 [(A+D) *" + str(vars["percent"]) + "]% 的概率+6");
-		options.push_back("-3，有 [(A+B-D) *" + str(vars["percent"]) + "]% 的概率使A和B-4，D+5");
+        options.push_back("+2，有 [(B+C) *" + str(percent_) + "]% 的概率-4");
+        options.push_back("+1，有 [(A-B) *" + str(percent_) + "]% 的概率使C+2");
+		options.push_back("-2，有 [(A+D) *" + str(percent_) + "]% 的概率+6");
+		options.push_back("-3，有 [(A+B-D) *" + str(percent_) + "]% 的概率使A和B-4，D+5");
 	}
 	virtual void initExpects() override
 	{
@@ -3487,21 +3556,24 @@ public:
 		tempScore[1] = 1;
 		tempScore[2] = -2;
 		tempScore[3] = -3;
-		if (rand() % 100 < (optionCount[1] + optionCount[2]) * vars["percent"]) {
+		if (randInt() % 100 < (optionCount[1] + optionCount[2]) * percent_) {
 			tempScore[0] -= 4;
 		}
-		if (rand() % 100 < (optionCount[0] - optionCount[1]) * vars["percent"]) {
+		if (randInt() % 100 < (optionCount[0] - optionCount[1]) * percent_) {
 			tempScore[2] += 2;
 		}
-		if (rand() % 100 < (optionCount[0] + optionCount[3]) * vars["percent"]) {
+		if (randInt() % 100 < (optionCount[0] + optionCount[3]) * percent_) {
 			tempScore[2] += 6;
 		}
-		if (rand() % 100 < (optionCount[0] + optionCount[1] - optionCount[3]) * vars["percent"]) {
+		if (randInt() % 100 < (optionCount[0] + optionCount[1] - optionCount[3]) * percent_) {
 			tempScore[0] -= 4;
 			tempScore[1] -= 4;
 			tempScore[2] += 5;
 		}
 	}
+
+private:
+	double percent_ = 0;
 };
 
 class Q79 : public Question   // [待修改]分数增减幅度太大    平衡 1
@@ -3516,9 +3588,9 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["start"] = playerNum * 2;
-		vars["limit"] = int(playerNum * 3.2);
-		texts.push_back("桌上有 " + str(vars["start"]) + " 个资源，一资源一分，如果投入后总资源超过了 " + str(vars["limit"]) + " ，那获得（你的减分/所有玩家的减分）比例的总资源。如果投入后分数为负数，则选择无效。");
+		start_ = playerNum * 2;
+		limit_ = int(playerNum * 3.2);
+		texts.push_back("桌上有 " + str(start_) + " 个资源，一资源一分，如果投入后总资源超过了 " + str(limit_) + " ，那获得（你的减分/所有玩家的减分）比例的总资源。如果投入后分数为负数，则选择无效。");
 	}
 	virtual void initOptions() override
 	{
@@ -3535,7 +3607,7 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		int total = vars["start"];
+		int total = start_;
 		total = total + optionCount[1] * 1 + optionCount[2] * 2 + optionCount[3] * 4 + optionCount[4] * 6;
 		tempScore[1] = -1;
 		tempScore[2] = -2;
@@ -3547,19 +3619,23 @@ public:
 				players[i].score -= tempScore[players[i].select];
 			}
 		}
-		if (rand() % 1000 < 16) {
+		if (randInt() % 1000 < 16) {
 			tempScore[5] = total;
 		} else {
-			if (total > vars["limit"]) {
+			if (total > limit_) {
 				for (int i = 0; i < playerNum; i++) {
 					if (players[i].score >= -tempScore[players[i].select]) {
-						players[i].score += -tempScore[players[i].select] / (total - vars["start"]) * total;
+						players[i].score += -tempScore[players[i].select] / (total - start_) * total;
 					}
 				}
 			}
 			tempScore[5] = -15;
 		}
 	}
+
+private:
+	double start_ = 0;
+	double limit_ = 0;
 };
 
 class Q80 : public Question   // [待修改]选项不平衡，选D居多
@@ -3795,12 +3871,12 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		tempScore[0] = rand() % 100 < 5 ? -1 : 2;
-		tempScore[1] = rand() % 100 < 10 ? 24 : 0;
+		tempScore[0] = randInt() % 100 < 5 ? -1 : 2;
+		tempScore[1] = randInt() % 100 < 10 ? 24 : 0;
 		tempScore[2] = 13 - optionCount[1] * 1.75;
 		tempScore[3] = optionCount[0] == 0 ? 12 : 0;
 		tempScore[4] = optionCount[0] + optionCount[1] - optionCount[2] + optionCount[3];
-		tempScore[5] = rand() % 1000 < 25 ? 1919810 : -114514;
+		tempScore[5] = randInt() % 1000 < 25 ? 1919810 : -114514;
 	}
 };
 
@@ -3923,8 +3999,8 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["point"] = playerNum * 1.5;
-		texts.push_back("场上有 " + str(vars["point"]) + " 的积分，玩家从中获得和选项数值一致的积分，如果积分不够分配至所有玩家，选 A 的玩家平分所有积分");
+		point_ = playerNum * 1.5;
+		texts.push_back("场上有 " + str(point_) + " 的积分，玩家从中获得和选项数值一致的积分，如果积分不够分配至所有玩家，选 A 的玩家平分所有积分");
 	}
 	virtual void initOptions() override
 	{
@@ -3941,15 +4017,18 @@ public:
 	virtual void calc(vector<Player>& players) override
 	{
 		double sum = optionCount[1]*1 + optionCount[2]*2 + optionCount[3]*3 + optionCount[4]*4;
-		if (sum <= vars["point"]) {
+		if (sum <= point_) {
 			tempScore[1] = 1;
 			tempScore[2] = 2;
 			tempScore[3] = 3;
 			tempScore[4] = 4;
 		} else {
-			tempScore[0] = vars["point"] / optionCount[0];
+			tempScore[0] = point_ / optionCount[0];
 		}
 	}
+
+private:
+	double point_ = 0;
 };
 
 class Q89 : public Question   // 备选题目   平衡 1
@@ -4003,8 +4082,8 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["num"] = int(playerNum / 2);
-        options.push_back("B人数大于 " + str(vars["num"]) + " 则胜利");
+		num_ = int(playerNum / 2);
+        options.push_back("B人数大于 " + str(num_) + " 则胜利");
         options.push_back("中立");
 		options.push_back("A人数大于B则胜利，否则输");
 	}
@@ -4014,7 +4093,7 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		bool a_win = optionCount[1] > vars["num"];
+		bool a_win = optionCount[1] > num_;
 		bool c_win = optionCount[0] > optionCount[1];
 		if (a_win && !c_win) {
 			tempScore[0] = 2;
@@ -4028,6 +4107,9 @@ public:
 			tempScore[2] = -2;
 		}
 	}
+
+private:
+	double num_ = 0;
 };
 
 class Q91 : public Question   // [待修改]题目过于复杂
@@ -4102,8 +4184,8 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["debt"] = playerNum * 1.5;
-		texts.push_back("有 " + str(vars["debt"]) + " 负债需要分摊，玩家每+1分，负债+1，玩家每-1分，负债-1。每轮将以从上往下的顺序结算。若所有选项均结算完成，将开始新一轮结算，直到负债归零。你选择：");
+		debt_ = playerNum * 1.5;
+		texts.push_back("有 " + str(debt_) + " 负债需要分摊，玩家每+1分，负债+1，玩家每-1分，负债-1。每轮将以从上往下的顺序结算。若所有选项均结算完成，将开始新一轮结算，直到负债归零。你选择：");
 	}
 	virtual void initOptions() override
 	{
@@ -4120,7 +4202,7 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		int debt = vars["debt"];
+		int debt = debt_;
 		tempScore[0] -= 1;
 		tempScore[1] += 1;
 		tempScore[2] -= 2;
@@ -4139,6 +4221,9 @@ public:
 			}
 		}
 	}
+
+private:
+	double debt_ = 0;
 };
 
 class Q93 : public Question   // [待修改]D选项不好理解，选项不平衡，AD人数居多
@@ -4168,7 +4253,7 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		int gap;
+		int gap = 0;
 		optionCount[0] -= optionCount[3];
 		if (optionCount[0] <= 0) {
 			gap = 1 - optionCount[0];
@@ -4401,12 +4486,12 @@ public:
 			tmp_score.push_back(players[i].score);
 		}
 		sort(tmp_score.begin(),tmp_score.end());
-		vars["score"] = tmp_score[2];
+		score_ = tmp_score[2];
 		texts.push_back("获胜的选项获得 [选择非此选项人数] 的分数，失败的选项失去 [选择获胜选项人数] 的分数");
 	}
 	virtual void initOptions() override
 	{
-        options.push_back("红苹果：如果分数小于等于 " + str(vars["score"]) + " 的玩家都选择红苹果，红苹果获胜。但如果所有人都选择此项，全员分数取反");
+        options.push_back("红苹果：如果分数小于等于 " + str(score_) + " 的玩家都选择红苹果，红苹果获胜。但如果所有人都选择此项，全员分数取反");
         options.push_back("银苹果：如果选择此项的人数少于 C，且红苹果没有获胜，银苹果获胜。");
 		options.push_back("金苹果：如果选择此项的人数少于等于 B，且红苹果没有获胜，金苹果获胜。");
 	}
@@ -4421,7 +4506,7 @@ public:
 		bool is_invert = false;
 		win = l1 = l2 = 0;
 		for (int i = 0; i < playerNum; i++) {
-			if (players[i].score <= vars["score"] && players[i].select != 0) {
+			if (players[i].score <= score_ && players[i].select != 0) {
 				red_win = false; break;
 			}
 		}
@@ -4450,6 +4535,9 @@ public:
 			tempScore[l2] = -optionCount[win];
 		}
 	}
+
+private:
+	double score_ = 0;
 };
 
 class Q100 : public Question   // [待修改]A选项不平衡，无人选择
@@ -4464,8 +4552,8 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["point"] = playerNum * 2.5;
-		texts.push_back("有 " + str(vars["point"]) + " 分可供瓜分，你可以选择拿取的分数，然后从小到大进行拿取操作。但当剩余分数不够某个选项拿取时，该组及更高分组-1分。");
+		point_ = playerNum * 2.5;
+		texts.push_back("有 " + str(point_) + " 分可供瓜分，你可以选择拿取的分数，然后从小到大进行拿取操作。但当剩余分数不够某个选项拿取时，该组及更高分组-1分。");
 	}
 	virtual void initOptions() override
 	{
@@ -4481,7 +4569,7 @@ public:
 	virtual void calc(vector<Player>& players) override
 	{
 		int need[4] = {1, 2, 3, 4};
-		int point = vars["point"];
+		int point = point_;
 		for(int i = 0; i < 4; i++)
 		{
 			if(point >= optionCount[i] * need[i])
@@ -4496,6 +4584,9 @@ public:
 			}
 		}
 	}
+
+private:
+	double point_ = 0;
 };
 
 class Q101: public Question   // [待定]对于为玩过伊甸园的玩家读题略有困难
@@ -4556,8 +4647,8 @@ public:
 	}
 	virtual void initOptions() override
 	{
-		vars["num"] = playerNum * 2 - 1;
-		options.push_back("宝藏：平分 " + str(vars["num"]) + " 分");
+		num_ = playerNum * 2 - 1;
+		options.push_back("宝藏：平分 " + str(num_) + " 分");
 		options.push_back("珍宝：如果选择人数小于等于3，+2");
 		options.push_back("奇遇：选择A，B的玩家减 [选择C的人数] 的分数");
 		options.push_back("怪物：+1分，如果没有人选本项，选C的玩家分数归0");
@@ -4568,7 +4659,7 @@ public:
 	}
 	virtual void calc(vector<Player>& players) override
 	{
-		tempScore[0] = vars["num"] / optionCount[0];
+		tempScore[0] = num_ / optionCount[0];
 		if (optionCount[1] <= 3) {
 			tempScore[1] = 2;
 		}
@@ -4583,6 +4674,9 @@ public:
 			}
 		}
 	}
+
+private:
+	double num_ = 0;
 };
 
 class Q103 : public Question   // [待修改]反向执行的结算容易引发歧义
@@ -4746,7 +4840,7 @@ public:
 	{
 		tempScore[0] = 1;
 		tempScore[1] = 3 - optionCount[0];
-		tempScore[2] = rand() % 2 ? 3 : 0;
+		tempScore[2] = randInt() % 2 ? 3 : 0;
 	}
 };
 
@@ -4862,7 +4956,7 @@ public:
 			tempScore[1] = -2;
 			tempScore[2] = -2;
 		}
-		if (rand() % 2 == 0) {
+		if (randInt() % 2 == 0) {
 			tempScore[3] = 2;
 		} else {
 			tempScore[3] = -2;
@@ -4901,7 +4995,7 @@ public:
 			tempScore[3] += 1.5;
 		} else if (optionCount[2] == maxSelect) {
 			tempScore[2] = optionCount[2];
-			if (rand() % 10 < 4) {
+			if (randInt() % 10 < 4) {
 				tempScore[2] = -tempScore[2];
 			}
 			tempScore[2] += 1.5;
@@ -4979,8 +5073,8 @@ public:
 	
 	virtual void initTexts(vector<Player>& players) override
 	{
-		vars["total"] = round(playerNum * 1.6);
-		texts.push_back("请选择一项投资，若总投资达到 " + str(vars["total"]) + " 则投资成功，每人返还 3.5 积分，投资金额最多的选项额外返还 2 积分。你选择：");
+		total_ = round(playerNum * 1.6);
+		texts.push_back("请选择一项投资，若总投资达到 " + str(total_) + " 则投资成功，每人返还 3.5 积分，投资金额最多的选项额外返还 2 积分。你选择：");
 	}
 	virtual void initOptions() override
 	{
@@ -5001,7 +5095,7 @@ public:
 		tempScore[2] = -2;
 		tempScore[3] = -3;
 		tempScore[4] = -4;
-		if (optionCount[1] + optionCount[2]*2 + optionCount[3]*3 + optionCount[4]*4 >= vars["total"]) {
+		if (optionCount[1] + optionCount[2]*2 + optionCount[3]*3 + optionCount[4]*4 >= total_) {
 			int max = 0;
 			for (int i = 1; i < 5; i++) {
 				tempScore[i] += 3.5;
@@ -5012,6 +5106,9 @@ public:
 			tempScore[max] += 2;
 		}
 	}
+
+private:
+	double total_ = 0;
 };
 
 class Q113 : public Question   // [待修改]人多时分数增减幅度太大
@@ -5077,4 +5174,128 @@ E．	反向赌博（本组每人-5分）
 */ 
 
 
+// The factories of all questions, which are shared by the game and tools/crowd_balance.cc.
+// formal questions
+constexpr uint32_t k_question_num = 72;
+// with test questions
+constexpr uint32_t all_question_num = 113;
+
+
+static const std::array<Question*(*)(), all_question_num> create_question{
+	[]() -> Question* { return new Q1(); },
+	[]() -> Question* { return new Q2(); },
+	[]() -> Question* { return new Q3(); },
+	[]() -> Question* { return new Q4(); },
+	[]() -> Question* { return new Q5(); },
+	[]() -> Question* { return new Q6(); },
+	[]() -> Question* { return new Q7(); },
+	[]() -> Question* { return new Q8(); },
+	[]() -> Question* { return new Q9(); },
+	[]() -> Question* { return new Q10(); },
+	[]() -> Question* { return new Q11(); },
+	[]() -> Question* { return new Q12(); },
+	[]() -> Question* { return new Q13(); },
+	[]() -> Question* { return new Q14(); },
+	[]() -> Question* { return new Q15(); },
+	[]() -> Question* { return new Q16(); },
+	[]() -> Question* { return new Q17(); },
+	[]() -> Question* { return new Q18(); },
+	[]() -> Question* { return new Q19(); },
+	[]() -> Question* { return new Q20(); },
+	[]() -> Question* { return new Q21(); },
+	[]() -> Question* { return new Q22(); },
+	[]() -> Question* { return new Q23(); },
+	[]() -> Question* { return new Q24(); },
+	[]() -> Question* { return new Q25(); },
+	[]() -> Question* { return new Q26(); },
+	[]() -> Question* { return new Q27(); },
+	[]() -> Question* { return new Q28(); },
+	[]() -> Question* { return new Q29(); },
+	[]() -> Question* { return new Q30(); },
+	[]() -> Question* { return new Q31(); },
+	[]() -> Question* { return new Q32(); },
+	[]() -> Question* { return new Q33(); },
+	[]() -> Question* { return new Q34(); },
+	[]() -> Question* { return new Q35(); },
+	[]() -> Question* { return new Q36(); },
+	[]() -> Question* { return new Q37(); },
+	[]() -> Question* { return new Q38(); },
+	[]() -> Question* { return new Q39(); },
+	[]() -> Question* { return new Q40(); },
+	[]() -> Question* { return new Q41(); },
+	[]() -> Question* { return new Q42(); },
+	[]() -> Question* { return new Q43(); },
+	[]() -> Question* { return new Q44(); },
+	[]() -> Question* { return new Q45(); },
+	[]() -> Question* { return new Q46(); },
+	[]() -> Question* { return new Q47(); },
+	[]() -> Question* { return new Q48(); },
+	[]() -> Question* { return new Q49(); },
+	[]() -> Question* { return new Q50(); },
+	[]() -> Question* { return new Q51(); },
+	[]() -> Question* { return new Q52(); },
+	[]() -> Question* { return new Q53(); },
+	[]() -> Question* { return new Q54(); },
+	[]() -> Question* { return new Q55(); },
+	[]() -> Question* { return new Q56(); },
+	[]() -> Question* { return new Q57(); },
+	[]() -> Question* { return new Q58(); },
+	[]() -> Question* { return new Q59(); },
+	[]() -> Question* { return new Q60(); },
+	[]() -> Question* { return new Q61(); },
+	[]() -> Question* { return new Q62(); },
+	[]() -> Question* { return new Q63(); },
+	[]() -> Question* { return new Q64(); },
+	[]() -> Question* { return new Q65(); },
+	[]() -> Question* { return new Q66(); },
+	[]() -> Question* { return new Q67(); },
+	[]() -> Question* { return new Q68(); },
+	[]() -> Question* { return new Q69(); },
+	[]() -> Question* { return new Q70(); },
+	[]() -> Question* { return new Q71(); },
+	[]() -> Question* { return new Q72(); },
+	// test questions
+	[]() -> Question* { return new Q73(); },
+	[]() -> Question* { return new Q74(); },
+	[]() -> Question* { return new Q75(); },
+	[]() -> Question* { return new Q76(); },
+	[]() -> Question* { return new Q77(); },
+	[]() -> Question* { return new Q78(); },
+	[]() -> Question* { return new Q79(); },
+	[]() -> Question* { return new Q80(); },
+	[]() -> Question* { return new Q81(); },
+	[]() -> Question* { return new Q82(); },
+	[]() -> Question* { return new Q83(); },
+	[]() -> Question* { return new Q84(); },
+	[]() -> Question* { return new Q85(); },
+	[]() -> Question* { return new Q86(); },
+	[]() -> Question* { return new Q87(); },
+	[]() -> Question* { return new Q88(); },
+	[]() -> Question* { return new Q89(); },
+	[]() -> Question* { return new Q90(); },
+	[]() -> Question* { return new Q91(); },
+	[]() -> Question* { return new Q92(); },
+	[]() -> Question* { return new Q93(); },
+	[]() -> Question* { return new Q94(); },
+	[]() -> Question* { return new Q95(); },
+	[]() -> Question* { return new Q96(); },
+	[]() -> Question* { return new Q97(); },
+	[]() -> Question* { return new Q98(); },
+	[]() -> Question* { return new Q99(); },
+	[]() -> Question* { return new Q100(); },
+	[]() -> Question* { return new Q101(); },
+	[]() -> Question* { return new Q102(); },
+	[]() -> Question* { return new Q103(); },
+	[]() -> Question* { return new Q104(); },
+	[]() -> Question* { return new Q105(); },
+	[]() -> Question* { return new Q106(); },
+	[]() -> Question* { return new Q107(); },
+	[]() -> Question* { return new Q108(); },
+	[]() -> Question* { return new Q109(); },
+	[]() -> Question* { return new Q110(); },
+	[]() -> Question* { return new Q111(); },
+	[]() -> Question* { return new Q112(); },
+	[]() -> Question* { return new Q113(); },
+};
+
 #endif
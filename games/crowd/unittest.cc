@@ -3,6 +3,7 @@
 // This source code is licensed under LGPLv2 (found in the LICENSE file).
 
 #include "game_framework/unittest_base.h"
+#include "equilibrium.h"
 
 namespace lgtbot {
 
@@ -2661,6 +2662,36 @@ GAME_TEST(6, Q72_Basic_ABBCDE){
         ASSERT_PRI_MSG(CHECKOUT, 5, "E");
         ASSERT_SCORE(0,200,200,-200,100,200);}
 
+TEST(TestEquilibrium, evaluate_on_copies)
+{
+    vector<Player> players(6);
+    players[0].score = 5;
+    QuestionEvaluator evaluator(0, players); // Q1
+    const auto& scores = evaluator.Evaluate({1, 1, 1, 1, 1, 1});
+    ASSERT_EQ(vector<double>(6, 2), scores);
+    ASSERT_EQ(5, players[0].score);
+    ASSERT_EQ(0, players[0].select);
+}
+
+TEST(TestEquilibrium, avoid_crowded_war)
+{
+    QuestionEvaluator evaluator(1, vector<Player>(9)); // Q2: peace +2, war +6 if exactly two players choose it
+    std::mt19937 engine(0);
+    const auto strategy = SolveEquilibrium(evaluator, 3000, engine);
+    ASSERT_EQ(2, strategy.size());
+    ASSERT_NEAR(1, strategy[0] + strategy[1], 1e-6);
+    ASSERT_GT(strategy[0], 0.9);
+}
+
+TEST(TestEquilibrium, never_choose_excluded_option)
+{
+    SharedEquilibrium equilibrium(1, vector<Player>(9), 3000, 0); // Q2: peace is chosen in most cases
+    std::mt19937 engine(0);
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_EQ(1, equilibrium.Choose(engine, 0)); // the special rule 9 forbids peace
+    }
+}
+
 } // namespace GAME_MODULE_NAME
 
 } // namespace game
@@ -101,7 +101,7 @@ class MainStage : public MainGameStage<TargetStage, RoundStage>
             }
             table.playerPoint[pid] = 0;
         }
-        table.Initialize(GAME_OPTION(模式), Global().ResourceDir());
+        table.Initialize(GAME_OPTION(模式), Global().ResourceDir(), Global().RandomEngine());
         if (GAME_OPTION(模式) == 2) {
             // 进入[人生模式]设置目标分
             setter.Emplace<TargetStage>(*this);
@@ -164,7 +164,7 @@ class MainStage : public MainGameStage<TargetStage, RoundStage>
         }
         // [点球模式]胜负判定
         if (GAME_OPTION(模式) == 1) {
-            Global().Boardcast() << Markdown(table.GetShootoutModeTable(round_ < 10 ? round_ : round_ - 1));
+            Global().Boardcast() << LazyMarkdown{[&] { return table.GetShootoutModeTable(round_ < 10 ? round_ : round_ - 1); }};
             player_scores_[0] = point[0];
             player_scores_[1] = point[1];
             if (player_scores_[0] == player_scores_[1]) {
@@ -179,7 +179,7 @@ class MainStage : public MainGameStage<TargetStage, RoundStage>
         }
         // [人生模式]胜负判定
         if (GAME_OPTION(模式) == 2) {
-            Global().Boardcast() << Markdown(table.GetLiveModeTable());
+            Global().Boardcast() << LazyMarkdown{[&] { return table.GetLiveModeTable(); }};
             if (point[att] <= 0) {
                 player_scores_[def] = 1;
                 Global().Boardcast() << "游戏结束，防守方 " << At(def) << " 获胜！";
@@ -268,7 +268,7 @@ class TargetStage : public SubGameStage<>
             t.attacker = 0;
             t.defender = 1;
         } else {
-            t.attacker = rand() % 2;
+            t.attacker = Global().Rand() % 2;
             t.defender = 1 - t.attacker;
             boardcast << "\n双方目标分相同，随机选取进攻方和防守方\n";
         }
@@ -321,7 +321,7 @@ class RoundStage : public SubGameStage<BitStage, GameStage>
         } else {
             // [点球模式]赛况播报
             if (GAME_OPTION(模式) == 1) {
-                Global().Boardcast() << Markdown(Main().table.GetShootoutModeTable(Main().round_));
+                Global().Boardcast() << LazyMarkdown{[&] { return Main().table.GetShootoutModeTable(Main().round_); }};
                 if (Main().round_ == 11) {
                     Global().Boardcast() << "[提示] 10回合结束，双方玩家比分相同，进入加赛阶段。从下回合起，若2回合内获胜结果不一致，游戏会立即结束";
                 }
@@ -337,7 +337,7 @@ class RoundStage : public SubGameStage<BitStage, GameStage>
         if (reason == CheckoutReason::BY_TIMEOUT || reason == CheckoutReason::BY_LEAVE) {
             return;
         }
-        Global().Boardcast() << Markdown(Main().table.GetLiveModeTable());
+        Global().Boardcast() << LazyMarkdown{[&] { return Main().table.GetLiveModeTable(); }};
         PlayerID emperor = Main().round_ <= 3 || (Main().round_ >= 7 && Main().round_ <= 9) ? Main().table.attacker : Main().table.defender;
         setter.Emplace<GameStage>(Main(), emperor);
     }
@@ -361,7 +361,7 @@ class BitStage : public SubGameStage<>
 
     virtual void OnStageBegin() override
     {
-        Global().Boardcast() << Markdown(Main().table.GetLiveModeTable());
+        Global().Boardcast() << LazyMarkdown{[&] { return Main().table.GetLiveModeTable(); }};
         Global().Boardcast() << "请 " << At(Main().table.attacker) << " 选择本轮下注";
         Global().SetReady(Main().table.defender);
         Global().StartTimer(GAME_OPTION(时限));
@@ -418,22 +418,22 @@ class BitStage : public SubGameStage<>
         } else {
             if (pid == emperor) {
                 if (t.playerPoint[pid] > 20) {
-                    bit = rand() % 10 + 11;
+                    bit = Global().Rand() % 10 + 11;
                 } else if (t.playerPoint[pid] > 10) {
-                    bit = rand() % (t.playerPoint[pid] - 8) + 6;
+                    bit = Global().Rand() % (t.playerPoint[pid] - 8) + 6;
                 } else {
-                    bit = rand() % t.playerPoint[pid] + 1;
+                    bit = Global().Rand() % t.playerPoint[pid] + 1;
                 }
-                if (Main().round_ > 6 && t.playerPoint[t.defender] <= t.targetScore[t.attacker] - 100 && t.playerPoint[pid] < 15 && rand() % 10 == 0) {
+                if (Main().round_ > 6 && t.playerPoint[t.defender] <= t.targetScore[t.attacker] - 100 && t.playerPoint[pid] < 15 && Global().Rand() % 10 == 0) {
                     bit = t.playerPoint[pid] + 15;
                 }
             } else {
-                if (t.playerPoint[pid] > 15 && rand() % 5 == 0) {
-                    bit = rand() % 6 + 5;
+                if (t.playerPoint[pid] > 15 && Global().Rand() % 5 == 0) {
+                    bit = Global().Rand() % 6 + 5;
                 } else if (t.playerPoint[pid] > 5) {
-                    bit = rand() % 5 + 1;
+                    bit = Global().Rand() % 5 + 1;
                 } else {
-                    bit = rand() % t.playerPoint[pid] + 1;
+                    bit = Global().Rand() % t.playerPoint[pid] + 1;
                 }
             }
         }
@@ -469,7 +469,7 @@ class GameStage : public SubGameStage<>
             Global().Boardcast() << "本回合 " << At(emperor) << " 为皇帝方，请双方玩家私信裁判出牌，时限 " << to_string(GAME_OPTION(时限)) << " 秒";
             player_cards_.push_back(vector<int>{(int)GAME_OPTION(市民数), emperor == 0, emperor == 1});
             player_cards_.push_back(vector<int>{(int)GAME_OPTION(市民数), emperor == 1, emperor == 0});
-            ComputerActRound = rand() % (GAME_OPTION(市民数) + 1);
+            ComputerActRound = Global().Rand() % (GAME_OPTION(市民数) + 1);
         }
         Global().StartTimer(GAME_OPTION(时限));
     }
@@ -521,7 +521,7 @@ class GameStage : public SubGameStage<>
         auto &t = Main().table;
         int left_card = player_cards_[0][0] + player_cards_[0][1] + player_cards_[0][2];
 
-        Global().Boardcast() << Markdown(t.GetCardTable(player_select_[t.defender], player_select_[t.attacker], left_card, GAME_OPTION(市民数) + 1));
+        Global().Boardcast() << LazyMarkdown{[&] { return t.GetCardTable(player_select_[t.defender], player_select_[t.attacker], left_card, GAME_OPTION(市民数) + 1); }};
         
         auto boardcast = Global().Boardcast();
         boardcast << "本回合结果为：\n\n　　" << CardName_ch[player_select_[t.defender]] << " - " << CardName_ch[player_select_[t.attacker]] << "\n\n";
@@ -46,13 +46,13 @@ public:
     int shootoutRecord[2][55];
 
     // 初始化游戏
-    void Initialize(const int mode, const char* dir)
+    void Initialize(const int mode, const char* dir, std::mt19937& g)
     {
         GameMode = mode;
         ResourceDir = dir;
-        special = rand() % 10 == 0 ? 1 : 0;
+        special = g() % 10 == 0 ? 1 : 0;
 #ifndef TEST_BOT
-        swapPlayer = rand() % 2 == 1 ? true : false;
+        swapPlayer = g() % 2 == 1 ? true : false;
 #endif
         for (int i = 0; i < 3; i++) {
             for (int j = 0; j < 13; j++) {
@@ -75,8 +75,8 @@ std::string map_name;
 int offset, initial_random_cnt, turn;
 std::string three_pos;
 
-void generate_two_num(int& a, int& b, int* c) {
-  int x = rand() % 180;
+void generate_two_num(int& a, int& b, int* c, std::mt19937& g) {
+  int x = g() % 180;
   if (x == 0) {
     a = 2, b = 9;
   } else if (x == 1) {
@@ -88,7 +88,7 @@ void generate_two_num(int& a, int& b, int* c) {
   } else if (x == 4) {
     a = 2, b = 18;
   } else if (x == 5) {
-    a = 2, b = 10 + rand() % 10;
+    a = 2, b = 10 + g() % 10;
   } else if (x == 6) {
     a = 3, b = 9;
   } else if (x == 7) {
@@ -102,27 +102,27 @@ void generate_two_num(int& a, int& b, int* c) {
   } else if (x == 11) {
     a = 4, b = 9;
   } else if (x == 12) {
-    if (rand() % 2 == 0) {
+    if (g() % 2 == 0) {
       a = 9, b = 25;
     } else {
       a = 10, b = 24;
     }
   } else if (x == 13) {
-    if (rand() % 2 == 0) {
-      a = 13, b = 16 + rand() % 2;
+    if (g() % 2 == 0) {
+      a = 13, b = 16 + g() % 2;
     } else {
-      a = 11, b = 18 + rand() % 2;
+      a = 11, b = 18 + g() % 2;
     }
   } else if (x == 14) {
     a = 5, b = 8;
   } else if (x <= 20) {
     a = 1, b = x - 7;
   } else {
-    a = rand() % 6 + 1;
-    b = rand() % 6 + 1;
-    if (rand() % 2 == 1) {
-      a += rand() % 2;
-      b += rand() % 2 + 1;
+    a = g() % 6 + 1;
+    b = g() % 6 + 1;
+    if (g() % 2 == 1) {
+      a += g() % 2;
+      b += g() % 2 + 1;
     }
     if (a > b) {
       std::swap(a, b);
@@ -419,7 +419,7 @@ class RoundStage : public SubGameStage<> {
                   MakeStageCommand(*this, "跳过", &RoundStage::Pass_, VoidChecker("pass"))) {}
 
   virtual void OnStageBegin() override {
-    generate_two_num(num_1, num_2, number);
+    generate_two_num(num_1, num_2, number, Global().RandomEngine());
     for (int i = 0; i < Main().num_player_; i++) {
       Main().ui_.SetName(i, Global().PlayerName(i));
       Main().ui_.SetBoard(i, Main().boards_[i]);
@@ -505,7 +505,7 @@ MainStage::MainStage(StageUtility&& utility)
   auto map_file = map_files[GAME_OPTION(地图)];
   map_name = map_names[GAME_OPTION(地图)];
   if (map_file == "random") {
-    int index = rand() % (map_files.size() - 1) + 1;
+    int index = Global().Rand() % (map_files.size() - 1) + 1;
     map_file = map_files[index];
     map_name = map_names[index];
   }
@@ -516,8 +516,8 @@ MainStage::MainStage(StageUtility&& utility)
     initBoard(boards_[i]);
   }
   for (int i = 0; i < initial_random_cnt; i++) {
-    int val = 3 + rand() % 10;
-    int x = 1 + rand() % n, y = 1 + rand() % m;
+    int val = 3 + Global().Rand() % 10;
+    int x = 1 + Global().Rand() % n, y = 1 + Global().Rand() % m;
     if ('a' <= map[x][y] && map[x][y] <= 'z') {
       for (int i = 0; i < Global().PlayerNum(); i++) {
         boards_[i].num[x][y] = val;
@@ -542,7 +542,7 @@ bool MainStage::JudgeOver() { return turn_ >= turn; }
 
 void MainStage::Print() {
   const int width = Global().PlayerNum() == 1 ? 400 : 700;
-  Global().Boardcast() << Markdown(ui_.ToHtml(), width);
+  Global().Boardcast() << LazyMarkdown{[&] { return ui_.ToHtml(); }, width};
 }
 
 auto* MakeMainStage(MainStageFactory factory) { return factory.Create<MainStage>(); }
@@ -209,7 +209,7 @@ class RoundStage : public SubGameStage<>
             num = current_max_speed;
         } else if (Main().round_ == 1) {
             // R1 8:9:10 - 1:4:1
-            int rd = rand() % 6;
+            int rd = Global().Rand() % 6;
             if (rd == 0) num = current_max_speed;
             else if (rd == 1) num = current_max_speed - 2;
             else num = current_max_speed - 1;
@@ -218,14 +218,14 @@ class RoundStage : public SubGameStage<>
             if (position == 8) {
                 // P=8 速度未降低 8-10 已降低 最大/低概率1
                 if (current_max_speed == last_max_speed) {
-                    num = rand() % 3 + current_max_speed - 2;
+                    num = Global().Rand() % 3 + current_max_speed - 2;
                 } else {
                     num = current_max_speed;
-                    if (rand() % 10 == 0) num = 1;
+                    if (Global().Rand() % 10 == 0) num = 1;
                 }
             } else if (position == 9) {
                 // P=9 9-10
-                num = rand() % 2 + current_max_speed - 1;
+                num = Global().Rand() % 2 + current_max_speed - 1;
             } else {
                 // P=10 最大
                 num = current_max_speed;
@@ -236,10 +236,10 @@ class RoundStage : public SubGameStage<>
                 if (total_max_count == 1) {
                     // 唯一最高 最大/极小概率1
                     num = current_max_speed;
-                    if (rand() % 20 == 0) num = 1;
+                    if (Global().Rand() % 20 == 0) num = 1;
                 } else {
                     // 最高非唯一 最大/最大-1
-                    num = rand() % 2 + current_max_speed - 1;
+                    num = Global().Rand() % 2 + current_max_speed - 1;
                 }
             } else if (current_max_speed == total_min_speed) {
                 if (total_min_count == 1) {
@@ -248,7 +248,7 @@ class RoundStage : public SubGameStage<>
                 } else {
                     // 最低非唯一 最大/小概率最大-1
                     num = current_max_speed;
-                    if (rand() % 10 == 0) num = current_max_speed - 1;
+                    if (Global().Rand() % 10 == 0) num = current_max_speed - 1;
                 }
             } else {
                 // 非最高非最低
@@ -259,7 +259,7 @@ class RoundStage : public SubGameStage<>
                     // 否则根据与最小速度的差值决定当前速度
                     if (current_max_speed - total_min_speed <= 2) {
                         num = total_min_speed;
-                    } else if (rand() % 10 < 8) {
+                    } else if (Global().Rand() % 10 < 8) {
                         num = current_max_speed;
                     } else {
                         num = total_min_speed - 1;
@@ -274,10 +274,10 @@ class RoundStage : public SubGameStage<>
                     num = current_max_speed;
                 } else {
                     // 最高非唯一 最大/最大-1
-                    if (rand() % 3 == 0) num = current_max_speed;
+                    if (Global().Rand() % 3 == 0) num = current_max_speed;
                     else num = current_max_speed - 1;
                 }
-            } else if (current_max_speed >= GAME_OPTION(上限) * 0.8 || rand() % 10 < 6) {
+            } else if (current_max_speed >= GAME_OPTION(上限) * 0.8 || Global().Rand() % 10 < 6) {
                 // 速度快或大概率最大速度赶距离
                 num = current_max_speed;
             } else {
@@ -475,8 +475,6 @@ string MainStage::GetStatusBoard() {
 
 void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 {
-    srand((unsigned int)time(NULL));
-
     racing_num = Global().PlayerNum();
     for (int i = 0; i < Global().PlayerNum(); i++) {
         player_maxspeed_[i] = GAME_OPTION(上限);
@@ -169,17 +169,22 @@ class RoundStage : public SubGameStage<>
 {
   public:
     RoundStage(MainStage& main_stage, const uint64_t round)
-        : StageFsm(main_stage, "第 " + std::to_string(round) + " 回合",
-                MakeStageCommand(*this, "捡金币", &RoundStage::Pick_Up_Coins_,
-                                VoidChecker("捡"), ArithChecker<int64_t>(0, 5, "金币数")),
-                MakeStageCommand(*this, "抢金币", &RoundStage::Snatch_Coins_,
-                                VoidChecker("抢"), ArithChecker<int64_t>(1, main_stage.Global().PlayerNum(), "对象号码"), ArithChecker<int64_t>(1, 5, "金币数")),
-                MakeStageCommand(*this, "守金币", &RoundStage::Guard_Coins_,
-                                VoidChecker("守"), ArithChecker<int64_t>(1, main_stage.Global().PlayerNum(), "对象号码"), ArithChecker<int64_t>(1, 5, "金币数")),
-                MakeStageCommand(*this, "夺血条", &RoundStage::Take_HP_,
-                                VoidChecker("夺"), ArithChecker<int64_t>(1, main_stage.Global().PlayerNum(), "对象号码"), ArithChecker<int64_t>(1, 5, "金币数")),
-                MakeStageCommand(*this, "撤离", &RoundStage::Leave_,
-                                VoidChecker("撤离"))) {}
+        : StageFsm(main_stage, "第 " + std::to_string(round) + " 回合", [&main_stage]
+            {
+                const int64_t player_num = main_stage.Global().PlayerNum();
+                return std::vector{
+                    MakeStageCommand("捡金币", &RoundStage::Pick_Up_Coins_,
+                                    VoidChecker("捡"), ArithChecker<int64_t>(0, 5, "金币数")),
+                    MakeStageCommand("抢金币", &RoundStage::Snatch_Coins_,
+                                    VoidChecker("抢"), ArithChecker<int64_t>(1, player_num, "对象号码"), ArithChecker<int64_t>(1, 5, "金币数")),
+                    MakeStageCommand("守金币", &RoundStage::Guard_Coins_,
+                                    VoidChecker("守"), ArithChecker<int64_t>(1, player_num, "对象号码"), ArithChecker<int64_t>(1, 5, "金币数")),
+                    MakeStageCommand("夺血条", &RoundStage::Take_HP_,
+                                    VoidChecker("夺"), ArithChecker<int64_t>(1, player_num, "对象号码"), ArithChecker<int64_t>(1, 5, "金币数")),
+                    MakeStageCommand("撤离", &RoundStage::Leave_,
+                                    VoidChecker("撤离")),
+                };
+            }) {}
 
   private:
 
@@ -330,17 +335,17 @@ class RoundStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        if ((Main().player_coins_[pid] >= 25 && rand() % 3 < 2) || (Main().player_hp_[pid] <= 5 && rand() % 10 == 0)) {
+        if ((Main().player_coins_[pid] >= 25 && Global().Rand() % 3 < 2) || (Main().player_hp_[pid] <= 5 && Global().Rand() % 10 == 0)) {
             Selected_(pid, reply, 'L', pid + 1, 0);
         } else if (Main().alive_ == 1) {
             Selected_(pid, reply, 'P', pid + 1, Main().round_coin);
         } else {
-            int rd = rand() % 100;
+            int rd = Global().Rand() % 100;
             int target;
-            int coinselect = rand() % 5 + 1;
+            int coinselect = Global().Rand() % 5 + 1;
             char action;
             do {
-                target = rand() % Global().PlayerNum() + 1;
+                target = Global().Rand() % Global().PlayerNum() + 1;
             } while (target == pid + 1 || Main().player_out_[target - 1] > 0);
             if (Main().player_action_[pid] == 'P' || Main().player_action_[pid] == 'S') {
                 if (rd < 40) { action = 'P'; }
@@ -354,7 +359,7 @@ class RoundStage : public SubGameStage<>
                 if (rd < 60) { action = 'P'; }
                 else if (rd < 100) { action = 'S'; }
             }
-            if (action == 'P' && rand() % 10 == 0) {
+            if (action == 'P' && Global().Rand() % 10 == 0) {
                 coinselect = 0;
             }
             Selected_(pid, reply, action, target, coinselect);
@@ -672,7 +677,7 @@ class RoundStage : public SubGameStage<>
         }
 
         if (Main().alive_ > 0 && Main().round_ < GAME_OPTION(回合数)) {
-            Main().round_coin = rand() % (Main().alive_ + 1) + Main().alive_ * 2;
+            Main().round_coin = Global().Rand() % (Main().alive_ + 1) + Main().alive_ * 2;
             round_details += "<font size=5>· 本轮金币数：" + to_string(Main().round_coin) + "</font><br/>";
         }
 
@@ -748,7 +753,6 @@ string MainStage::GetStatusBoard() {
 
 void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 {
-    srand((unsigned int)time(NULL));
     alive_ = Global().PlayerNum();
     player_total_damage_.resize(Global().PlayerNum());
 
@@ -785,7 +789,7 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
     string status_Board = GetStatusBoard();
 
     string coin_Board = "";
-    round_coin = rand() % (alive_ + 1) + alive_ * 2;
+    round_coin = Global().Rand() % (alive_ + 1) + alive_ * 2;
     coin_Board += "<tr><td align=\"left\" colspan=" + to_string(Global().PlayerNum() + 1) + "><font size=5>· 本轮金币数：" + to_string(round_coin) + "</font></td></tr>";
 
     string PreBoard = "";
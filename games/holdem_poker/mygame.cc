@@ -264,11 +264,11 @@ class RaiseStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        if (rand() % Global().PlayerNum() == 0 && StageErrCode::READY == Raise_(pid, false, reply, rand() % 50 + raise_chips_)) {
+        if (Global().Rand() % Global().PlayerNum() == 0 && StageErrCode::READY == Raise_(pid, false, reply, Global().Rand() % 50 + raise_chips_)) {
             // raise successfully
             return StageErrCode::READY;
         }
-        if (rand() % Global().PlayerNum() <= 1) {
+        if (Global().Rand() % Global().PlayerNum() <= 1) {
             Fold_(pid, false, reply);
         } else {
             Call_(pid, false, reply);
@@ -391,7 +391,7 @@ class BetStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        if (rand() % 2 || StageErrCode::READY != Bet_(pid, false, reply, base_chips_)) {
+        if (Global().Rand() % 2 || StageErrCode::READY != Bet_(pid, false, reply, base_chips_)) {
             Check_(pid, false, reply);
         }
         return StageErrCode::READY;
@@ -458,7 +458,7 @@ class RoundStage : public SubGameStage<RaiseStage, BetStage>
         Global().Boardcast() << Name() << "开始，将私信各位玩家手牌信息";
         const auto& seed_in_option = GAME_OPTION(种子);
         const auto shuffled_pokers = poker::ShuffledPokers<k_type>(
-                 seed_in_option.empty() ? "" : (seed_in_option + std::to_string(round)));
+                 seed_in_option.empty() ? "" : (seed_in_option + std::to_string(round)), Global().RandomEngine());
         auto poker_it = shuffled_pokers.begin();
         // fill `public_cards_`
         for (auto& card : public_cards_) {
@@ -813,10 +813,10 @@ class MainStage : public MainGameStage<>
                 MakeStageCommand(*this, "跳过本回合行动", &MainStage::Pass_, VoidChecker("pass")))
 #ifdef TEST_BOT
         , role_manager_(GAME_OPTION(身份列表).empty()
-                ? GetRoleVec_(Global().Options(), DefaultRoleOption_(Global().Options()), Global().PlayerNum(), role_manager_)
+                ? GetRoleVec_(Global().Options(), DefaultRoleOption_(Global().Options()), Global().PlayerNum(), Global().RandomEngine(), role_manager_)
                 : LoadRoleVec_(GAME_OPTION(身份列表), DefaultRoleOption_(Global().Options()), role_manager_))
 #else
-        , role_manager_(GetRoleVec_(Global().Options(), DefaultRoleOption_(Global().Options()), Global().PlayerNum(), role_manager_))
+        , role_manager_(GetRoleVec_(Global().Options(), DefaultRoleOption_(Global().Options()), Global().PlayerNum(), Global().RandomEngine(), role_manager_))
 #endif
         , k_image_width_((k_avatar_width_ + k_cellspacing_ + k_cellpadding_) * role_manager_.Size() + 150)
         , role_info_(RoleInfo_())
@@ -852,10 +852,10 @@ class MainStage : public MainGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        if (rand() % 2) {
-            Hurt_(pid, false, reply, {Token{static_cast<uint32_t>(rand() % Global().PlayerNum())}}, 15); // randomly hurt one role
+        if (Global().Rand() % 2) {
+            Hurt_(pid, false, reply, {Token{static_cast<uint32_t>(Global().Rand() % Global().PlayerNum())}}, 15); // randomly hurt one role
         } else {
-            Cure_(pid, false, reply, Token{static_cast<uint32_t>(rand() % Global().PlayerNum())}, false); // randomly hurt one role
+            Cure_(pid, false, reply, Token{static_cast<uint32_t>(Global().Rand() % Global().PlayerNum())}, false); // randomly hurt one role
         }
         return StageErrCode::READY;
     }
@@ -1241,14 +1241,12 @@ class MainStage : public MainGameStage<>
         return v;
     }
 
-    static RoleManager::RoleVec GetRoleVec_(const MyGameOptions& option, const RoleOption& role_option, const uint32_t player_num, RoleManager& role_manager)
+    static RoleManager::RoleVec GetRoleVec_(const MyGameOptions& option, const RoleOption& role_option, const uint32_t player_num, std::mt19937& g, RoleManager& role_manager)
     {
         const auto make_roles = [&]<typename T>(const std::initializer_list<T>& occupation_lists)
             {
                 assert(occupation_lists.size() > 0);
-                std::random_device rd;
-                std::mt19937 g(rd());
-                const auto& occupation_list = std::data(occupation_lists)[std::uniform_int_distribution<int>(0, occupation_lists.size() - 1)(rd)];
+                const auto& occupation_list = std::data(occupation_lists)[std::uniform_int_distribution<int>(0, occupation_lists.size() - 1)(g)];
                 std::vector<PlayerID> pids;
                 for (uint32_t i = 0; i < player_num; ++i) {
                     pids.emplace_back(i);
@@ -1458,7 +1456,7 @@ class MainStage : public MainGameStage<>
             RolesOnRoundBegin_();
             return false;
         }
-        Global().Boardcast() << Markdown("## 终局\n\n" + Html_(true), k_image_width_);
+        Global().Boardcast() << LazyMarkdown{[&] { return "## 终局\n\n" + Html_(true); }, k_image_width_};
         return true;
     }
 
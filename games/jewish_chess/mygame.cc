@@ -268,13 +268,13 @@ MainStage::MainStage(StageUtility&& utility)
       score_(2, 0),
       board_(9, std::vector<int>(9, -1)),
       side_(2, 0) {
-  side_[0] = rand() % 2;
+  side_[0] = Global().Rand() % 2;
   side_[1] = !side_[0];
 }
 
 void MainStage::FirstStageFsm(SubStageFsmSetter setter) {
   table_.SetName(Global().PlayerName(0), Global().PlayerName(1));
-  Global().Boardcast() << Markdown(table_.ToHtml(), 600);
+  Global().Boardcast() << LazyMarkdown{[&] { return table_.ToHtml(); }, 600};
   setter.Emplace<RoundStage>(*this);
 }
 
@@ -288,7 +288,7 @@ void MainStage::NextStageFsm(RoundStage& sub_stage, const CheckoutReason reason,
 int64_t MainStage::PlayerScore(const PlayerID pid) const { return score_.at(pid); }
 
 bool MainStage::JudgeOver() {
-  Global().Boardcast() << Markdown(table_.ToHtml(), 600);
+  Global().Boardcast() << LazyMarkdown{[&] { return table_.ToHtml(); }, 600};
   return ended_;
 }
 
@@ -8,6 +8,7 @@
 #include <memory>
 #include <vector>
 #include <random>
+#include <sstream>
 
 #include "game_framework/stage.h"
 #include "game_framework/util.h"
@@ -59,10 +60,35 @@ const std::vector<InitOptionsCommand> k_init_options_commands = {
 
 // ========== GAME STAGES ==========
 
+#ifdef TEST_BOT
+static constexpr auto k_computer_think_budget = std::chrono::milliseconds(5);
+#else
+static constexpr auto k_computer_think_budget = std::chrono::milliseconds(1000);
+#endif
+
 enum class Choise { UP, RIGHT, DOWN, LEFT, RIGHT_UP, LEFT_UP, RIGHT_DOWN, LEFT_DOWN, CLOCKWISE, ANTICLOCKWISE, _MAX };
 
 static std::ostream& operator<<(std::ostream& os, const Coor& coor) { return os << ('A' + coor.m_) << coor.n_; }
 
+// The action searched by a computer is journaled as its choice.
+static std::string EncodeAction(const Action& action)
+{
+    std::ostringstream ss;
+    ss << static_cast<int>(action.type_) << ' ' << action.src_.m_ << ' ' << action.src_.n_ << ' ' << action.dst_.m_
+       << ' ' << action.dst_.n_;
+    return ss.str();
+}
+
+static Action DecodeAction(const std::string& str)
+{
+    std::istringstream ss(str);
+    int type = 0;
+    Action action;
+    ss >> type >> action.src_.m_ >> action.src_.n_ >> action.dst_.m_ >> action.dst_.n_;
+    action.type_ = static_cast<Action::Type>(type);
+    return action;
+}
+
 // function order should be same as enum order
 std::array<Board(*)(std::string), GameMap::Count() - 1> game_map_initers =
     {InitAceBoard, InitCuriosityBoard, InitGrailBoard, InitMercuryBoard, InitSophieBoard, InitGeniusBoard, InitRefractionBoard, InitGeminiBoard, InitDaisukeBoard};
@@ -87,7 +113,7 @@ class MainStage : public MainGameStage<>
                             { "顺", Choise::CLOCKWISE },
                             { "逆", Choise::ANTICLOCKWISE }}
                         )))
-        , map_(GAME_OPTION(地图) == GameMap::随机 ? GameMap::Members()[rand() % (GameMap::Count() - 1)] : GAME_OPTION(地图))
+        , map_(GAME_OPTION(地图) == GameMap::随机 ? GameMap::Members()[Global().Rand() % (GameMap::Count() - 1)] : GAME_OPTION(地图))
         , board_(game_map_initers[map_.ToUInt()](Global().ResourceDir()))
         , round_(0)
         , scores_{0}
@@ -97,24 +123,27 @@ class MainStage : public MainGameStage<>
     virtual void OnStageBegin()
     {
         Global().StartTimer(GAME_OPTION(局时));
+        round_begin_snapshot_ = board_.TakeSnapshot();
         board_html_ = board_.ToHtml();
-        Global().Boardcast() << Markdown(ShowInfo_());
+        Global().Boardcast() << LazyMarkdown{[&] { return ShowInfo_(); }};
         Global().Boardcast() << "请双方行动，" << GAME_OPTION(局时)
                     << "秒未行动自动 pass\n格式：棋子位置 行动方式";
     }
 
     virtual AtomReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply)
     {
-        const Coor coor = [&]() -> Coor
-            {
-                while (true) {
-                    const Coor coor(rand() % board_.max_m(), rand() % board_.max_n());
-                    if (Act_(pid, coor, static_cast<Choise>(rand() % static_cast<uint32_t>(Choise::_MAX)), EmptyMsgSender::Get())) {
-                        return coor;
-                    }
-                }
-                return {};
-            }();
+        if (Global().IsReady(pid)) {
+            return StageErrCode::OK;
+        }
+        // Search the board at the beginning of the round, so the pending action of the opponent is not seen.
+        const auto action = DecodeAction(Global().ComputerChoice([&]
+                    {
+                        Board board = board_;
+                        board.Restore(round_begin_snapshot_);
+                        return EncodeAction(Minimax(board, pid).Search(false, k_computer_think_budget));
+                    }));
+        // If the action conflicts with the pending action of the opponent, it fails and the computer passes.
+        board_.Act(action, pid);
         return StageErrCode::READY;
     }
 
@@ -235,7 +264,7 @@ class MainStage : public MainGameStage<>
         const auto settle_ret = board_.Settle();
         board_html_ = settle_ret.html_;
 
-        Global().Boardcast() << Markdown(ShowInfo_());
+        Global().Boardcast() << LazyMarkdown{[&] { return ShowInfo_(); }};
         if (settle_ret.king_alive_num_[0] == 0 && settle_ret.king_alive_num_[1] == 0) {
             Global().Boardcast() << "双方王同归于尽，根据剩余棋子数量计算胜负";
             scores_[0] = board_.ChessCount(0);
@@ -262,6 +291,7 @@ class MainStage : public MainGameStage<>
                 sender << "玩家" << At(PlayerID{1}) << "被命中了 " << settle_ret.chess_dead_num_[1] << " 枚棋子\n\n";
             }
             finish = false;
+            round_begin_snapshot_ = board_.TakeSnapshot();
             Global().ClearReady();
             Global().StartTimer(GAME_OPTION(局时));
             sender << "请双方行动，" << GAME_OPTION(局时) << "秒未行动默认 pass\n格式：棋子位置 行动方式";
@@ -276,6 +306,7 @@ class MainStage : public MainGameStage<>
 
     GameMap map_;
     Board board_;
+    Board::Snapshot round_begin_snapshot_;
     uint32_t round_;
     std::array<int64_t, 2> scores_;
     std::string board_html_;
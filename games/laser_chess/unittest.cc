@@ -53,6 +53,20 @@ GAME_TEST(2, forbid_rotate_shooter_towards_outside)
     ASSERT_PRI_MSG(FAILED, 0, "A0 顺");
 }
 
+GAME_TEST(2, computer_acts_after_opponent)
+{
+    ASSERT_PUB_MSG(OK, 0, "地图 genius");
+    ASSERT_PUB_MSG(OK, 0, "回合数 10");
+    ASSERT_TRUE(StartGame());
+    for (uint32_t i = 0; i < 9; ++i) {
+        ASSERT_PRI_MSG(OK, 0, "A5 逆");
+        ASSERT_COMPUTER_ACT(CONTINUE, 1);
+    }
+    ASSERT_PRI_MSG(OK, 0, "A5 逆");
+    ASSERT_COMPUTER_ACT(CHECKOUT, 1);
+    ASSERT_FINISHED(true);
+}
+
 GAME_TEST(1, too_few_player)
 {
     ASSERT_FALSE(StartGame());
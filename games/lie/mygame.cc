@@ -207,8 +207,8 @@ class NumberStage : public SubGameStage<>
     virtual AtomReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply) override
     {
         if (questioner_ == pid) {
-            actual_number_ = std::rand() % GAME_OPTION(数字种类) + 1;
-            lie_number_ = std::rand() % 5 >= 2 ? std::rand() % GAME_OPTION(数字种类) + 1
+            actual_number_ = Global().Rand() % GAME_OPTION(数字种类) + 1;
+            lie_number_ = Global().Rand() % 5 >= 2 ? Global().Rand() % GAME_OPTION(数字种类) + 1
                                                : actual_number_; // 50% same
             return StageErrCode::READY;
         }
@@ -257,7 +257,7 @@ class GuessStage : public SubGameStage<>
     virtual AtomReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply) override
     {
         if (guesser_ == pid) {
-            doubt_ = std::rand() % 2;
+            doubt_ = Global().Rand() % 2;
             return StageErrCode::CHECKOUT;
         }
         return StageErrCode::OK;
@@ -346,7 +346,7 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 {
     table_.SetName(Global().PlayerAvatar(0, 30) + HTML_ESCAPE_SPACE + HTML_ESCAPE_SPACE + Global().PlayerName(0),
             Global().PlayerAvatar(1, 30) + HTML_ESCAPE_SPACE + HTML_ESCAPE_SPACE + Global().PlayerName(1));
-    setter.Emplace<RoundStage>(*this, 1, std::rand() % 2);
+    setter.Emplace<RoundStage>(*this, 1, Global().Rand() % 2);
 }
 
 void MainStage::NextStageFsm(RoundStage& sub_stage, const CheckoutReason reason, SubStageFsmSetter setter)
@@ -172,7 +172,7 @@ struct PlayerRoundInfo
         return Reset_(hand_id, coins, scores, is_mutable ? PlayerHand<k_type>::DISCARD_ALL : PlayerHand<k_type>::DISCARD_ALL_IMMUTBLE);
     }
 
-    void RandomAct(const bool is_first)
+    void RandomAct(const bool is_first, std::mt19937& g)
     {
         for (uint32_t hand_id = 0; remain_coins_ > 0; hand_id = (hand_id + 1) % hands_.size()) {
             auto& hand = hands_[hand_id];
@@ -181,12 +181,12 @@ struct PlayerRoundInfo
             }
             if (hand.discard_idx_ != PlayerHand<k_type>::DISCARD_ALL && hand.discard_idx_ != PlayerHand<k_type>::DISCARD_ALL_IMMUTBLE) {
                 const auto coins =
-                    rand() % ((is_first ? remain_coins_ : std::min(remain_coins_, static_cast<int64_t>(hand.immutable_coins_))) + 1);
+                    g() % ((is_first ? remain_coins_ : std::min(remain_coins_, static_cast<int64_t>(hand.immutable_coins_))) + 1);
                 remain_coins_ -= coins;
                 hand.mutable_coins_ += coins;
             }
             if (!is_first && hand.discard_idx_ == PlayerHand<k_type>::DISCARD_NOT_CHOOSE) {
-                hand.discard_idx_ = rand() % k_hand_poker_num; // TODO: choose the best deck
+                hand.discard_idx_ = g() % k_hand_poker_num; // TODO: choose the best deck
             }
         }
     }
@@ -405,7 +405,7 @@ class BetStage : public SubGameStage<>
 
     virtual AtomReqErrCode OnComputerAct(const PlayerID pid, MsgSenderBase& reply)
     {
-        player_round_infos_[pid].RandomAct(is_first_);
+        player_round_infos_[pid].RandomAct(is_first_, Global().RandomEngine());
         return StageErrCode::READY;
     }
 
@@ -551,7 +551,8 @@ class RoundStage : public SubGameStage<BetStage<k_type>>
                 MakeStageCommand(*this, "通过图片查看各玩家手牌及金币情况", &RoundStage::Status_, VoidChecker("赛况")))
         , is_first_(true), player_htmls_(this->Global().PlayerNum())
     {
-        const auto shuffled_pokers = poker::ShuffledPokers<k_type>(GAME_OPTION(种子).empty() ? "" : GAME_OPTION(种子) + std::to_string(round));
+        const auto shuffled_pokers = poker::ShuffledPokers<k_type>(GAME_OPTION(种子).empty() ? "" : GAME_OPTION(种子) + std::to_string(round),
+                this->Global().RandomEngine());
         const auto player_num = this->Global().PlayerNum();
         const uint32_t player_hand_num = PlayerHandNum(player_num);
         auto it = shuffled_pokers.cbegin();
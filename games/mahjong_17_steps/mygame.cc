@@ -84,18 +84,16 @@ class MainStage : public MainGameStage<TableStage>
   public:
     MainStage(StageUtility&& utility) : StageFsm(std::move(utility)), table_idx_(0)
     {
-        std::variant<std::random_device, std::seed_seq> rd;
-        std::mt19937 g([&]
+        std::uniform_int_distribution<uint32_t> distribution(1, Global().PlayerNum());
+        const auto offset = [&]
             {
                 if (GAME_OPTION(种子).empty()) {
-                    auto& real_rd = rd.emplace<std::random_device>();
-                    return std::mt19937(real_rd());
-                } else {
-                    auto& real_rd = rd.emplace<std::seed_seq>(GAME_OPTION(种子).begin(), GAME_OPTION(种子).end());
-                    return std::mt19937(real_rd);
+                    return distribution(Global().RandomEngine());
                 }
-            }());
-        const auto offset = std::uniform_int_distribution<uint32_t>(1, Global().PlayerNum())(g);
+                std::seed_seq seed(GAME_OPTION(种子).begin(), GAME_OPTION(种子).end());
+                std::mt19937 g(seed);
+                return distribution(g);
+            }();
         for (uint64_t pid = 0; pid < Global().PlayerNum(); ++pid) {
             players_.emplace_back((pid + offset) % Global().PlayerNum());
         }
@@ -151,7 +149,7 @@ class PrepareStage : public SubGameStage<>
         Global().Boardcast() << "请私信裁判进行配牌，时限 " << GAME_OPTION(配牌时限) << " 秒";
         Global().SaveMarkdown(game_table_.SpecHtml());
         for (PlayerID pid = 0; pid < Global().PlayerNum(); ++pid) {
-            Global().Tell(pid) << Markdown(game_table_.PrepareHtml(pid));
+            Global().Tell(pid) << LazyMarkdown{[&] { return game_table_.PrepareHtml(pid); }};
             Global().Tell(pid) << "请配牌，您可通过「帮助」命令查看命令格式";
         }
     }
@@ -282,10 +280,10 @@ class KiriStage : public SubGameStage<>
 
     void SendInfo_()
     {
-        Global().Group() << Markdown(game_table_.PublicHtml());
+        Global().Group() << LazyMarkdown{[&] { return game_table_.PublicHtml(); }};
         Global().SaveMarkdown(game_table_.SpecHtml());
         for (PlayerID pid = 0; pid < Global().PlayerNum(); ++pid) {
-            Global().Tell(pid) << Markdown(game_table_.KiriHtml(pid));
+            Global().Tell(pid) << LazyMarkdown{[&] { return game_table_.KiriHtml(pid); }};
         }
     }
 
@@ -375,7 +373,8 @@ class TableStage : public SubGameStage<PrepareStage, KiriStage>
                     .tile_option_{
                         .with_red_dora_ = GAME_OPTION(赤宝牌),
                         .with_toumei_ = GAME_OPTION(透明牌),
-                        .seed_ = GAME_OPTION(种子).empty() ? "" : GAME_OPTION(种子) + stage_name,
+                        .seed_ = GAME_OPTION(种子).empty() ? std::to_string(main_stage.Global().RandomEngine()()) :
+                                                             GAME_OPTION(种子) + stage_name,
                     },
                     .name_ = stage_name,
                     .with_inner_dora_ = GAME_OPTION(里宝牌),
@@ -379,7 +379,7 @@ class RoundStage : public SubGameStage<>
 
     virtual void OnStageBegin() override
     {
-		Global().Boardcast() << Markdown(Main().board.GetUI());
+		Global().Boardcast() << LazyMarkdown{[&] { return Main().board.GetUI(); }};
 		Global().SetReady(!Main().currentPlayer);
         Global().StartTimer(GAME_OPTION(时限));
         
@@ -489,8 +489,7 @@ class RoundStage : public SubGameStage<>
 void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 {
 	// 随机生成先后手 
-	srand((unsigned int)time(NULL));
-	currentPlayer = rand() % 2;
+	currentPlayer = Global().Rand() % 2;
 	Global().Boardcast() << "先手（黑棋）：" << At(PlayerID(currentPlayer));
 	
 	// 设置读取棋盘大小 
@@ -505,7 +504,7 @@ void MainStage::NextStageFsm(RoundStage& sub_stage, const CheckoutReason reason,
 	// 有人退出，强制结束 
 	if (stop == 1)
 	{
-		Global().Boardcast() << Markdown(board.GetUI());
+		Global().Boardcast() << LazyMarkdown{[&] { return board.GetUI(); }};
 		return;
 	}
 	round_++;
@@ -514,7 +513,7 @@ void MainStage::NextStageFsm(RoundStage& sub_stage, const CheckoutReason reason,
 	{ 
 		// 平局 
 		Global().Boardcast() << "棋盘已满或回合达到上限，游戏结束";
-		Global().Boardcast() << Markdown(board.GetUI());
+		Global().Boardcast() << LazyMarkdown{[&] { return board.GetUI(); }};
 		return;
 	}
 	// 检查胜利
@@ -552,7 +551,7 @@ void MainStage::NextStageFsm(RoundStage& sub_stage, const CheckoutReason reason,
 	{
 		player_scores_[winner] = 1;
 		Global().Boardcast() << "有玩家连成四子，游戏结束";
-		Global().Boardcast() << Markdown(board.GetUI());
+		Global().Boardcast() << LazyMarkdown{[&] { return board.GetUI(); }};
 		return;
 	}
 	
@@ -1,5 +1,6 @@
 
 #include <iomanip>
+#include <random>
 
 class Boss
 {
@@ -29,6 +30,9 @@ public:
     // BOSS3 电磁干扰
     bool EMI = false;
 
+    // 随机数引擎，由比赛提供，以便比赛恢复时得到相同的随机数
+    std::mt19937* random_engine = nullptr;
+
 
     // BOSS简介
     string BossDesc() const
@@ -131,9 +135,9 @@ public:
         RD_is_hit = false;
         int try_count = 0;
         while (board[1].alive < board[1].planeNum) {
-            X = rand() % board[1].sizeX + 1;
-            Y = rand() % board[1].sizeY + 1;
-            direction = rand() % 4 + 1;
+            X = Rand_() % board[1].sizeX + 1;
+            Y = Rand_() % board[1].sizeY + 1;
+            direction = Rand_() % 4 + 1;
             if (board[1].AddPlane(X, Y, direction, overlap) == "OK") try_count = 0;
             if (try_count++ > 5000) {
                 board[1].RemoveAllPlanes();
@@ -148,8 +152,8 @@ public:
     {
         bool SpecialPlane_success = false;
         while (!SpecialPlane_success) {
-            int X = rand() % (board[1].sizeX - 4) + 3;
-            int Y = rand() % (board[1].sizeY - 4) + 3;
+            int X = Rand_() % (board[1].sizeX - 4) + 3;
+            int Y = Rand_() % (board[1].sizeY - 4) + 3;
             if (board[1].map[X][Y][0] > 0) continue;
             if (BossType == 0) {
                 // BOSS0 放置万能核心
@@ -157,7 +161,7 @@ public:
                 for (auto position : UniversalCore_position) {
                     board[1].map[X + position[0]][Y + position[1]][1] = board[1].body[X + position[0]][Y + position[1]] = 1;
                 }
-                const int a = rand() % 2 + 1, b = rand() % 2 + 1;
+                const int a = Rand_() % 2 + 1, b = Rand_() % 2 + 1;
                 for (auto position : UniversalCoreRandom_position) {
                     board[1].map[X + a * position[0]][Y + b * position[1]][1] = board[1].body[X + a * position[0]][Y + b * position[1]] = 1;
                 }
@@ -180,7 +184,7 @@ public:
     // BOSS 普攻+技能攻击（进攻阶段调用）
     string BossAttack(Board (&board)[2], int round, int (&attack_count)[2], int (&timeout)[2], int (&repeated)[2])
     {
-        if (BossType == 0) tempBossType = rand() % 3 + 1;
+        if (BossType == 0) tempBossType = Rand_() % 3 + 1;
         string normalInfo = (BossType == 0 ? "[BOSS " + to_string(tempBossType) + " 形态]\n" : "");
         if (BossType == 1 || tempBossType == 1) normalInfo += BossNormalAttack(board, round, attack_count, 3, 6, 20, 2);
         if (BossType == 2 || tempBossType == 2) normalInfo += BossNormalAttack(board, round, attack_count, 3, 6, 18, 2);
@@ -197,14 +201,14 @@ public:
 
 
     // BOSS 普攻
-    static string BossNormalAttack(Board (&board)[2], const int round_, int (&attack_count)[2], const int a, const int b, const int enhance_round, const int enhance_num)
+    string BossNormalAttack(Board (&board)[2], const int round_, int (&attack_count)[2], const int a, const int b, const int enhance_round, const int enhance_num)
     {
-        int num = (round_ < enhance_round ? rand() % (b - a + 1) + a : rand() % (b - a + 1) + a + enhance_num);
+        int num = (round_ < enhance_round ? Rand_() % (b - a + 1) + a : Rand_() % (b - a + 1) + a + enhance_num);
         int X, Y, try_count = 0, count = 0;
         for (int i = 0; i < num; i++) {
             if (try_count > 1000) break;
-            X = rand() % board[0].sizeX + 1;
-            Y = rand() % board[0].sizeY + 1;
+            X = Rand_() % board[0].sizeX + 1;
+            Y = Rand_() % board[0].sizeY + 1;
             string result = board[0].Attack(X, Y);
             if (result != "0" && result != "1" && result != "2" ) {
                 i--; try_count++;
@@ -225,7 +229,7 @@ public:
         int add_p = 0;
         int X, Y;
 
-        int skill = rand() % 100 + 1;
+        int skill = Rand_() % 100 + 1;
         if (board[1].alive <= board[1].planeNum - 3) add_p = 5;
 
         if (skill > 100 - skill_probability[0] - add_p * 1)
@@ -243,9 +247,9 @@ public:
             int try_count = 0;
             int direction;
             while (board[1].alive < alive_count) {
-                X = rand() % board[1].sizeX + 1;
-                Y = rand() % board[1].sizeY + 1;
-                direction = rand() % 4 + 1;
+                X = Rand_() % board[1].sizeX + 1;
+                Y = Rand_() % board[1].sizeY + 1;
+                direction = Rand_() % 4 + 1;
                 int found_count = 0;
                 for (int i = 0; i < 9; i++) {
                     if (board[1].map[X + board[1].position[direction][i][0]][Y + board[1].position[direction][i][1]][0] > 0) {
@@ -254,7 +258,7 @@ public:
                 }
                 bool hide = false;
                 for (int i = 0; i <= 9; i++) {
-                    if ((found_count <= i && try_count >= i * 300) || (found_count <= 1 && rand() % 50 == 0)) {
+                    if ((found_count <= i && try_count >= i * 300) || (found_count <= 1 && Rand_() % 50 == 0)) {
                         hide = true; break;
                     }
                 }
@@ -272,8 +276,8 @@ public:
         else if (skill > 100 - skill_probability[1] - add_p * 2)
         {
             // 15%概率触发连环轰炸，打击十字区域
-            X = rand() % board[0].sizeX + 1;
-            Y = rand() % board[0].sizeY + 1;
+            X = Rand_() % board[0].sizeX + 1;
+            Y = Rand_() % board[0].sizeY + 1;
             for (int i = 1; i <= board[0].sizeX; i++) {
                 board[0].Attack(X, i);
                 board[0].Attack(i, Y);
@@ -288,8 +292,8 @@ public:
             for (int attempt = 1; attempt <= 30; attempt++) {
                 count = exposed_space_count = exposed_plane_count = 0;
                 remain_head = true;
-                X = rand() % (board[0].sizeX - 4) + 3;
-                Y = rand() % (board[0].sizeY - 4) + 3;
+                X = Rand_() % (board[0].sizeX - 4) + 3;
+                Y = Rand_() % (board[0].sizeY - 4) + 3;
                 for (int i = -2; i <= 2; i++) {
                     for (int j = -2; j <= 2; j++) {
                         if (board[0].map[X + i][Y + j][0] > 0) {
@@ -322,8 +326,8 @@ public:
             // 25%概率触高爆导弹，打击3*3区域
             for (int attempt = 1; attempt <= 30; attempt++) {
                 int exposed_count = 0;
-                X = rand() % (board[0].sizeX - 2) + 2;
-                Y = rand() % (board[0].sizeY - 2) + 2;
+                X = Rand_() % (board[0].sizeX - 2) + 2;
+                Y = Rand_() % (board[0].sizeY - 2) + 2;
                 for (int i = -1; i <= 1; i++) {
                     for (int j = -1; j <= 1; j++) {
                         if (board[0].map[X + i][Y + j][0] > 0) {
@@ -353,7 +357,7 @@ public:
         string N_warning;
         int X, Y;
         
-        int skill = rand() % 100 + 1;
+        int skill = Rand_() % 100 + 1;
 
         // [核弹]
         if (!nuclear_hitted) {
@@ -374,12 +378,12 @@ public:
             ostringstream oss;
             oss << fixed << setprecision(1) << percent_d;
             string percent_s = oss.str();
-            if (rand() % 1000 < percent) {
+            if (Rand_() % 1000 < percent) {
                 nuclear_hitted = true;
-                int power = rand() % 4 + 4;
+                int power = Rand_() % 4 + 4;
                 for (int i = 1; i <= board[0].sizeX; i++) {
                     for (int j = 1; j <= board[0].sizeY; j++) {
-                        if (percent < 60 && rand() % 10 >= power) continue;
+                        if (percent < 60 && Rand_() % 10 >= power) continue;
                         board[0].Attack(i, j);
                     }
                 }
@@ -415,9 +419,9 @@ public:
             int direction;
             bool success = false;
             while (!success) {
-                X = rand() % board[1].sizeX + 1;
-                Y = rand() % board[1].sizeY + 1;
-                direction = rand() % 4 + 1;
+                X = Rand_() % board[1].sizeX + 1;
+                Y = Rand_() % board[1].sizeY + 1;
+                direction = Rand_() % 4 + 1;
                 int found_count = 0;
                 for (int i = 0; i < 9; i++) {
                     if (board[1].map[X + board[1].position[direction][i][0]][Y + board[1].position[direction][i][1]][0] > 0) {
@@ -465,7 +469,7 @@ public:
         int X, Y;
         EMI = false;
 
-        int skill = rand() % 100 + 1;
+        int skill = Rand_() % 100 + 1;
         if (board[1].alive <= board[1].planeNum - 3) add_p = 5;
 
         if (skill > 100 - skill_probability[0] - add_p * 1)
@@ -473,14 +477,14 @@ public:
             // 10%概率发动高能激光（地图右侧2-13），斜线打击，反射两次
             const int laser_move[5][2] = {{}, {-1, 1}, {-1, -1}, {1, -1}, {1, 1}};   // 1左下 2左上 3右上 4右下
             int direction, reflex_count = 0;
-            if (rand() % 2 == 0) {
+            if (Rand_() % 2 == 0) {
                 X = board[0].sizeX;
-                direction = rand() % 2 + 1;
+                direction = Rand_() % 2 + 1;
             } else {
                 X = 1;
-                direction = rand() % 2 + 3;
+                direction = Rand_() % 2 + 3;
             }
-            Y = rand() % 10 + 3;
+            Y = Rand_() % 10 + 3;
             string start_str = string(1, 'A' + X - 1) + to_string(Y);
             while (reflex_count <= 2) {
                 if ((X == 1 && direction == 2) || (X == board[0].sizeX && direction == 4) || (Y == 1 && direction == 3) || (Y == board[0].sizeY && direction == 1)) {
@@ -510,11 +514,11 @@ public:
                 }
             }
             if (found_body.empty()) {
-                X = rand() % (board[0].sizeX - 2) + 2;
-                Y = rand() % (board[0].sizeY - 2) + 2;
+                X = Rand_() % (board[0].sizeX - 2) + 2;
+                Y = Rand_() % (board[0].sizeY - 2) + 2;
             } else {
                 for (int attempt = 1; attempt <= 30; attempt++) {
-                    int rd = rand() % found_body.size();
+                    int rd = Rand_() % found_body.size();
                     int num = rd;
                     for(int i = 1; i <= board[0].sizeX; i++) {
                         for(int j = 1; j <= board[0].sizeY; j++) {
@@ -559,8 +563,8 @@ public:
             const int num = board[1].alive <= board[1].planeNum - 3 ? 2 : 3;
             string str[3], areas;
             while (success < num) {
-                X = rand() % (board[0].sizeX - 4) + 3;
-                Y = rand() % (board[0].sizeY - 4) + 3;
+                X = Rand_() % (board[0].sizeX - 4) + 3;
+                Y = Rand_() % (board[0].sizeY - 4) + 3;
                 str[success] = string(1, 'A' + X - 1) + to_string(Y);
                 if (success == 1 && str[success] == str[0]) continue;
                 if (success == 2 && (str[success] == str[0] || str[success] == str[1])) continue;
@@ -591,8 +595,8 @@ public:
             for(int i = 0; i < normal_attack.size(); i++) {
                 try_count = temp_count = 0;
                 while (temp_count < 3 && try_count++ < 1000) {
-                    X = normal_attack[i][0] + rand() % 5 - 2;
-                    Y = normal_attack[i][1] + rand() % 5 - 2;
+                    X = normal_attack[i][0] + Rand_() % 5 - 2;
+                    Y = normal_attack[i][1] + Rand_() % 5 - 2;
                     string ret = board[0].Attack(X, Y);
                     if (ret == "0" || ret == "1" || ret == "2") {
                         temp_count++;
@@ -619,7 +623,7 @@ public:
         if (is_boss) {
             // BOSS2 [导弹拦截]
             if (BossType == 2 || tempBossType == 2) {
-                if (rand() % 100 < 8) {
+                if (Rand_() % 100 < 8) {
                     string ret = board[0].PlayerAttack(str);
                     if (ret == "0" || ret == "1" || ret == "2") {
                         return make_pair(ret, "【WARNING】BOSS触发技能 [导弹拦截]，当前导弹被拦截并打击到了玩家的地图上");
@@ -636,8 +640,8 @@ public:
 
                     int try_count = 0;
                     while (try_count++ < 1000) {
-                        int actual_X = X + rand() % 5 - 2;
-                        int actual_Y = Y + rand() % 5 - 2;
+                        int actual_X = X + Rand_() % 5 - 2;
+                        int actual_Y = Y + Rand_() % 5 - 2;
                         string actual_str = string(1, 'A' + actual_X - 1) + to_string(actual_Y);
                         string ret = board[1].PlayerAttack(actual_str);
                         if (ret == "0" || ret == "1" || ret == "2") {
@@ -685,4 +689,6 @@ public:
         return info;
     }
 
+private:
+    int Rand_() const { return std::uniform_int_distribution<int>(0, RAND_MAX)(*random_engine); }
 };
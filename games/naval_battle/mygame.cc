@@ -50,11 +50,6 @@ bool AdaptOptions(MsgSenderBase& reply, MyGameOptions& game_options, const Gener
         GET_OPTION_VALUE(game_options, 进攻时限) = 150;
         reply() << "[提示] 本局飞机数为 " + to_string(GET_OPTION_VALUE(game_options, 飞机)) + "，已增加长考时间。";
     }
-
-    if (GET_OPTION_VALUE(game_options, BOSS挑战) == 100) {
-        GET_OPTION_VALUE(game_options, BOSS挑战) = rand() % 3 + 1;
-        if (rand() % 100 == 0) GET_OPTION_VALUE(game_options, BOSS挑战) = 0;
-    }
     return true;
 }
 
@@ -153,8 +148,15 @@ class MainStage : public MainGameStage<PrepareStage, AttackStage>
         }
 
         // 初始化BOSS战配置
+        boss.random_engine = &Global().RandomEngine();
         if (Global().PlayerName(1) == "机器人0号") {
-            boss.BossType = GAME_OPTION(BOSS挑战);
+            // 随机BOSS
+            uint32_t boss_challenge = GAME_OPTION(BOSS挑战);
+            if (boss_challenge == 100) {
+                boss_challenge = Global().Rand() % 3 + 1;
+                if (Global().Rand() % 100 == 0) boss_challenge = 0;
+            }
+            boss.BossType = boss_challenge;
             boss.tempBossType = 0;
             boss.overlap = GAME_OPTION(重叠);
             boss.is_boss = true;
@@ -163,7 +165,7 @@ class MainStage : public MainGameStage<PrepareStage, AttackStage>
 
             auto sender = Global().Boardcast();
 
-            if (GAME_OPTION(BOSS挑战) >= 0 && GAME_OPTION(连发) == 3 && GAME_OPTION(侦察) == 100) {
+            if (boss_challenge >= 0 && GAME_OPTION(连发) == 3 && GAME_OPTION(侦察) == 100) {
                 sender << "[提示] 初始化预设BOSS配置成功！\n\n";
             } else {
                 sender << "[警告] 当前游戏未使用默认连发或侦察配置。\n\n";
@@ -173,22 +175,22 @@ class MainStage : public MainGameStage<PrepareStage, AttackStage>
                       "\n- 要害 " << (GAME_OPTION(要害) == 0 ? "有" : (GAME_OPTION(要害) == 1 ? "无" : "首次")) <<
                       "\n- 连发 " << to_string(GAME_OPTION(连发)) <<
                       "\n- 侦察 " << (GAME_OPTION(侦察) == 100 ? "随机" : to_string(GAME_OPTION(侦察)));
-            if (GAME_OPTION(BOSS挑战) == 0) {
+            if (boss_challenge == 0) {
                 board[0].sizeX = board[0].sizeY = board[1].sizeX = board[1].sizeY = 14;
                 board[0].planeNum = 3;
                 board[1].planeNum = 5;
             }
-            if (GAME_OPTION(BOSS挑战) == 1) {
+            if (boss_challenge == 1) {
                 board[0].sizeX = board[0].sizeY = board[1].sizeX = board[1].sizeY = 14;
                 board[0].planeNum = 3;
                 board[1].planeNum = 6;
             }
-            if (GAME_OPTION(BOSS挑战) == 2) {
+            if (boss_challenge == 2) {
                 board[0].sizeX = board[0].sizeY = board[1].sizeX = board[1].sizeY = 14;
                 board[0].planeNum = 3;
                 board[1].planeNum = 5;
             }
-            if (GAME_OPTION(BOSS挑战) == 3) {
+            if (boss_challenge == 3) {
                 board[0].sizeX = board[0].sizeY = board[1].sizeX = board[1].sizeY = 14;
                 board[0].planeNum = 3;
                 board[1].planeNum = 6;
@@ -198,15 +200,14 @@ class MainStage : public MainGameStage<PrepareStage, AttackStage>
         board[1].InitializeMap();
         
         // 随机生成侦察点
-        srand((unsigned int)time(NULL));
         int count = 0, X, Y;
         int investigate = GAME_OPTION(侦察);
         if (investigate == 100) {
-            investigate = rand() % 5 + (board[0].sizeX - 7);
+            investigate = Global().Rand() % 5 + (board[0].sizeX - 7);
         }
         while (count < investigate) {
-            X = rand() % board[0].sizeX + 1;
-            Y = rand() % board[0].sizeY + 1;
+            X = Global().Rand() % board[0].sizeX + 1;
+            Y = Global().Rand() % board[0].sizeY + 1;
             if (board[0].map[X][Y][0] == 0) {
                 board[0].map[X][Y][0] = board[1].map[X][Y][0] = 2;
                 count++;
@@ -221,7 +222,7 @@ class MainStage : public MainGameStage<PrepareStage, AttackStage>
         if (timeout[0] || timeout[1]) {
             if (timeout[0]) player_scores_[0] = -1;
             if (timeout[1]) player_scores_[1] = -1;
-            Global().Boardcast() << Markdown(GetAllMap(1, 1, 0));
+            Global().Boardcast() << LazyMarkdown{[&] { return GetAllMap(1, 1, 0); }};
             return;
         }
         // UI从转为要害显示
@@ -229,7 +230,7 @@ class MainStage : public MainGameStage<PrepareStage, AttackStage>
         board[1].prepare = 0;
 
         // 展示初始地图
-        Global().Boardcast() << Markdown(GetAllMap(0, 0, GAME_OPTION(要害)));
+        Global().Boardcast() << LazyMarkdown{[&] { return GetAllMap(0, 0, GAME_OPTION(要害)); }};
 
         setter.Emplace<AttackStage>(*this, ++round_);
     }
@@ -272,7 +273,7 @@ class MainStage : public MainGameStage<PrepareStage, AttackStage>
                 }
             }
         }
-        Global().Boardcast() << Markdown(GetAllMap(1, 1, 0));
+        Global().Boardcast() << LazyMarkdown{[&] { return GetAllMap(1, 1, 0); }};
 
         if (round_ == 1 && GAME_OPTION(飞机) >= 3) {
             for (PlayerID pid = 0; pid < Global().PlayerNum(); ++pid) {
@@ -305,7 +306,7 @@ class PrepareStage : public SubGameStage<>
 
     virtual void OnStageBegin() override
     {
-		Global().Boardcast() << Markdown(Main().GetAllMap(0, 0, GAME_OPTION(要害)));
+		Global().Boardcast() << LazyMarkdown{[&] { return Main().GetAllMap(0, 0, GAME_OPTION(要害)); }};
         Global().Boardcast() << "请私信裁判放置飞机，时限 " << GAME_OPTION(放置时限) << " 秒";
         
         // 游戏开始时展示特殊规则
@@ -320,7 +321,7 @@ class PrepareStage : public SubGameStage<>
         }
 
         for (PlayerID pid = 0; pid < Global().PlayerNum(); ++pid) {
-            Global().Tell(pid) << Markdown(Main().board[pid].Getmap(1, GAME_OPTION(要害)));
+            Global().Tell(pid) << LazyMarkdown{[&] { return Main().board[pid].Getmap(1, GAME_OPTION(要害)); }};
             Global().Tell(pid) << "请放置飞机，指令为「坐标 方向」，如：C5 上\n可通过「帮助」查看全部命令格式";
         }
         Global().StartTimer(GAME_OPTION(放置时限));
@@ -451,7 +452,7 @@ class PrepareStage : public SubGameStage<>
 
         Main().boss.BossPrepare(Main().board);
 
-        Global().Boardcast() << "BOSS已抵达战场，请根据BOSS技能选择合适的部署和战术！\n" << Markdown(Main().boss.BossIntro(), 680);
+        Global().Boardcast() << "BOSS已抵达战场，请根据BOSS技能选择合适的部署和战术！\n" << LazyMarkdown{[&] { return Main().boss.BossIntro(); }, 680};
         return StageErrCode::READY;
     }
 
@@ -488,7 +489,7 @@ class AttackStage : public SubGameStage<>
 
     virtual CheckoutErrCode OnStageOver() override
     {
-        Global().Boardcast() << Markdown(Main().GetAllMap(0, 0, GAME_OPTION(要害)));
+        Global().Boardcast() << LazyMarkdown{[&] { return Main().GetAllMap(0, 0, GAME_OPTION(要害)); }};
         // 重置上回合打击位置
         for (PlayerID pid = 0; pid < Global().PlayerNum(); ++pid) {
             for(int i = 1; i <= Main().board[pid].sizeX; i++) {
@@ -653,7 +654,7 @@ class AttackStage : public SubGameStage<>
         }
 
         string roundInfo = Main().boss.BossAttack(Main().board, Main().round_, Main().attack_count, Main().timeout, repeated);
-        Global().Boardcast() << roundInfo << Markdown(Main().GetAllMap(0, 0, GAME_OPTION(要害)));
+        Global().Boardcast() << roundInfo << LazyMarkdown{[&] { return Main().GetAllMap(0, 0, GAME_OPTION(要害)); }};
 
         if (Main().timeout[1] == 1) Global().SetReady(0);
 
@@ -235,10 +235,10 @@ class GuessingStage : public SubGameStage<> {
     auto limit = GAME_OPTION(时限);
     if (limit % 60 == 0) {
       Global().Boardcast() << "请双方做出猜测，本回合时间限制" << limit / 60 << "分钟。"
-                  << Markdown(Main().table_.ToHtml());
+                  << LazyMarkdown{[&] { return Main().table_.ToHtml(); }};
     } else {
       Global().Boardcast() << "请双方做出猜测，本回合时间限制" << limit << "秒。"
-                  << Markdown(Main().table_.ToHtml());
+                  << LazyMarkdown{[&] { return Main().table_.ToHtml(); }};
     }
     Global().StartTimer(limit);
   }
@@ -331,7 +331,7 @@ int64_t MainStage::PlayerScore(const PlayerID pid) const { return score_.at(pid)
 
 bool MainStage::JudgeOver() {
   if (ended_) {
-    Global().Boardcast() << Markdown(table_.ToHtml());
+    Global().Boardcast() << LazyMarkdown{[&] { return table_.ToHtml(); }};
     return true;
   }
   Info_();
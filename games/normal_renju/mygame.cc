@@ -66,7 +66,7 @@ class MainStage : public MainGameStage<>
         , round_(0)
         , player_scores_(Global().PlayerNum(), 0)
         , board_(Global().ResourceDir(), BoardOptions{.to_expand_board_ = false, .is_overline_win_ = false})
-        , turn_pid_(rand() % 2)
+        , turn_pid_(Global().Rand() % 2)
         , black_pid_(turn_pid_)
         , state_(State::INIT)
         , last_round_passed_(false)
@@ -78,7 +78,7 @@ class MainStage : public MainGameStage<>
     virtual void OnStageBegin() override
     {
         Global().StartTimer(GAME_OPTION(时限));
-        Global().Boardcast() << Markdown(HtmlHead_() + board_.ToHtml());
+        Global().Boardcast() << LazyMarkdown{[&] { return HtmlHead_() + board_.ToHtml(); }};
         Global().Boardcast() << "请" << At(turn_pid_) << "行动，时限 " << GAME_OPTION(时限) << " 秒，下前 3 手棋（如「J10 H9 E8」）";
         Global().SetReady(1 - turn_pid_);
     }
@@ -106,8 +106,8 @@ class MainStage : public MainGameStage<>
             {
                 uint32_t x, y;
                 do {
-                    x = rand() % Board::k_size_;
-                    y = rand() % Board::k_size_;
+                    x = Global().Rand() % Board::k_size_;
+                    y = Global().Rand() % Board::k_size_;
                 } while (!board_.CanBeSet(x, y));
                 return board_.Set(x, y, type);
             };
@@ -118,7 +118,7 @@ class MainStage : public MainGameStage<>
             set(AreaType::BLACK);
             state_ = State::SWAP_1;
         } else if (state_ == State::SWAP_1) {
-            switch (rand() % 3) {
+            switch (Global().Rand() % 3) {
             case 0:
                 set(AreaType::WHITE);
                 state_ = State::PLACE;
@@ -133,7 +133,7 @@ class MainStage : public MainGameStage<>
                 state_ = State::PLACE;
             }
         } else if (state_ == State::SWAP_2) {
-            if (rand() % 2) {
+            if (Global().Rand() % 2) {
                 set(AreaType::WHITE);
             } else {
                 HandlePass_();
@@ -276,7 +276,7 @@ class MainStage : public MainGameStage<>
     CheckoutErrCode RoundOver_(const bool to_continue)
     {
         turn_pid_ = 1 - turn_pid_;
-        Global().Boardcast() << Markdown(HtmlHead_() + board_.ToHtml());
+        Global().Boardcast() << LazyMarkdown{[&] { return HtmlHead_() + board_.ToHtml(); }};
         if (!to_continue) {
             return StageErrCode::CHECKOUT;
         }
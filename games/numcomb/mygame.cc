@@ -50,6 +50,12 @@ const std::vector<InitOptionsCommand> k_init_options_commands = {
 
 // ========== GAME STAGES ==========
 
+#ifdef TEST_BOT
+static constexpr auto k_computer_think_budget = std::chrono::milliseconds(5);
+#else
+static constexpr auto k_computer_think_budget = std::chrono::milliseconds(1000);
+#endif
+
 static const std::array<std::vector<int32_t>, comb::k_direct_max> k_points{
     std::vector<int32_t>{3, 4, 8},
     std::vector<int32_t>{1, 5, 9},
@@ -74,12 +80,11 @@ class MainStage : public MainGameStage<RoundStage>
         : StageFsm(std::move(utility))
         , round_(0)
     {
-        srand((unsigned int)time(NULL));
         const std::array<const char*, 5> skin_names = {"random", "pure", "green", "pink", "gold"};
         int skin_num = skin_names.size();
         int skin = GAME_OPTION(皮肤);
         if (GAME_OPTION(皮肤) == 0) {
-            skin = rand() % (skin_num - 1) + 1;
+            skin = Global().Rand() % (skin_num - 1) + 1;
         }
         imageDir = Global().ResourceDir() / std::filesystem::path(skin_names[skin]);
 
@@ -96,18 +101,19 @@ class MainStage : public MainGameStage<RoundStage>
                     // two card for each type
                     cards_.emplace_back(point_0, point_1, point_2);
                     cards_.emplace_back(point_0, point_1, point_2);
+                    unrevealed_cards_.Add(cards_.back(), 2);
                 }
             }
         }
         for (uint32_t i = 0; i < GAME_OPTION(癞子); ++i) {
             cards_.emplace_back();
+            unrevealed_cards_.Add(cards_.back());
         }
 
         seed_str = GAME_OPTION(种子);
         if (seed_str.empty()) {
-            std::random_device rd;
             std::uniform_int_distribution<unsigned long long> dis;
-            seed_str = std::to_string(dis(rd));
+            seed_str = std::to_string(dis(Global().RandomEngine()));
         }
         std::seed_seq seed(seed_str.begin(), seed_str.end());
         std::mt19937 g(seed);
@@ -144,6 +150,11 @@ class MainStage : public MainGameStage<RoundStage>
         return str + table.ToString();
     }
 
+    // The cards which have not been revealed to players. The current card is excluded because `NewStage_` removes it
+    // from the pool before computers act.
+    const comb::CardPool& UnrevealedCards() const { return unrevealed_cards_; }
+
+    uint32_t RemainingRounds() const { return GAME_OPTION(回合数) - round_; }
 
     std::vector<Player> players_;
 
@@ -156,15 +167,20 @@ class MainStage : public MainGameStage<RoundStage>
     uint32_t round_;
     std::vector<comb::AreaCard> cards_;
     decltype(cards_)::iterator it_;
+    comb::CardPool unrevealed_cards_;
 };
 
 class RoundStage : public SubGameStage<>
 {
   public:
     RoundStage(MainStage& main_stage, const uint64_t round, const comb::AreaCard& card)
-            : StageFsm(main_stage, "第" + std::to_string(round) + "回合",
-                MakeStageCommand(*this, "设置数字", &RoundStage::Set_, ArithChecker<uint32_t>(0, 19, "数字")),
-                MakeStageCommand(*this, "查看本回合开始时蜂巢情况，可用于图片重发", &RoundStage::Info_, VoidChecker("赛况")))
+            : StageFsm(main_stage, "第" + std::to_string(round) + "回合", []
+                {
+                    return std::vector{
+                        MakeStageCommand("设置数字", &RoundStage::Set_, ArithChecker<uint32_t>(0, 19, "数字")),
+                        MakeStageCommand("查看本回合开始时蜂巢情况，可用于图片重发", &RoundStage::Info_, VoidChecker("赛况")),
+                    };
+                })
             , card_(card)
             , comb_html_(main_stage.CombHtml("## 第 " + std::to_string(round) + " 回合"))
     {}
@@ -212,8 +228,34 @@ class RoundStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
+        return ComputerFill_(pid, std::stoul(Global().ComputerChoice([&]
+                    {
+                        return std::to_string(comb::Expectimax(Main().UnrevealedCards(), Main().RemainingRounds())
+                                .Search(Main().players_[pid].comb_->State(), card_, k_computer_think_budget));
+                    })));
+    }
+
+    virtual std::optional<ComputerDecisionTask> PrepareComputerDecision(const PlayerID pid) override
+    {
+        return ComputerDecisionTask{
+            .compute_ = [expectimax = comb::Expectimax(Main().UnrevealedCards(), Main().RemainingRounds()),
+                         state = Main().players_[pid].comb_->State(), card = card_]() mutable -> ComputerDecision
+                {
+                    return std::to_string(expectimax.Search(state, card, k_computer_think_budget));
+                },
+        };
+    }
+
+    virtual AtomReqErrCode OnComputerDecision(const PlayerID pid, const ComputerDecision& decision,
+            MsgSenderBase& reply) override
+    {
+        return ComputerFill_(pid, std::stoul(decision));
+    }
+
+    AtomReqErrCode ComputerFill_(const PlayerID pid, const uint32_t idx)
+    {
         auto& player = Main().players_[pid];
-        if (const auto& [point, line] = player.comb_->SeqFill(card_).second; point > 0) {
+        if (const auto& [point, line] = player.comb_->Fill(idx, card_); point > 0) {
             player.score_ += point;
             player.line_count_ += line;
         }
@@ -262,6 +304,7 @@ void MainStage::NewStage_(SubStageFsmSetter& setter)
 {
     const auto round = round_;
     const auto& card = *(it_++);
+    unrevealed_cards_.Remove(card);
     setter.Emplace<RoundStage>(*this, ++round_, card);
     return;
 }
@@ -277,7 +320,7 @@ void MainStage::NextStageFsm(RoundStage& sub_stage, const CheckoutReason reason,
         NewStage_(setter);
         return;
     }
-    Global().Boardcast() << Markdown(CombHtml("## 终局"));
+    Global().Boardcast() << LazyMarkdown{[&] { return CombHtml("## 终局"); }};
     if (GAME_OPTION(种子).empty()) {
         Global().Boardcast() << "本局随机数种子：" + seed_str;
         for (PlayerID pid = 0; pid < Global().PlayerNum(); ++pid) {
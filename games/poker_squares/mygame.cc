@@ -64,6 +64,13 @@ constexpr int32_t k_skip_next_num = 2;
 constexpr int32_t k_show_extra_cards_num = 2;
 constexpr int32_t k_round_num = ps::k_square_size * ps::k_square_size + k_skip_next_num;
 
+#ifdef TEST_BOT
+constexpr auto k_computer_think_budget = std::chrono::milliseconds(5);
+#else
+constexpr auto k_computer_think_budget = std::chrono::milliseconds(1000);
+#endif
+const uint32_t k_computer_thread_num = std::clamp(std::thread::hardware_concurrency(), 1U, 4U);
+
 class MainStage : public MainGameStage<>
 {
   public:
@@ -77,8 +84,8 @@ class MainStage : public MainGameStage<>
 #else
                 true
 #endif
-                ? game_util::poker::ShuffledPokers<ps::k_card_type>(GAME_OPTION(种子)) : game_util::poker::UnshuffledPokers<ps::k_card_type>())
-        , poker_squares_(MakePokerSquares_(Global().ResourceDir(), Global().PlayerNum(), GAME_OPTION(种子),
+                ? game_util::poker::ShuffledPokers<ps::k_card_type>(GAME_OPTION(种子), Global().RandomEngine()) : game_util::poker::UnshuffledPokers<ps::k_card_type>())
+        , poker_squares_(MakePokerSquares_(Global().ResourceDir(), Global().PlayerNum(), GAME_OPTION(种子), Global().RandomEngine(),
 #ifdef TEST_BOT
                 GAME_OPTION(洗牌)
 #else
@@ -106,7 +113,32 @@ class MainStage : public MainGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        poker_squares_[pid].FillRandomly(*current_card_iter_);
+        // The seed is drawn even if the choice is journaled, so the random engine is not affected by replaying.
+        const auto seed = Global().RandomEngine()();
+        poker_squares_[pid].Fill(std::stoi(Global().ComputerChoice([&]
+                    {
+                        return std::to_string(MakeMonteCarlo_(pid).Search(*current_card_iter_, k_computer_think_budget,
+                                    k_computer_thread_num, seed));
+                    })), *current_card_iter_);
+        return StageErrCode::READY;
+    }
+
+    virtual std::optional<ComputerDecisionTask> PrepareComputerDecision(const PlayerID pid) override
+    {
+        return ComputerDecisionTask{
+            .compute_ = [monte_carlo = MakeMonteCarlo_(pid), card = *current_card_iter_,
+                         seed = Global().RandomEngine()()]() mutable -> ComputerDecision
+                {
+                    return std::to_string(monte_carlo.Search(card, k_computer_think_budget, k_computer_thread_num, seed));
+                },
+        };
+    }
+
+    // The decision is applied in the same round, so the current card is the one it was computed for.
+    virtual AtomReqErrCode OnComputerDecision(const PlayerID pid, const ComputerDecision& decision,
+            MsgSenderBase& reply) override
+    {
+        poker_squares_[pid].Fill(std::stoi(decision), *current_card_iter_);
         return StageErrCode::READY;
     }
 
@@ -118,20 +150,26 @@ class MainStage : public MainGameStage<>
     virtual int64_t PlayerScore(const PlayerID pid) const override { return ps::GetScore(poker_squares_[pid].GetStatistic()); }
 
   private:
-    static std::array<ps::GridType, ps::k_grid_num> MakeGridTypes_(const std::string_view seed_sv, const bool shuffle)
+    ps::MonteCarlo MakeMonteCarlo_(const PlayerID pid)
+    {
+        const auto upcoming_cards_end = current_card_iter_ + 1 + k_show_extra_cards_num;
+        return ps::MonteCarlo(poker_squares_[pid].GetState(), {current_card_iter_ + 1, upcoming_cards_end},
+                {upcoming_cards_end, cards_.end()});
+    }
+
+    static std::array<ps::GridType, ps::k_grid_num> MakeGridTypes_(const std::string_view seed_sv, std::mt19937& engine,
+            const bool shuffle)
     {
         std::array<ps::GridType, ps::k_grid_num> result;
         result.fill(ps::GridType::empty);
-        const auto shuffled_indexes = [&seed_sv, shuffle]()
+        const auto shuffled_indexes = [&seed_sv, &engine, shuffle]()
             {
                 auto result = MakeArray<ps::k_grid_num>([](const auto i) { return i; });
                 if (!shuffle) {
                     return result;
                 }
                 if (seed_sv.empty()) {
-                    std::random_device rd;
-                    std::mt19937 g(rd());
-                    std::ranges::shuffle(result, g);
+                    std::ranges::shuffle(result, engine);
                 } else {
                     std::seed_seq seed(seed_sv.begin(), seed_sv.end());
                     std::mt19937 g(seed);
@@ -152,11 +190,11 @@ class MainStage : public MainGameStage<>
         return result;
     }
 
-    static std::vector<ps::PokerSquare> MakePokerSquares_(const std::string& resource_dir, const uint32_t player_num, const std::string_view seed_sv, const bool shuffle)
+    static std::vector<ps::PokerSquare> MakePokerSquares_(const std::string& resource_dir, const uint32_t player_num, const std::string_view seed_sv, std::mt19937& engine, const bool shuffle)
     {
         std::vector<ps::PokerSquare> result;
         result.reserve(player_num);
-        const auto grid_types = MakeGridTypes_(seed_sv, shuffle);
+        const auto grid_types = MakeGridTypes_(seed_sv, engine, shuffle);
         std::ranges::for_each(std::views::iota(0U, player_num),
                 [&](...) { result.emplace_back(resource_dir, grid_types); });
         return result;
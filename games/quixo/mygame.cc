@@ -23,10 +23,18 @@ namespace GAME_MODULE_NAME {
 class MainStage;
 template <typename... SubStages> using SubGameStage = StageFsm<MainStage, SubStages...>;
 template <typename... SubStages> using MainGameStage = StageFsm<void, SubStages...>;
+static const char* const k_resources[] = {
+    "box_0.png", "box_1.png", "box_2.png", "box_3.png", "box_4.png",
+    "light_1.png", "light_2.png", "light_3.png", "light_4.png",
+    "num_0.png", "num_1.png", "num_2.png", "num_3.png", "num_4.png", "num_5.png", "num_6.png", "num_7.png",
+    "num_8.png", "num_9.png", "num_10.png", "num_11.png", "num_12.png", "num_13.png", "num_14.png", "num_15.png",
+    nullptr,
+};
 const GameProperties k_properties { 
     .name_ = "你推我挤",
     .developer_ = "森高",
     .description_ = "通过取出并重新放入棋子，先连成五子者获胜的游戏",
+    .resources_ = k_resources,
 };
 uint64_t MaxPlayerNum(const MyGameOptions& options) { return 2; } /* 0 means no max-player limits */
 uint32_t Multiple(const MyGameOptions& options) { return 2; }
@@ -63,7 +71,7 @@ class MainStage : public MainGameStage<>
                 MakeStageCommand(*this, "查看盘面情况，可用于图片重发", &MainStage::Info_, VoidChecker("赛况")),
                 MakeStageCommand(*this, "移动棋子", &MainStage::Set_,
                     ArithChecker<uint32_t>(0, 15, "移动前位置"), ArithChecker<uint32_t>(0, 15, "移动后位置")))
-        , first_turn_(rand() % 2)
+        , first_turn_(Global().Rand() % 2)
         , board_(Global().ResourceDir())
         , round_(0)
         , scores_{0}
@@ -74,7 +82,7 @@ class MainStage : public MainGameStage<>
     {
         Global().SetReady(1 - cur_pid());
         Global().StartTimer(GAME_OPTION(局时));
-        Global().Boardcast() << Markdown(ShowInfo_());
+        ShowInfo_(Global().Boardcast());
         Global().Boardcast() << "请" << At(cur_pid()) << "行动，" << GAME_OPTION(局时)
                     << "秒未行动自动判负\n格式：移动前位置 移动后位置";
     }
@@ -85,9 +93,9 @@ class MainStage : public MainGameStage<>
             return StageErrCode::OK;
         }
         while (true) {
-            const uint32_t src = rand() % 16;
+            const uint32_t src = Global().Rand() % 16;
             const auto valid_dsts = board_.ValidDsts(src);
-            const uint32_t dst = valid_dsts[rand() % valid_dsts.size()];
+            const uint32_t dst = valid_dsts[Global().Rand() % valid_dsts.size()];
             const auto ret = board_.Push(src, dst, cur_type());
             if (ret == game_util::quixo::ErrCode::OK) {
                 Global().Boardcast() << At(pid) << "将 " << src << " 位置的棋子取出，从 " << dst << " 位置重新推入";
@@ -131,11 +139,21 @@ class MainStage : public MainGameStage<>
 
     AtomReqErrCode Info_(const PlayerID pid, const bool is_public, MsgSenderBase& reply)
     {
-        reply() << Markdown(ShowInfo_());
+        ShowInfo_(reply());
         return StageErrCode::OK;
     }
 
-    std::string ShowInfo_() const
+    void ShowInfo_(MsgSenderBase::MsgSenderGuard&& sender)
+    {
+        const auto grid = board_.ToSpriteGrid();
+        if (const auto image = Global().SaveSpriteGrid(grid)) {
+            sender << PlayerInfoText_() << "\n" << *image; // no html needs to be rendered
+        } else {
+            sender << Markdown(PlayerInfo_() + "\n\n" + grid.ToHtml());
+        }
+    }
+
+    std::string PlayerInfo_() const
     {
         std::string str = "## 第" + std::to_string(round_ / 2 + 1) + "回合\n\n";
         html::Table player_table(2, 4);
@@ -155,8 +173,19 @@ class MainStage : public MainGameStage<>
         print_player(0);
         print_player(1);
         str += player_table.ToString();
-        str += "\n\n";
-        str += board_.ToHtml();
+        return str;
+    }
+
+    std::string PlayerInfoText_() const
+    {
+        std::string str = "第" + std::to_string(round_ / 2 + 1) + "回合";
+        const auto chess_counts = ChessCounts_();
+        for (PlayerID pid = 0; pid < 2; ++pid) {
+            str += "\n" + Global().PlayerName(pid) + "：棋子数量 " + std::to_string(chess_counts[pid]);
+            if (pid == cur_pid()) {
+                str += "（行动中）";
+            }
+        }
         return str;
     }
 
@@ -164,15 +193,15 @@ class MainStage : public MainGameStage<>
     {
         const auto ret = board_.LineCount();
         if (ret[1 - static_cast<uint32_t>(cur_symbol())]) {
-            Global().Boardcast() << Markdown(ShowInfo_());
+            ShowInfo_(Global().Boardcast());
             Global().Boardcast() << At(cur_pid()) << "帮助对手达成了直线，于是，输掉了比赛";
             scores_[1 - cur_pid()] = 1;
         } else if (ret[static_cast<uint32_t>(cur_symbol())]) {
-            Global().Boardcast() << Markdown(ShowInfo_());
+            ShowInfo_(Global().Boardcast());
             Global().Boardcast() << At(cur_pid()) << "达成了直线，于是，赢得了比赛";
             scores_[cur_pid()] = 1;
         } else if ((++round_) / 2 >= GAME_OPTION(回合数)) {
-            Global().Boardcast() << Markdown(ShowInfo_());
+            ShowInfo_(Global().Boardcast());
             const auto chess_counts = ChessCounts_();
             if (chess_counts[0] == chess_counts[1]) {
                 Global().Boardcast() << "游戏达到最大回合数，双方棋子数量相同，游戏平局";
@@ -184,11 +213,11 @@ class MainStage : public MainGameStage<>
                 Global().Boardcast() << "游戏达到最大回合数，玩家" << At(PlayerID(0)) << "棋子数量较少，于是，赢得了比赛";
             }
         } else if (!board_.CanPush(cur_type())) {
-            Global().Boardcast() << Markdown(ShowInfo_());
+            ShowInfo_(Global().Boardcast());
             Global().Boardcast() << At(cur_pid()) << "没有可取出的棋子，于是，输掉了比赛";
             scores_[1 - cur_pid()] = 1;
         } else {
-            Global().Boardcast() << Markdown(ShowInfo_());
+            ShowInfo_(Global().Boardcast());
             Global().ClearReady(cur_pid());
             Global().StartTimer(GAME_OPTION(局时));
             Global().Boardcast() << "请" << At(cur_pid()) << "行动，" << GAME_OPTION(局时)
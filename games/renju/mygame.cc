@@ -82,7 +82,7 @@ class MainStage : public MainGameStage<>
             Global().Boardcast() << "[注意] 本局和棋时 pass 次数较多的玩家取得胜利\n\n但是因为首回合 pass 不计 pass 次数，所以第一手还请正常落子";
         }
         Global().StartTimer(GAME_OPTION(时限));
-        Global().Boardcast() << Markdown(HtmlHead_() + board_.ToHtml());
+        Global().Boardcast() << LazyMarkdown{[&] { return HtmlHead_() + board_.ToHtml(); }};
         Global().Boardcast() << "请私信裁判落子位置";
     }
 
@@ -90,8 +90,8 @@ class MainStage : public MainGameStage<>
     {
         uint32_t x, y;
         do {
-            x = rand() % Board::k_size_;
-            y = rand() % Board::k_size_;
+            x = Global().Rand() % Board::k_size_;
+            y = Global().Rand() % Board::k_size_;
         } while (!board_.CanBeSet(x, y));
         player_pos_[pid].emplace_back(x, y);
         return StageErrCode::READY;
@@ -133,7 +133,7 @@ class BuyStage : public SubGameStage<>
 
     void NewCard()
     {
-        buy_list = Main().pasture.ShuffleN();
+        buy_list = Main().pasture.ShuffleN(Global().RandomEngine());
         markdown = "# 【" + Name() + "】<br>";
         markdown += "当前牧场：<br>";
         markdown += ToString(Main().pasture.GetAnimal()) + "<br>";
@@ -186,7 +186,7 @@ class GrazingStage : public SubGameStage<>
 
     virtual void OnStageBegin() override
     {
-        Main().pasture.Rand();
+        Main().pasture.Rand(Global().RandomEngine());
         mInfo = "当前牧场：" + ToString(Main().pasture.GetAnimal()) + "\n";
         mInfo += "抽取到了：" + ToString(Main().pasture.GetGrazing()) + "\n";
         if (Main().pasture.GetRemoveCount() > 0) {
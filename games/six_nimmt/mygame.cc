@@ -85,6 +85,13 @@ const std::vector<InitOptionsCommand> k_init_options_commands = {
 
 // ========== GAME STAGES ==========
 
+// 电脑玩家每次选牌时模拟结算的次数
+#ifdef TEST_BOT
+constexpr int k_simulation_num = 200;
+#else
+constexpr int k_simulation_num = 5000;
+#endif
+
 class RoundStage;
 
 class MainStage : public MainGameStage<RoundStage>
@@ -132,7 +139,7 @@ class MainStage : public MainGameStage<RoundStage>
             players.push_back(newPlayer);
         }
         table.Initialize(Global().ResourceDir(), Global().PlayerNum(), GAME_OPTION(手牌), GAME_OPTION(行数), GAME_OPTION(上限), GAME_OPTION(倍数));
-        table.ShuffleCards(players, GAME_OPTION(卡牌));
+        table.ShuffleCards(players, GAME_OPTION(卡牌), Global().RandomEngine());
         setter.Emplace<RoundStage>(*this, ++round_);
     }
 
@@ -149,7 +156,7 @@ class MainStage : public MainGameStage<RoundStage>
                 Global().Boardcast() << "[提示] 手牌用尽但未到达游戏结束条件，将重新洗牌继续游戏！";
                 table.tableStatus.clear();
                 table.tableStatus.resize(GAME_OPTION(行数));
-                table.ShuffleCards(players, GAME_OPTION(卡牌));
+                table.ShuffleCards(players, GAME_OPTION(卡牌), Global().RandomEngine());
             } else if (game_end) {
                 Global().Boardcast() << "[提示] 已经有玩家达到目标分数！游戏将在本轮结束时结算分数";
             }
@@ -168,7 +175,7 @@ class MainStage : public MainGameStage<RoundStage>
                 player_scores_[pid] = -players[pid].head;
             }
         }
-        Global().Boardcast() << Markdown(table.GetPlayerTable(players));
+        Global().Boardcast() << LazyMarkdown{[&] { return table.GetPlayerTable(players); }};
 
         if (count(player_scores_.begin(), player_scores_.end(), 0) > 0) {
             if (count(player_scores_.begin(), player_scores_.end(), 0) == 1 && GAME_OPTION(模式) == 0) {
@@ -227,9 +234,9 @@ class CardStage : public SubGameStage<>
     {
         if (Main().players[0].hand.size() > 1) {
             for (PlayerID pid = 0; pid < Global().PlayerNum(); ++pid) {
-                Global().Tell(pid) << Markdown(Main().table.GetHand(pid, Main().players, Main().current_players));
+                Global().Tell(pid) << LazyMarkdown{[&] { return Main().table.GetHand(pid, Main().players, Main().current_players); }};
             }
-            Global().Group() << Markdown(Main().table.GetTable(false, Main().players, Main().current_players));
+            Global().Group() << LazyMarkdown{[&] { return Main().table.GetTable(false, Main().players, Main().current_players); }};
             Global().Boardcast() << "请所有玩家私信选择本回合出牌，时限 " + to_string(GAME_OPTION(时限)) + " 秒";
             Global().StartTimer(GAME_OPTION(时限));
         } else {
@@ -283,6 +290,7 @@ class CardStage : public SubGameStage<>
         sort(Main().current_players.begin(), Main().current_players.end(), [](const Player &a, const Player &b) {
             return a.current < b.current;
         });
+        Main().table.RevealCards(Main().current_players);
     }
 
     virtual CheckoutErrCode OnStageTimeout() override
@@ -308,8 +316,7 @@ class CardStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        int rd = rand() % Main().players[pid].hand.size();
-        PlayerSelectCard(pid, Main().players[pid].hand[rd]);
+        PlayerSelectCard(pid, Main().table.ChooseCard(pid, Main().players, GAME_OPTION(模式) == 4, k_simulation_num, Global().RandomEngine()));
         return StageErrCode::READY;
     }
 };
@@ -326,7 +333,7 @@ class PlaceStage : public SubGameStage<>
 
     virtual void OnStageBegin() override
     {
-        Global().Boardcast() << Markdown(Main().table.GetTable(true, Main().players, Main().current_players));
+        Global().Boardcast() << LazyMarkdown{[&] { return Main().table.GetTable(true, Main().players, Main().current_players); }};
         PlayerID lastpid = AutoPlaceCard();
         for (int pid = 0; pid < Global().PlayerNum(); pid++) {
             if (pid != lastpid) {
@@ -334,7 +341,7 @@ class PlaceStage : public SubGameStage<>
             }
         }
         if (once_BoardCast != "") {
-            Global().Boardcast() << once_BoardCast << Markdown(Main().table.GetTable(true, Main().players, Main().current_players));
+            Global().Boardcast() << once_BoardCast << LazyMarkdown{[&] { return Main().table.GetTable(true, Main().players, Main().current_players); }};
         }
         if (lastpid != -1) {
             Global().Boardcast() << "请 [" << (lastpid + 1) << "号]" << Global().PlayerName(lastpid) << " 选择一行放置您的卡牌，时限 90 秒";
@@ -355,7 +362,7 @@ class PlaceStage : public SubGameStage<>
         }
         int gain_head = Main().table.PlaceCard(Main().players[pid], line - 1, Main().current_players);
         Global().Boardcast() << "[" << (pid + 1) << "号]" << Global().PlayerName(pid) << " 放置卡牌于第 " + to_string(line) + " 行，吃掉了该行所有的卡牌，增加了 " + to_string(gain_head) + " 个牛头。\n"
-                             << Markdown(Main().table.GetTable(true, Main().players, Main().current_players));
+                             << LazyMarkdown{[&] { return Main().table.GetTable(true, Main().players, Main().current_players); }};
         return StageErrCode::READY;
     }
 
@@ -383,12 +390,7 @@ class PlaceStage : public SubGameStage<>
         }
         PlayerID pid = Main().current_players[0].id;
         if (!Global().IsReady(pid)) {
-            int line = 0;
-            for (int i = 1; i < GAME_OPTION(行数); i++) {
-                if (Main().table.GetLineHead(i) < Main().table.GetLineHead(line)) {
-                    line = i;
-                }
-            }
+            int line = Main().table.GetMinHeadLine();
             int gain_head = Main().table.PlaceCard(Main().players[pid], line, Main().current_players);
             Global().Boardcast() << "[" << (pid + 1) << "号]" << Global().PlayerName(pid) << " 行动超时，自动放置于第 " << (line + 1) << " 行" << (gain_head ? "，增加了 " + to_string(gain_head) + " 个牛头。" : "");
             Global().Hook(pid);
@@ -397,9 +399,9 @@ class PlaceStage : public SubGameStage<>
         // 继续下一个玩家行动
         PlayerID lastpid = AutoPlaceCard();
         if (once_BoardCast != "") {
-            Global().Boardcast() << once_BoardCast << Markdown(Main().table.GetTable(true, Main().players, Main().current_players));
+            Global().Boardcast() << once_BoardCast << LazyMarkdown{[&] { return Main().table.GetTable(true, Main().players, Main().current_players); }};
         } else {
-            Global().Boardcast() << Markdown(Main().table.GetTable(true, Main().players, Main().current_players));
+            Global().Boardcast() << LazyMarkdown{[&] { return Main().table.GetTable(true, Main().players, Main().current_players); }};
         }
         if (lastpid != -1) {
             Global().ClearReady(lastpid);
@@ -431,15 +433,10 @@ class PlaceStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        int line = 0;
-        for (int i = 1; i < GAME_OPTION(行数); i++) {
-            if (Main().table.GetLineHead(i) < Main().table.GetLineHead(line)) {
-                line = i;
-            }
-        }
+        int line = Main().table.GetMinHeadLine();
         int gain_head = Main().table.PlaceCard(Main().players[pid], line, Main().current_players);
         Global().Boardcast() << "[" << (pid + 1) << "号]" << Global().PlayerName(pid) << " 放置卡牌于第 " << (line + 1) << " 行，吃掉了该行所有的卡牌，增加了 " << gain_head << " 个牛头。\n"
-                             << Markdown(Main().table.GetTable(true, Main().players, Main().current_players));
+                             << LazyMarkdown{[&] { return Main().table.GetTable(true, Main().players, Main().current_players); }};
         return StageErrCode::READY;
     }
 };
@@ -0,0 +1,4 @@
+if (WITH_TEST)
+  # The computer players simulate thousands of rounds for each card choice, so we keep an eye on the throughput.
+  add_test(NAME benchmark_game_six_nimmt COMMAND run_game_six_nimmt --resource_dir "${GAME_RESOURCE_PATH}" --repeat=100 --benchmark)
+endif()
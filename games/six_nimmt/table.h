@@ -1,4 +1,6 @@
 
+#include <array>
+#include <algorithm>
 #include <random>
 
 class Player
@@ -28,6 +30,76 @@ public:
 	
 };
 
+// 牌阵行数的最大值（见 options.h）
+constexpr int k_max_line_num = 8;
+// 卡牌数字的最大值（见 options.h）
+constexpr int k_max_card = 999;
+// 玩家数量的最大值
+constexpr int k_max_player_num = 10;
+
+// 牌阵结算器：仅记录每行的末尾卡牌、卡牌数与牛头数，复制与结算均不分配内存，供放置阶段与电脑玩家的模拟共用
+class LineResolver
+{
+public:
+    struct Line {
+        int last = 0;   // 末尾卡牌
+        int count = 0;  // 卡牌数
+        int head = 0;   // 牛头数
+    };
+
+    LineResolver(const int lines, const int limit) : lineNum(lines), lineLimit(limit) {}
+
+    void SetLine(const int line, const Line& status) { lines[line] = status; }
+
+    const Line& GetLine(const int line) const { return lines[line]; }
+
+    // 自动放置的行（末尾卡牌小于该卡牌的行中末尾卡牌最大的一行），-1 表示需要玩家选择吃掉的行
+    int FindLine(const int card) const
+    {
+        int maxIndex = -1;
+        for (int i = 0; i < lineNum; i++) {
+            if (card > lines[i].last && (maxIndex == -1 || lines[i].last > lines[maxIndex].last)) {
+                maxIndex = i;
+            }
+        }
+        return maxIndex;
+    }
+
+    // 牛头数最少的行（相同时取靠前的行）
+    int MinHeadLine() const
+    {
+        int line = 0;
+        for (int i = 1; i < lineNum; i++) {
+            if (lines[i].head < lines[line].head) {
+                line = i;
+            }
+        }
+        return line;
+    }
+
+    // 放置卡牌，返回获得的牛头数
+    int Place(const int card, const int cardHead, const int line)
+    {
+        Line& status = lines[line];
+        // 放置成功
+        if (card > status.last && status.count + 1 < lineLimit) {
+            status.last = card;
+            status.count++;
+            status.head += cardHead;
+            return 0;
+        }
+        // 放置失败
+        const int gain_head = status.head;
+        status = Line{card, 1, cardHead};
+        return gain_head;
+    }
+
+private:
+    int lineNum;
+    int lineLimit;
+    array<Line, k_max_line_num> lines;
+};
+
 class Table
 {
 public:
@@ -49,6 +121,12 @@ public:
 
     // 牌阵数据
     vector<vector<int>> tableStatus;
+    // 牌库卡牌总数
+    int totalCards;
+    // 每张卡牌的牛头数
+    vector<int> cardHeads;
+    // 本轮洗牌后已公开的卡牌（牌阵中与已打出的卡牌）
+    vector<bool> revealed;
     
 
     // 初始化游戏
@@ -72,17 +150,25 @@ public:
                 return a.head > b.head;
             }
         });
+        cardHeads.resize(k_max_card + 1);
+        for (int num = 1; num <= k_max_card; num++) {
+            cardHeads[num] = 1;
+            for (int i = 0; i < 5; i++) {
+                if (num % headMultiple[i].multiple == 0) {
+                    cardHeads[num] = headMultiple[i].head;
+                    break;
+                }
+            }
+        }
     }
 
     // 开局发牌
-    void ShuffleCards(vector<Player>& players, const int TotalCards)
+    void ShuffleCards(vector<Player>& players, const int TotalCards, mt19937& g)
     {
         vector<int> deck(TotalCards);
         for (int i = 0; i < TotalCards; i++) {
             deck[i] = i + 1;
         }
-        random_device rd;
-        mt19937 g(rd());
         shuffle(deck.begin(), deck.end(), g);
         int cardIndex = 0;
         for (int pid = 0; pid < playerNum; pid++) {
@@ -99,6 +185,83 @@ public:
         for (int i = 0; i < lineNum; i++) {
             tableStatus[i].push_back(tmp[i]);
         }
+        totalCards = TotalCards;
+        revealed.assign(TotalCards + 1, false);
+        for (const int card : tmp) {
+            revealed[card] = true;
+        }
+    }
+
+    // 公开本回合打出的卡牌
+    void RevealCards(const vector<Player>& current_players)
+    {
+        for (const Player& player : current_players) {
+            revealed[player.current] = true;
+        }
+    }
+
+    // 当前牌阵的结算器
+    LineResolver GetResolver() const
+    {
+        LineResolver resolver(lineNum, lineLimit);
+        for (int i = 0; i < lineNum; i++) {
+            resolver.SetLine(i, LineResolver::Line{tableStatus[i].back(), static_cast<int>(tableStatus[i].size()), GetLineHead(i)});
+        }
+        return resolver;
+    }
+
+    // 电脑玩家选牌：从未公开的卡牌中抽样其他玩家的出牌，模拟本回合的结算，选择期望牛头最少（大胃王模式下最多）的手牌
+    int ChooseCard(const PlayerID pid, const vector<Player>& players, const bool moreHeadBetter, const int simulationNum, mt19937& g) const
+    {
+        const vector<int>& hand = players[pid].hand;
+        vector<int> unseen;
+        for (int card = 1; card <= totalCards; card++) {
+            if (!revealed[card] && find(hand.begin(), hand.end(), card) == hand.end()) {
+                unseen.push_back(card);
+            }
+        }
+        const int otherNum = min<int>(playerNum - 1, unseen.size());
+        const LineResolver resolver = GetResolver();
+        vector<long long> heads(hand.size(), 0);
+        array<int, k_max_player_num> others;
+        for (int s = 0; s < simulationNum; s++) {
+            // 部分洗牌抽取其他玩家的出牌，等价于先抽样其他玩家的手牌再从中随机出牌
+            for (int i = 0; i < otherNum; i++) {
+                swap(unseen[i], unseen[uniform_int_distribution<int>(i, unseen.size() - 1)(g)]);
+                others[i] = unseen[i];
+            }
+            sort(others.begin(), others.begin() + otherNum);
+            // 所有候选手牌使用相同的抽样，以减小比较时的方差
+            for (int i = 0; i < hand.size(); i++) {
+                heads[i] += SimulateRound(resolver, others.data(), otherNum, hand[i]);
+            }
+        }
+        int best = 0;
+        for (int i = 1; i < hand.size(); i++) {
+            if (moreHeadBetter ? heads[i] > heads[best] : heads[i] < heads[best]) {
+                best = i;
+            }
+        }
+        return hand[best];
+    }
+
+    // 模拟一回合的结算，返回打出 card 的玩家获得的牛头数。需要选择吃掉的行时，均假设选择牛头最少的行
+    int SimulateRound(LineResolver resolver, const int* others, const int otherNum, const int card) const
+    {
+        for (int i = 0; i <= otherNum; i++) {
+            // 其他玩家的卡牌已经升序排列，只需要结算到 card 为止
+            const bool is_self = i == otherNum || others[i] > card;
+            const int current = is_self ? card : others[i];
+            int line = resolver.FindLine(current);
+            if (line == -1) {
+                line = resolver.MinHeadLine();
+            }
+            const int gain_head = resolver.Place(current, cardHeads[current], line);
+            if (is_self) {
+                return gain_head;
+            }
+        }
+        return 0;
     }
 
     // 获取公屏赛况
@@ -179,41 +342,22 @@ public:
     }
 
     // 检测玩家是否需要手动操作
-    int CheckPlayerNeedPlace(const PlayerID pid, const vector<Player> players) const
+    int CheckPlayerNeedPlace(const PlayerID pid, const vector<Player>& players) const
     {
-        int card = players[pid].current;
-        int maxIndex = 0;
-        bool automatic = false;
-        for (int i = 0; i < lineNum; i++) {
-            if (card > tableStatus[i][tableStatus[i].size() - 1]) {
-                if (!automatic) {
-                    automatic = true;
-                    maxIndex = i;
-                    continue;
-                }
-                if (tableStatus[i][tableStatus[i].size() - 1] > tableStatus[maxIndex][tableStatus[maxIndex].size() - 1]) {
-                    maxIndex = i;
-                }
-            }
-        }
-        if (!automatic) return -1;
-        else return maxIndex;
+        return GetResolver().FindLine(players[pid].current);
     }
 
     // 玩家放置卡牌
     int PlaceCard(Player &player, const int line, vector<Player> &current_players)
     {
         int card = player.current;
-        int current_place = tableStatus[line].size() - 1;
         current_players.erase(current_players.begin());
-        // 放置成功
-        if (card > tableStatus[line][current_place] && current_place + 2 < lineLimit) {
-            tableStatus[line].push_back(card);
-            return 0;
+        LineResolver resolver = GetResolver();
+        int gain_head = resolver.Place(card, cardHeads[card], line);
+        // 放置失败，吃掉该行
+        if (resolver.GetLine(line).count == 1) {
+            tableStatus[line].clear();
         }
-        // 放置失败
-        int gain_head = GetLineHead(line);
-        tableStatus[line].clear();
         tableStatus[line].push_back(card);
         player.head += gain_head;
         return gain_head;
@@ -223,16 +367,13 @@ public:
     {
         int gain_head = 0;
         for (int i = 0; i < tableStatus[line].size(); i++) {
-            if (tableStatus[line][i] % headMultiple[0].multiple == 0) gain_head += headMultiple[0].head;
-            else if (tableStatus[line][i] % headMultiple[1].multiple == 0) gain_head += headMultiple[1].head;
-            else if (tableStatus[line][i] % headMultiple[2].multiple == 0) gain_head += headMultiple[2].head;
-            else if (tableStatus[line][i] % headMultiple[3].multiple == 0) gain_head += headMultiple[3].head;
-            else if (tableStatus[line][i] % headMultiple[4].multiple == 0) gain_head += headMultiple[4].head;
-            else gain_head += 1;
+            gain_head += cardHeads[tableStatus[line][i]];
         }
         return gain_head;
     }
 
+    int GetMinHeadLine() const { return GetResolver().MinHeadLine(); }
+
     bool CheckPlayerHead(const int num, const vector<Player> players) const
     {
         for (int pid = 0; pid < playerNum; pid++) {
@@ -246,12 +387,7 @@ public:
     // 生成卡牌
     string Card(const int num) const
     {
-        if (num % headMultiple[0].multiple == 0) return HeadToImage(headMultiple[0].head, num);
-        else if (num % headMultiple[1].multiple == 0) return HeadToImage(headMultiple[1].head, num);
-        else if (num % headMultiple[2].multiple == 0) return HeadToImage(headMultiple[2].head, num);
-        else if (num % headMultiple[3].multiple == 0) return HeadToImage(headMultiple[3].head, num);
-        else if (num % headMultiple[4].multiple == 0) return HeadToImage(headMultiple[4].head, num);
-        else return HeadToImage(1, num);
+        return HeadToImage(cardHeads[num], num);
     }
 
     string HeadToImage(const int headNum, const int num) const
@@ -116,7 +116,8 @@ class MainStage : public MainGameStage<TableStage>
 #else
         sync_mahjong_option_.tiles_option_.
 #endif
-        seed_ = GAME_OPTION(种子).empty() ? "" : GAME_OPTION(种子) + std::to_string(sync_mahjong_option_.benchang_);
+        seed_ = GAME_OPTION(种子).empty() ? std::to_string(Global().RandomEngine()()) :
+                GAME_OPTION(种子) + std::to_string(sync_mahjong_option_.benchang_);
     }
 
     game_util::mahjong::SyncMahjongOption sync_mahjong_option_;
@@ -250,7 +251,7 @@ class TableStage : public SubGameStage<>
             }
             Global().ClearReady(player.PlayerID());
             auto sender = Global().Tell(player.PlayerID());
-            sender << Markdown(PlayerHtml_(player), k_image_width);
+            sender << LazyMarkdown{[&] { return PlayerHtml_(player); }, k_image_width};
             if (player.State() == game_util::mahjong::ActionState::AFTER_GET_TILE) {
                 sender << "\n自动为您摸了一张牌\n";
             }
@@ -261,7 +262,7 @@ class TableStage : public SubGameStage<>
 
     void TellAllPlayersHtml_() {
         for (const auto& player : table_.Players()) {
-            Global().Tell(player.PlayerID()) << Markdown(PlayerHtml_(player), k_image_width);
+            Global().Tell(player.PlayerID()) << LazyMarkdown{[&] { return PlayerHtml_(player); }, k_image_width};
         }
     }
 
@@ -352,7 +353,8 @@ class TableStage : public SubGameStage<>
         const char* message = nullptr;
         switch (result) {
             case game_util::mahjong::SyncMajong::RoundOverResult::NORMAL_ROUND:
-                Global().Group() << "本巡结果如图所示，请各玩家进行下一巡的行动\n" << Markdown(BoardcastHtml_(), k_image_width);
+                Global().Group() << "本巡结果如图所示，请各玩家进行下一巡的行动\n" <<
+                    LazyMarkdown{[&] { return BoardcastHtml_(); }, k_image_width};
             case game_util::mahjong::SyncMajong::RoundOverResult::RON_ROUND:
                 AllowPlayersToAct_();
                 return false;
@@ -380,9 +382,10 @@ class TableStage : public SubGameStage<>
         if (GAME_OPTION(种子).empty()) {
             std::ranges::for_each(table_.Players(), [this, result](const auto& player) { Achieve_(player, result); });
         }
-        Global().Group() << message << "\n" << Markdown(BoardcastHtml_(), k_image_width);
+        Global().Group() << message << "\n" << LazyMarkdown{[&] { return BoardcastHtml_(); }, k_image_width};
         for (const auto& player : table_.Players()) {
-            Global().Tell(player.PlayerID()) << message << "\n" << Markdown(PlayerHtml_(player), k_image_width);
+            Global().Tell(player.PlayerID()) << message << "\n" <<
+                LazyMarkdown{[&] { return PlayerHtml_(player); }, k_image_width};
         }
         return true;
     }
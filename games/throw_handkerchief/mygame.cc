@@ -143,13 +143,13 @@ class MainStage : public MainGameStage<>
     virtual void OnStageBegin() override
     {
 #ifndef TEST_BOT
-        lookback_player = rand() % 2;
+        lookback_player = Global().Rand() % 2;
 #endif
         player_time_[lookback_player] = GAME_OPTION(生命);
         player_time_[1 - lookback_player] = GAME_OPTION(生命) - 15;
         player_select_[0] = player_select_[1] = 61;
 
-        Global().Boardcast() << Markdown(GetTable());
+        Global().Boardcast() << LazyMarkdown{[&] { return GetTable(); }};
         if (GAME_OPTION(模式) != 2) {
             Global().Boardcast() << "第 " << round_ << " 回合开始\n"
                                  << At(PlayerID(1 - lookback_player)) << " 选择时机丢出手帕\n"
@@ -325,7 +325,7 @@ class MainStage : public MainGameStage<>
             game_end = true;
             Global().Boardcast() << At(PlayerID(lookback_player)) << " 剩余时间归零，" << At(PlayerID(1 - lookback_player)) << " 获得胜利！";
         }
-        Global().Boardcast() << Markdown(GetTable());
+        Global().Boardcast() << LazyMarkdown{[&] { return GetTable(); }};
         if (game_end) {
             return StageErrCode::CHECKOUT;
         }
@@ -361,12 +361,12 @@ class MainStage : public MainGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        player_select_[pid] = rand() % 61;
-        if (rand() % 5 == 0) {
+        player_select_[pid] = Global().Rand() % 61;
+        if (Global().Rand() % 5 == 0) {
             if (pid == lookback_player) {
-                player_select_[pid] = rand() % 3 + 58;
+                player_select_[pid] = Global().Rand() % 3 + 58;
             } else {
-                player_select_[pid] = rand() % 3;
+                player_select_[pid] = Global().Rand() % 3;
             }
         }
         return StageErrCode::READY;
@@ -198,7 +198,7 @@ class RoundStage : public SubGameStage<>
         if (Global().IsReady(pid)) {
             return StageErrCode::OK;
         }
-        int rd = rand() % Main().player_leftnum_[pid].size();
+        int rd = Global().Rand() % Main().player_leftnum_[pid].size();
         PlayerSelectNum(pid, Main().player_leftnum_[pid][rd]);
         return StageErrCode::READY;
     }
@@ -343,7 +343,6 @@ string MainStage::GetScoreBoard() {
 
 void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 {
-    srand((unsigned int)time(NULL));
     player_leftnum_.resize(Global().PlayerNum());
 
     for (int i = 0; i < Global().PlayerNum(); i++) {
@@ -358,9 +357,7 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
         X.push_back(i);
     }
 
-    random_device rd;
-    mt19937 g(rd());
-    shuffle(X.begin(), X.end(), g);
+    shuffle(X.begin(), X.end(), Global().RandomEngine());
 
     T_Board += "<table><tr>";
     for (int i = 0; i < Global().PlayerNum(); i++) {
@@ -367,7 +367,7 @@ class RoundStage : public SubGameStage<>
 
     virtual void OnStageBegin() override
     {
-		Global().Boardcast() << Markdown(Main().board.GetUI());
+		Global().Boardcast() << LazyMarkdown{[&] { return Main().board.GetUI(); }};
 		Global().SetReady(!Main().currentPlayer);
         Global().StartTimer(GAME_OPTION(时限));
         
@@ -435,8 +435,7 @@ class RoundStage : public SubGameStage<>
 void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 {
 	// 随机生成先后手 
-	srand((unsigned int)time(NULL));
-	currentPlayer = rand() % 2;
+	currentPlayer = Global().Rand() % 2;
 	Global().Boardcast() << "先手（黑棋）：" << At(PlayerID(currentPlayer));
 	
 	// 设置读取棋盘大小 
@@ -452,7 +451,7 @@ void MainStage::NextStageFsm(RoundStage& sub_stage, const CheckoutReason reason,
 	// 有人退出，强制结束 
 	if (stop == 1)
 	{
-		Global().Boardcast() << Markdown(board.GetUI());
+		Global().Boardcast() << LazyMarkdown{[&] { return board.GetUI(); }};
 		return;
 	}
 	// 棋盘已满 
@@ -472,7 +471,7 @@ void MainStage::NextStageFsm(RoundStage& sub_stage, const CheckoutReason reason,
 		}
 		player_scores_[0] = score1;
 		player_scores_[1] = score2;
-		Global().Boardcast() << Markdown(board.GetUI());
+		Global().Boardcast() << LazyMarkdown{[&] { return board.GetUI(); }};
 		return;
 	}
 	// 交换玩家 
@@ -696,7 +696,6 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 
 
     // 2. Choose random words for players
-    srand((unsigned int)time(NULL));
     int fin = 1;
     while(fin != 0 && fin < 100)
     {
@@ -711,7 +710,7 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
 
         if(wordLength == 0)
         {
-            int r = rand() % 100 + 1;
+            int r = Global().Rand() % 100 + 1;
             if(hard == 2 || mode == 2)
             {
                 if(r <= -1);
@@ -746,7 +745,7 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
         if(wordList[l].size()==0)
             continue;
 
-        r1=rand()%wordList[l].size();
+        r1=Global().Rand()%wordList[l].size();
 
         // random select a word or player 0
         for(auto v:wordList[l])
@@ -777,7 +776,7 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
         }
 
         // find a correct s2 for s1
-        r2 = rand()%n2;
+        r2 = Global().Rand()%n2;
         r2++;
         for(auto v:wordList[l])
         {
@@ -793,7 +792,7 @@ void MainStage::FirstStageFsm(SubStageFsmSetter setter)
             }
         }
 
-        if(rand() % 2 == 0)
+        if(Global().Rand() % 2 == 0)
         {
             string temp;
             temp = s1;
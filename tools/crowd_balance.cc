@@ -0,0 +1,229 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+//
+// Simulates rounds of every question of the game crowd to find unbalanced questions.
+//
+// For each question, player number and crowd strategy, all players but the first one choose options by the crowd
+// strategy. The score variance is measured when the first player follows the crowd as well, and the average score of
+// each option is measured when the first player always chooses that option. An option is dominant if its average score
+// exceeds the ones of all other options by `dominance_margin`.
+
+#include <gflags/gflags.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "utility/thread_pool.h"
+#include "games/crowd/equilibrium.h"
+
+DEFINE_uint64(rounds, 100000, "The number of simulated rounds for each question, player number and crowd strategy");
+DEFINE_string(player_nums, "4,6,9,14,20", "The player numbers to simulate, separated by commas");
+DEFINE_uint32(threads, 0, "The number of threads, 0 indicates the number of cores");
+DEFINE_bool(with_test_questions, false, "Whether to simulate the test questions");
+DEFINE_uint32(max_initial_score, 20, "Players start with random integer scores between 0 and this value");
+DEFINE_uint64(scenario_rounds, 1000, "The number of rounds sharing the same initial scores");
+DEFINE_uint32(equilibrium_iterations, 3000, "The number of iterations to solve the equilibrium of each question");
+DEFINE_double(dominance_margin, 1.0, "The minimal score advantage of a dominant option");
+DEFINE_uint64(seed, 0, "The seed of random numbers");
+
+enum class CrowdStrategy { EXPECTS, UNIFORM, EQUILIBRIUM };
+
+static const char* StrategyName(const CrowdStrategy strategy)
+{
+    switch (strategy) {
+    case CrowdStrategy::EXPECTS: return "expects";
+    case CrowdStrategy::UNIFORM: return "uniform";
+    case CrowdStrategy::EQUILIBRIUM: return "equilibrium";
+    }
+    return "unknown";
+}
+
+struct SimulateResult
+{
+    int id_ = 0;
+    std::string title_;
+    uint32_t player_num_ = 0;
+    CrowdStrategy strategy_ = CrowdStrategy::EXPECTS;
+    double mean_ = 0; // the average score of players following the crowd
+    double stddev_ = 0;
+    std::vector<double> option_means_; // the average score of the first player choosing each option
+};
+
+class Simulator
+{
+  public:
+    Simulator(const uint32_t question_index, const uint32_t player_num, const CrowdStrategy strategy, const uint32_t seed)
+        : question_index_(question_index), player_num_(player_num), strategy_(strategy), engine_(seed),
+          selects_(player_num)
+    {
+    }
+
+    SimulateResult Run(const uint64_t rounds)
+    {
+        SimulateResult result{.player_num_ = player_num_, .strategy_ = strategy_};
+        double sum = 0;
+        double square_sum = 0;
+        uint64_t sample_count = 0;
+        std::vector<double> option_sums;
+        for (uint64_t round = 0; round < rounds; ++round) {
+            if (round % std::max<uint64_t>(FLAGS_scenario_rounds, 1) == 0) {
+                NewScenario_();
+                result.id_ = evaluator_->GetQuestion().id;
+                result.title_ = evaluator_->GetQuestion().title;
+                option_sums.resize(evaluator_->OptionNum(), 0);
+            }
+            for (auto& select : selects_) {
+                select = crowd_distribution_(engine_);
+            }
+            for (const double score : evaluator_->Evaluate(selects_)) {
+                sum += score;
+                square_sum += score * score;
+            }
+            sample_count += player_num_;
+            for (size_t option = 0; option < option_sums.size(); ++option) {
+                selects_[0] = option;
+                option_sums[option] += evaluator_->Evaluate(selects_)[0];
+            }
+        }
+        if (sample_count > 0) {
+            result.mean_ = sum / sample_count;
+            result.stddev_ = std::sqrt(std::max(0.0, square_sum / sample_count - result.mean_ * result.mean_));
+        }
+        for (const double option_sum : option_sums) {
+            result.option_means_.emplace_back(option_sum / std::max<uint64_t>(rounds, 1));
+        }
+        return result;
+    }
+
+  private:
+    // Questions may depend on the scores of players when they are initialized, so we create the question again for the
+    // new initial scores.
+    void NewScenario_()
+    {
+        std::uniform_int_distribution<uint32_t> score_distribution(0, FLAGS_max_initial_score);
+        std::vector<Player> players(player_num_);
+        for (auto& player : players) {
+            player.score = player.lastScore = player.realLastScore = score_distribution(engine_);
+        }
+        evaluator_.emplace(question_index_, players);
+        const auto& question = evaluator_->GetQuestion();
+        std::vector<double> weights(evaluator_->OptionNum(), 0);
+        if (strategy_ == CrowdStrategy::EXPECTS) {
+            // The same as the old computer player of the game, which chooses 'A' if there are no valid expects.
+            if (!question.expects.empty()) {
+                for (const char c : question.expects[0]) {
+                    if (const int option = std::tolower(c) - 'a'; option >= 0 && option < weights.size()) {
+                        ++weights[option];
+                    }
+                }
+            }
+            if (std::ranges::all_of(weights, [](const double weight) { return weight == 0; })) {
+                weights[0] = 1;
+            }
+        } else if (strategy_ == CrowdStrategy::UNIFORM) {
+            std::ranges::fill(weights, 1);
+        } else {
+            weights = SolveEquilibrium(*evaluator_, FLAGS_equilibrium_iterations, engine_);
+        }
+        crowd_distribution_ = std::discrete_distribution<int>(weights.begin(), weights.end());
+    }
+
+    const uint32_t question_index_;
+    const uint32_t player_num_;
+    const CrowdStrategy strategy_;
+    std::mt19937 engine_;
+    std::optional<QuestionEvaluator> evaluator_;
+    std::discrete_distribution<int> crowd_distribution_;
+    std::vector<int> selects_;
+};
+
+static std::vector<uint32_t> ParsePlayerNums(const std::string& s)
+{
+    std::vector<uint32_t> player_nums;
+    std::stringstream ss(s);
+    for (std::string item; std::getline(ss, item, ',');) {
+        const uint32_t player_num = std::stoul(item);
+        if (player_num < 4) {
+            throw std::invalid_argument("the game requires at least 4 players");
+        }
+        player_nums.emplace_back(player_num);
+    }
+    return player_nums;
+}
+
+static void PrintResult(const SimulateResult& result)
+{
+    std::vector<size_t> options(result.option_means_.size());
+    std::iota(options.begin(), options.end(), 0);
+    std::ranges::sort(options, [&](const size_t a, const size_t b) { return result.option_means_[a] > result.option_means_[b]; });
+    const bool is_dominant = options.size() == 1 ||
+        (options.size() > 1 && result.option_means_[options[0]] - result.option_means_[options[1]] >= FLAGS_dominance_margin);
+    std::cout << result.id_ << '\t' << result.title_ << '\t' << result.player_num_ << '\t' << StrategyName(result.strategy_)
+              << '\t' << result.mean_ << '\t' << result.stddev_ << '\t';
+    if (!options.empty()) {
+        std::cout << static_cast<char>('A' + options[0]) << (is_dominant ? "*" : "");
+    }
+    std::cout << '\t';
+    for (size_t option = 0; option < result.option_means_.size(); ++option) {
+        std::cout << (option == 0 ? "" : " ") << static_cast<char>('A' + option) << ':' << result.option_means_[option];
+    }
+    std::cout << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    std::vector<uint32_t> player_nums;
+    try {
+        player_nums = ParsePlayerNums(FLAGS_player_nums);
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] Invalid player_nums '" << FLAGS_player_nums << "': " << e.what() << std::endl;
+        return 1;
+    }
+    const uint32_t question_num = FLAGS_with_test_questions ? all_question_num : k_question_num;
+    const CrowdStrategy strategies[] = {CrowdStrategy::EXPECTS, CrowdStrategy::UNIFORM, CrowdStrategy::EQUILIBRIUM};
+
+    std::vector<SimulateResult> results(question_num * player_nums.size() * std::size(strategies));
+    std::atomic<uint64_t> simulated_count{0};
+    const auto begin = std::chrono::steady_clock::now();
+    {
+        ThreadPool thread_pool(FLAGS_threads ? FLAGS_threads : std::max(std::thread::hardware_concurrency(), 1U));
+        for (size_t i = 0; i < results.size(); ++i) {
+            thread_pool.Submit([&, i]
+                    {
+                        const uint32_t question_index = i / (player_nums.size() * std::size(strategies));
+                        const uint32_t player_num = player_nums[i / std::size(strategies) % player_nums.size()];
+                        Simulator simulator(question_index, player_num, strategies[i % std::size(strategies)],
+                                FLAGS_seed + i);
+                        results[i] = simulator.Run(FLAGS_rounds);
+                        if (const uint64_t count = ++simulated_count; count % 100 == 0) {
+                            std::cerr << "[LOG] Simulated " << count << "/" << results.size() << std::endl;
+                        }
+                    });
+        }
+    }
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "id\ttitle\tplayers\tcrowd\tmean\tstddev\tbest\toption_means" << std::endl;
+    for (const auto& result : results) {
+        PrintResult(result);
+    }
+    std::cerr << "[LOG] Simulated " << results.size() * FLAGS_rounds << " rounds in " << seconds << " seconds"
+              << std::endl;
+    return 0;
+}
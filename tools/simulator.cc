@@ -27,6 +27,8 @@ DEFINE_string(bot_uid, "this_bot", "The UserID of bot");
 DEFINE_string(admin_uid, "admin", "The UserID of administor");
 DEFINE_string(conf_path, "", "The path of the configuration file");
 DEFINE_string(image_path, "", "The path of the directory to save images");
+DEFINE_string(journal_path, "", "The path of the directory to save match journals, which are used to recover matches");
+DEFINE_string(metrics_path, "", "The file to dump the performance metrics periodically");
 
 #ifdef WITH_SQLITE
 DEFINE_string(db_path, "simulator.db", "Name of database");
@@ -165,6 +167,8 @@ int main(int argc, char** argv)
 #endif
         .conf_path_ = FLAGS_conf_path.empty() ? nullptr : FLAGS_conf_path.c_str(),
         .image_path_ = FLAGS_image_path.empty() ? nullptr : FLAGS_image_path.c_str(),
+        .journal_path_ = FLAGS_journal_path.empty() ? nullptr : FLAGS_journal_path.c_str(),
+        .metrics_path_ = FLAGS_metrics_path.empty() ? nullptr : FLAGS_metrics_path.c_str(),
         .admins_ = FLAGS_admin_uid.c_str(),
         .callbacks_ = LGTBot_Callback{
             .get_user_name = GetUserName,
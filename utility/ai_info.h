@@ -0,0 +1,189 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "nlohmann/json.hpp"
+
+// The binary encoding of the information sent to AI players, which is much more compact than json texts. Each info is
+// encoded as a 28-byte header followed by the payload:
+//
+//   | magic "LGAI" (4) | schema version (1) | kind (1) | reserved (2) | match ID (8) | info ID (8) | payload size (4) |
+//
+// Integers are little-endian. The payload is MessagePack. For a FULL info, the payload is the info itself. For a DELTA
+// info, the payload is a JSON patch (RFC 6902) to the previous info of the same match, whose info ID is exactly one
+// less. For a MATCH_STATE info, the payload is a match event (e.g. started or finished) with info ID 0, which does not
+// take part in deltas.
+
+namespace ai_info {
+
+inline constexpr std::array<char, 4> k_magic{'L', 'G', 'A', 'I'};
+inline constexpr uint8_t k_schema_version = 1;
+inline constexpr size_t k_header_size = 28;
+
+enum class Kind : uint8_t { FULL = 0, DELTA = 1, MATCH_STATE = 2 };
+
+struct Header
+{
+    Kind kind_;
+    uint64_t match_id_;
+    uint64_t info_id_;
+    uint32_t payload_size_;
+};
+
+namespace internal {
+
+template <typename T>
+void AppendInt(std::string& buffer, const T value)
+{
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        buffer.push_back(static_cast<char>(static_cast<uint64_t>(value) >> (i * 8)));
+    }
+}
+
+template <typename T>
+T ReadInt(const char* const data)
+{
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(data[i])) << (i * 8);
+    }
+    return static_cast<T>(value);
+}
+
+// Appends the header and the payload to `buffer`.
+inline void Append(std::string& buffer, const Kind kind, const uint64_t match_id, const uint64_t info_id,
+        const nlohmann::json& payload)
+{
+    const size_t begin = buffer.size();
+    buffer.append(k_magic.data(), k_magic.size());
+    AppendInt(buffer, k_schema_version);
+    AppendInt(buffer, static_cast<uint8_t>(kind));
+    AppendInt(buffer, uint16_t{0});
+    AppendInt(buffer, match_id);
+    AppendInt(buffer, info_id);
+    AppendInt(buffer, uint32_t{0}); // filled after the payload is encoded
+    nlohmann::json::to_msgpack(payload, buffer);
+    const auto payload_size = static_cast<uint32_t>(buffer.size() - begin - k_header_size);
+    for (size_t i = 0; i < sizeof(payload_size); ++i) {
+        buffer[begin + k_header_size - sizeof(payload_size) + i] = static_cast<char>(payload_size >> (i * 8));
+    }
+}
+
+} // namespace internal
+
+// Returns std::nullopt if the data is not a complete info of the supported schema version.
+inline std::optional<Header> ParseHeader(const std::string_view data)
+{
+    if (data.size() < k_header_size || data.compare(0, k_magic.size(), k_magic.data(), k_magic.size()) != 0 ||
+            static_cast<uint8_t>(data[4]) != k_schema_version || static_cast<uint8_t>(data[5]) > 2) {
+        return std::nullopt;
+    }
+    Header header{
+        .kind_ = static_cast<Kind>(data[5]),
+        .match_id_ = internal::ReadInt<uint64_t>(data.data() + 8),
+        .info_id_ = internal::ReadInt<uint64_t>(data.data() + 16),
+        .payload_size_ = internal::ReadInt<uint32_t>(data.data() + 24),
+    };
+    if (data.size() != k_header_size + header.payload_size_) {
+        return std::nullopt;
+    }
+    return header;
+}
+
+inline std::string EncodeMatchState(const uint64_t match_id, const nlohmann::json& state)
+{
+    std::string buffer;
+    internal::Append(buffer, Kind::MATCH_STATE, match_id, 0, state);
+    return buffer;
+}
+
+// Encodes the infos of one match. An info is encoded as a delta to the previous one if it is smaller.
+class Encoder
+{
+  public:
+    // A full info is encoded at least once in every `k_full_info_interval` infos, so a client which misses some infos
+    // can catch up.
+    static constexpr uint64_t k_full_info_interval = 32;
+
+    // The returned data is valid until the next call.
+    std::string_view Encode(const uint64_t match_id, const uint64_t info_id, nlohmann::json info)
+    {
+        buffer_.clear();
+        internal::Append(buffer_, Kind::FULL, match_id, info_id, info);
+        if (last_info_.has_value() && info_id == last_info_id_ + 1 && ++delta_count_ < k_full_info_interval) {
+            delta_buffer_.clear();
+            internal::Append(delta_buffer_, Kind::DELTA, match_id, info_id, nlohmann::json::diff(*last_info_, info));
+            if (delta_buffer_.size() < buffer_.size()) {
+                buffer_.swap(delta_buffer_);
+            } else {
+                delta_count_ = 0;
+            }
+        } else {
+            delta_count_ = 0;
+        }
+        last_info_ = std::move(info);
+        last_info_id_ = info_id;
+        return buffer_;
+    }
+
+  private:
+    std::optional<nlohmann::json> last_info_;
+    uint64_t last_info_id_{0};
+    uint64_t delta_count_{0}; // the number of deltas since the last full info
+    // The buffers are reused so that they are not allocated for each info.
+    std::string buffer_;
+    std::string delta_buffer_;
+};
+
+// Decodes the infos of one match, which is used by AI clients.
+class Decoder
+{
+  public:
+    // Returns the whole info (or the match event for MATCH_STATE infos). Returns std::nullopt if the data is invalid or
+    // it is a delta whose previous info is missed.
+    std::optional<nlohmann::json> Decode(const std::string_view data)
+    {
+        const auto header = ParseHeader(data);
+        if (!header.has_value()) {
+            return std::nullopt;
+        }
+        auto payload = nlohmann::json::from_msgpack(data.substr(k_header_size), true, false);
+        if (payload.is_discarded()) {
+            return std::nullopt;
+        }
+        switch (header->kind_) {
+        case Kind::MATCH_STATE:
+            return payload;
+        case Kind::DELTA:
+            if (!last_info_.has_value() || header->info_id_ != last_info_id_ + 1) {
+                return std::nullopt;
+            }
+            try {
+                payload = last_info_->patch(payload);
+            } catch (const nlohmann::json::exception&) {
+                return std::nullopt;
+            }
+            [[fallthrough]];
+        case Kind::FULL:
+            last_info_ = payload;
+            last_info_id_ = header->info_id_;
+            return payload;
+        }
+        return std::nullopt;
+    }
+
+  private:
+    std::optional<nlohmann::json> last_info_;
+    uint64_t last_info_id_{0};
+};
+
+} // namespace ai_info
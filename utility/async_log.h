@@ -0,0 +1,216 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// A bounded queue which multiple threads push values to and pop values from without locks (Dmitry Vyukov's algorithm).
+// Each cell records the position it is ready for, so a thread only needs one CAS to claim a cell.
+template <typename T>
+class RingBuffer
+{
+  public:
+    // The capacity is rounded up to a power of 2.
+    explicit RingBuffer(const size_t capacity)
+        : mask_(std::bit_ceil(std::max<size_t>(capacity, 2)) - 1), cells_(std::make_unique<Cell[]>(mask_ + 1))
+    {
+        for (size_t i = 0; i <= mask_; ++i) {
+            cells_[i].sequence_.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    // Returns false without moving `value` if the buffer is full.
+    bool TryPush(T& value)
+    {
+        size_t pos = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t sequence = cell.sequence_.load(std::memory_order_acquire);
+            if (sequence == pos) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value_ = std::move(value);
+                    cell.sequence_.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (static_cast<std::make_signed_t<size_t>>(sequence - pos) < 0) {
+                return false; // the cell has not been popped since the last round
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Returns false if the buffer is empty.
+    bool TryPop(T& value)
+    {
+        size_t pos = head_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t sequence = cell.sequence_.load(std::memory_order_acquire);
+            if (sequence == pos + 1) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    value = std::move(cell.value_);
+                    cell.sequence_.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (static_cast<std::make_signed_t<size_t>>(sequence - (pos + 1)) < 0) {
+                return false; // the cell has not been pushed in this round
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    size_t Capacity() const { return mask_ + 1; }
+
+    // It is only a hint when other threads are pushing or popping.
+    bool Empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+  private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence_;
+        T value_;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    // Pushing and popping threads do not share cache lines.
+    alignas(64) std::atomic<size_t> head_{0};
+    alignas(64) std::atomic<size_t> tail_{0};
+};
+
+struct LogRecord
+{
+    const char* file_ = nullptr;
+    int line_ = 0;
+    int severity_ = 0;
+    std::string message_;
+    // Where and when the record is logged, which are not those of the background thread writing it.
+    std::thread::id thread_id_;
+    std::chrono::system_clock::time_point time_;
+};
+
+// Writes formatted logs to the sink in a background thread, so that threads handling requests only pay for formatting
+// and pushing the records into a ring buffer. If the ring buffer is full, the record is written synchronously instead
+// of being dropped, so such a record may be written before the ones still in the buffer.
+class AsyncLogger
+{
+  public:
+    using Sink = std::function<void(const LogRecord&)>;
+
+    static constexpr size_t k_default_capacity = 8192;
+    static constexpr std::chrono::milliseconds k_flush_interval{100};
+
+    explicit AsyncLogger(Sink sink, const size_t capacity = k_default_capacity)
+        : sink_(std::move(sink)), records_(capacity), thread_([this] { Run_(); })
+    {
+    }
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // Writes all pushed records before exiting.
+    ~AsyncLogger()
+    {
+        {
+            std::lock_guard<std::mutex> l(mutex_);
+            is_stopped_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+    void Push(LogRecord record)
+    {
+        if (!records_.TryPush(record)) {
+            std::lock_guard<std::mutex> l(sink_mutex_);
+            ++sync_write_count_;
+            sink_(record);
+            return;
+        }
+        pushed_count_.fetch_add(1, std::memory_order_release);
+        // Pairs with the fence in `Run_`, so either the background thread sees the record or we see it sleeping.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (is_sleeping_.load(std::memory_order_relaxed)) {
+            std::lock_guard<std::mutex> l(mutex_);
+            cv_.notify_one();
+        }
+    }
+
+    // Waits until the records pushed before are written (e.g., before the process aborts).
+    void Flush()
+    {
+        const uint64_t pushed_count = pushed_count_.load(std::memory_order_acquire);
+        {
+            std::lock_guard<std::mutex> l(mutex_);
+            cv_.notify_one();
+        }
+        for (uint64_t written_count = written_count_.load(std::memory_order_acquire); written_count < pushed_count;
+                written_count = written_count_.load(std::memory_order_acquire)) {
+            written_count_.wait(written_count, std::memory_order_acquire);
+        }
+    }
+
+    // The number of records written synchronously because the ring buffer is full.
+    uint64_t SyncWriteCount() const
+    {
+        std::lock_guard<std::mutex> l(sink_mutex_);
+        return sync_write_count_;
+    }
+
+  private:
+    void Run_()
+    {
+        LogRecord record;
+        while (true) {
+            uint64_t count = 0;
+            for (; records_.TryPop(record); ++count) {
+                // Lock for each record, so a thread writing synchronously does not wait for the whole batch.
+                std::lock_guard<std::mutex> l(sink_mutex_);
+                sink_(record);
+            }
+            if (count > 0) {
+                written_count_.fetch_add(count, std::memory_order_release);
+                written_count_.notify_all();
+                continue;
+            }
+            std::unique_lock<std::mutex> l(mutex_);
+            if (is_stopped_) {
+                return;
+            }
+            is_sleeping_.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (records_.Empty()) {
+                cv_.wait_for(l, k_flush_interval);
+            }
+            is_sleeping_.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    const Sink sink_;
+    RingBuffer<LogRecord> records_;
+    std::atomic<uint64_t> pushed_count_{0};
+    std::atomic<uint64_t> written_count_{0};
+    std::atomic<bool> is_sleeping_{false};
+    std::mutex mutex_; // protects `is_stopped_` and the sleeping of the background thread
+    std::condition_variable cv_;
+    bool is_stopped_{false};
+    mutable std::mutex sink_mutex_; // the sink is not required to be thread-safe
+    uint64_t sync_write_count_{0};
+    std::thread thread_; // constructed last, after the members it uses
+};
@@ -25,6 +25,45 @@ class OPTION_CLASSNAME
         MAX_OPTION
     };
 
+  private:
+    struct NameTable_
+    {
+        static constexpr uint32_t k_max_seed = 1 << 12;
+        uint32_t seed_ = 0;
+        std::array<int, std::bit_ceil(std::max<uint32_t>(Option::MAX_OPTION * 2, 1))> slots_{};
+    };
+
+    // FNV-1a mixed with the seed. The low bits of FNV-1a do not depend on the high bits of the seed, so the high bits are
+    // folded in.
+    static constexpr uint32_t HashName_(const std::string_view name, const uint32_t seed)
+    {
+        uint32_t hash = 2166136261U ^ seed;
+        for (const char c : name) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619U;
+        }
+        return hash ^ (hash >> 16);
+    }
+
+    // Tries seeds until all names are hashed into different slots.
+    static constexpr NameTable_ MakeNameTable_()
+    {
+        NameTable_ table;
+        for (; table.seed_ < NameTable_::k_max_seed; ++table.seed_) {
+            table.slots_.fill(-1);
+            bool collided = false;
+            for (int index = 0; index < Option::MAX_OPTION && !collided; ++index) {
+                int& slot = table.slots_[HashName_(k_names[index], table.seed_) % table.slots_.size()];
+                collided = slot >= 0;
+                slot = index;
+            }
+            if (!collided) {
+                break;
+            }
+        }
+        return table;
+    }
+
+  public:
     OPTION_CLASSNAME() : options_{
 #define EXTEND_OPTION(_0, _1, checker, default_value) \
         default_value, std::move(checker),
@@ -68,27 +107,37 @@ class OPTION_CLASSNAME
 
     bool SetOption(const std::string_view find_name, MsgReader& msg_reader)
     {
-        const auto reader_it = msg_reader.Iterator();
-        bool find = false;
-        Find(find_name, [&](const char* const description, const auto& checker, auto& value)
-                {
-                    msg_reader.Reset(reader_it);
-                    auto new_value = checker.Check(msg_reader);
-                    if (new_value.has_value() && !msg_reader.HasNext()) {
-                        value = *new_value;
-                        find = true;
-                    }
-                });
-        return find;
+        static constexpr std::array<bool(*)(OPTION_CLASSNAME&, MsgReader&), Option::MAX_OPTION> k_setters{
+#define EXTEND_OPTION(_0, name, _1, _2) &SetOptionAt_<OPTION_(name)>,
+#include OPTION_FILENAME
+#undef EXTEND_OPTION
+        };
+        const Option option = Name2Option(find_name);
+        return option != Option::INVALID_OPTION && k_setters[option](*this, msg_reader);
+    }
+
+    // Finds the option by a perfect hash table built at compile time, so the cost does not grow with the number of
+    // options.
+    static Option Name2Option(const std::string_view find_name)
+    {
+        static constexpr NameTable_ k_name_table = MakeNameTable_();
+        static_assert(k_name_table.seed_ != NameTable_::k_max_seed, "Cannot find a perfect hash seed for option names");
+        if constexpr (Option::MAX_OPTION == 0) {
+            return Option::INVALID_OPTION;
+        } else {
+            const int index = k_name_table.slots_[HashName_(find_name, k_name_table.seed_) % k_name_table.slots_.size()];
+            return index >= 0 && k_names[index] == find_name ? static_cast<Option>(index) : Option::INVALID_OPTION;
+        }
     }
 
     template <typename Fn>
     bool Find(const std::string_view find_name, Fn&& fn)
     {
-        // TODO: use std::map to optimize
-        return Foreach([&](const char* const description, const char* const name, const auto& checker, auto& value)
+        const Option option = Name2Option(find_name);
+        return option != Option::INVALID_OPTION &&
+            Foreach([&, index = 0](const char* const description, const char* const name, const auto& checker, auto& value) mutable
                 {
-                    if (name == find_name) {
+                    if (index++ == option) {
                         fn(description, checker, value);
                         return true; // break;
                     }
@@ -123,6 +172,12 @@ class OPTION_CLASSNAME
 
     static constexpr uint32_t Count() { return Option::MAX_OPTION; }
 
+    static constexpr std::array<std::string_view, Option::MAX_OPTION> k_names{
+#define EXTEND_OPTION(_0, name, _1, _2) #name,
+#include OPTION_FILENAME
+#undef EXTEND_OPTION
+    };
+
     std::string Info(const bool with_example, const bool with_html_syntax, const char* const prefix) const
     {
         // The reason why we do not use HTML_ESCAPE_SPACE instead of " " as space is that the `checkers.ExampleInfo()` use " " as space.
@@ -161,6 +216,17 @@ class OPTION_CLASSNAME
     }
 
   private:
+    template <Option op>
+    static bool SetOptionAt_(OPTION_CLASSNAME& options, MsgReader& msg_reader)
+    {
+        auto new_value = std::get<op * 2 + 1>(options.options_).Check(msg_reader);
+        if (!new_value.has_value() || msg_reader.HasNext()) {
+            return false;
+        }
+        std::get<op * 2>(options.options_) = std::move(*new_value);
+        return true;
+    }
+
     decltype(std::tuple{
 #define EXTEND_OPTION(_0, _1, checker, default_value) \
     static_cast<std::decay<decltype(checker)>::type::arg_type>(default_value), checker,
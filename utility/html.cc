@@ -4,6 +4,11 @@
 
 #include "html.h"
 
+#include <charconv>
+#include <iterator>
+#include <mutex>
+#include <set>
+
 namespace html {
 
 Table::Table(const uint32_t row, const uint32_t column)
@@ -15,36 +20,76 @@ Table::Table(const uint32_t row, const uint32_t column)
 {
 }
 
-std::string Table::ToString() const
+const std::string* Intern(const std::string_view str)
+{
+    if (str.empty()) {
+        return nullptr;
+    }
+    static std::mutex mutex;
+    static std::set<std::string, std::less<>> strings; // nodes of std::set are never moved
+    std::lock_guard<std::mutex> l(mutex);
+    if (const auto it = strings.find(str); it != strings.end()) {
+        return &*it;
+    }
+    return &*strings.emplace(str).first;
+}
+
+// The same `Write_` is used to compute the output size and to append the output, so the size is always exact.
+template <typename Sink>
+void Table::Write_(Sink&& sink) const
 {
-    std::string outstr = "<table " + table_style_ + " ><tbody>";
+    sink("<table ");
+    sink(table_style_);
+    sink(" ><tbody>");
     for (const auto& row : boxes_) {
-        outstr += "\n<tr>";
+        sink("\n<tr>");
         for (const auto& box : row) {
             if (box.merge_num_ == 0) {
                 continue;
             }
-            outstr += "\n<td " + (row.style_.empty() ? row_style_ : row.style_);
-            if (!box.color_.empty()) {
-                outstr += " bgcolor=\"" + box.color_ + "\"";
+            sink("\n<td ");
+            sink(row.style_.empty() ? row_style_ : row.style_);
+            if (box.color_) {
+                sink(" bgcolor=\"");
+                sink(*box.color_);
+                sink("\"");
             }
-            if (!box.style_.empty()) {
-                outstr += " " + box.style_;
+            if (box.style_) {
+                sink(" ");
+                sink(*box.style_);
             }
             if (box.merge_num_ > 1) {
-                outstr += (box.merge_direct_ == Box::MergeDirect::TO_BOTTOM ? " rowspan=\"" : " colspan=\"");
-                outstr += std::to_string(box.merge_num_) + "\"";
+                sink(box.merge_direct_ == Box::MergeDirect::TO_BOTTOM ? " rowspan=\"" : " colspan=\"");
+                char buffer[16];
+                sink(std::string_view(buffer, std::to_chars(std::begin(buffer), std::end(buffer), box.merge_num_).ptr - buffer));
+                sink("\"");
             }
-            outstr += ">\n\n";
-            outstr += box.content_;
-            outstr += "\n\n</td>";
+            sink(">\n\n");
+            sink(box.content_);
+            sink("\n\n</td>");
         }
-        outstr += "\n</tr>";
+        sink("\n</tr>");
     }
-    outstr += "\n</tbody></table>";
+    sink("\n</tbody></table>");
+}
+
+std::string Table::ToString() const
+{
+    std::string outstr;
+    AppendTo(outstr);
     return outstr;
 }
 
+void Table::AppendTo(std::string& sink) const
+{
+    size_t size = 0;
+    Write_([&size](const std::string_view str) { size += str.size(); });
+    [[maybe_unused]] const size_t expected_size = sink.size() + size;
+    sink.reserve(expected_size);
+    Write_([&sink](const std::string_view str) { sink.append(str); });
+    assert(sink.size() == expected_size);
+}
+
 void Table::MergeDown(const uint32_t row, const uint32_t column, const uint32_t num)
 {
     if (num == 1) {
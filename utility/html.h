@@ -5,6 +5,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 #include <cassert>
@@ -19,6 +20,10 @@
 
 namespace html {
 
+// Returns a string equal to `str` which lives until the process exits, or nullptr if `str` is empty. Colors and styles are
+// interned because a board usually repeats a few of them in thousands of boxes. It is thread-safe.
+const std::string* Intern(std::string_view str);
+
 class Box
 {
   public:
@@ -41,18 +46,16 @@ class Box
         return content_;
     }
 
-    template <typename String>
-    Box& SetColor(String&& str)
+    Box& SetColor(const std::string_view str)
     {
         assert(merge_num_ > 0);
-        color_ = std::forward<String>(str);
+        color_ = Intern(str);
         return *this;
     }
 
-    template <typename String>
-    Box& SetStyle(String&& str)
+    Box& SetStyle(const std::string_view str)
     {
-        style_ = std::forward<String>(str);
+        style_ = Intern(str);
         return *this;
     }
 
@@ -62,8 +65,8 @@ class Box
     uint32_t merge_num_;
     MergeDirect merge_direct_;
     std::string content_;
-    std::string color_;
-    std::string style_;
+    const std::string* color_ = nullptr; // interned, nullptr if empty
+    const std::string* style_ = nullptr; // interned, nullptr if empty
 };
 
 class Table
@@ -76,6 +79,9 @@ class Table
     uint32_t Column() const { return column_; }
     std::string ToString() const;
 
+    // Appends the same content as `ToString` to `sink` with at most one allocation.
+    void AppendTo(std::string& sink) const;
+
     void AppendRow()
     {
         boxes_.emplace_back(column_);
@@ -114,6 +120,9 @@ class Table
     void ResizeRow(const uint32_t row);
 
   private:
+    template <typename Sink>
+    void Write_(Sink&& sink) const;
+
     struct RowDesc : public std::vector<Box> {
         using std::vector<Box>::vector;
         std::string style_;
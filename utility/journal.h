@@ -0,0 +1,246 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#pragma once
+
+#include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// A journal is an append-only file of records. Each record is stored as a 4-byte length, a 4-byte CRC32 of the payload
+// and then the payload itself, so that a record torn by a crash can be detected and dropped when reading.
+
+namespace journal_internal {
+
+inline uint32_t Crc32(const std::string_view data)
+{
+    static constexpr auto k_table = []
+        {
+            std::array<uint32_t, 256> table{};
+            for (uint32_t i = 0; i < 256; ++i) {
+                uint32_t c = i;
+                for (int k = 0; k < 8; ++k) {
+                    c = (c & 1) ? 0xEDB88320U ^ (c >> 1) : c >> 1;
+                }
+                table[i] = c;
+            }
+            return table;
+        }();
+    uint32_t crc = 0xFFFFFFFFU;
+    for (const char ch : data) {
+        crc = k_table[(crc ^ static_cast<uint8_t>(ch)) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFU;
+}
+
+inline void PutUint32(char* const p, const uint32_t value)
+{
+    for (int i = 0; i < 4; ++i) {
+        p[i] = static_cast<char>((value >> (i * 8)) & 0xFF);
+    }
+}
+
+inline uint32_t GetUint32(const char* const p)
+{
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(p[i])) << (i * 8);
+    }
+    return value;
+}
+
+} // namespace journal_internal
+
+// Records are written to the file once appended, so that they survive a crash of the process. They survive a crash of
+// the machine only after `Sync` is invoked, which is usually batched by a `JournalSyncer`. `Append` should not be invoked
+// by multiple threads at the same time.
+class JournalWriter
+{
+  public:
+    static constexpr uint32_t k_header_size = 8;
+
+    // Returns nullptr if the file cannot be opened. Records are appended if the file already exists.
+    static std::shared_ptr<JournalWriter> Open(const std::string& path)
+    {
+#ifdef _WIN32
+        const int fd = _open(path.c_str(), _O_WRONLY | _O_APPEND | _O_CREAT | _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+        const int fd = open(path.c_str(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+#endif
+        if (fd < 0) {
+            return nullptr;
+        }
+        return std::shared_ptr<JournalWriter>(new JournalWriter(fd, path));
+    }
+
+    JournalWriter(const JournalWriter&) = delete;
+    JournalWriter& operator=(const JournalWriter&) = delete;
+
+    ~JournalWriter()
+    {
+        Sync();
+#ifdef _WIN32
+        _close(fd_);
+#else
+        close(fd_);
+#endif
+    }
+
+    bool Append(const std::string_view record)
+    {
+        buffer_.resize(k_header_size + record.size());
+        journal_internal::PutUint32(buffer_.data(), static_cast<uint32_t>(record.size()));
+        journal_internal::PutUint32(buffer_.data() + 4, journal_internal::Crc32(record));
+        std::memcpy(buffer_.data() + k_header_size, record.data(), record.size());
+        for (std::string_view remain = buffer_; !remain.empty(); ) {
+#ifdef _WIN32
+            const auto written = _write(fd_, remain.data(), static_cast<unsigned int>(remain.size()));
+#else
+            const auto written = write(fd_, remain.data(), remain.size());
+#endif
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            remain.remove_prefix(written);
+        }
+        dirty_ = true;
+        return true;
+    }
+
+    // Flushes the appended records to the disk. It can be invoked by another thread while appending.
+    bool Sync()
+    {
+        if (!dirty_.exchange(false)) {
+            return true;
+        }
+#ifdef _WIN32
+        return _commit(fd_) == 0;
+#elif defined(__APPLE__)
+        return fsync(fd_) == 0;
+#else
+        return fdatasync(fd_) == 0;
+#endif
+    }
+
+    const std::string& path() const { return path_; }
+
+  private:
+    JournalWriter(const int fd, std::string path) : fd_(fd), path_(std::move(path)) {}
+
+    const int fd_;
+    const std::string path_;
+    std::atomic<bool> dirty_{false};
+    std::string buffer_;
+};
+
+// Returns all the complete records of a journal file. Reading stops at the first torn or corrupted record, which can only
+// be the last record written before a crash.
+inline std::vector<std::string> ReadJournal(const std::string& path)
+{
+    std::vector<std::string> records;
+    std::ifstream f(path, std::ios::binary);
+    if (!f) {
+        return records;
+    }
+    const std::string content{std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+    for (size_t offset = 0; content.size() - offset >= JournalWriter::k_header_size; ) {
+        const uint32_t size = journal_internal::GetUint32(content.data() + offset);
+        const uint32_t crc = journal_internal::GetUint32(content.data() + offset + 4);
+        offset += JournalWriter::k_header_size;
+        if (content.size() - offset < size) {
+            break;
+        }
+        std::string_view record(content.data() + offset, size);
+        if (journal_internal::Crc32(record) != crc) {
+            break;
+        }
+        records.emplace_back(record);
+        offset += size;
+    }
+    return records;
+}
+
+// A background thread which syncs the registered journals periodically, so that the cost of flushing to the disk is
+// shared by all the records appended in an interval.
+class JournalSyncer
+{
+  public:
+    explicit JournalSyncer(std::function<std::chrono::milliseconds()> interval)
+        : interval_(std::move(interval)), thread_([this] { Run_(); })
+    {
+    }
+
+    JournalSyncer(const JournalSyncer&) = delete;
+    JournalSyncer& operator=(const JournalSyncer&) = delete;
+
+    ~JournalSyncer()
+    {
+        {
+            std::lock_guard<std::mutex> l(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    void Register(std::weak_ptr<JournalWriter> writer)
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        writers_.emplace_back(std::move(writer));
+    }
+
+  private:
+    void Run_()
+    {
+        std::unique_lock<std::mutex> l(mutex_);
+        while (!cv_.wait_for(l, interval_(), [this] { return stopped_; })) {
+            std::vector<std::shared_ptr<JournalWriter>> writers;
+            std::erase_if(writers_, [&](const std::weak_ptr<JournalWriter>& writer_wk)
+                    {
+                        auto writer = writer_wk.lock();
+                        if (!writer) {
+                            return true;
+                        }
+                        writers.emplace_back(std::move(writer));
+                        return false;
+                    });
+            l.unlock();
+            for (const auto& writer : writers) {
+                writer->Sync();
+            }
+            writers.clear(); // the writers may be released here, so we do it before locking
+            l.lock();
+        }
+    }
+
+    const std::function<std::chrono::milliseconds()> interval_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopped_{false};
+    std::vector<std::weak_ptr<JournalWriter>> writers_;
+    std::thread thread_; // must be the last member because it is started in the constructor
+};
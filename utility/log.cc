@@ -0,0 +1,44 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include "utility/log.h"
+
+#if WITH_GLOG
+
+#include <ctime>
+#include <iomanip>
+
+// It is set when the module is loaded, before any stage of the module runs.
+static AsyncLogger* g_shared_logger = nullptr;
+
+// The prefix of glog shows the time and thread of writing the record, so the ones of logging it are prefixed to the
+// message.
+static void WriteToGlog(const LogRecord& record)
+{
+    const std::time_t time = std::chrono::system_clock::to_time_t(record.time_);
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &time);
+#else
+    localtime_r(&time, &tm);
+#endif
+    const auto us =
+        std::chrono::duration_cast<std::chrono::microseconds>(record.time_.time_since_epoch()).count() % 1000000;
+    google::LogMessage(record.file_, record.line_, record.severity_).stream()
+        << '[' << std::put_time(&tm, "%m%d %H:%M:%S") << '.' << std::setw(6) << std::setfill('0') << us << ' '
+        << record.thread_id_ << "] " << record.message_;
+}
+
+AsyncLogger& GlobalAsyncLogger()
+{
+    if (g_shared_logger) {
+        return *g_shared_logger;
+    }
+    static AsyncLogger logger(&WriteToGlog);
+    return logger;
+}
+
+void ShareGlobalAsyncLogger(AsyncLogger* const logger) { g_shared_logger = logger; }
+
+#endif
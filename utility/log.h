@@ -6,6 +6,22 @@
 
 inline const char* Bool2Str(const bool ret) { return ret ? "true" : "false"; }
 
+// Logs below this level are removed at compile time: 0 for debug, 1 for info, 2 for warn and 3 for error.
+#ifndef LGTBOT_MIN_LOG_LEVEL
+#define LGTBOT_MIN_LOG_LEVEL 0
+#endif
+
+// Makes the streaming expression void, so it can be the operand of `?:` in `LAZY_LOG`.
+struct LogVoidify
+{
+    template <typename Stream>
+    void operator&(Stream&&) const {}
+};
+
+// The values streamed after it are evaluated only if logs of the level (Debug, Info, Warn, Error or Fatal) are enabled.
+// For example, `LAZY_LOG(Info, InfoLog()) << "result=" << ToString();`.
+#define LAZY_LOG(level, logger) !level##LogEnabled() ? (void)0 : LogVoidify() & (logger)
+
 #if WITH_GLOG
 
 #ifndef GLOG_NO_ABBREVIATED_SEVERITIES
@@ -13,20 +29,74 @@ inline const char* Bool2Str(const bool ret) { return ret ? "true" : "false"; }
 #endif
 #include <glog/logging.h>
 
-#define DebugLog() LOG(INFO)
-#define InfoLog() LOG(INFO)
-#define WarnLog() LOG(WARNING)
-#define ErrorLog() LOG(ERROR)
-#define FatalLog() LOG(FATAL)
+#include <chrono>
+#include <sstream>
+#include <thread>
+
+#include "utility/async_log.h"
+
+// The logger of the process, which writes records to glog.
+AsyncLogger& GlobalAsyncLogger();
+
+// A game module writes its records by the logger of the process loading it, so that the process has only one
+// background thread writing logs. It must be invoked before the module logs anything.
+void ShareGlobalAsyncLogger(AsyncLogger* logger);
+
+inline bool IsLogEnabled(const int level, const google::LogSeverity severity)
+{
+    return level >= LGTBOT_MIN_LOG_LEVEL && severity >= FLAGS_minloglevel;
+}
+
+// Formats a log and pushes it to the global async logger when destructed.
+class AsyncLogMessage
+{
+  public:
+    AsyncLogMessage(const char* const file, const int line, const google::LogSeverity severity)
+        : file_(file), line_(line), severity_(severity), time_(std::chrono::system_clock::now())
+    {
+    }
+
+    ~AsyncLogMessage()
+    {
+        GlobalAsyncLogger().Push(
+                LogRecord{file_, line_, severity_, std::move(stream_).str(), std::this_thread::get_id(), time_});
+    }
+
+    std::ostream& stream() { return stream_; }
+
+  private:
+    const char* const file_;
+    const int line_;
+    const google::LogSeverity severity_;
+    const std::chrono::system_clock::time_point time_;
+    std::ostringstream stream_;
+};
+
+#define DebugLog() AsyncLogMessage(__FILE__, __LINE__, google::GLOG_INFO).stream()
+#define InfoLog() AsyncLogMessage(__FILE__, __LINE__, google::GLOG_INFO).stream()
+#define WarnLog() AsyncLogMessage(__FILE__, __LINE__, google::GLOG_WARNING).stream()
+#define ErrorLog() AsyncLogMessage(__FILE__, __LINE__, google::GLOG_ERROR).stream()
+// The process aborts after a fatal log, so we write the pending logs before it.
+#define FatalLog() (GlobalAsyncLogger().Flush(), LOG(FATAL))
+
+#define DebugLogEnabled() IsLogEnabled(0, google::GLOG_INFO)
+#define InfoLogEnabled() IsLogEnabled(1, google::GLOG_INFO)
+#define WarnLogEnabled() IsLogEnabled(2, google::GLOG_WARNING)
+#define ErrorLogEnabled() IsLogEnabled(3, google::GLOG_ERROR)
+#define FatalLogEnabled() true
 
 #else
 
-#include <sstream>
+#include <ostream>
 
-class EmptyLogger : public std::stringstream
+// Discards everything without formatting.
+class EmptyLogger
 {
   public:
-    EmptyLogger() { setstate(std::ios_base::badbit); }
+    template <typename T>
+    EmptyLogger& operator<<(const T&) { return *this; }
+
+    EmptyLogger& operator<<(std::ostream& (*)(std::ostream&)) { return *this; } // for manipulators like `std::endl`
 };
 
 #define DebugLog EmptyLogger
@@ -35,4 +105,10 @@ class EmptyLogger : public std::stringstream
 #define ErrorLog EmptyLogger
 #define FatalLog EmptyLogger
 
+#define DebugLogEnabled() false
+#define InfoLogEnabled() false
+#define WarnLogEnabled() false
+#define ErrorLogEnabled() false
+#define FatalLogEnabled() false
+
 #endif
@@ -0,0 +1,371 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Metrics are recorded on hot paths by many threads, so each metric is split into shards and a thread only writes to its
+// own shard with relaxed atomic operations. Shards are merged when the metric is read.
+
+namespace metrics_internal {
+
+inline constexpr uint32_t k_shard_num = 16;
+
+inline uint32_t ShardIndex()
+{
+    static std::atomic<uint32_t> next_index{0};
+    thread_local const uint32_t index = next_index.fetch_add(1, std::memory_order_relaxed) % k_shard_num;
+    return index;
+}
+
+} // namespace metrics_internal
+
+class MetricCounter
+{
+  public:
+    void Add(const uint64_t value = 1)
+    {
+        shards_[metrics_internal::ShardIndex()].value_.fetch_add(value, std::memory_order_relaxed);
+    }
+
+    uint64_t Get() const
+    {
+        uint64_t sum = 0;
+        for (const auto& shard : shards_) {
+            sum += shard.value_.load(std::memory_order_relaxed);
+        }
+        return sum;
+    }
+
+    void Reset()
+    {
+        for (auto& shard : shards_) {
+            shard.value_.store(0, std::memory_order_relaxed);
+        }
+    }
+
+  private:
+    struct alignas(64) Shard
+    {
+        std::atomic<uint64_t> value_{0};
+    };
+
+    std::array<Shard, metrics_internal::k_shard_num> shards_;
+};
+
+// A histogram of latencies in nanoseconds in the way of HDR histograms: each power of two is divided into
+// `2 ^ k_sub_bucket_bits` linear buckets, so any value is kept with a relative error of at most 12.5%.
+class LatencyHistogram
+{
+  public:
+    static constexpr uint32_t k_sub_bucket_bits = 3;
+    static constexpr uint32_t k_sub_bucket_num = 1 << k_sub_bucket_bits;
+    static constexpr uint32_t k_bucket_num = (64 - k_sub_bucket_bits + 1) * k_sub_bucket_num;
+
+    struct Snapshot
+    {
+        uint64_t count_ = 0;
+        uint64_t sum_ = 0;
+        uint64_t max_ = 0;
+        std::array<uint64_t, k_bucket_num> buckets_{};
+
+        uint64_t Mean() const { return count_ == 0 ? 0 : sum_ / count_; }
+
+        // Returns the upper bound of the bucket holding the value at `percentile` (in [0, 100]).
+        uint64_t Percentile(const double percentile) const
+        {
+            if (count_ == 0) {
+                return 0;
+            }
+            const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(count_ * percentile / 100 + 0.5));
+            uint64_t accumulated = 0;
+            for (uint32_t index = 0; index < k_bucket_num; ++index) {
+                if ((accumulated += buckets_[index]) >= rank) {
+                    return std::min(max_, BucketUpperBound(index));
+                }
+            }
+            return max_;
+        }
+    };
+
+    LatencyHistogram() = default;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    ~LatencyHistogram()
+    {
+        for (auto& shard : shards_) {
+            delete shard.load(std::memory_order_relaxed);
+        }
+    }
+
+    static uint32_t BucketIndex(const uint64_t value)
+    {
+        if (value < k_sub_bucket_num) {
+            return static_cast<uint32_t>(value);
+        }
+        const uint32_t exponent = std::bit_width(value) - 1;
+        const uint32_t sub_bucket = (value >> (exponent - k_sub_bucket_bits)) & (k_sub_bucket_num - 1);
+        return ((exponent - k_sub_bucket_bits + 1) << k_sub_bucket_bits) + sub_bucket;
+    }
+
+    static uint64_t BucketUpperBound(const uint32_t index)
+    {
+        if (index < k_sub_bucket_num) {
+            return index;
+        }
+        const uint32_t exponent = (index >> k_sub_bucket_bits) + k_sub_bucket_bits - 1;
+        const uint64_t lower_bound = static_cast<uint64_t>(k_sub_bucket_num + (index & (k_sub_bucket_num - 1)))
+            << (exponent - k_sub_bucket_bits);
+        return lower_bound + (uint64_t(1) << (exponent - k_sub_bucket_bits)) - 1;
+    }
+
+    void Record(const uint64_t value)
+    {
+        Shard& shard = GetShard_();
+        shard.buckets_[BucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+        shard.sum_.fetch_add(value, std::memory_order_relaxed);
+        for (uint64_t max = shard.max_.load(std::memory_order_relaxed);
+                max < value && !shard.max_.compare_exchange_weak(max, value, std::memory_order_relaxed); )
+            ;
+    }
+
+    Snapshot GetSnapshot() const
+    {
+        Snapshot snapshot;
+        for (const auto& shard_atomic : shards_) {
+            const Shard* const shard = shard_atomic.load(std::memory_order_acquire);
+            if (!shard) {
+                continue;
+            }
+            for (uint32_t index = 0; index < k_bucket_num; ++index) {
+                const uint64_t count = shard->buckets_[index].load(std::memory_order_relaxed);
+                snapshot.buckets_[index] += count;
+                snapshot.count_ += count;
+            }
+            snapshot.sum_ += shard->sum_.load(std::memory_order_relaxed);
+            snapshot.max_ = std::max(snapshot.max_, shard->max_.load(std::memory_order_relaxed));
+        }
+        return snapshot;
+    }
+
+    void Reset()
+    {
+        for (auto& shard_atomic : shards_) {
+            if (Shard* const shard = shard_atomic.load(std::memory_order_acquire)) {
+                for (auto& bucket : shard->buckets_) {
+                    bucket.store(0, std::memory_order_relaxed);
+                }
+                shard->sum_.store(0, std::memory_order_relaxed);
+                shard->max_.store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+  private:
+    struct Shard
+    {
+        std::array<std::atomic<uint64_t>, k_bucket_num> buckets_{};
+        std::atomic<uint64_t> sum_{0};
+        std::atomic<uint64_t> max_{0};
+    };
+
+    // Shards are allocated when they are used at the first time because most histograms are only recorded by a few
+    // threads.
+    Shard& GetShard_()
+    {
+        auto& shard_atomic = shards_[metrics_internal::ShardIndex()];
+        if (Shard* const shard = shard_atomic.load(std::memory_order_acquire)) {
+            return *shard;
+        }
+        auto new_shard = std::make_unique<Shard>();
+        Shard* expected = nullptr;
+        if (shard_atomic.compare_exchange_strong(expected, new_shard.get(), std::memory_order_acq_rel)) {
+            return *new_shard.release();
+        }
+        return *expected; // another thread with the same shard index has allocated it
+    }
+
+    std::array<std::atomic<Shard*>, metrics_internal::k_shard_num> shards_{};
+};
+
+// Records the time from its construction to its destruction.
+class ScopedLatency
+{
+  public:
+    explicit ScopedLatency(LatencyHistogram& histogram)
+        : histogram_(histogram), begin_time_(std::chrono::steady_clock::now())
+    {
+    }
+
+    ScopedLatency(const ScopedLatency&) = delete;
+    ScopedLatency& operator=(const ScopedLatency&) = delete;
+
+    ~ScopedLatency()
+    {
+        histogram_.Record(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - begin_time_).count());
+    }
+
+  private:
+    LatencyHistogram& histogram_;
+    const std::chrono::steady_clock::time_point begin_time_;
+};
+
+// Metrics are never removed once created, so the returned references can be kept to avoid looking up on hot paths.
+class MetricsRegistry
+{
+  public:
+    MetricCounter& Counter(const std::string_view name) { return Get_(counters_, name); }
+
+    LatencyHistogram& Histogram(const std::string_view name) { return Get_(histograms_, name); }
+
+    std::vector<std::pair<std::string, uint64_t>> CounterValues() const
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        std::vector<std::pair<std::string, uint64_t>> values;
+        for (const auto& [name, counter] : counters_) {
+            values.emplace_back(name, counter->Get());
+        }
+        return values;
+    }
+
+    // Histograms which have never been recorded are skipped.
+    std::vector<std::pair<std::string, LatencyHistogram::Snapshot>> HistogramSnapshots() const
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        std::vector<std::pair<std::string, LatencyHistogram::Snapshot>> snapshots;
+        for (const auto& [name, histogram] : histograms_) {
+            if (auto snapshot = histogram->GetSnapshot(); snapshot.count_ > 0) {
+                snapshots.emplace_back(name, std::move(snapshot));
+            }
+        }
+        return snapshots;
+    }
+
+    void Reset()
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        for (const auto& [_, counter] : counters_) {
+            counter->Reset();
+        }
+        for (const auto& [_, histogram] : histograms_) {
+            histogram->Reset();
+        }
+    }
+
+    // Latencies are in microseconds.
+    std::string ToString() const
+    {
+        std::ostringstream ss;
+        ss << std::left << std::setw(48) << "histogram" << std::right;
+        for (const char* const column : {"count", "mean", "p50", "p90", "p99", "max"}) {
+            ss << std::setw(12) << column;
+        }
+        for (const auto& [name, snapshot] : HistogramSnapshots()) {
+            ss << '\n' << std::left << std::setw(48) << name << std::right << std::setw(12) << snapshot.count_;
+            for (const uint64_t ns : {snapshot.Mean(), snapshot.Percentile(50), snapshot.Percentile(90),
+                    snapshot.Percentile(99), snapshot.max_}) {
+                ss << std::setw(12) << ns / 1000;
+            }
+        }
+        ss << "\n\n" << std::left << std::setw(48) << "counter" << std::right << std::setw(12) << "value";
+        for (const auto& [name, value] : CounterValues()) {
+            ss << '\n' << std::left << std::setw(48) << name << std::right << std::setw(12) << value;
+        }
+        return ss.str();
+    }
+
+  private:
+    template <typename Metric>
+    Metric& Get_(std::map<std::string, std::unique_ptr<Metric>, std::less<>>& metrics, const std::string_view name)
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (const auto it = metrics.find(name); it != metrics.end()) {
+            return *it->second;
+        }
+        return *metrics.emplace(std::string(name), std::make_unique<Metric>()).first->second;
+    }
+
+    mutable std::mutex mutex_;
+    std::map<std::string, std::unique_ptr<MetricCounter>, std::less<>> counters_;
+    std::map<std::string, std::unique_ptr<LatencyHistogram>, std::less<>> histograms_;
+};
+
+// A background thread which writes the metrics to a file periodically. The file is replaced atomically so that readers
+// never see a partially written file.
+class MetricsDumper
+{
+  public:
+    MetricsDumper(const MetricsRegistry& registry, std::string path, std::function<std::chrono::seconds()> interval)
+        : registry_(registry), path_(std::move(path)), interval_(std::move(interval)), thread_([this] { Run_(); })
+    {
+    }
+
+    MetricsDumper(const MetricsDumper&) = delete;
+    MetricsDumper& operator=(const MetricsDumper&) = delete;
+
+    ~MetricsDumper()
+    {
+        {
+            std::lock_guard<std::mutex> l(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+    bool Dump() const
+    {
+        const std::string tmp_path = path_ + ".tmp";
+        {
+            std::ofstream f(tmp_path, std::ios::trunc);
+            if (!(f << registry_.ToString() << std::endl)) {
+                return false;
+            }
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp_path, path_, ec);
+        return !ec;
+    }
+
+  private:
+    void Run_()
+    {
+        std::unique_lock<std::mutex> l(mutex_);
+        while (!cv_.wait_for(l, interval_(), [this] { return stopped_; })) {
+            l.unlock();
+            Dump();
+            l.lock();
+        }
+    }
+
+    const MetricsRegistry& registry_;
+    const std::string path_;
+    const std::function<std::chrono::seconds()> interval_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopped_{false};
+    std::thread thread_; // must be the last member because it is started in the constructor
+};
@@ -5,14 +5,19 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <optional>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 #include <sstream>
 #include <bitset>
@@ -42,6 +47,13 @@ class MsgReader final
 
     bool HasNext() const { return iter_ != args_.end(); }
 
+    // Returns an empty string if there are no arguments.
+    const std::string& FirstArg() const
+    {
+        static const std::string k_empty;
+        return args_.empty() ? k_empty : args_.front();
+    }
+
     IterType Iterator() const { return iter_; }
 
     const std::string& NextArg()
@@ -340,6 +352,7 @@ class MsgArgChecker<void> final
     std::string EscapedFormatInfo() const { return format_info_; };
     std::string ColoredFormatInfo() const { return format_info_; };
     std::string ExampleInfo() const { return optional_strs_.front(); };
+    const std::vector<std::string>& OptionalStrs() const { return optional_strs_; }
 
    private:
     const std::vector<std::string> optional_strs_;
@@ -718,6 +731,7 @@ class Command<UserResult(UserArgs...)>
         virtual ~Base_() {}
         virtual CommandResult CallIfValid(MsgReader& msg_reader, UserArgs... user_args) const = 0;
         virtual std::string Info(const bool with_example, const bool with_html_color, const std::string& prefix) const = 0;
+        virtual const std::vector<std::string>* LeadingLiterals() const = 0;
     };
 
     template <typename Callback, typename... Checkers>
@@ -801,6 +815,16 @@ class Command<UserResult(UserArgs...)>
             return outstr;
         }
 
+        virtual const std::vector<std::string>* LeadingLiterals() const override
+        {
+            if constexpr (sizeof...(Checkers) > 0) {
+                if constexpr (std::is_same_v<std::decay_t<std::tuple_element_t<0, std::tuple<Checkers...>>>, MsgArgChecker<void>>) {
+                    return &std::get<0>(checkers_).OptionalStrs();
+                }
+            }
+            return nullptr;
+        }
+
       private:
         const char* const description_;
         const std::decay_t<Callback> callback_;
@@ -822,7 +846,54 @@ class Command<UserResult(UserArgs...)>
 
     auto Info(const bool with_example, const bool with_html_color, const std::string& prefix = "") const { return cmd_->Info(with_example, with_html_color, prefix); }
 
+    // Returns the literals which the first argument must be one of, or nullptr if the first argument is not a literal.
+    const std::vector<std::string>* LeadingLiterals() const { return cmd_->LeadingLiterals(); }
+
   private:
     std::shared_ptr<Base_> cmd_;
 };
 
+// Indexes commands by the literals of their first arguments, so a message is only tried with the commands which may
+// match it. A message whose first argument is not any literal is only tried with the commands whose first argument is
+// not a literal.
+class CommandIndex
+{
+  public:
+    template <typename Command>
+    explicit CommandIndex(const std::vector<Command>& commands)
+    {
+        for (uint32_t i = 0; i < commands.size(); ++i) {
+            const auto* const literals = commands[i].LeadingLiterals();
+            if (!literals) {
+                non_literal_candidates_.emplace_back(i);
+                continue;
+            }
+            for (const auto& literal : *literals) {
+                auto& candidates = literal_candidates_[literal];
+                if (candidates.empty() || candidates.back() != i) {
+                    candidates.emplace_back(i);
+                }
+            }
+        }
+        // The commands whose first argument is not a literal may match any message. They are merged into each list so
+        // that the candidates are still tried in the original order.
+        for (auto& [_, candidates] : literal_candidates_) {
+            std::vector<uint32_t> merged;
+            merged.reserve(candidates.size() + non_literal_candidates_.size());
+            std::ranges::merge(candidates, non_literal_candidates_, std::back_inserter(merged));
+            candidates = std::move(merged);
+        }
+    }
+
+    // Returns the indexes of the commands which may match the message, in the original order.
+    const std::vector<uint32_t>& Candidates(const MsgReader& reader) const
+    {
+        const auto it = literal_candidates_.find(reader.FirstArg());
+        return it == literal_candidates_.end() ? non_literal_candidates_ : it->second;
+    }
+
+  private:
+    std::unordered_map<std::string, std::vector<uint32_t>> literal_candidates_;
+    std::vector<uint32_t> non_literal_candidates_;
+};
+
@@ -0,0 +1,53 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+// A background thread which runs the task periodically until destructed. The interval is got before each wait, so it
+// can be changed at runtime.
+class PeriodicTask
+{
+  public:
+    PeriodicTask(std::function<void()> task, std::function<std::chrono::milliseconds()> interval)
+        : task_(std::move(task)), interval_(std::move(interval)), thread_([this] { Run_(); })
+    {
+    }
+
+    PeriodicTask(const PeriodicTask&) = delete;
+    PeriodicTask& operator=(const PeriodicTask&) = delete;
+
+    ~PeriodicTask()
+    {
+        {
+            std::lock_guard<std::mutex> l(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+
+  private:
+    void Run_()
+    {
+        std::unique_lock<std::mutex> l(mutex_);
+        while (!cv_.wait_for(l, interval_(), [this] { return stopped_; })) {
+            l.unlock();
+            task_();
+            l.lock();
+        }
+    }
+
+    const std::function<void()> task_;
+    const std::function<std::chrono::milliseconds()> interval_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopped_{false};
+    std::thread thread_; // must be the last member because it is started in the constructor
+};
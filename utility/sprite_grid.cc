@@ -0,0 +1,376 @@
+// Copyright (c) 2018-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include "sprite_grid.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef WITH_PNG
+#include <png.h>
+#include <zlib.h>
+#endif
+
+namespace html {
+
+#ifdef WITH_PNG
+
+std::optional<Bitmap> DecodePng(const std::string& path)
+{
+    png_image image;
+    std::memset(&image, 0, sizeof(image));
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, path.c_str())) {
+        return std::nullopt;
+    }
+    image.format = PNG_FORMAT_RGBA;
+    Bitmap bitmap(image.width, image.height);
+    if (!png_image_finish_read(&image, nullptr, bitmap.pixels_.data(), 0, nullptr)) {
+        png_image_free(&image);
+        return std::nullopt;
+    }
+    return bitmap;
+}
+
+// We write PNGs with zlib instead of libpng, so that the image data can be split into bands which are compressed
+// independently. Each band is a raw deflate stream ended with a sync flush in its own IDAT chunk, and the chunks are
+// concatenated into one zlib stream. Then a band can be encoded again without touching the others.
+
+static void AppendUint32(std::string& data, const uint32_t value)
+{
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        data.push_back(static_cast<char>(value >> shift));
+    }
+}
+
+static void AppendChunk(std::string& png, const char* const type, const std::string_view data)
+{
+    AppendUint32(png, data.size());
+    const size_t type_begin = png.size();
+    png.append(type, 4);
+    png.append(data);
+    AppendUint32(png, crc32(0, reinterpret_cast<const Bytef*>(png.data() + type_begin), png.size() - type_begin));
+}
+
+static std::optional<PngBand> EncodePngBand(const Bitmap& bitmap, const uint32_t begin_row, const uint32_t end_row)
+{
+    // Rows are filtered by the Up filter except the first row of the band, so the bands are independent.
+    const size_t row_size = 1 + bitmap.width_ * 4;
+    std::string filtered((end_row - begin_row) * row_size, '\0');
+    for (uint32_t y = begin_row; y < end_row; ++y) {
+        auto* const out = reinterpret_cast<uint8_t*>(filtered.data()) + (y - begin_row) * row_size;
+        const uint8_t* const in = bitmap.Pixel(0, y);
+        if (y == begin_row) {
+            out[0] = 0;
+            std::memcpy(out + 1, in, bitmap.width_ * 4);
+            continue;
+        }
+        const uint8_t* const up = bitmap.Pixel(0, y - 1);
+        out[0] = 2;
+        for (size_t i = 0; i < bitmap.width_ * 4; ++i) {
+            out[1 + i] = in[i] - up[i];
+        }
+    }
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return std::nullopt;
+    }
+    // The sync flush appends an empty stored block, which is not counted in the bound.
+    std::string compressed(deflateBound(&stream, filtered.size()) + 16, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(filtered.data());
+    stream.avail_in = filtered.size();
+    stream.next_out = reinterpret_cast<Bytef*>(compressed.data());
+    stream.avail_out = compressed.size();
+    const int ret = deflate(&stream, Z_SYNC_FLUSH);
+    const bool succeed = ret == Z_OK && stream.avail_in == 0 && stream.avail_out > 0;
+    compressed.resize(stream.total_out);
+    deflateEnd(&stream);
+    if (!succeed) {
+        return std::nullopt;
+    }
+    PngBand band;
+    AppendChunk(band.chunk_, "IDAT", compressed);
+    band.adler_ = adler32(1, reinterpret_cast<const Bytef*>(filtered.data()), filtered.size());
+    band.size_ = filtered.size();
+    return band;
+}
+
+static std::string AssemblePng(const Bitmap& bitmap, const std::vector<PngBand>& bands)
+{
+    std::string png("\x89PNG\r\n\x1a\n", 8);
+    std::string header;
+    AppendUint32(header, bitmap.width_);
+    AppendUint32(header, bitmap.height_);
+    header.append({8, 6, 0, 0, 0}); // 8-bit RGBA, deflate, adaptive filtering, no interlace
+    AppendChunk(png, "IHDR", header);
+    AppendChunk(png, "IDAT", "\x78\x01"); // the zlib header
+    uLong adler = 1;
+    for (const auto& band : bands) {
+        png.append(band.chunk_);
+        adler = adler32_combine(adler, band.adler_, band.size_);
+    }
+    std::string tail("\x03\x00", 2); // an empty final block
+    AppendUint32(tail, adler);
+    AppendChunk(png, "IDAT", tail);
+    AppendChunk(png, "IEND", "");
+    return png;
+}
+
+std::optional<std::string> EncodePng(const Bitmap& bitmap)
+{
+    auto band = EncodePngBand(bitmap, 0, bitmap.height_);
+    if (!band.has_value()) {
+        return std::nullopt;
+    }
+    return AssemblePng(bitmap, {std::move(*band)});
+}
+
+#else
+
+std::optional<Bitmap> DecodePng(const std::string& path) { return std::nullopt; }
+
+std::optional<std::string> EncodePng(const Bitmap& bitmap) { return std::nullopt; }
+
+#endif
+
+bool SavePng(const Bitmap& bitmap, const std::string& path)
+{
+    const auto data = EncodePng(bitmap);
+    if (!data.has_value()) {
+        return false;
+    }
+    std::ofstream ofs(path, std::ios::binary);
+    return ofs.write(data->data(), data->size()).good();
+}
+
+SpriteCache& SpriteCache::Instance()
+{
+    static SpriteCache cache;
+    return cache;
+}
+
+std::shared_ptr<const Bitmap> SpriteCache::Get(const std::string& path)
+{
+    std::error_code ec;
+    const std::string key = std::filesystem::absolute(path, ec).lexically_normal().string();
+    const auto modified_time = std::filesystem::last_write_time(key, ec);
+    if (ec) {
+        return nullptr;
+    }
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (const auto it = entries_.find(key); it != entries_.end() && it->second.modified_time_ == modified_time) {
+            ++statistic_.hit_count_;
+            lru_.splice(lru_.begin(), lru_, it->second.lru_it_);
+            return it->second.bitmap_;
+        }
+        ++statistic_.miss_count_;
+    }
+    // We decode without holding the lock so that other files can be got meanwhile. We do not cache the failure so that a
+    // file which is copied to the directory later can still be loaded.
+    auto decoded = DecodePng(key);
+    if (!decoded.has_value()) {
+        return nullptr;
+    }
+    auto bitmap = std::make_shared<const Bitmap>(std::move(*decoded));
+    std::lock_guard<std::mutex> l(mutex_);
+    auto it = entries_.find(key);
+    if (it == entries_.end()) {
+        lru_.emplace_front(key);
+        it = entries_.emplace(key, Entry{.lru_it_ = lru_.begin()}).first;
+    } else {
+        size_ -= it->second.bitmap_->pixels_.size();
+        lru_.splice(lru_.begin(), lru_, it->second.lru_it_);
+    }
+    it->second.bitmap_ = bitmap;
+    it->second.modified_time_ = modified_time;
+    size_ += bitmap->pixels_.size();
+    Evict_();
+    return bitmap;
+}
+
+uint32_t SpriteCache::Prefetch(const std::string& dir, const char* const* names)
+{
+    uint32_t count = 0;
+    for (; names && *names; ++names) {
+        count += Get(dir + "/" + *names) != nullptr;
+    }
+    return count;
+}
+
+void SpriteCache::SetCapacity(const uint64_t capacity)
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    capacity_ = capacity;
+    Evict_();
+}
+
+uint64_t SpriteCache::Size() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    return size_;
+}
+
+SpriteCache::Statistic SpriteCache::GetStatistic() const
+{
+    std::lock_guard<std::mutex> l(mutex_);
+    return statistic_;
+}
+
+// The most recently used file is kept even if it alone exceeds the capacity, because it is still being used.
+void SpriteCache::Evict_()
+{
+    while (size_ > capacity_ && lru_.size() > 1) {
+        const auto it = entries_.find(lru_.back());
+        size_ -= it->second.bitmap_->pixels_.size();
+        entries_.erase(it);
+        lru_.pop_back();
+        ++statistic_.evict_count_;
+    }
+}
+
+// Draws `src` over `dst` at (x, y) with the alpha channel.
+static void Blit(Bitmap& dst, const Bitmap& src, const uint32_t x, const uint32_t y)
+{
+    const uint32_t width = std::min(src.width_, dst.width_ - x);
+    const uint32_t height = std::min(src.height_, dst.height_ - y);
+    for (uint32_t j = 0; j < height; ++j) {
+        for (uint32_t i = 0; i < width; ++i) {
+            const uint8_t* const s = src.Pixel(i, j);
+            uint8_t* const d = dst.Pixel(x + i, y + j);
+            if (s[3] == 0) {
+                continue;
+            }
+            if (s[3] == 255 || d[3] == 0) {
+                std::memcpy(d, s, 4);
+                continue;
+            }
+            const uint32_t src_weight = s[3] * 255;
+            const uint32_t dst_weight = d[3] * (255 - s[3]);
+            const uint32_t alpha = src_weight + dst_weight;
+            for (uint32_t c = 0; c < 3; ++c) {
+                d[c] = (s[c] * src_weight + d[c] * dst_weight + alpha / 2) / alpha;
+            }
+            d[3] = (alpha + 127) / 255;
+        }
+    }
+}
+
+static void Fill(Bitmap& bitmap, const std::array<uint8_t, 4>& color, const uint32_t x, const uint32_t y,
+        const uint32_t width, const uint32_t height)
+{
+    for (uint32_t j = y; j < y + height; ++j) {
+        for (uint32_t i = x; i < x + width; ++i) {
+            std::memcpy(bitmap.Pixel(i, j), color.data(), 4);
+        }
+    }
+}
+
+std::optional<SpriteGrid::Sprites> SpriteGrid::LoadSprites_() const
+{
+    auto& cache = SpriteCache::Instance();
+    Sprites sprites;
+    sprites.bitmaps_.resize(names_.size());
+    std::unordered_map<std::string_view, std::shared_ptr<const Bitmap>> loaded; // boards usually repeat few sprites
+    for (size_t i = 0; i < names_.size(); ++i) {
+        if (names_[i].empty()) {
+            continue;
+        }
+        auto& bitmap = loaded[names_[i]];
+        if (!bitmap && !(bitmap = cache.Get(resource_dir_ + "/" + names_[i] + ".png"))) {
+            return std::nullopt;
+        }
+        sprites.bitmaps_[i] = bitmap;
+        sprites.width_ = std::max(sprites.width_, sprites.bitmaps_[i]->width_);
+        sprites.height_ = std::max(sprites.height_, sprites.bitmaps_[i]->height_);
+    }
+    return sprites;
+}
+
+void SpriteGrid::DrawBox_(Bitmap& bitmap, const Sprites& sprites, const uint32_t row, const uint32_t column) const
+{
+    const uint32_t x = spacing_ + BoxWidth_(sprites) * column;
+    const uint32_t y = spacing_ + BoxHeight_(sprites) * row;
+    Fill(bitmap, background_, x, y, BoxWidth_(sprites) - spacing_, BoxHeight_(sprites) - spacing_);
+    if (const auto& sprite = sprites.bitmaps_[row * column_ + column]) {
+        Blit(bitmap, *sprite, x + padding_, y + padding_);
+    }
+}
+
+Bitmap SpriteGrid::Draw_(const Sprites& sprites) const
+{
+    Bitmap bitmap(spacing_ + BoxWidth_(sprites) * column_, spacing_ + BoxHeight_(sprites) * row_);
+    Fill(bitmap, background_, 0, 0, bitmap.width_, bitmap.height_);
+    for (uint32_t row = 0; row < row_; ++row) {
+        for (uint32_t column = 0; column < column_; ++column) {
+            if (const auto& sprite = sprites.bitmaps_[row * column_ + column]) {
+                Blit(bitmap, *sprite, spacing_ + BoxWidth_(sprites) * column + padding_,
+                        spacing_ + BoxHeight_(sprites) * row + padding_);
+            }
+        }
+    }
+    return bitmap;
+}
+
+std::optional<Bitmap> SpriteGrid::Compose() const
+{
+    const auto sprites = LoadSprites_();
+    if (!sprites.has_value()) {
+        return std::nullopt;
+    }
+    return Draw_(*sprites);
+}
+
+std::optional<std::string> SpriteGridRenderer::Render(const SpriteGrid& grid)
+{
+#ifdef WITH_PNG
+    const auto sprites = grid.LoadSprites_();
+    if (!sprites.has_value()) {
+        return std::nullopt;
+    }
+    std::vector<bool> dirty_rows(std::max<uint32_t>(grid.row_, 1), true);
+    if (last_grid_.has_value() && last_grid_->IsSameLayout_(grid) && sprite_width_ == sprites->width_ &&
+            sprite_height_ == sprites->height_) {
+        std::fill(dirty_rows.begin(), dirty_rows.end(), false);
+        for (uint32_t row = 0; row < grid.row_; ++row) {
+            for (uint32_t column = 0; column < grid.column_; ++column) {
+                if (grid.Get(row, column) != last_grid_->Get(row, column)) {
+                    grid.DrawBox_(bitmap_, *sprites, row, column);
+                    dirty_rows[row] = true;
+                }
+            }
+        }
+    } else {
+        bitmap_ = grid.Draw_(*sprites);
+        bands_.assign(dirty_rows.size(), PngBand{});
+    }
+    last_grid_.reset(); // the cached frame is incomplete until all dirty bands are encoded
+    last_encoded_row_count_ = 0;
+    for (uint32_t row = 0; row < dirty_rows.size(); ++row) {
+        if (!dirty_rows[row]) {
+            continue;
+        }
+        // The first band also contains the top spacing.
+        const uint32_t begin = row == 0 ? 0 : grid.spacing_ + grid.BoxHeight_(*sprites) * row;
+        const uint32_t end = row + 1 == dirty_rows.size() ? bitmap_.height_ :
+            grid.spacing_ + grid.BoxHeight_(*sprites) * (row + 1);
+        auto band = EncodePngBand(bitmap_, begin, end);
+        if (!band.has_value()) {
+            return std::nullopt;
+        }
+        bands_[row] = std::move(*band);
+        ++last_encoded_row_count_;
+    }
+    last_grid_ = grid;
+    sprite_width_ = sprites->width_;
+    sprite_height_ = sprites->height_;
+    return AssemblePng(bitmap_, bands_);
+#else
+    return std::nullopt;
+#endif
+}
+
+}
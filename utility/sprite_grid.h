@@ -0,0 +1,201 @@
+// Copyright (c) 2018-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "html.h"
+
+namespace html {
+
+// An image whose pixels are stored row by row in RGBA with 8 bits for each channel.
+struct Bitmap
+{
+    Bitmap() = default;
+    Bitmap(const uint32_t width, const uint32_t height) : width_(width), height_(height), pixels_(width * height * 4, 0) {}
+
+    uint8_t* Pixel(const uint32_t x, const uint32_t y) { return pixels_.data() + (y * width_ + x) * 4; }
+    const uint8_t* Pixel(const uint32_t x, const uint32_t y) const { return pixels_.data() + (y * width_ + x) * 4; }
+
+    uint32_t width_{0};
+    uint32_t height_{0};
+    std::vector<uint8_t> pixels_;
+};
+
+// The PNG codec returns std::nullopt if the data is invalid or the program is built without libpng.
+std::optional<Bitmap> DecodePng(const std::string& path);
+std::optional<std::string> EncodePng(const Bitmap& bitmap);
+bool SavePng(const Bitmap& bitmap, const std::string& path);
+
+// The decoded PNG files shared by all matches, keyed by the absolute path. A file is decoded again once it is modified,
+// and the least recently used files are evicted when the decoded pixels exceed the capacity. It is thread-safe.
+class SpriteCache
+{
+  public:
+    // Each game module has its own cache, so the memory of a bot is bounded by the capacity multiplied by the number of
+    // loaded modules. The decoded sprites of a game usually take less than a few megabytes, so the capacity is small.
+    static constexpr uint64_t k_default_capacity = 32 << 20;
+
+    struct Statistic
+    {
+        uint64_t hit_count_ = 0;
+        uint64_t miss_count_ = 0;   // decoded the file (modified files included)
+        uint64_t evict_count_ = 0;  // removed because the cache is full
+    };
+
+    // The cache of the module (or the process if it is not a game module).
+    static SpriteCache& Instance();
+
+    explicit SpriteCache(const uint64_t capacity = k_default_capacity) : capacity_(capacity) {}
+
+    SpriteCache(const SpriteCache&) = delete;
+    SpriteCache& operator=(const SpriteCache&) = delete;
+
+    // Returns nullptr if the file cannot be decoded.
+    std::shared_ptr<const Bitmap> Get(const std::string& path);
+
+    // Decodes the files in `dir` which are not cached yet, so that the following `Get` will not wait for decoding.
+    // `names` is terminated by nullptr. Returns the number of files which are cached.
+    uint32_t Prefetch(const std::string& dir, const char* const* names);
+
+    void SetCapacity(const uint64_t capacity);
+    uint64_t Size() const; // the bytes of the cached pixels
+    Statistic GetStatistic() const;
+
+  private:
+    struct Entry
+    {
+        std::shared_ptr<const Bitmap> bitmap_;
+        std::filesystem::file_time_type modified_time_;
+        std::list<std::string>::iterator lru_it_;
+    };
+
+    void Evict_();
+
+    mutable std::mutex mutex_;
+    uint64_t capacity_;
+    uint64_t size_{0};
+    std::unordered_map<std::string, Entry> entries_;
+    std::list<std::string> lru_; // the front one is the most recently used
+    Statistic statistic_;
+};
+
+// A table whose boxes only contain sprites (e.g., a chessboard). Besides being converted to the equivalent html table,
+// it can be composed into an image directly, which is much faster than rendering the html table. All sprites are
+// expected to be of the same size.
+class SpriteGrid
+{
+  public:
+    // Sprites are the PNG files in `resource_dir`.
+    SpriteGrid(std::string resource_dir, const uint32_t row, const uint32_t column)
+        : resource_dir_(std::move(resource_dir)), row_(row), column_(column), names_(row * column)
+    {}
+
+    uint32_t Row() const { return row_; }
+    uint32_t Column() const { return column_; }
+
+    // `name` is the file name without the ".png" suffix.
+    void Set(const uint32_t row, const uint32_t column, std::string name)
+    {
+        assert(row < row_ && column < column_);
+        names_[row * column_ + column] = std::move(name);
+    }
+    const std::string& Get(const uint32_t row, const uint32_t column) const { return names_[row * column_ + column]; }
+
+    // The same as the `cellpadding` and `cellspacing` of the html table.
+    void SetPadding(const uint32_t padding) { padding_ = padding; }
+    void SetSpacing(const uint32_t spacing) { spacing_ = spacing; }
+
+    // The RGBA color filled before placing sprites. It is white by default as the page of the html table.
+    void SetBackground(const std::array<uint8_t, 4>& background) { background_ = background; }
+
+    std::string ToHtml() const
+    {
+        html::Table table(row_, column_);
+        table.SetTableStyle(" align=\"center\" cellpadding=\"" + std::to_string(padding_) + "\" cellspacing=\"" +
+                std::to_string(spacing_) + "\" ");
+        for (uint32_t row = 0; row < row_; ++row) {
+            for (uint32_t column = 0; column < column_; ++column) {
+                if (const auto& name = Get(row, column); !name.empty()) {
+                    table.Get(row, column).SetContent("![](file:///" + resource_dir_ + "/" + name + ".png)");
+                }
+            }
+        }
+        return table.ToString();
+    }
+
+    // Places the sprites as the html table does. Returns std::nullopt if any sprite cannot be decoded.
+    std::optional<Bitmap> Compose() const;
+
+  private:
+    friend class SpriteGridRenderer;
+
+    struct Sprites
+    {
+        std::vector<std::shared_ptr<const Bitmap>> bitmaps_; // nullptr for boxes without sprites
+        uint32_t width_{0}; // the size of the largest sprite
+        uint32_t height_{0};
+    };
+
+    std::optional<Sprites> LoadSprites_() const;
+    uint32_t BoxWidth_(const Sprites& sprites) const { return sprites.width_ + padding_ * 2 + spacing_; }
+    uint32_t BoxHeight_(const Sprites& sprites) const { return sprites.height_ + padding_ * 2 + spacing_; }
+    Bitmap Draw_(const Sprites& sprites) const;
+    void DrawBox_(Bitmap& bitmap, const Sprites& sprites, const uint32_t row, const uint32_t column) const;
+    bool IsSameLayout_(const SpriteGrid& other) const
+    {
+        return resource_dir_ == other.resource_dir_ && row_ == other.row_ && column_ == other.column_ &&
+            padding_ == other.padding_ && spacing_ == other.spacing_ && background_ == other.background_;
+    }
+
+    std::string resource_dir_;
+    uint32_t row_;
+    uint32_t column_;
+    uint32_t padding_{1};
+    uint32_t spacing_{1};
+    std::array<uint8_t, 4> background_{255, 255, 255, 255};
+    std::vector<std::string> names_;
+};
+
+// A part of the rows of a PNG image, which is encoded into an IDAT chunk independently of other parts.
+struct PngBand
+{
+    std::string chunk_;
+    uint32_t adler_{0}; // the checksum of the uncompressed data
+    uint32_t size_{0}; // the size of the uncompressed data
+};
+
+// Renders the frames of a sprite grid (e.g., the board of each round) into PNGs. Only the boxes changed since the last
+// frame are redrawn, and only the rows of boxes containing them are encoded again, so the cost is roughly proportional to
+// how much of the grid changed. It is not thread-safe.
+class SpriteGridRenderer
+{
+  public:
+    // Returns std::nullopt if any sprite cannot be decoded or the program is built without libpng.
+    std::optional<std::string> Render(const SpriteGrid& grid);
+
+    // The number of rows of boxes encoded by the last `Render`.
+    uint32_t LastEncodedRowCount() const { return last_encoded_row_count_; }
+
+  private:
+    std::optional<SpriteGrid> last_grid_;
+    uint32_t sprite_width_{0};
+    uint32_t sprite_height_{0};
+    Bitmap bitmap_;
+    std::vector<PngBand> bands_; // one band for each row of boxes
+    uint32_t last_encoded_row_count_{0};
+};
+
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include "utility/ai_info.h"
+
+#include <gtest/gtest.h>
+
+static nlohmann::json MakeBoard(const int step)
+{
+    nlohmann::json board = nlohmann::json::array();
+    for (int i = 0; i < 64; ++i) {
+        board.push_back(i < step ? "black" : "none");
+    }
+    return nlohmann::json{{"round", step}, {"board", std::move(board)}};
+}
+
+TEST(TestAiInfo, encode_and_decode_full_info)
+{
+    ai_info::Encoder encoder;
+    const std::string data{encoder.Encode(5, 0, MakeBoard(0))};
+    const auto header = ai_info::ParseHeader(data);
+    ASSERT_TRUE(header.has_value());
+    ASSERT_EQ(ai_info::Kind::FULL, header->kind_);
+    ASSERT_EQ(5, header->match_id_);
+    ASSERT_EQ(0, header->info_id_);
+    ASSERT_EQ(data.size(), ai_info::k_header_size + header->payload_size_);
+    ai_info::Decoder decoder;
+    ASSERT_EQ(MakeBoard(0), decoder.Decode(data));
+    ASSERT_LT(data.size(), MakeBoard(0).dump().size());
+}
+
+TEST(TestAiInfo, encode_consecutive_infos_as_deltas)
+{
+    ai_info::Encoder encoder;
+    ai_info::Decoder decoder;
+    const std::string full_data{encoder.Encode(5, 0, MakeBoard(0))};
+    ASSERT_EQ(MakeBoard(0), decoder.Decode(full_data));
+    for (int step = 1; step < 10; ++step) {
+        const std::string data{encoder.Encode(5, step, MakeBoard(step))};
+        ASSERT_EQ(ai_info::Kind::DELTA, ai_info::ParseHeader(data)->kind_);
+        ASSERT_LT(data.size(), full_data.size());
+        ASSERT_EQ(MakeBoard(step), decoder.Decode(data));
+    }
+}
+
+TEST(TestAiInfo, encode_full_info_periodically)
+{
+    ai_info::Encoder encoder;
+    std::vector<ai_info::Kind> kinds;
+    for (uint64_t step = 0; step <= ai_info::Encoder::k_full_info_interval; ++step) {
+        kinds.emplace_back(ai_info::ParseHeader(encoder.Encode(5, step, MakeBoard(step)))->kind_);
+    }
+    ASSERT_EQ(ai_info::Kind::FULL, kinds.front());
+    ASSERT_EQ(ai_info::Kind::FULL, kinds.back());
+    ASSERT_EQ(ai_info::Encoder::k_full_info_interval - 1, std::ranges::count(kinds, ai_info::Kind::DELTA));
+}
+
+TEST(TestAiInfo, decode_delta_without_previous_info)
+{
+    ai_info::Encoder encoder;
+    encoder.Encode(5, 0, MakeBoard(0));
+    const std::string data{encoder.Encode(5, 1, MakeBoard(1))};
+    ai_info::Decoder decoder;
+    ASSERT_FALSE(decoder.Decode(data).has_value());
+}
+
+TEST(TestAiInfo, decode_invalid_data)
+{
+    ai_info::Decoder decoder;
+    ASSERT_FALSE(decoder.Decode("").has_value());
+    ASSERT_FALSE(decoder.Decode(std::string(ai_info::k_header_size, 'x')).has_value());
+    std::string data = ai_info::EncodeMatchState(5, {{"state", "started"}});
+    ASSERT_EQ(nlohmann::json({{"state", "started"}}), decoder.Decode(data));
+    data.pop_back();
+    ASSERT_FALSE(decoder.Decode(data).has_value());
+}
@@ -0,0 +1,200 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+
+#include "async_log.h"
+#include "log.h"
+
+DEFINE_uint64(log_benchmark_count, 100000, "The number of logs written in the benchmark");
+
+TEST(TestRingBuffer, push_and_pop_in_order)
+{
+    RingBuffer<int> buffer(3);
+    ASSERT_EQ(4, buffer.Capacity());
+    ASSERT_TRUE(buffer.Empty());
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(buffer.TryPush(i));
+    }
+    int value = 4;
+    ASSERT_FALSE(buffer.TryPush(value));
+    ASSERT_EQ(4, value);
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(buffer.TryPop(value));
+        ASSERT_EQ(i, value);
+    }
+    ASSERT_FALSE(buffer.TryPop(value));
+    ASSERT_TRUE(buffer.Empty());
+}
+
+TEST(TestRingBuffer, multiple_producers_and_consumers)
+{
+    constexpr int k_thread_num = 4;
+    constexpr int k_value_num = 100000;
+    RingBuffer<int> buffer(64);
+    std::atomic<int64_t> sum{0};
+    std::atomic<int> popped_count{0};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < k_thread_num; ++i) {
+        threads.emplace_back([&]
+                {
+                    for (int value = 1; value <= k_value_num; ++value) {
+                        for (int pushed = value; !buffer.TryPush(pushed);) {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+        threads.emplace_back([&]
+                {
+                    for (int value; popped_count.load() < k_thread_num * k_value_num;) {
+                        if (buffer.TryPop(value)) {
+                            sum += value;
+                            ++popped_count;
+                        } else {
+                            std::this_thread::yield();
+                        }
+                    }
+                });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(int64_t(k_thread_num) * k_value_num * (k_value_num + 1) / 2, sum.load());
+}
+
+TEST(TestAsyncLogger, write_records_of_each_thread_in_order)
+{
+    constexpr int k_thread_num = 4;
+    constexpr int k_record_num = 10000;
+    std::vector<std::vector<int>> lines(k_thread_num);
+    // The buffer never gets full, so no records are written synchronously.
+    AsyncLogger logger([&](const LogRecord& record) { lines[record.severity_].emplace_back(record.line_); },
+            k_thread_num * k_record_num);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < k_thread_num; ++i) {
+        threads.emplace_back([&, i]
+                {
+                    for (int line = 0; line < k_record_num; ++line) {
+                        logger.Push(LogRecord{__FILE__, line, i, "message"});
+                    }
+                });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    logger.Flush();
+    ASSERT_EQ(0, logger.SyncWriteCount());
+    for (const auto& thread_lines : lines) {
+        ASSERT_EQ(k_record_num, thread_lines.size());
+        ASSERT_TRUE(std::ranges::is_sorted(thread_lines));
+    }
+}
+
+TEST(TestAsyncLogger, write_synchronously_when_full)
+{
+    std::atomic<bool> is_blocked{false};
+    std::atomic<bool> is_released{false};
+    std::vector<std::string> messages;
+    AsyncLogger logger([&](const LogRecord& record)
+            {
+                if (!is_blocked.exchange(true)) {
+                    // Block the background thread after it takes the first record.
+                    while (!is_released.load()) {
+                        std::this_thread::yield();
+                    }
+                }
+                messages.emplace_back(record.message_);
+            }, 2);
+    logger.Push(LogRecord{.message_ = "1"});
+    while (!is_blocked.load()) {
+        std::this_thread::yield();
+    }
+    logger.Push(LogRecord{.message_ = "2"});
+    logger.Push(LogRecord{.message_ = "3"});
+    std::thread thread([&] { logger.Push(LogRecord{.message_ = "4"}); }); // the buffer is full
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    is_released = true;
+    thread.join();
+    logger.Flush();
+    ASSERT_EQ(1, logger.SyncWriteCount());
+    // The record written synchronously may be written before the ones in the buffer.
+    ASSERT_EQ("1", messages.front());
+    std::ranges::sort(messages);
+    ASSERT_EQ((std::vector<std::string>{"1", "2", "3", "4"}), messages);
+}
+
+TEST(TestAsyncLogger, write_all_records_when_destructed)
+{
+    std::vector<int> lines;
+    {
+        AsyncLogger logger([&](const LogRecord& record) { lines.emplace_back(record.line_); });
+        for (int line = 0; line < 100; ++line) {
+            logger.Push(LogRecord{.line_ = line});
+        }
+    }
+    ASSERT_EQ(100, lines.size());
+}
+
+#if !WITH_GLOG
+TEST(TestLazyLog, not_evaluate_disabled_logs)
+{
+    int evaluated_count = 0;
+    LAZY_LOG(Info, InfoLog()) << "count=" << ++evaluated_count;
+    ASSERT_EQ(0, evaluated_count);
+}
+#endif
+
+TEST(TestAsyncLogger, DISABLED_benchmark_write_logs)
+{
+    // The sink writes records to a buffered file, as glog does for info logs.
+    const auto path = std::filesystem::temp_directory_path() / "lgtbot_test_async_log.txt";
+    std::ofstream file(path);
+    const auto sink = [&](const LogRecord& record) { file << record.message_ << '\n'; };
+    const auto log = [](auto&& write, const uint64_t i)
+        {
+            std::ostringstream stream;
+            stream << "[mid=" << 1 << "] [game=test] [stage=main] [atomic_stage] Handle READY pid=" << i
+                   << " is_user=" << Bool2Str(i % 2);
+            write(LogRecord{__FILE__, __LINE__, 0, std::move(stream).str()});
+        };
+    const auto sync_begin = std::chrono::steady_clock::now();
+    std::mutex mutex;
+    for (uint64_t i = 0; i < FLAGS_log_benchmark_count; ++i) {
+        log([&](const LogRecord& record) { std::lock_guard<std::mutex> l(mutex); sink(record); }, i);
+    }
+    const auto sync_cost = std::chrono::steady_clock::now() - sync_begin;
+    AsyncLogger logger(sink);
+    const auto async_begin = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < FLAGS_log_benchmark_count; ++i) {
+        log([&](LogRecord&& record) { logger.Push(std::move(record)); }, i);
+    }
+    const auto async_cost = std::chrono::steady_clock::now() - async_begin;
+    logger.Flush();
+    const uint64_t count = std::max<uint64_t>(FLAGS_log_benchmark_count, 1);
+    std::cout << "Benchmark: " << FLAGS_log_benchmark_count << " logs, "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(sync_cost).count() / count
+              << "ns per synchronous log, "
+              << std::chrono::duration_cast<std::chrono::nanoseconds>(async_cost).count() / count
+              << "ns per asynchronous log (" << logger.SyncWriteCount() << " written synchronously)" << std::endl;
+    std::filesystem::remove(path);
+}
+
+int main(int argc, char** argv)
+{
+    testing::InitGoogleTest(&argc, argv);
+    gflags::ParseCommandLineFlags(&argc, &argv, true);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+
+#include "html.h"
+
+DEFINE_uint64(benchmark_iterations, 2000, "The number of times a board is rendered in the benchmark");
+
+static thread_local uint64_t g_allocation_count = 0;
+
+void* operator new(const std::size_t size)
+{
+    ++g_allocation_count;
+    if (void* const p = std::malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const p) noexcept { std::free(p); }
+
+void operator delete(void* const p, const std::size_t) noexcept { std::free(p); }
+
+template <typename Fn>
+static uint64_t CountAllocations(Fn&& fn)
+{
+    const uint64_t begin_count = g_allocation_count;
+    fn();
+    return g_allocation_count - begin_count;
+}
+
+// A board like the ones of chess games: every box holds an image and the background colors alternate.
+static html::Table MakeBoard(const uint32_t size)
+{
+    html::Table table(size, size);
+    table.SetTableStyle(" align=\"center\" cellpadding=\"0\" cellspacing=\"0\" ");
+    for (uint32_t row = 0; row < size; ++row) {
+        for (uint32_t col = 0; col < size; ++col) {
+            table.Get(row, col)
+                .SetContent("![](file:///home/lgtbot/images/chess/piece_" + std::to_string((row * size + col) % 7) + ".png)")
+                .SetColor((row + col) % 2 ? "#C3C3C3" : "#FFFDE4")
+                .SetStyle("style=\"width:40px; height:40px;\"");
+        }
+    }
+    table.MergeRight(0, 0, 2);
+    table.MergeDown(1, 0, 3);
+    return table;
+}
+
+TEST(TestHtml, to_string)
+{
+    html::Table table(2, 3);
+    table.SetTableStyle("border=\"1\"");
+    table.SetRowStyle(1, "align=\"left\"");
+    table.MergeRight(0, 1, 2);
+    table.Get(0, 0).SetContent("a").SetColor("white");
+    table.Get(0, 1).SetContent("b").SetStyle("width=\"30px\"");
+    table.Get(1, 2).SetContent("c").SetColor("").SetStyle("");
+    ASSERT_EQ("<table border=\"1\" ><tbody>"
+              "\n<tr>"
+              "\n<td  align=\"center\"  bgcolor=\"white\">\n\na\n\n</td>"
+              "\n<td  align=\"center\"  width=\"30px\" colspan=\"2\">\n\nb\n\n</td>"
+              "\n</tr>"
+              "\n<tr>"
+              "\n<td align=\"left\">\n\n\n\n</td>"
+              "\n<td align=\"left\">\n\n\n\n</td>"
+              "\n<td align=\"left\">\n\nc\n\n</td>"
+              "\n</tr>"
+              "\n</tbody></table>", table.ToString());
+}
+
+TEST(TestHtml, to_string_merge_down)
+{
+    html::Table table(12, 1);
+    table.SetTableStyle("");
+    table.MergeColumn(0);
+    std::string expected = "<table  ><tbody>\n<tr>\n<td  align=\"center\"  rowspan=\"12\">\n\n\n\n</td>\n</tr>";
+    for (int i = 1; i < 12; ++i) {
+        expected += "\n<tr>\n</tr>";
+    }
+    expected += "\n</tbody></table>";
+    ASSERT_EQ(expected, table.ToString());
+}
+
+TEST(TestHtml, append_to_sink)
+{
+    const auto table = MakeBoard(4);
+    std::string sink = "prefix";
+    table.AppendTo(sink);
+    ASSERT_EQ("prefix" + table.ToString(), sink);
+}
+
+TEST(TestHtml, intern)
+{
+    ASSERT_EQ(nullptr, html::Intern(""));
+    ASSERT_EQ(html::Intern("#FFFFFF"), html::Intern(std::string("#FFFFFF")));
+    ASSERT_NE(html::Intern("#FFFFFF"), html::Intern("#000000"));
+    ASSERT_EQ("#000000", *html::Intern("#000000"));
+}
+
+TEST(TestHtml, to_string_allocates_once)
+{
+    const auto table = MakeBoard(10);
+    ASSERT_EQ(1, CountAllocations([&] { table.ToString(); }));
+    std::string sink;
+    sink.reserve(table.ToString().size());
+    ASSERT_EQ(0, CountAllocations([&] { table.AppendTo(sink); }));
+}
+
+TEST(TestHtml, set_interned_color_and_style_without_allocation)
+{
+    html::Table table(1, 1);
+    table.Get(0, 0).SetColor("#ABCDEF").SetStyle("width=\"65px\"");
+    ASSERT_EQ(0, CountAllocations([&] { table.Get(0, 0).SetColor("#ABCDEF").SetStyle("width=\"65px\""); }));
+}
+
+TEST(TestHtml, DISABLED_benchmark)
+{
+    for (const uint32_t size : {9, 19}) {
+        const auto table = MakeBoard(size);
+        uint64_t output_size = 0;
+        const auto begin = std::chrono::steady_clock::now();
+        const uint64_t allocation_count = CountAllocations([&]
+                {
+                    for (uint64_t i = 0; i < FLAGS_benchmark_iterations; ++i) {
+                        output_size += table.ToString().size();
+                    }
+                });
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+        const uint64_t iterations = std::max<uint64_t>(FLAGS_benchmark_iterations, 1);
+        std::cout << "Benchmark: " << size << "x" << size << " board, " << ns / iterations << " ns and "
+                  << allocation_count / iterations << " allocations per ToString, "
+                  << output_size * 1000 / std::max<int64_t>(ns, 1) << " MB/s" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+
+#include "journal.h"
+
+DEFINE_uint64(benchmark_records, 10000, "The number of records appended in the benchmark");
+DEFINE_uint64(benchmark_synced_records, 200, "The number of records appended and synced one by one in the benchmark");
+
+class TestJournal : public testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+        path_ = (std::filesystem::temp_directory_path() /
+                ("lgtbot_test_journal_" + std::string(testing::UnitTest::GetInstance()->current_test_info()->name()))).string();
+        std::filesystem::remove(path_);
+    }
+
+    virtual void TearDown() override { std::filesystem::remove(path_); }
+
+    void Truncate(const uint64_t removed_size)
+    {
+        std::filesystem::resize_file(path_, std::filesystem::file_size(path_) - removed_size);
+    }
+
+    std::string path_;
+};
+
+TEST_F(TestJournal, read_appended_records)
+{
+    {
+        const auto writer = JournalWriter::Open(path_);
+        ASSERT_NE(nullptr, writer);
+        ASSERT_TRUE(writer->Append("first"));
+        ASSERT_TRUE(writer->Append(""));
+        ASSERT_TRUE(writer->Append(std::string("with\0zero", 9)));
+    }
+    ASSERT_EQ((std::vector<std::string>{"first", "", std::string("with\0zero", 9)}), ReadJournal(path_));
+}
+
+TEST_F(TestJournal, append_after_reopen)
+{
+    JournalWriter::Open(path_)->Append("first");
+    JournalWriter::Open(path_)->Append("second");
+    ASSERT_EQ((std::vector<std::string>{"first", "second"}), ReadJournal(path_));
+}
+
+TEST_F(TestJournal, read_nonexistent_file)
+{
+    ASSERT_TRUE(ReadJournal(path_).empty());
+}
+
+TEST_F(TestJournal, drop_torn_record)
+{
+    {
+        const auto writer = JournalWriter::Open(path_);
+        writer->Append("first");
+        writer->Append("second");
+    }
+    Truncate(1);
+    ASSERT_EQ((std::vector<std::string>{"first"}), ReadJournal(path_));
+    Truncate(std::string_view("second").size() - 1 + 4); // only a part of the header is left
+    ASSERT_EQ((std::vector<std::string>{"first"}), ReadJournal(path_));
+}
+
+TEST_F(TestJournal, stop_at_corrupted_record)
+{
+    {
+        const auto writer = JournalWriter::Open(path_);
+        writer->Append("first");
+        writer->Append("second");
+        writer->Append("third");
+    }
+    {
+        std::fstream f(path_, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(JournalWriter::k_header_size * 2 + std::string_view("first").size());
+        f.put('S');
+    }
+    ASSERT_EQ((std::vector<std::string>{"first"}), ReadJournal(path_));
+}
+
+TEST_F(TestJournal, syncer_keeps_writer_alive_while_syncing)
+{
+    JournalSyncer syncer([] { return std::chrono::milliseconds(1); });
+    for (int i = 0; i < 100; ++i) {
+        const auto writer = JournalWriter::Open(path_);
+        syncer.Register(writer);
+        writer->Append(std::to_string(i));
+    }
+    ASSERT_EQ(100, ReadJournal(path_).size());
+}
+
+TEST_F(TestJournal, DISABLED_benchmark)
+{
+    const std::string record(100, 'x'); // about the size of a request record
+    const auto measure = [&](const uint64_t record_num, const bool sync)
+        {
+            std::filesystem::remove(path_);
+            const auto writer = JournalWriter::Open(path_);
+            const auto begin = std::chrono::steady_clock::now();
+            for (uint64_t i = 0; i < record_num; ++i) {
+                writer->Append(record);
+                if (sync) {
+                    writer->Sync();
+                }
+            }
+            const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+            return ns / std::max<uint64_t>(record_num, 1);
+        };
+    const auto batched_ns = measure(FLAGS_benchmark_records, false);
+    const auto synced_ns = measure(FLAGS_benchmark_synced_records, true);
+    std::cout << "Benchmark: " << batched_ns << " ns per record with batched sync, " << synced_ns
+              << " ns per record with sync per record" << std::endl;
+    ASSERT_EQ(FLAGS_benchmark_synced_records, ReadJournal(path_).size());
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  return RUN_ALL_TESTS();
+}
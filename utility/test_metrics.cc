@@ -0,0 +1,147 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+
+#include "metrics.h"
+
+DEFINE_uint64(benchmark_records, 1000000, "The number of values recorded by each thread in the benchmark");
+
+TEST(TestMetrics, bucket_bounds)
+{
+    for (const uint64_t value : std::initializer_list<uint64_t>{0, 1, 7, 8, 9, 15, 16, 17, 1000, 123456789, UINT64_MAX}) {
+        const uint32_t index = LatencyHistogram::BucketIndex(value);
+        ASSERT_LT(index, LatencyHistogram::k_bucket_num);
+        ASSERT_LE(value, LatencyHistogram::BucketUpperBound(index)) << value;
+        if (index > 0) {
+            ASSERT_GT(value, LatencyHistogram::BucketUpperBound(index - 1)) << value;
+        }
+    }
+    for (uint32_t index = 1; index < LatencyHistogram::k_bucket_num; ++index) {
+        ASSERT_EQ(index, LatencyHistogram::BucketIndex(LatencyHistogram::BucketUpperBound(index - 1) + 1));
+    }
+}
+
+TEST(TestMetrics, histogram_percentile)
+{
+    LatencyHistogram histogram;
+    for (uint64_t value = 1; value <= 10000; ++value) {
+        histogram.Record(value);
+    }
+    const auto snapshot = histogram.GetSnapshot();
+    ASSERT_EQ(10000, snapshot.count_);
+    ASSERT_EQ(10000, snapshot.max_);
+    ASSERT_EQ(5000, snapshot.Mean());
+    for (const double percentile : {50.0, 90.0, 99.0}) {
+        const double expected = percentile * 100;
+        ASSERT_GE(snapshot.Percentile(percentile), expected);
+        ASSERT_LE(snapshot.Percentile(percentile), expected * 1.125);
+    }
+    ASSERT_EQ(10000, snapshot.Percentile(100));
+    histogram.Reset();
+    ASSERT_EQ(0, histogram.GetSnapshot().count_);
+    ASSERT_EQ(0, histogram.GetSnapshot().Percentile(50));
+}
+
+TEST(TestMetrics, record_by_multiple_threads)
+{
+    MetricCounter counter;
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 32; ++i) {
+        threads.emplace_back([&] {
+                for (int j = 0; j < 1000; ++j) {
+                    counter.Add();
+                    histogram.Record(j);
+                }
+            });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(32000, counter.Get());
+    ASSERT_EQ(32000, histogram.GetSnapshot().count_);
+    ASSERT_EQ(999, histogram.GetSnapshot().max_);
+}
+
+TEST(TestMetrics, registry)
+{
+    MetricsRegistry registry;
+    ASSERT_EQ(&registry.Counter("a"), &registry.Counter("a"));
+    ASSERT_EQ(&registry.Histogram("a"), &registry.Histogram(std::string("a")));
+    registry.Counter("a").Add(3);
+    registry.Histogram("never_recorded");
+    registry.Histogram("h").Record(2000);
+    ASSERT_EQ((std::vector<std::pair<std::string, uint64_t>>{{"a", 3}}), registry.CounterValues());
+    ASSERT_EQ(1, registry.HistogramSnapshots().size());
+    ASSERT_EQ("h", registry.HistogramSnapshots()[0].first);
+    const std::string str = registry.ToString();
+    ASSERT_NE(std::string::npos, str.find("h "));
+    ASSERT_EQ(std::string::npos, str.find("never_recorded"));
+    registry.Reset();
+    ASSERT_EQ(0, registry.Counter("a").Get());
+    ASSERT_TRUE(registry.HistogramSnapshots().empty());
+}
+
+TEST(TestMetrics, dump)
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "lgtbot_test_metrics_dump").string();
+    std::filesystem::remove(path);
+    MetricsRegistry registry;
+    registry.Counter("dumped_counter").Add();
+    {
+        MetricsDumper dumper(registry, path, [] { return std::chrono::seconds(3600); });
+        ASSERT_TRUE(dumper.Dump());
+    }
+    std::ifstream f(path);
+    const std::string content{std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+    ASSERT_NE(std::string::npos, content.find("dumped_counter"));
+    std::filesystem::remove(path);
+}
+
+TEST(TestMetrics, DISABLED_benchmark)
+{
+    for (const uint32_t thread_num : {1U, std::max(2U, std::thread::hardware_concurrency())}) {
+        LatencyHistogram histogram;
+        const auto begin = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for (uint32_t i = 0; i < thread_num; ++i) {
+            threads.emplace_back([&histogram] {
+                    for (uint64_t j = 0; j < FLAGS_benchmark_records; ++j) {
+                        histogram.Record(j & 0xFFFFF);
+                    }
+                });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+        ASSERT_EQ(FLAGS_benchmark_records * thread_num, histogram.GetSnapshot().count_);
+        std::cout << "Benchmark: " << thread_num << " threads, " << ns / std::max<uint64_t>(FLAGS_benchmark_records, 1)
+                  << " ns per record in each thread" << std::endl;
+    }
+    LatencyHistogram histogram;
+    const auto begin = std::chrono::steady_clock::now();
+    for (uint64_t j = 0; j < FLAGS_benchmark_records; ++j) {
+        ScopedLatency latency(histogram);
+    }
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+    std::cout << "Benchmark: " << ns / std::max<uint64_t>(FLAGS_benchmark_records, 1) << " ns per ScopedLatency" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  return RUN_ALL_TESTS();
+}
@@ -270,6 +270,24 @@ TEST_F(TestMsgChecker, test_batch_checker)
     ASSERT_ARG(checker, "0 true", (std::tuple<int, bool>{0, true}));
 }
 
+TEST_F(TestMsgChecker, test_command_index)
+{
+    using Command = Command<int()>;
+    const std::vector<Command> commands{
+        Command("a", [](const int) { return 0; }, VoidChecker("a"), ArithChecker<int>(0, 10)),
+        Command("number", [](const int) { return 1; }, ArithChecker<int>(0, 10)),
+        Command("a or b", [] { return 2; }, VoidChecker("b", "a")),
+        Command("empty", [] { return 3; }),
+        Command("b", [] { return 4; }, VoidChecker("b"), VoidChecker("b")),
+    };
+    const CommandIndex index(commands);
+    const auto candidates = [&index](const std::string& msg) { return index.Candidates(MsgReader(msg)); };
+    ASSERT_EQ((std::vector<uint32_t>{0, 1, 2, 3}), candidates("a 1"));
+    ASSERT_EQ((std::vector<uint32_t>{1, 2, 3, 4}), candidates("b"));
+    ASSERT_EQ((std::vector<uint32_t>{1, 3}), candidates("1"));
+    ASSERT_EQ((std::vector<uint32_t>{1, 3}), candidates(""));
+}
+
 int main(int argc, char** argv)
 {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,287 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+
+#include "sprite_grid.h"
+
+DEFINE_uint64(benchmark_iterations, 200, "The number of times a board is composed in the benchmark");
+
+class TestSpriteGrid : public testing::Test
+{
+  protected:
+    virtual void SetUp() override
+    {
+#ifndef WITH_PNG
+        GTEST_SKIP() << "built without libpng";
+#endif
+        dir_ = std::filesystem::temp_directory_path() /
+            ("lgtbot_test_sprite_grid_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        std::filesystem::create_directories(dir_);
+    }
+
+    virtual void TearDown() override
+    {
+        if (!dir_.empty()) {
+            std::filesystem::remove_all(dir_);
+        }
+    }
+
+    // The pixel at (x, y) is {r, g, x, y} so that every pixel of a sprite is different.
+    html::Bitmap MakeSprite(const std::string& name, const uint32_t size, const uint8_t r, const uint8_t g)
+    {
+        html::Bitmap sprite(size, size);
+        for (uint32_t y = 0; y < size; ++y) {
+            for (uint32_t x = 0; x < size; ++x) {
+                uint8_t* const pixel = sprite.Pixel(x, y);
+                pixel[0] = r;
+                pixel[1] = g;
+                pixel[2] = x;
+                pixel[3] = y == 0 ? 0 : 255; // the first row is transparent
+            }
+        }
+        EXPECT_TRUE(html::SavePng(sprite, (dir_ / (name + ".png")).string()));
+        return sprite;
+    }
+
+    std::filesystem::path dir_;
+};
+
+TEST_F(TestSpriteGrid, png_round_trip)
+{
+    const auto sprite = MakeSprite("a", 16, 10, 20);
+    const auto decoded = html::DecodePng((dir_ / "a.png").string());
+    ASSERT_TRUE(decoded.has_value());
+    ASSERT_EQ(sprite.width_, decoded->width_);
+    ASSERT_EQ(sprite.height_, decoded->height_);
+    ASSERT_EQ(sprite.pixels_, decoded->pixels_);
+    ASSERT_TRUE(html::EncodePng(sprite).has_value());
+    ASSERT_FALSE(html::DecodePng((dir_ / "not_exist.png").string()).has_value());
+}
+
+// The html table puts each sprite at `spacing + (spacing + padding * 2 + size) * index + padding` and leaves the rest
+// as the background.
+TEST_F(TestSpriteGrid, compose_as_html_table)
+{
+    constexpr uint32_t k_size = 8;
+    constexpr uint32_t k_padding = 2;
+    constexpr uint32_t k_spacing = 3;
+    const html::Bitmap sprites[2]{MakeSprite("a", k_size, 100, 0), MakeSprite("b", k_size, 0, 100)};
+    html::SpriteGrid grid(dir_.string(), 2, 3);
+    grid.SetPadding(k_padding);
+    grid.SetSpacing(k_spacing);
+    grid.Set(0, 0, "a");
+    grid.Set(0, 2, "b");
+    grid.Set(1, 1, "a");
+    grid.Set(1, 2, "a");
+
+    const auto bitmap = grid.Compose();
+    ASSERT_TRUE(bitmap.has_value());
+    constexpr uint32_t k_box_size = k_size + k_padding * 2 + k_spacing;
+    ASSERT_EQ(k_spacing + k_box_size * 3, bitmap->width_);
+    ASSERT_EQ(k_spacing + k_box_size * 2, bitmap->height_);
+    const int sprite_indexes[2][3]{{0, -1, 1}, {-1, 0, 0}};
+    for (uint32_t y = 0; y < bitmap->height_; ++y) {
+        for (uint32_t x = 0; x < bitmap->width_; ++x) {
+            const uint32_t row = (y - k_spacing) / k_box_size;
+            const uint32_t column = (x - k_spacing) / k_box_size;
+            const uint32_t sprite_y = (y - k_spacing) % k_box_size - k_padding;
+            const uint32_t sprite_x = (x - k_spacing) % k_box_size - k_padding;
+            const uint8_t background[4]{255, 255, 255, 255};
+            const uint8_t* expected = background;
+            if (y >= k_spacing && x >= k_spacing && sprite_y < k_size && sprite_x < k_size &&
+                    sprite_indexes[row][column] >= 0) {
+                expected = sprites[sprite_indexes[row][column]].Pixel(sprite_x, sprite_y);
+            }
+            if (expected[3] == 0) {
+                expected = background;
+            }
+            ASSERT_EQ(0, std::memcmp(expected, bitmap->Pixel(x, y), 4)) << "x=" << x << " y=" << y;
+        }
+    }
+
+    const auto html = grid.ToHtml();
+    ASSERT_NE(std::string::npos, html.find("cellpadding=\"2\" cellspacing=\"3\""));
+    ASSERT_NE(std::string::npos, html.find("![](file:///" + dir_.string() + "/b.png)"));
+}
+
+TEST_F(TestSpriteGrid, compose_with_alpha)
+{
+    html::Bitmap sprite(1, 1);
+    const uint8_t color[4]{200, 100, 0, 128};
+    std::memcpy(sprite.Pixel(0, 0), color, 4);
+    ASSERT_TRUE(html::SavePng(sprite, (dir_ / "a.png").string()));
+    html::SpriteGrid grid(dir_.string(), 1, 1);
+    grid.SetPadding(0);
+    grid.SetSpacing(0);
+    grid.Set(0, 0, "a");
+
+    grid.SetBackground({0, 0, 0, 0});
+    const auto transparent = grid.Compose();
+    ASSERT_TRUE(transparent.has_value());
+    ASSERT_EQ(0, std::memcmp(color, transparent->Pixel(0, 0), 4));
+
+    grid.SetBackground({0, 0, 100, 255});
+    const auto opaque = grid.Compose();
+    ASSERT_TRUE(opaque.has_value());
+    const uint8_t expected[4]{100, 50, 50, 255};
+    for (uint32_t c = 0; c < 4; ++c) {
+        ASSERT_NEAR(expected[c], opaque->Pixel(0, 0)[c], 1) << "c=" << c;
+    }
+}
+
+TEST_F(TestSpriteGrid, compose_with_missing_sprite)
+{
+    MakeSprite("a", 8, 0, 0);
+    html::SpriteGrid grid(dir_.string(), 1, 2);
+    grid.Set(0, 0, "a");
+    grid.Set(0, 1, "not_exist");
+    ASSERT_FALSE(grid.Compose().has_value());
+}
+
+TEST_F(TestSpriteGrid, cache_reload_modified_file)
+{
+    html::SpriteCache cache;
+    MakeSprite("a", 8, 100, 0);
+    const auto path = (dir_ / "a.png").string();
+    const auto bitmap = cache.Get(path);
+    ASSERT_NE(nullptr, bitmap);
+    ASSERT_EQ(bitmap, cache.Get((dir_ / "." / "a.png").string())); // keyed by the normalized path
+    ASSERT_EQ(1, cache.GetStatistic().miss_count_);
+
+    const auto modified_time = std::filesystem::last_write_time(path);
+    const auto new_sprite = MakeSprite("a", 4, 0, 100);
+    std::filesystem::last_write_time(path, modified_time + std::chrono::seconds(1));
+    const auto new_bitmap = cache.Get(path);
+    ASSERT_NE(nullptr, new_bitmap);
+    ASSERT_EQ(new_sprite.pixels_, new_bitmap->pixels_);
+    ASSERT_EQ(2, cache.GetStatistic().miss_count_);
+    ASSERT_EQ(new_bitmap->pixels_.size(), cache.Size());
+
+    ASSERT_EQ(nullptr, cache.Get((dir_ / "not_exist.png").string()));
+}
+
+TEST_F(TestSpriteGrid, cache_evict_least_recently_used)
+{
+    constexpr uint64_t k_sprite_size = 8 * 8 * 4;
+    html::SpriteCache cache(k_sprite_size * 2);
+    for (const char* const name : {"a", "b", "c"}) {
+        MakeSprite(name, 8, 0, 0);
+    }
+    const char* const names[]{"a.png", "b.png", nullptr};
+    ASSERT_EQ(2, cache.Prefetch(dir_.string(), names));
+    ASSERT_EQ(2, cache.GetStatistic().miss_count_);
+    cache.Get((dir_ / "a.png").string()); // "b" becomes the least recently used
+    cache.Get((dir_ / "c.png").string());
+    ASSERT_EQ(1, cache.GetStatistic().evict_count_);
+    ASSERT_EQ(k_sprite_size * 2, cache.Size());
+    cache.Get((dir_ / "a.png").string());
+    ASSERT_EQ(3, cache.GetStatistic().miss_count_);
+    cache.Get((dir_ / "b.png").string());
+    ASSERT_EQ(4, cache.GetStatistic().miss_count_);
+
+    cache.SetCapacity(0); // the most recently used one is kept
+    ASSERT_EQ(k_sprite_size, cache.Size());
+    ASSERT_EQ(0, cache.Prefetch(dir_.string(), nullptr));
+}
+
+TEST_F(TestSpriteGrid, render_changed_rows)
+{
+    MakeSprite("a", 8, 100, 0);
+    MakeSprite("b", 8, 0, 100);
+    MakeSprite("big", 10, 0, 0);
+    html::SpriteGrid grid(dir_.string(), 4, 3);
+    html::SpriteGridRenderer renderer;
+    const auto check_render = [&](const uint32_t expected_encoded_row_count)
+        {
+            const auto png = renderer.Render(grid);
+            ASSERT_TRUE(png.has_value());
+            ASSERT_EQ(expected_encoded_row_count, renderer.LastEncodedRowCount());
+            const auto path = (dir_ / "render.png").string();
+            std::ofstream(path, std::ios::binary).write(png->data(), png->size());
+            const auto decoded = html::DecodePng(path);
+            ASSERT_TRUE(decoded.has_value());
+            const auto composed = grid.Compose();
+            ASSERT_EQ(composed->width_, decoded->width_);
+            ASSERT_EQ(composed->height_, decoded->height_);
+            ASSERT_EQ(composed->pixels_, decoded->pixels_);
+        };
+    grid.Set(0, 0, "a");
+    grid.Set(3, 2, "b");
+    check_render(4);
+    check_render(0);
+    grid.Set(1, 1, "b");
+    check_render(1);
+    grid.Set(0, 0, "");
+    grid.Set(3, 0, "a");
+    check_render(2);
+    grid.SetSpacing(2);
+    check_render(4);
+    grid.Set(2, 2, "big"); // the size of boxes changes
+    check_render(4);
+}
+
+// A board like the one of quixo: 7x7 sprites of 64x64 pixels.
+TEST_F(TestSpriteGrid, DISABLED_benchmark)
+{
+    for (uint32_t i = 0; i < 4; ++i) {
+        MakeSprite("sprite_" + std::to_string(i), 64, i * 60, 255 - i * 60);
+    }
+    html::SpriteGrid grid(dir_.string(), 7, 7);
+    for (uint32_t row = 0; row < 7; ++row) {
+        for (uint32_t column = 0; column < 7; ++column) {
+            grid.Set(row, column, "sprite_" + std::to_string((row + column) % 4));
+        }
+    }
+    const auto benchmark_render = [&](const bool change_one_box)
+        {
+            html::SpriteGridRenderer renderer;
+            renderer.Render(grid);
+            std::chrono::nanoseconds time{0};
+            for (uint64_t i = 0; i < FLAGS_benchmark_iterations; ++i) {
+                auto new_grid = grid;
+                if (change_one_box) {
+                    new_grid.Set(i % 7, i % 5, "sprite_" + std::to_string(i % 4));
+                } else {
+                    new_grid.SetSpacing(i % 2 + 1); // redraw the whole grid
+                }
+                const auto begin = std::chrono::steady_clock::now();
+                renderer.Render(new_grid);
+                time += std::chrono::steady_clock::now() - begin;
+            }
+            return time.count() / std::max<uint64_t>(FLAGS_benchmark_iterations, 1) / 1000;
+        };
+    std::cout << "Benchmark: 7x7 board of 64x64 sprites, " << benchmark_render(false) << " us to render the whole board, "
+              << benchmark_render(true) << " us to render a change of one box" << std::endl;
+    uint64_t output_size = 0;
+    std::chrono::nanoseconds compose_time{0};
+    std::chrono::nanoseconds encode_time{0};
+    for (uint64_t i = 0; i < FLAGS_benchmark_iterations; ++i) {
+        const auto begin = std::chrono::steady_clock::now();
+        const auto bitmap = grid.Compose();
+        const auto composed = std::chrono::steady_clock::now();
+        const auto data = html::EncodePng(*bitmap);
+        encode_time += std::chrono::steady_clock::now() - composed;
+        compose_time += composed - begin;
+        output_size += data->size();
+    }
+    const uint64_t iterations = std::max<uint64_t>(FLAGS_benchmark_iterations, 1);
+    std::cout << "Benchmark: 7x7 board of 64x64 sprites, " << compose_time.count() / iterations / 1000
+              << " us to compose and " << encode_time.count() / iterations / 1000 << " us to encode per board, "
+              << output_size / iterations / 1024 << " KB per image" << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <stdexcept>
+#include <gtest/gtest.h>
+#include <gflags/gflags.h>
+
+#include "ttl_cache.h"
+
+using namespace std::chrono_literals;
+
+TEST(TestTtlCache, hit_before_expired)
+{
+    TtlCache<std::string, std::string> cache(10);
+    int fetch_count = 0;
+    const auto fetcher = [&] { ++fetch_count; return std::string("value"); };
+    ASSERT_EQ("value", cache.Get("key", 1h, fetcher));
+    ASSERT_EQ("value", cache.Get("key", 1h, fetcher));
+    ASSERT_EQ("value", cache.Get("key", 1h, fetcher));
+    ASSERT_EQ(1, fetch_count);
+    const auto statistic = cache.GetStatistic();
+    ASSERT_EQ(2, statistic.hit_count_);
+    ASSERT_EQ(1, statistic.miss_count_);
+}
+
+TEST(TestTtlCache, refetch_after_expired)
+{
+    TtlCache<std::string, int> cache(10);
+    int fetch_count = 0;
+    const auto fetcher = [&] { return ++fetch_count; };
+    ASSERT_EQ(1, cache.Get("key", 0s, fetcher));
+    ASSERT_EQ(2, cache.Get("key", 0s, fetcher));
+    ASSERT_EQ(3, cache.Get("key", 1h, fetcher)); // the value fetched with TTL 0s has expired
+    ASSERT_EQ(3, cache.Get("key", 1h, fetcher));
+}
+
+TEST(TestTtlCache, invalidate)
+{
+    TtlCache<std::string, int> cache(10);
+    int fetch_count = 0;
+    const auto fetcher = [&] { return ++fetch_count; };
+    ASSERT_EQ(1, cache.Get("key", 1h, fetcher));
+    cache.Invalidate("key");
+    ASSERT_EQ(2, cache.Get("key", 1h, fetcher));
+}
+
+TEST(TestTtlCache, evict_least_recently_used)
+{
+    TtlCache<int, int> cache(2);
+    int fetch_count = 0;
+    const auto fetcher = [&] { return ++fetch_count; };
+    cache.Get(1, 1h, fetcher);
+    cache.Get(2, 1h, fetcher);
+    cache.Get(1, 1h, fetcher); // now key 2 is the least recently used
+    cache.Get(3, 1h, fetcher);
+    ASSERT_EQ(2, cache.Size());
+    ASSERT_EQ(1, cache.GetStatistic().evict_count_);
+    ASSERT_EQ(1, cache.Get(1, 1h, fetcher));
+    ASSERT_EQ(3, cache.Get(3, 1h, fetcher));
+    ASSERT_EQ(4, cache.Get(2, 1h, fetcher));
+}
+
+TEST(TestTtlCache, fetcher_throws)
+{
+    TtlCache<std::string, int> cache(10);
+    ASSERT_THROW(cache.Get("key", 1h, []() -> int { throw std::runtime_error("fetch failed"); }), std::runtime_error);
+    ASSERT_EQ(0, cache.Size());
+    ASSERT_EQ(1, cache.Get("key", 1h, [] { return 1; }));
+}
+
+TEST(TestTtlCache, single_flight)
+{
+    constexpr int k_thread_num = 8;
+    TtlCache<std::string, int> cache(10);
+    std::atomic<int> fetch_count = 0;
+    std::atomic<bool> fetch_started = false;
+    std::atomic<bool> release = false;
+    const auto fetcher = [&]
+        {
+            ++fetch_count;
+            fetch_started = true;
+            while (!release) {
+                std::this_thread::yield();
+            }
+            return 1;
+        };
+    std::vector<std::thread> threads;
+    std::atomic<int> sum = 0;
+    threads.emplace_back([&] { sum += cache.Get("key", 1h, fetcher); });
+    while (!fetch_started) {
+        std::this_thread::yield();
+    }
+    for (int i = 1; i < k_thread_num; ++i) {
+        threads.emplace_back([&] { sum += cache.Get("key", 1h, fetcher); });
+    }
+    while (cache.GetStatistic().wait_count_ < k_thread_num - 1) {
+        std::this_thread::yield();
+    }
+    release = true;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(1, fetch_count);
+    ASSERT_EQ(k_thread_num, sum);
+}
+
+TEST(TestTtlCache, serve_stale_value_while_refreshing)
+{
+    TtlCache<std::string, int> cache(10);
+    ASSERT_EQ(1, cache.Get("key", 0s, [] { return 1; }));
+    std::atomic<bool> fetch_started = false;
+    std::atomic<bool> release = false;
+    std::thread refresher([&]
+            {
+                cache.Get("key", 1h, [&]
+                        {
+                            fetch_started = true;
+                            while (!release) {
+                                std::this_thread::yield();
+                            }
+                            return 2;
+                        });
+            });
+    while (!fetch_started) {
+        std::this_thread::yield();
+    }
+    ASSERT_EQ(1, cache.Get("key", 1h, [] { return 3; }));
+    release = true;
+    refresher.join();
+    ASSERT_EQ(2, cache.Get("key", 1h, [] { return 3; }));
+}
+
+int main(int argc, char** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  return RUN_ALL_TESTS();
+}
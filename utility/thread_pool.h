@@ -0,0 +1,73 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A fixed number of worker threads running the submitted tasks in FIFO order. The destructor waits for all submitted
+// tasks to finish.
+class ThreadPool
+{
+  public:
+    explicit ThreadPool(const uint32_t thread_num)
+    {
+        for (uint32_t i = 0; i < thread_num; ++i) {
+            threads_.emplace_back([this] { Run_(); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> l(mutex_);
+            stopped_ = true;
+        }
+        cv_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    void Submit(std::function<void()> task)
+    {
+        {
+            std::lock_guard<std::mutex> l(mutex_);
+            tasks_.emplace_back(std::move(task));
+        }
+        cv_.notify_one();
+    }
+
+  private:
+    void Run_()
+    {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> l(mutex_);
+                cv_.wait(l, [this] { return stopped_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return; // stopped
+                }
+                task = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            task();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopped_{false};
+    std::vector<std::thread> threads_;
+};
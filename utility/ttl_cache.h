@@ -0,0 +1,161 @@
+// Copyright (c) 2023-present, Chang Liu <github.com/slontia>. All rights reserved.
+//
+// This source code is licensed under LGPLv2 (found in the LICENSE file).
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+
+// A bounded LRU cache whose values are refreshed after the TTL expires.
+//
+// Only one thread calls the fetcher for a key at a time (single-flight). Other threads requesting a key which has never
+// been fetched wait for that fetch, while threads requesting an expired key get the stale value without waiting.
+template <typename Key, typename Value>
+class TtlCache
+{
+    using Clock = std::chrono::steady_clock;
+
+  public:
+    struct Statistic
+    {
+        uint64_t hit_count_ = 0;   // returned a cached value (stale values included)
+        uint64_t miss_count_ = 0;  // called the fetcher
+        uint64_t wait_count_ = 0;  // waited for a fetch made by another thread
+        uint64_t evict_count_ = 0; // removed because the cache is full
+    };
+
+    explicit TtlCache(const size_t capacity) : capacity_(capacity) {}
+
+    TtlCache(const TtlCache&) = delete;
+    TtlCache& operator=(const TtlCache&) = delete;
+
+    template <typename Fetcher>
+    Value Get(const Key& key, const Clock::duration ttl, Fetcher&& fetcher)
+    {
+        std::unique_lock<std::mutex> l(mutex_);
+        bool waited = false;
+        auto it = entries_.find(key);
+        while (it != entries_.end() && it->second.fetching_ && !it->second.value_.has_value()) {
+            if (!waited) {
+                waited = true;
+                ++wait_count_;
+            }
+            cv_.wait(l);
+            it = entries_.find(key); // the entry may be erased if the fetcher throws
+        }
+        if (it != entries_.end()) {
+            Entry& entry = it->second;
+            lru_.splice(lru_.begin(), lru_, entry.lru_it_);
+            if (entry.fetching_ || Clock::now() < entry.expire_time_) {
+                ++hit_count_;
+                return *entry.value_;
+            }
+            entry.fetching_ = true;
+            entry.ttl_ = ttl;
+        } else {
+            lru_.emplace_front(key);
+            it = entries_.emplace(key, Entry{.lru_it_ = lru_.begin(), .fetching_ = true, .ttl_ = ttl}).first;
+            Evict_();
+        }
+        ++miss_count_;
+        l.unlock();
+
+        std::optional<Value> value;
+        try {
+            value.emplace(fetcher());
+        } catch (...) {
+            l.lock();
+            Finish_(key, nullptr);
+            throw;
+        }
+
+        l.lock();
+        Finish_(key, &*value);
+        return std::move(*value);
+    }
+
+    void Invalidate(const Key& key)
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        if (const auto it = entries_.find(key); it != entries_.end() && !it->second.fetching_) {
+            lru_.erase(it->second.lru_it_);
+            entries_.erase(it);
+        }
+    }
+
+    size_t Size() const
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        return entries_.size();
+    }
+
+    Statistic GetStatistic() const
+    {
+        std::lock_guard<std::mutex> l(mutex_);
+        return Statistic{
+            .hit_count_ = hit_count_,
+            .miss_count_ = miss_count_,
+            .wait_count_ = wait_count_,
+            .evict_count_ = evict_count_,
+        };
+    }
+
+  private:
+    struct Entry
+    {
+        std::optional<Value> value_;
+        Clock::time_point expire_time_;
+        typename std::list<Key>::iterator lru_it_;
+        bool fetching_ = false;
+        Clock::duration ttl_{};
+    };
+
+    void Finish_(const Key& key, Value* const value)
+    {
+        const auto it = entries_.find(key);
+        if (it == entries_.end()) {
+            return;
+        }
+        Entry& entry = it->second;
+        entry.fetching_ = false;
+        if (value) {
+            entry.value_ = *value;
+            entry.expire_time_ = Clock::now() + entry.ttl_;
+        } else if (!entry.value_.has_value()) {
+            lru_.erase(entry.lru_it_);
+            entries_.erase(it);
+        }
+        cv_.notify_all();
+    }
+
+    // Entries being fetched for the first time cannot be evicted because there are threads waiting for them.
+    void Evict_()
+    {
+        for (auto lru_it = lru_.end(); entries_.size() > capacity_ && lru_it != lru_.begin(); ) {
+            --lru_it;
+            const auto it = entries_.find(*lru_it);
+            if (it->second.fetching_) {
+                continue;
+            }
+            lru_it = lru_.erase(lru_it);
+            entries_.erase(it);
+            ++evict_count_;
+        }
+    }
+
+    const size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::unordered_map<Key, Entry> entries_;
+    std::list<Key> lru_; // the most recently used key is at front
+    uint64_t hit_count_ = 0;
+    uint64_t miss_count_ = 0;
+    uint64_t wait_count_ = 0;
+    uint64_t evict_count_ = 0;
+};